@@ -154,6 +154,13 @@ $(document).ready(function () {
     $("#dash_ports_boblight_row").hide();
   }
 
+  if (jQuery.inArray("ledstream", window.serverInfo.services) !== -1) {
+    var ledStreamPort = window.serverConfig.ledStreamServer.enable ? window.serverConfig.ledStreamServer.port : $.i18n('general_disabled');
+    $('#dash_ledStreamPort').html(ledStreamPort);
+  } else {
+    $("#dash_ports_ledstream_row").hide();
+  }
+
   var jsonPort = window.serverConfig.jsonServer.port;
   $('#dash_jsonPort').html(jsonPort);
   var wsPorts = window.serverConfig.webConfig.port + ' | ' + window.serverConfig.webConfig.sslPort;
@@ -222,7 +222,8 @@ $(document).ready(function () {
         (window.serverInfo.grabbers.video.available.length === 0) &&
         (window.serverInfo.grabbers.audio.available.length === 0)) {
       $("#MenuItemGrabber").attr('style', 'display:none')
-      if ((jQuery.inArray("boblight", window.serverInfo.services) === -1)) {
+      if ((jQuery.inArray("boblight", window.serverInfo.services) === -1) &&
+          (jQuery.inArray("ledstream", window.serverInfo.services) === -1)) {
         $("#MenuItemInstCapture").attr('style', 'display:none')
       }
     }
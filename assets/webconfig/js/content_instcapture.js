@@ -6,12 +6,14 @@ $(document).ready(function () {
   const audioGrabberAvailable = (window.serverInfo.grabbers.audio.available.length !== 0);
 
   var BOBLIGHT_ENABLED = (jQuery.inArray("boblight", window.serverInfo.services) !== -1);
+  var LEDSTREAM_ENABLED = (jQuery.inArray("ledstream", window.serverInfo.services) !== -1);
 
   // update instance listing
   updateHyperionInstanceListing();
 
   var conf_editor_instCapt = null;
   var conf_editor_bobl = null;
+  var conf_editor_lss = null;
 
   // Instance Capture
 
@@ -27,6 +29,12 @@ $(document).ready(function () {
       $('#conf_cont_bobl').append(createOptPanel('fa-sitemap', $.i18n("edt_conf_bobls_heading_title"), 'editor_container_boblightserver', 'btn_submit_boblightserver', ''));
       $('#conf_cont_bobl').append(createHelpTable(window.schema.boblightServer.properties, $.i18n("edt_conf_bobls_heading_title"), "boblightServerHelpPanelId"));
     }
+    //DDP/E1.31 receiver
+    if (LEDSTREAM_ENABLED) {
+      $('#conf_cont').append(createRow('conf_cont_lss'));
+      $('#conf_cont_lss').append(createOptPanel('fa-sitemap', $.i18n("edt_conf_lss_heading_title"), 'editor_container_ledstreamserver', 'btn_submit_ledstreamserver', ''));
+      $('#conf_cont_lss').append(createHelpTable(window.schema.ledStreamServer.properties, $.i18n("edt_conf_lss_heading_title"), "ledStreamServerHelpPanelId"));
+    }
   }
   else {
     $('#conf_cont').addClass('row');
@@ -36,6 +44,9 @@ $(document).ready(function () {
     if (BOBLIGHT_ENABLED) {
       $('#conf_cont').append(createOptPanel('fa-sitemap', $.i18n("edt_conf_bobls_heading_title"), 'editor_container_boblightserver', 'btn_submit_boblightserver', ''));
     }
+    if (LEDSTREAM_ENABLED) {
+      $('#conf_cont').append(createOptPanel('fa-sitemap', $.i18n("edt_conf_lss_heading_title"), 'editor_container_ledstreamserver', 'btn_submit_ledstreamserver', ''));
+    }
   }
 
   if (screenGrabberAvailable || videoGrabberAvailable || audioGrabberAvailable) {
@@ -211,11 +222,57 @@ $(document).ready(function () {
     });
   }
 
+  //DDP/E1.31 receiver
+  if (LEDSTREAM_ENABLED) {
+    conf_editor_lss = createJsonEditor('editor_container_ledstreamserver', {
+      ledStreamServer: window.schema.ledStreamServer
+    }, true, true);
+
+    conf_editor_lss.on('ready', function () {
+      var ledStreamServerEnable = conf_editor_lss.getEditor("root.ledStreamServer.enable").getValue();
+      if (!ledStreamServerEnable) {
+        showInputOptionsForKey(conf_editor_lss, "ledStreamServer", "enable", false);
+        $('#ledStreamServerHelpPanelId').hide();
+      }
+    });
+
+    conf_editor_lss.on('change', function () {
+      conf_editor_lss.validate().length || window.readOnlyMode ? $('#btn_submit_ledstreamserver').prop('disabled', true) : $('#btn_submit_ledstreamserver').prop('disabled', false);
+    });
+
+    conf_editor_lss.watch('root.ledStreamServer.enable', () => {
+      var ledStreamServerEnable = conf_editor_lss.getEditor("root.ledStreamServer.enable").getValue();
+      if (ledStreamServerEnable) {
+        showInputOptionsForKey(conf_editor_lss, "ledStreamServer", "enable", true);
+        $('#ledStreamServerHelpPanelId').show();
+      } else {
+        showInputOptionsForKey(conf_editor_lss, "ledStreamServer", "enable", false);
+        $('#ledStreamServerHelpPanelId').hide();
+      }
+    });
+
+    conf_editor_lss.watch('root.ledStreamServer.protocol', () => {
+      //Switch to the protocol's standard port, if the port is still a standard one
+      var port = conf_editor_lss.getEditor("root.ledStreamServer.port").getValue();
+      var protocol = conf_editor_lss.getEditor("root.ledStreamServer.protocol").getValue();
+      if (port === 4048 || port === 5568) {
+        conf_editor_lss.getEditor("root.ledStreamServer.port").setValue(protocol === "e131" ? 5568 : 4048);
+      }
+    });
+
+    $('#btn_submit_ledstreamserver').off().on('click', function () {
+      requestWriteConfig(conf_editor_lss.getValue());
+    });
+  }
+
   //create introduction
   if (window.showOptHelp) {
     if (BOBLIGHT_ENABLED) {
       createHint("intro", $.i18n('conf_network_bobl_intro'), "editor_container_boblightserver");
     }
+    if (LEDSTREAM_ENABLED) {
+      createHint("intro", $.i18n('conf_network_lss_intro'), "editor_container_ledstreamserver");
+    }
   }
 
   removeOverlay();
@@ -289,6 +289,9 @@ $(document).ready(function () {
         newrecord.name = service.name;
         newrecord.host = service.host;
         newrecord.port = service.port;
+        if (service.imageWidth !== undefined) {
+          newrecord.imageWidth = service.imageWidth;
+        }
 
         newServices.push(newrecord);
       }
@@ -160,6 +160,9 @@ $(document).ready(function () {
         case "BOBLIGHTSERVER":
           owner = $.i18n('general_comp_BOBLIGHTSERVER');
           break;
+        case "LEDSTREAMSERVER":
+          owner = $.i18n('general_comp_LEDSTREAMSERVER') + ': (' + owner + ')';
+          break;
         case "FLATBUFSERVER":
           owner = $.i18n('general_comp_FLATBUFSERVER');
           break;
@@ -74,6 +74,14 @@ protected:
     ///
     bool setImage(ImageCmdData &data, hyperion::Components comp, QString &replyMsg, hyperion::Components callerComp = hyperion::COMP_INVALID);
 
+    ///
+    /// @brief Set an already decoded image
+    /// @param[in]  data      The command data, the image data is not evaluated
+    /// @param[in]  image     The image
+    /// @param[in]  comp      The component that should be used
+    ///
+    void setImage(ImageCmdData &data, const Image<ColorRgb> &image, hyperion::Components comp);
+
     ///
     /// @brief Clear a priority in the Muxer, if -1 all priorities are cleared
     /// @param priority   The priority to clear
@@ -100,6 +100,11 @@ signals:
 	///
 	void callbackMessage(QJsonObject);
 
+	///
+	/// Signal emits with a serialised message (compact JSON terminated by a newline), shared by all clients
+	///
+	void callbackData(const QByteArray&);
+
 	///
 	/// Signal emits whenever a JSON-message should be forwarded
 	///
@@ -26,6 +26,7 @@ class JsonCB : public QObject
 
 public:
 	JsonCB(QObject* parent);
+	~JsonCB() override;
 
 	///
 	/// @brief Subscribe to future data updates given by cmd
@@ -47,6 +48,12 @@ public:
 	///
 	QStringList getSubscribedCommands() { return _subscribedCommands; };
 
+	///
+	/// @brief Receive the published state updates (priorities, adjustments, settings) as JSON merge patches
+	/// @param enable  True for deltas, the first update of a command contains the complete state
+	///
+	void setDeltaUpdates(bool enable);
+
 	///
 	/// @brief Reset subscriptions, disconnect all signals
 	///
@@ -64,6 +71,12 @@ signals:
 	///
 	void newCallback(QJsonObject);
 
+	///
+	/// @brief Emits whenever a serialised json message callback is ready to send
+	/// @param The compact JSON message terminated by a newline
+	///
+	void newCallbackData(const QByteArray&);
+
 private slots:
 	///
 	/// @brief handle component state changes
@@ -71,22 +84,15 @@ private slots:
 	void handleComponentState(hyperion::Components comp, bool state);
 
 	///
-	/// @brief handle emits from PriorityMuxer
-	/// @param  currentPriority The current priority at time of emit
-	/// @param  activeInputs The current active input map at time of emit
+	/// @brief Handle the state updates of the shared publisher
 	///
-	void handlePriorityUpdate(int currentPriority, const PriorityMuxer::InputsMap& activeInputs);
+	void handlePublished(quint8 instance, const QString& cmd, const QByteArray& message, const QByteArray& snapshot, const QByteArray& delta);
 
 	///
 	/// @brief Handle imageToLedsMapping updates
 	///
 	void handleImageToLedsMappingChange(int mappingType);
 
-	///
-	/// @brief Handle the adjustment update
-	///
-	void handleAdjustmentChange();
-
 	///
 	/// @brief Handle video mode change
 	/// @param mode  The new videoMode
@@ -100,13 +106,6 @@ private slots:
 	void handleEffectListChange();
 #endif
 
-	///
-	/// @brief Handle a config part change. This does NOT include (global) changes from other hyperion instances
-	/// @param type   The settings type from enum
-	/// @param data   The data as QJsonDocument
-	///
-	void handleSettingsChange(settings::type type, const QJsonDocument& data);
-
 	///
 	/// @brief Handle led config specific updates (required for led color streaming with positional display)
 	/// @param type   The settings type from enum
@@ -127,6 +126,8 @@ private slots:
 private:
 	/// pointer of Hyperion instance
 	Hyperion* _hyperion;
+	/// index of the Hyperion instance
+	quint8 _instance;
 	/// pointer of comp register
 	ComponentRegister* _componentRegister;
 
@@ -136,6 +137,10 @@ private:
 	QStringList _availableCommands;
 	/// contains active subscriptions
 	QStringList _subscribedCommands;
+	/// true, if published state updates are sent as deltas
+	bool _deltaUpdates;
+	/// published commands, which the complete state was sent for
+	QStringList _deltaBase;
 	/// construct callback msg
 	void doCallback(const QString& cmd, const QVariant& data);
 };
@@ -0,0 +1,126 @@
+#pragma once
+
+// qt incl
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QMap>
+#include <QPointer>
+#include <QTimer>
+
+// settings
+#include <utils/settings.h>
+
+#include <hyperion/PriorityMuxer.h>
+
+class Hyperion;
+
+///
+/// @brief Shared publisher of the state subscriptions of all JSON API clients
+///
+/// The state updates (priorities, adjustments, settings) of an instance are built and serialised once for all
+/// subscribed clients, instead of once per JsonCB. Changes are only marked dirty on the signals of the instance,
+/// bursts are coalesced and published after a short window. Every published update gets a version number per
+/// instance and command. Besides the full update, a JSON merge patch (RFC 7386) against the previous version is
+/// provided for clients, which subscribed for delta updates. Unchanged states are not published.
+///
+class JsonCBPublisher : public QObject
+{
+	Q_OBJECT
+
+public:
+	static JsonCBPublisher* getInstance();
+
+	///
+	/// @brief Check, if the updates of a command are published by the publisher
+	/// @param cmd  The subscription command
+	/// @return True, if the command is a state subscription
+	///
+	static bool isPublished(const QString& cmd);
+
+	///
+	/// @brief Add a subscriber for the updates of a command of an instance, thread-safe
+	/// @param hyperion  The instance
+	/// @param cmd       The subscription command
+	///
+	void subscribe(Hyperion* hyperion, const QString& cmd);
+
+	///
+	/// @brief Remove a subscriber, thread-safe. The signals of the instance are disconnected with the last subscriber
+	/// @param instance  The instance index
+	/// @param cmd       The subscription command
+	///
+	void unsubscribe(quint8 instance, const QString& cmd);
+
+	///
+	/// @brief Create a JSON merge patch (RFC 7386), which transforms the source into the target
+	/// @param source  The source value
+	/// @param target  The target value
+	/// @return The patch, an undefined value if source and target are equal
+	///
+	static QJsonValue createMergePatch(const QJsonValue& source, const QJsonValue& target);
+
+signals:
+	///
+	/// @brief Emits in the main thread when an update was published. The messages are compact JSON terminated by a newline
+	/// @param instance  The instance index
+	/// @param cmd       The subscription command
+	/// @param message   The serialised update, the data contains the changes
+	/// @param snapshot  The serialised update, the data contains the complete state which later deltas are based on
+	/// @param delta     The serialised merge patch against the previous version
+	///
+	void published(quint8 instance, const QString& cmd, const QByteArray& message, const QByteArray& snapshot, const QByteArray& delta);
+
+private slots:
+	///
+	/// @brief Publish all dirty states
+	///
+	void publishDirty();
+
+private:
+	JsonCBPublisher();
+
+	struct Topic
+	{
+		/// number of subscribed clients
+		int subscribers = 0;
+		/// version of the last published state
+		quint64 version = 0;
+		/// last published state
+		QJsonValue state;
+		/// true, if the state changed since the last publishing
+		bool dirty = false;
+		/// connection to the signal of the instance
+		QMetaObject::Connection connection;
+	};
+
+	struct Channel
+	{
+		QPointer<Hyperion> hyperion;
+		QHash<QString, Topic> topics;
+
+		/// latest arguments of the priority muxer
+		int currentPriority = 0;
+		PriorityMuxer::InputsMap activeInputs;
+		/// latest changed settings, which are not published yet
+		QMap<settings::type, QJsonDocument> dirtySettings;
+	};
+
+	void addSubscriber(quint8 instance, const QPointer<Hyperion>& hyperion, const QString& cmd);
+	void removeSubscriber(quint8 instance, const QString& cmd);
+	void connectTopic(Channel& channel, const QString& cmd, Topic& topic);
+	void markDirty(quint8 instance, const QString& cmd);
+	void publish(quint8 instance, const QString& cmd, Channel& channel, Topic& topic);
+
+	QJsonObject buildPriorities(const Channel& channel) const;
+	QJsonArray buildAdjustments(const Channel& channel) const;
+
+	/// channels by instance index
+	QHash<quint8, Channel> _channels;
+	/// timer for coalescing updates
+	QTimer _timer;
+};
@@ -7,6 +7,7 @@
 // qt
 #include <QDateTime>
 #include <QUuid>
+#include <QHash>
 
 ///
 /// @brief Authentication table interface
@@ -191,6 +192,54 @@ public:
 		return false;
 	}
 
+	///
+	/// @brief      Update 'last_use' column entries of tokens in one transaction
+	/// @param[in]  lastUse   The timestamps of the last use by token hash
+	/// @return     true on success else false
+	///
+	inline bool updateTokensUsed(const QHash<QByteArray, QString>& lastUse)
+	{
+		if (!startTransaction())
+		{
+			return false;
+		}
+
+		for (auto it = lastUse.constBegin(); it != lastUse.constEnd(); ++it)
+		{
+			QVariantMap map;
+			map["last_use"] = it.value();
+
+			VectorPair cond;
+			cond.append(CPair("token", it.key()));
+			if (!updateRecord(cond, map))
+			{
+				rollbackTransaction();
+				return false;
+			}
+		}
+		return commitTransaction();
+	}
+
+	///
+	/// @brief Get the hashes of all tokens, excluding the user tokens
+	/// @return            The token hashes
+	///
+	inline const QVector<QByteArray> getTokenHashes()
+	{
+		QVector<QVariantMap> results;
+		getRecords(results, QStringList() << "token" << "id");
+
+		QVector<QByteArray> hashes;
+		for (const auto& entry : results)
+		{
+			if (!entry["id"].toString().isEmpty())
+			{
+				hashes.append(entry["token"].toByteArray());
+			}
+		}
+		return hashes;
+	}
+
 	///
 	/// @brief      Create a new token record with comment
 	/// @param[in]  token   The token id as plaintext
@@ -21,6 +21,10 @@ typedef QVector<CPair> VectorPair;
 ///        Incompatible functions with SQlite3:
 ///        QSqlQuery::size() returns always -1
 ///
+///        The database connection of each thread uses a write ahead log (WAL) and keeps its prepared statements.
+///        Several writes are batched with startTransaction() and commitTransaction(), i.e. they are synced to
+///        the storage once instead of per write
+///
 class DBManager : public QObject
 {
 	Q_OBJECT
@@ -126,6 +130,27 @@ public:
 	///
 	void setReadonlyMode(bool readOnly) { _readonlyMode = readOnly; };
 
+	///
+	/// @brief Start a transaction of the database connection of the calling thread.
+	///        Transactions may be nested, the changes are written when the outermost transaction is committed.
+	///        Every successful call requires a call of commitTransaction() or rollbackTransaction()
+	/// @return             True on success, false on error or in read-only mode
+	///
+	bool startTransaction() const;
+
+	///
+	/// @brief Commit a transaction started with startTransaction().
+	///        If a nested transaction was rolled back, the outermost transaction is rolled back instead
+	/// @return             True on success else false
+	///
+	bool commitTransaction() const;
+
+	///
+	/// @brief Roll back a transaction started with startTransaction()
+	/// @return             True on success else false
+	///
+	bool rollbackTransaction() const;
+
 private:
 
 	Logger* _log;
@@ -138,4 +163,10 @@ private:
 
 	/// addBindValue to query given by QVariantList
 	void doAddBindValue(QSqlQuery& query, const QVariantList& variants) const;
+
+	/// get the prepared query of a statement from the cache of the calling thread, prepare it if not cached
+	QSqlQuery cachedQuery(const QString& statement) const;
+
+	/// end the outermost transaction with COMMIT or ROLLBACK
+	bool endTransaction(bool commit) const;
 };
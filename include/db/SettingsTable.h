@@ -15,10 +15,11 @@ class SettingsTable : public DBManager
 
 public:
 	/// construct wrapper with settings table
-	SettingsTable(quint8 instance, QObject* parent = nullptr)
+	SettingsTable(quint8 instance, QObject* parent = nullptr, bool readonlyMode = false)
 		: DBManager(parent)
 		, _hyperion_inst(instance)
 	{
+		setReadonlyMode(readonlyMode);
 		setTable("settings");
 		// create table columns
 		createTable(QStringList()<<"type TEXT"<<"config TEXT"<<"hyperion_inst INTEGER"<<"updated_at TEXT");
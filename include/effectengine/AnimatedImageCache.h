@@ -0,0 +1,67 @@
+#pragma once
+
+// STL includes
+#include <memory>
+
+// Qt includes
+#include <QHash>
+#include <QMutex>
+#include <QSize>
+#include <QString>
+#include <QVector>
+
+// Hyperion includes
+#include <utils/Image.h>
+#include <utils/ColorRgb.h>
+
+///
+/// @brief Cache of decoded animated images (e.g. GIF, APNG) for the animated image effects
+///
+/// The frames are decoded once and scaled to the LED grid size of the instance, i.e. the resolution relevant for the
+/// LED mapping. Instances running the same image at the same size share the frames. The frames are released, when the
+/// last effect playing them has finished.
+///
+class AnimatedImageCache
+{
+public:
+	using Frames = QVector<Image<ColorRgb>>;
+
+	struct Source
+	{
+		/// File of the image, a leading ':' refers to the built-in effect images
+		QString file;
+		/// URL of the image, used instead of the file if not empty
+		QString url;
+		/// Base64 encoded image data, used instead of file and URL if not empty
+		QString imageData;
+		/// Pixels cropped at the borders of every frame
+		int cropLeft = 0;
+		int cropTop = 0;
+		int cropRight = 0;
+		int cropBottom = 0;
+		/// Convert the frames to grayscale
+		bool grayscale = false;
+	};
+
+	static AnimatedImageCache& getInstance();
+
+	///
+	/// @brief Get the frames of an animated image, the image is loaded and decoded if not cached
+	///
+	/// @param source        The image and its processing
+	/// @param size          The size of the frames, the size of the (cropped) image if empty
+	/// @param[out] error    The reason of a failure
+	/// @return The frames, nullptr on failure
+	///
+	std::shared_ptr<const Frames> getFrames(const Source& source, const QSize& size, QString& error);
+
+private:
+	AnimatedImageCache() = default;
+
+	static QString cacheKey(const Source& source, const QSize& size);
+	static bool loadImage(const Source& source, QByteArray& data, QString& error);
+	static bool decodeFrames(const QByteArray& data, const Source& source, const QSize& size, Frames& frames, QString& error);
+
+	QMutex _mutex;
+	QHash<QString, std::weak_ptr<const Frames>> _frames;
+};
@@ -15,6 +15,7 @@
 
 class Hyperion;
 class Logger;
+class NativeEffect;
 
 class Effect : public QThread
 {
@@ -77,6 +78,12 @@ private:
 	void setModuleParameters();
 	void addImage();
 
+	///
+	/// @brief Run a built-in effect by its native implementation, the frames are rendered by a timer of the effect's thread
+	/// @param effect  The native effect
+	///
+	void runNative(NativeEffect &effect);
+
 	Hyperion *_hyperion;
 
 	const int _priority;
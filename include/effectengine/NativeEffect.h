@@ -0,0 +1,77 @@
+#pragma once
+
+// STL includes
+#include <memory>
+#include <vector>
+
+// Qt includes
+#include <QJsonObject>
+#include <QSize>
+#include <QString>
+
+// Hyperion includes
+#include <utils/Image.h>
+#include <utils/ColorRgb.h>
+
+///
+/// @brief Interface of effects implemented in C++, which replace the Python scripts of built-in effects
+///
+/// A native effect renders a frame per tick of its interval, either as LED colors or as an image. The effect's thread
+/// calls render() by a timer, there is no Python interpreter involved. The effect definitions (JSON) and schemas are
+/// shared with the Python scripts, i.e. the effects take the same arguments. Scripts of users are always run by Python.
+///
+class NativeEffect
+{
+public:
+	struct Context
+	{
+		/// Number of LEDs of the instance
+		int ledCount = 0;
+		/// Size of the LED grid, i.e. the size of an image covering the LED layout
+		QSize imageSize;
+		/// Minimum time between two writes of the LED device in milliseconds
+		int latchTime = 0;
+		/// Base64 encoded image, given with the effect command
+		QString imageData;
+	};
+
+	virtual ~NativeEffect() = default;
+
+	///
+	/// @brief Create the native implementation of a built-in effect script
+	///
+	/// @param script  The script of the effect definition
+	/// @return The native effect, nullptr if the script is run by Python
+	///
+	static std::unique_ptr<NativeEffect> create(const QString& script);
+
+	///
+	/// @brief Initialise the effect with the arguments of the effect definition
+	///
+	/// @param args          The effect arguments
+	/// @param context       The instance running the effect
+	/// @param[out] error    The reason of a failure
+	/// @return True on success
+	///
+	virtual bool init(const QJsonObject& args, const Context& context, QString& error) = 0;
+
+	///
+	/// @brief Render the next frame
+	///
+	/// @param[out] ledColors  The colors of all LEDs, if the effect renders LED colors
+	/// @param[out] image      The image, if the effect renders an image
+	/// @return True if the image was rendered, false for the LED colors
+	///
+	virtual bool render(std::vector<ColorRgb>& ledColors, Image<ColorRgb>& image) = 0;
+
+	///
+	/// @brief Get the interval between two frames
+	///
+	/// @return The interval in milliseconds
+	///
+	int getInterval() const { return _interval; }
+
+protected:
+	/// Interval between two frames in milliseconds, set by init()
+	int _interval = 100;
+};
@@ -5,6 +5,7 @@
 #include <QColor>
 #include <QImage>
 #include <QTcpSocket>
+#include <QLocalSocket>
 #include <QTimer>
 #include <QMap>
 #include <QHostAddress>
@@ -15,6 +16,8 @@
 #include <utils/VideoMode.h>
 #include <utils/Logger.h>
 
+#include <flatbufserver/SharedImageRing.h>
+
 #include <flatbuffers/flatbuffers.h>
 
 const int FLATBUFFER_DEFAULT_PORT = 19400;
@@ -27,6 +30,9 @@ struct Reply;
 ///
 /// Connection class to setup an connection to the hyperion server and execute commands.
 ///
+/// Connections to a server on the same host use the server's local socket, if available.
+/// Images are then provided via shared memory instead of being serialised.
+///
 class FlatBufferConnection : public QObject
 {
 
@@ -81,6 +87,11 @@ public:
 	///
 	void sendMessage(const uint8_t* buffer, uint32_t size);
 
+	///
+	/// @brief Whether all data written was handed over to the connection, i.e. a new image is not queued behind a previous one
+	///
+	bool isWriteBufferEmpty() const;
+
 public slots:
 	///
 	/// @brief Set the leds according to the given image
@@ -99,6 +110,21 @@ private slots:
 	///
 	void readData();
 
+	///
+	/// @brief Slot called when data was written to the connection
+	///
+	void handleBytesWritten();
+
+	///
+	/// @brief Slot called when the local socket is connected
+	///
+	void handleLocalSocketConnected();
+
+	///
+	/// @brief Slot called when the local socket failed, the connection continues via TCP
+	///
+	void handleLocalSocketError(QLocalSocket::LocalSocketError error);
+
 signals:
 
 	///
@@ -106,6 +132,11 @@ signals:
 	///
 	void setVideoMode(VideoMode videoMode);
 
+	///
+	/// @brief emits when all data written was handed over to the connection
+	///
+	void writeBufferEmpty();
+
 private:
 
 	///
@@ -115,10 +146,34 @@ private:
 	///
 	bool parseReply(const hyperionnet::Reply *reply);
 
+	///
+	/// @brief Whether an error reply indicates, that the server cannot access the shared image memory
+	///
+	static bool isSharedImageRefused(const std::string& error);
+
+	///
+	/// @brief Get the state of the active connection
+	///
+	QAbstractSocket::SocketState socketState() const;
+
+	///
+	/// @brief Write a message with size header to the active connection
+	///
+	void writeMessage(const uint8_t* buffer, uint32_t size);
+
 private:
 	/// The TCP-Socket with the connection to the server
 	QTcpSocket _socket;
 
+	/// The local socket with the connection to a server on the same host
+	QLocalSocket _localSocket;
+	bool _useLocalSocket;
+	bool _isLocalHost;
+
+	/// Images provided to a server on the same host
+	SharedImageRing _sharedImages;
+	bool _sharedImagesEnabled;
+
 	QString _origin;
 	int _priority;
 
@@ -138,4 +193,5 @@ private:
 	flatbuffers::FlatBufferBuilder _builder;
 
 	bool _registered;
+	bool _skipReply;
 };
@@ -8,6 +8,7 @@
 #include <QVector>
 
 class QTcpServer;
+class QLocalServer;
 class FlatBufferClient;
 class NetOrigin;
 
@@ -46,6 +47,11 @@ private slots:
 	///
 	void newConnection();
 
+	///
+	/// @brief Is called whenever a new local socket wants to connect
+	///
+	void newLocalConnection();
+
 	///
 	/// @brief is called whenever a client disconnected
 	///
@@ -62,9 +68,15 @@ private:
 	///
 	void stopServer();
 
+	///
+	/// @brief Setup the signal connections of a new client
+	///
+	void setupClient(FlatBufferClient* client);
+
 
 private:
 	QTcpServer* _server;
+	QLocalServer* _localServer;
 	NetOrigin* _netOrigin;
 	Logger* _log;
 	int _timeout;
@@ -0,0 +1,95 @@
+#pragma once
+
+// Qt includes
+#include <QSharedMemory>
+#include <QString>
+
+// hyperion util
+#include <utils/Image.h>
+#include <utils/ColorRgb.h>
+
+///
+/// @brief Ring of image slots in shared memory, used to transfer images between processes on the same host
+///
+/// The producer (FlatBufferConnection) creates the memory segment and writes images into free slots.
+/// The consumer (FlatBufferClient) attaches to the segment by its key, which is announced via the
+/// local control connection together with the slot holding a new image. Every slot carries its own state,
+/// i.e. producer and consumer never block each other. If the consumer does not keep up, new images are dropped.
+///
+class SharedImageRing
+{
+public:
+	/// Number of image slots
+	static constexpr int SLOT_COUNT = 3;
+
+	/// Error replies of the consumer, if it cannot use the shared memory. The producer serialises the images then.
+	static constexpr const char* ERROR_NOT_LOCAL = "Shared memory images are supported for local connections only";
+	static constexpr const char* ERROR_ATTACH = "Unable to attach shared image memory";
+
+	SharedImageRing();
+	~SharedImageRing();
+
+	SharedImageRing(const SharedImageRing&) = delete;
+	SharedImageRing& operator=(const SharedImageRing&) = delete;
+
+	///
+	/// @brief Producer: Write an image into a free slot, the memory segment is (re)created if required
+	///
+	/// @param image The image
+	/// @return The slot written or -1, if no slot is free or the memory is not available
+	///
+	int write(const Image<ColorRgb>& image);
+
+	///
+	/// @brief Producer: Whether the memory segment was created or replaced since the last call
+	///
+	bool takeKeyChanged();
+
+	///
+	/// @brief Consumer: Attach to the memory segment of a producer
+	///
+	/// @param key The key of the segment
+	/// @return True on success
+	///
+	bool attach(const QString& key);
+
+	///
+	/// @brief Consumer: Read the image of a slot and release the slot
+	///
+	/// @param slot   The slot announced by the producer
+	/// @param[out] image The image
+	/// @return False, if the slot does not hold a valid image
+	///
+	bool read(int slot, Image<ColorRgb>& image);
+
+	///
+	/// @brief Consumer: Release all slots holding an image, e.g. announced images not read anymore, as the producer disconnected
+	///
+	void releaseSlots();
+
+	///
+	/// @brief Release the memory segment
+	///
+	void detach();
+
+	/// @brief The key of the memory segment
+	QString key() const { return _memory.key(); }
+
+	/// @brief Whether a memory segment is created/attached
+	bool isAttached() const { return _memory.isAttached(); }
+
+	///
+	/// @brief Get the name of the local control socket of a FlatBuffer server, which negotiates shared memory images
+	///
+	/// @param port The TCP port of the FlatBuffer server
+	///
+	static QString localServerName(quint16 port) { return QString("hyperion-flatbuffer-%1").arg(port); }
+
+private:
+	bool create(size_t slotCapacity);
+
+	QSharedMemory _memory;
+	size_t _slotCapacity;
+	int _nextSlot;
+	bool _keyChanged;
+};
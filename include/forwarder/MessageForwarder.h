@@ -5,6 +5,7 @@
 #include <map>
 #include <cstdint>
 #include <limits>
+#include <atomic>
 
 // QT includes
 #include <QList>
@@ -26,7 +27,7 @@
 
 // Forward declaration
 class Hyperion;
-class QTcpSocket;
+class JsonForwardClient;
 class FlatBufferConnection;
 class MessageForwarderFlatbufferClientsHelper;
 
@@ -87,13 +88,6 @@ private slots:
 	void forwardFlatbufferMessage(const QString& name, const Image<ColorRgb> &image);
 #endif
 
-	///
-	/// @brief Forward message to a single json target host
-	/// @param message The JSON message to send
-	/// @param socket The TCP-Socket with the connection to the target host
-	///
-	void sendJsonMessage(const QJsonObject &message, QTcpSocket *socket);
-
 private:
 
 	void enableTargets(bool enable, const QJsonObject& config);
@@ -113,9 +107,12 @@ private:
 	/// Muxer instance
 	PriorityMuxer *_muxer;
 
-	// JSON connections for forwarding
+	// JSON targets for forwarding
 	QList<TargetHost> _jsonTargets;
 
+	/// Persistent JSON connections, one per target
+	QList<JsonForwardClient*> _jsonClients;
+
 	/// Flatbuffer connection for forwarding
 	QList<TargetHost> _flatbufferTargets;
 
@@ -127,6 +124,13 @@ private:
 	MessageForwarderFlatbufferClientsHelper* _messageForwarderFlatBufHelper;
 };
 
+///
+/// @brief Runs the flatbuffer forward connections in a dedicated thread
+///
+/// Every target has its own send slot: An image is written immediately if the target's connection took over
+/// the previous one, otherwise it replaces the image waiting for the target (latest frame wins).
+/// A slow target does therefore neither delay other targets nor accumulate outdated images.
+///
 class MessageForwarderFlatbufferClientsHelper : public QObject
 {
 	Q_OBJECT
@@ -137,18 +141,32 @@ public:
 	~MessageForwarderFlatbufferClientsHelper();
 
 signals:
-	void addClient(const QString& origin, const TargetHost& targetHost, int priority, bool skipReply);
+	void addClient(const QString& origin, const TargetHost& targetHost, int priority, bool skipReply, int imageWidth);
 	void clearClients();
 
 public slots:
 	bool isFree() const;
 
 	void forwardImage(const Image<ColorRgb>& image);
-	void addClientHandler(const QString& origin, const TargetHost& targetHost, int priority, bool skipReply);
+	void addClientHandler(const QString& origin, const TargetHost& targetHost, int priority, bool skipReply, int imageWidth);
 	void clearClientsHandler();
 
 private:
+	struct ForwardTarget
+	{
+		FlatBufferConnection* connection;
+		/// Max. width of images sent, 0 for the original size
+		int imageWidth;
+		/// Image waiting for the connection to take over the previous one
+		Image<ColorRgb> pendingImage;
+		bool hasPendingImage;
+	};
+
+	///
+	/// @brief Send the image waiting for a target
+	///
+	void sendPendingImage(ForwardTarget* target);
 
-	QList<FlatBufferConnection*> _forwardClients;
-	bool _free;
+	QList<ForwardTarget*> _forwardClients;
+	std::atomic<bool> _free;
 };
@@ -19,9 +19,16 @@
 #include <X11/extensions/Xrandr.h>
 #include <X11/extensions/Xrender.h>
 #include <X11/extensions/XShm.h>
+#ifdef HAVE_XDAMAGE
+#include <X11/extensions/Xdamage.h>
+#include <X11/extensions/Xfixes.h>
+#endif
 #include <sys/ipc.h>
 #include <sys/shm.h>
 
+// STL includes
+#include <vector>
+
 #ifdef Bool
 	#undef Bool
 #endif
@@ -46,6 +53,8 @@ public:
 	/// @param[out] image  The snapped screenshot (should be initialized with correct width and
 	/// height)
 	///
+	/// @return Zero on success, FRAME_UNCHANGED if the screen did not change since the last grab (image is not updated), else negative
+	///
 	int grabFrame(Image<ColorRgb> & image, bool forceUpdate=false);
 
 	///
@@ -94,6 +103,22 @@ private:
 	void freeResources();
 	void setupResources();
 
+	///
+	/// @brief Collect the screen areas changed since the last call (XDamage)
+	///
+	/// @return False, if nothing changed
+	///
+	bool fetchDamage();
+
+	///
+	/// @brief Composite the damaged areas only into the scaled pixmap
+	///
+	/// @param scale  The scale of the pixmap in relation to the screen
+	///
+	void compositeDamage(double scale);
+
+	void reportStatistics(qint64 now);
+
 	/// Reference to the X11 display (nullptr if not opened)
 	Display* _x11Display;
 	Window _window;
@@ -122,8 +147,26 @@ private:
 	bool _xShmPixmapAvailable;
 	bool _xRenderAvailable;
 	bool _xRandRAvailable;
+	bool _xDamageAvailable;
 	bool _isWayland;
 
+#ifdef HAVE_XDAMAGE
+	Damage _damage;
+	XserverRegion _damageRegion;
+	int _xDamageEventBase;
+#endif
+	/// Screen areas changed since the last grab
+	std::vector<XRectangle> _damagedRects;
+	/// The next grab has to capture the whole screen, e.g. after a resolution change
+	bool _fullRefresh;
+	qint64 _lastFullGrabTime;
+
+	// capture statistics since the last report
+	qint64 _lastReportTime;
+	int _fullFrames;
+	int _partialFrames;
+	int _skippedFrames;
+
 	Logger * _logger;
 
 	Image<ColorRgb> _image;
@@ -18,6 +18,9 @@
 #include <xcb/xcb.h>
 #include <xcb/xcb_image.h>
 
+// STL includes
+#include <vector>
+
 class Logger;
 
 class XcbGrabber : public Grabber, public QAbstractNativeEventFilter
@@ -32,6 +35,9 @@ public:
 	bool open();
 	bool setupDisplay();
 
+	///
+	/// @return Zero on success, FRAME_UNCHANGED if the screen did not change since the last grab (image is not updated), else negative
+	///
 	int grabFrame(Image<ColorRgb> & image, bool forceUpdate = false);
 	int updateScreenDimensions(bool force = false);
 	void setVideoMode(VideoMode mode) override;
@@ -59,6 +65,23 @@ private:
 	void setupRender();
 	void setupRandr();
 	void setupShm();
+	void setupDamage();
+
+	///
+	/// @brief Collect the screen areas changed since the last call (XDamage)
+	///
+	/// @return False, if nothing changed
+	///
+	bool fetchDamage();
+
+	///
+	/// @brief Composite the damaged areas only into the scaled pixmap
+	///
+	/// @param scale  The scale of the pixmap in relation to the screen
+	///
+	void compositeDamage(double scale);
+
+	void reportStatistics(qint64 now);
 	xcb_screen_t * getScreen(const xcb_setup_t *setup, int screen_num) const;
 	xcb_render_pictformat_t findFormatForVisual(xcb_visualid_t visual) const;
 
@@ -82,8 +105,23 @@ private:
 	bool _XcbRandRAvailable;
 	bool _XcbShmAvailable;
 	bool _XcbShmPixmapAvailable;
+	bool _XcbDamageAvailable;
 	bool _isWayland;
 
+	uint32_t _damage;
+	uint32_t _damageRegion;
+	/// Screen areas changed since the last grab
+	std::vector<xcb_rectangle_t> _damagedRects;
+	/// The next grab has to capture the whole screen, e.g. after a resolution change
+	bool _fullRefresh;
+	qint64 _lastFullGrabTime;
+
+	// capture statistics since the last report
+	qint64 _lastReportTime;
+	int _fullFrames;
+	int _partialFrames;
+	int _skippedFrames;
+
 	Logger * _logger;
 
 	uint8_t * _shmData;
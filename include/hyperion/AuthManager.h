@@ -6,6 +6,13 @@
 //qt
 #include <QMap>
 #include <QVector>
+#include <QSet>
+#include <QHash>
+#include <QCache>
+#include <QMutex>
+
+// stl
+#include <atomic>
 
 class AuthTable;
 class MetaTable;
@@ -24,6 +31,8 @@ private:
 	AuthManager(QObject *parent = nullptr, bool readonlyMode = false);
 
 public:
+	~AuthManager() override;
+
 	struct AuthDefinition
 	{
 		QString id;
@@ -77,6 +86,16 @@ public:
 	///
 	bool isTokenAuthBlocked() const { return (_tokenAuthAttempts.length() >= 25); }
 
+	///
+	/// @brief Check if token is authorized by the token cache, i.e. without a database access.
+	/// This function is thread safe and may be called from the API threads directly.
+	/// The 'last_use' of the token is written to the database with the next flush of the token usage.
+	/// A failure is not counted against the token auth block, call isTokenAuthorized() for that
+	/// @param  token  The token
+	/// @return        True if authorized, false if unknown or token auth is blocked
+	///
+	bool isTokenAuthorizedCached(const QString &token);
+
 	/// Pointer of this instance
 	static AuthManager *manager;
 	/// Get Pointer of this instance
@@ -218,6 +237,11 @@ private:
 	///
 	void setAuthBlock(bool user = false);
 
+	///
+	/// @brief Load the token hashes from the database into the token cache
+	///
+	void loadTokenCache();
+
 	/// Database interface for auth table
 	AuthTable *_authTable;
 
@@ -251,6 +275,24 @@ private:
 	// Contains timestamps of failed token login attempts
 	QVector<uint64_t> _tokenAuthAttempts;
 
+	/// Reflects isTokenAuthBlocked() for the token cache
+	std::atomic<bool> _tokenAuthBlocked;
+
+	/// Guards the token cache and the pending token usage
+	QMutex _tokenCacheMutex;
+
+	/// Hashes of all tokens
+	QSet<QByteArray> _tokenHashes;
+
+	/// Recently verified tokens with their hash, saves hashing tokens used repeatedly
+	QCache<QString, QByteArray> _verifiedTokens;
+
+	/// 'last_use' timestamps by token hash, which are not written to the database yet
+	QHash<QByteArray, QString> _pendingTokenUse;
+
+	/// Timer for writing the token usage to the database
+	QTimer *_tokenUseTimer;
+
 private slots:
 	///
 	/// @brief Check timeout of pending requests
@@ -261,4 +303,9 @@ private slots:
 	/// @brief Check if there are timeouts for failed login attempts
 	///
 	void checkAuthBlockTimeout();
+
+	///
+	/// @brief Write the pending 'last_use' timestamps of tokens to the database
+	///
+	void flushTokenUse();
 };
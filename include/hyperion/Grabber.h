@@ -22,6 +22,9 @@ class Grabber : public QObject
 
 public:
 
+	/// Result of grabFrame(), if the screen did not change since the last grab and the image was not updated
+	static constexpr int FRAME_UNCHANGED = 1;
+
 	Grabber(const QString& grabberName = "", int cropLeft=0, int cropRight=0, int cropTop=0, int cropBottom=0);
 
 	///
@@ -16,6 +16,7 @@
 #include <utils/PixelFormat.h>
 #include <utils/settings.h>
 #include <utils/VideoStandard.h>
+#include <utils/Tracing.h>
 
 #include <grabber/GrabberType.h>
 
@@ -112,7 +113,16 @@ public:
 			_image.resize(w, h);
 		}
 
-		int ret = grabber.grabFrame(_image);
+		int ret;
+		{
+			TRACE_SCOPE(tracing::Stage::GRAB);
+			ret = grabber.grabFrame(_image);
+		}
+		if (ret == Grabber::FRAME_UNCHANGED)
+		{
+			// the last image is still valid, spare its processing
+			return true;
+		}
 		if (ret >= 0)
 		{
 			emit systemImage(_grabberName, _image);
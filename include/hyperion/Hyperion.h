@@ -44,6 +44,7 @@ class ImageProcessor;
 class MessageForwarder;
 #endif
 class LinearColorSmoothing;
+class UpdateScheduler;
 #if defined(ENABLE_EFFECTENGINE)
 class EffectEngine;
 #endif
@@ -55,6 +56,9 @@ class CaptureCont;
 #if defined(ENABLE_BOBLIGHT_SERVER)
 class BoblightServer;
 #endif
+#if defined(ENABLE_LEDSTREAM_SERVER)
+class LedStreamServer;
+#endif
 class LedDeviceWrapper;
 class Logger;
 
@@ -389,6 +393,11 @@ public slots:
 
 	int getLatchTime() const;
 
+	///
+	/// @brief Get the number of frames of the visible priority processed and superseded by newer ones before processing
+	///
+	QJsonObject getUpdateStatistics() const;
+
 	///
 	/// @brief Set hyperion in suspend mode or resume from suspend/idle.
 	/// All instances and components will be disabled/enabled.
@@ -575,6 +584,12 @@ private:
 	/// The smoothing LedDevice
 	LinearColorSmoothing * _deviceSmooth;
 
+	/// Coalesces the updates of incoming frames to the output rate
+	UpdateScheduler* _updateScheduler;
+
+	/// The latch time of the LED-device (ms)
+	int _ledDeviceLatchTime;
+
 #if defined(ENABLE_EFFECTENGINE)
 	/// Effect engine
 	EffectEngine * _effectEngine;
@@ -608,5 +623,10 @@ private:
 	BoblightServer* _boblightServer;
 #endif
 
+#if defined(ENABLE_LEDSTREAM_SERVER)
+	/// DDP/E1.31 receiver instance
+	LedStreamServer* _ledStreamServer;
+#endif
+
 	bool _readOnlyMode;
 };
@@ -10,6 +10,7 @@
 #include <hyperion/LedString.h>
 #include <hyperion/ImageToLedsMap.h>
 #include <utils/Logger.h>
+#include <utils/Tracing.h>
 
 // settings
 #include <utils/settings.h>
@@ -135,6 +136,7 @@ public:
 			verifyBorder(image);
 
 			// Create a result vector and call the 'in place' function
+			TRACE_SCOPE(tracing::Stage::MAPPING);
 			switch (_mappingType)
 			{
 			case 1:
@@ -180,6 +182,7 @@ public:
 			verifyBorder(image);
 
 			// Determine the mean or uni colors of each led (using the existing mapping)
+			TRACE_SCOPE(tracing::Stage::MAPPING);
 			switch (_mappingType)
 			{
 			case 1:
@@ -231,6 +234,8 @@ private:
 	template <typename Pixel_T>
 	void verifyBorder(const Image<Pixel_T> & image)
 	{
+		TRACE_SCOPE(tracing::Stage::BORDER_DETECTION);
+
 		if (!_borderProcessor->enabled() && ( _imageToLedColors->horizontalBorder()!=0 || _imageToLedColors->verticalBorder()!=0 ))
 		{
 			Debug(_log, "Reset border");
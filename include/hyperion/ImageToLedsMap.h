@@ -12,6 +12,7 @@
 #include <utils/Logger.h>
 #include <utils/ColorRgbScalar.h>
 #include <utils/ColorSys.h>
+#include <utils/WorkerPool.h>
 
 // hyperion includes
 #include <hyperion/LedString.h>
@@ -110,13 +111,8 @@ namespace hyperion
 				return;
 			}
 
-			// Iterate each led and compute the mean
-			auto led = ledColors.begin();
-			for (auto colors = _colorsMap.begin(); colors != _colorsMap.end(); ++colors, ++led)
-			{
-				const ColorRgb color = calcMeanColor(image, *colors);
-				*led = color;
-			}
+			// Compute the mean color of the LEDs, chunks of LEDs are processed in parallel
+			processLedAreas(ledColors, [this, &image](const std::vector<int>& pixels) { return calcMeanColor(image, pixels); });
 		}
 
 		///
@@ -151,13 +147,8 @@ namespace hyperion
 				return;
 			}
 
-			// Iterate each led and compute the mean
-			auto led = ledColors.begin();
-			for (auto colors = _colorsMap.begin(); colors != _colorsMap.end(); ++colors, ++led)
-			{
-				const ColorRgb color = calcMeanColorSqrt(image, *colors);
-				*led = color;
-			}
+			// Compute the mean color of the LEDs, chunks of LEDs are processed in parallel
+			processLedAreas(ledColors, [this, &image](const std::vector<int>& pixels) { return calcMeanColorSqrt(image, pixels); });
 		}
 
 		///
@@ -229,13 +220,8 @@ namespace hyperion
 				return;
 			}
 
-			// Iterate each led and compute the dominant color
-			auto led = ledColors.begin();
-			for (auto colors = _colorsMap.begin(); colors != _colorsMap.end(); ++colors, ++led)
-			{
-				const ColorRgb color = calculateDominantColor(image, *colors);
-				*led = color;
-			}
+			// Compute the dominant color of the LEDs, chunks of LEDs are processed in parallel
+			processLedAreas(ledColors, [this, &image](const std::vector<int>& pixels) { return calculateDominantColor(image, pixels); });
 		}
 
 		///
@@ -271,13 +257,8 @@ namespace hyperion
 				return;
 			}
 
-			// Iterate each led and compute the dominant color
-			auto led = ledColors.begin();
-			for (auto colors = _colorsMap.begin(); colors != _colorsMap.end(); ++colors, ++led)
-			{
-				const ColorRgb color = calculateDominantColorAdv(image, *colors);
-				*led = color;
-			}
+			// Compute the dominant color of the LEDs, chunks of LEDs are processed in parallel
+			processLedAreas(ledColors, [this, &image](const std::vector<int>& pixels) { return calculateDominantColorAdv(image, pixels); });
 		}
 
 	private:
@@ -301,6 +282,31 @@ namespace hyperion
 		/// The absolute indices into the image for each led
 		std::vector<std::vector<int>> _colorsMap;
 
+		/// The first LED of each chunk processed in parallel, followed by the number of LEDs
+		std::vector<size_t> _chunkStarts;
+
+		///
+		/// Splits the LED areas into chunks of about the same number of pixels to be processed in parallel
+		///
+		void createChunks();
+
+		///
+		/// Calculates the color of every LED area, chunks of LED areas are processed by the worker pool
+		///
+		/// @param[out] ledColors  The vector containing the output
+		/// @param[in] calcColor   Calculates the color of the LED area given by its pixels
+		///
+		template <typename Calc_T>
+		void processLedAreas(std::vector<ColorRgb> & ledColors, const Calc_T & calcColor) const
+		{
+			WorkerPool::getInstance().run(_chunkStarts.size() - 1, [this, &ledColors, &calcColor](size_t chunk) {
+				for (size_t led = _chunkStarts[chunk]; led < _chunkStarts[chunk + 1]; ++led)
+				{
+					ledColors[led] = calcColor(_colorsMap[led]);
+				}
+			});
+		}
+
 		///
 		/// Calculates the 'mean color' over the given image. This is the mean over each color-channel
 		/// (red, green, blue)
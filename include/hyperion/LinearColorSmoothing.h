@@ -4,6 +4,7 @@
 // STL includes
 #include <vector>
 #include <deque>
+#include <atomic>
 
 // Qt includes
 #include <QVector>
@@ -12,6 +13,7 @@
 #include <leddevice/LedDevice.h>
 #include <utils/Components.h>
 #include <hyperion/PriorityMuxer.h>
+#include <utils/LatestFrameSlot.h>
 
 // settings
 #include <utils/settings.h>
@@ -22,6 +24,7 @@
 class QTimer;
 class Logger;
 class Hyperion;
+class SmoothingOutputThread;
 
 enum SmoothingConfigID
 {
@@ -69,6 +72,12 @@ enum SmoothingConfigID
 ///           the average color values to the 8-bit RGB resolution of the LED-device. Effectively,
 ///           this performs diffusion of the residual errors across multiple egress frames.
 ///
+///           Output thread
+///           =============
+///           Optionally, interpolation and output are run on a dedicated thread which is paced by a
+///           monotonic clock with absolute deadlines instead of the QTimer on the instance thread.
+///           Ingress frames are then handed over to the output thread via a lock-free slot, and the
+///           smoothing state is owned by the output thread as long as it is running.
 ///
 
 class LinearColorSmoothing : public QObject
@@ -92,9 +101,12 @@ public:
 
 	void setEnable(bool enable);
 	void setPause(bool pause);
-	bool pause() const { return _pause; }
+	bool pause() const { return _pause.load(); }
 	bool enabled() const { return _enabled && !_pause; }
 
+	/// @return The interval of the LED updates of the current configuration (µsec)
+	int64_t getUpdateIntervalMicros() const { return _updateIntervalMicros; }
+
 	///
 	/// @brief Add a new smoothing configuration which can be used with selectConfig()
 	/// @param   settlingTime_ms       The buffer time
@@ -162,6 +174,29 @@ private:
 	///
 	virtual int write(const std::vector<ColorRgb> &ledValues);
 
+	/// Takes over a new target frame into the smoothing state
+	///
+	/// @param time The time the frame was received
+	/// @param ledValues The color-value per led
+	/// @return True, if this is the first frame after the smoothing state was cleared
+	///
+	bool ingestFrame(int64_t time, const std::vector<ColorRgb> &ledValues);
+
+	/// Output thread callback which takes over the latest ingress frame and writes updated led values to the led device
+	void updateLedsOutputThread();
+
+	/// Enables or disables the dedicated output thread
+	///
+	/// @param enable True, to run interpolation and output on the output thread
+	///
+	void setOutputThreadEnabled(bool enable);
+
+	/// Starts the output thread, or the timer if no output thread is used
+	void startOutput();
+
+	/// Stops the output thread, or the timer if no output thread is used
+	void stopOutput();
+
 	QString getConfig(int cfgID);
 
 	/// Logger instance
@@ -182,6 +217,12 @@ private:
 	/// The Qt timer object
 	QTimer *_timer;
 
+	/// The dedicated output thread (nullptr, if output is driven by the timer)
+	SmoothingOutputThread *_outputThread;
+
+	/// The interval at which to update the leds (µsec)
+	int64_t _updateIntervalMicros;
+
 	/// The timestamp at which the target data should be fully applied
 	int64_t _targetTime;
 
@@ -216,6 +257,11 @@ private:
 		REMEMBERED_FRAME ( REMEMBERED_FRAME && ) = default;
 		REMEMBERED_FRAME ( const REMEMBERED_FRAME & ) = default;
 		REMEMBERED_FRAME & operator= ( const REMEMBERED_FRAME & ) = default;
+		REMEMBERED_FRAME & operator= ( REMEMBERED_FRAME && ) = default;
+
+		REMEMBERED_FRAME()
+		: time(0)
+		{}
 
 		REMEMBERED_FRAME(int64_t time, const std::vector<ColorRgb> colors)
 		: time(time)
@@ -227,8 +273,11 @@ private:
 	/// The queue of temporarily remembered frames
 	std::deque<REMEMBERED_FRAME> _frameQueue;
 
+	/// Hand-over of ingress frames to the output thread
+	LatestFrameSlot<REMEMBERED_FRAME> _frameSlot;
+
 	/// Flag for pausing
-	bool _pause;
+	std::atomic<bool> _pause;
 
 	/// The interval time in microseconds for writing of LED Frames.
 	int64_t _outputIntervalMicros;
@@ -262,6 +311,9 @@ private:
 		/// The interval time in milliseconds of the timer used for scheduling LED update operations. A value of 0 indicates sub-millisecond timing.
 		int _updateInterval;
 
+		/// The interval time in microseconds used for scheduling LED update operations on the output thread.
+		int64_t _updateIntervalMicros;
+
 		/// The type of smoothing to perform
 		SmoothingType _type;
 
@@ -297,8 +349,9 @@ private:
 
 	/// Pushes the colors into the frame queue and cleans outdated frames from memory.
 	///
+	/// @param time The time the colors were received
 	/// @param ledColors The next colors to queue
-	void rememberFrame(const std::vector<ColorRgb> &ledColors);
+	void rememberFrame(int64_t time, const std::vector<ColorRgb> &ledColors);
 
 	/// Frees the LED frames that were queued for calculating the moving average.
 	void clearRememberedFrames();
@@ -312,13 +365,14 @@ private:
 	size_t _ledCount = 0;
 
 	/// The average component colors red, green, blue of the leds
+	/// The component buffers hold the RGB components of all leds as one flat stream, processed by vectorised kernels (see SmoothingKernels.h)
 	std::vector<floatT> meanValues;
 
 	/// The residual component errors of the leds
 	std::vector<floatT> residualErrors;
 
-	/// The accumulated led color values in 64-bit fixed point domain
-	std::vector<uint64_t> tempValues;
+	/// The accumulated weighted led color components
+	std::vector<floatT> tempValues;
 
 	/// Writes the target frame RGB data to the LED device without any interpolation.
 	void writeDirect();
@@ -354,7 +408,7 @@ private:
 	/// @param colors The LED colors to aggregate.
 	/// @param weighted The target vector, that accumulates the terms.
 	/// @param weight The weight to use.
-	static inline void aggregateComponents(const std::vector<ColorRgb>& colors, std::vector<uint64_t>& weighted, const floatT weight);
+	static inline void aggregateComponents(const std::vector<ColorRgb>& colors, std::vector<floatT>& weighted, const floatT weight);
 
 	/// Gets the current time in microseconds from high precision system clock.
 	static inline int64_t micros() ;
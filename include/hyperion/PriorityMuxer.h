@@ -82,7 +82,7 @@ public:
 	~PriorityMuxer() override;
 
 	///
-	/// @brief Start/Stop the PriorityMuxer update timer; On disabled no priority and timeout updates will be performend
+	/// @brief Start/Stop the PriorityMuxer deadline timer; On disabled no priority and timeout updates will be performend
 	/// @param  enable  The new state
 	///
 	void setEnable(bool enable);
@@ -242,6 +242,34 @@ private slots:
 	void updatePriorities();
 
 private:
+	///
+	/// Entry of the deadline index, the absolute timeout of a priority channel
+	///
+	struct Deadline
+	{
+		int64_t timeoutTime_ms;
+		int priority;
+
+		bool operator>(const Deadline& other) const { return timeoutTime_ms > other.timeoutTime_ms; }
+	};
+
+	///
+	/// @brief Add the timeout of a priority channel to the deadline index and arm the timer, if it is the next expiry
+	/// @param priority        The priority channel
+	/// @param timeoutTime_ms  The absolute timeout
+	///
+	void addDeadline(int priority, int64_t timeoutTime_ms);
+
+	///
+	/// @brief Arm the timer for the next expiry of the deadline index, deadlines of changed channels are dropped
+	///
+	void armDeadlineTimer();
+
+	///
+	/// @brief Update the priorities with the next event loop iteration, e.g. after a priority was cleared
+	///
+	void scheduleUpdate();
+
 	///
 	/// @brief Get the component of the given priority
 	/// @return The component
@@ -272,9 +300,21 @@ private:
 	// Reflect the state of auto select
 	bool _sourceAutoSelectEnabled;
 
-	// Timer to update Muxer times independent
+	// One-shot timer to update the priorities at the next expiry or after changes
 	QTimer* _updateTimer;
 
+	// Deadline index, a min-heap of the channel timeouts; entries of changed or removed channels are dropped lazily
+	std::vector<Deadline> _deadlines;
+
+	// The deadline the timer is armed for, -1 if none
+	int64_t _armedDeadline;
+
+	// True, if the update timer is armed for an immediate update
+	bool _updatePending;
+
+	// Reflect the state of setEnable()
+	bool _enabled;
+
 	QTimer* _timer;
 	QTimer* _blockTimer;
 };
@@ -0,0 +1,54 @@
+#ifndef SMOOTHINGKERNELS_H
+#define SMOOTHINGKERNELS_H
+
+// STL includes
+#include <cstddef>
+#include <cstdint>
+
+///
+/// @brief Vectorised kernels used by LinearColorSmoothing
+///
+/// All kernels operate on flat component buffers, i.e. the RGB components of N LEDs are processed as
+/// one stream of 3*N values. As the components of every LED are treated identically, no de-interleaving
+/// of the packed RGB data is required and full SIMD register widths can be used.
+///
+/// Implementations are provided for SSE2, AVX2 and NEON plus a scalar fallback. The best implementation
+/// supported by the CPU is selected at runtime. All implementations produce identical results.
+///
+namespace smoothing {
+
+struct Kernels
+{
+	/// The name of the implementation
+	const char* name;
+
+	/// Accumulates weighted components: acc[i] += weight * src[i]
+	void (*accumulate)(const uint8_t* src, float* acc, size_t count, float weight);
+
+	/// Scales components: dst[i] = src[i] * factor
+	void (*scale)(const float* src, float* dst, size_t count, float factor);
+
+	/// Rounds components to the nearest integer clamped to [0, 255]
+	void (*quantize)(const float* values, uint8_t* dst, size_t count);
+
+	/// Rounds components incl. the residual errors of the previous frame to the nearest integer clamped to [0, 255]
+	/// and stores the new residual errors (temporal dithering)
+	void (*quantizeDithered)(const float* values, float* residuals, uint8_t* dst, size_t count);
+
+	/// Moves the current components towards the target by the fraction k (rounded up), k is expected to be in [0, 1]
+	void (*linearStep)(const uint8_t* target, uint8_t* current, size_t count, float k);
+};
+
+///
+/// @brief Get the best kernel implementation supported by the CPU (runtime dispatched)
+///
+const Kernels& kernels();
+
+///
+/// @brief Get the scalar reference implementation
+///
+const Kernels& scalarKernels();
+
+} // namespace smoothing
+
+#endif // SMOOTHINGKERNELS_H
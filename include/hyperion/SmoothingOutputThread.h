@@ -0,0 +1,120 @@
+#ifndef SMOOTHINGOUTPUTTHREAD_H
+#define SMOOTHINGOUTPUTTHREAD_H
+
+// STL includes
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+// Qt includes
+#include <QThread>
+#include <QMutex>
+
+class Logger;
+
+///
+/// @brief Dedicated output thread for LinearColorSmoothing
+///
+/// The thread is paced by a monotonic clock using absolute deadlines (clock_nanosleep with TIMER_ABSTIME on Linux),
+/// i.e. the tick rate does not drift with the processing time per tick and is not affected by the load on the
+/// instance thread. The interval between ticks is tracked to provide frame-interval jitter statistics.
+///
+class SmoothingOutputThread : public QThread
+{
+	Q_OBJECT
+
+public:
+	/// Frame-interval statistics of a measurement window
+	struct JitterStatistics
+	{
+		/// The number of ticks in the window
+		int64_t ticks = 0;
+
+		/// The configured tick interval (µs)
+		int64_t intervalMicros = 0;
+
+		/// The shortest, average and longest interval measured between two ticks (µs)
+		int64_t minIntervalMicros = 0;
+		double avgIntervalMicros = 0.0;
+		int64_t maxIntervalMicros = 0;
+
+		/// The mean absolute deviation of the measured intervals from the configured interval (µs)
+		double meanJitterMicros = 0.0;
+
+		/// The longest wake-up delay after a deadline (µs)
+		int64_t maxLatenessMicros = 0;
+
+		/// The number of deadlines that were missed completely and skipped
+		int64_t missedDeadlines = 0;
+	};
+
+	///
+	/// @brief Constructor
+	///
+	/// @param tick    Function called on the output thread at every deadline
+	/// @param log     Logger used for the statistics
+	/// @param parent  Parent object
+	///
+	SmoothingOutputThread(std::function<void()> tick, Logger* log, QObject* parent = nullptr);
+	~SmoothingOutputThread() override;
+
+	///
+	/// @brief Set the tick interval, takes effect with the next start of the thread
+	///
+	/// @param intervalMicros The interval between two ticks in microseconds
+	///
+	void setInterval(int64_t intervalMicros);
+
+	///
+	/// @brief Start the output thread with time critical priority, if it is not running yet
+	///
+	void startOutput();
+
+	///
+	/// @brief Stop the output thread and wait until it has finished
+	///
+	void stopOutput();
+
+	///
+	/// @brief Get the statistics of the last completed measurement window
+	///
+	JitterStatistics getStatistics() const;
+
+	///
+	/// @brief Get the current time of the monotonic clock used for pacing
+	///
+	/// @return Time in microseconds
+	///
+	static int64_t monotonicMicros();
+
+protected:
+	void run() override;
+
+private:
+	/// Sleep until the given absolute deadline of the monotonic clock
+	static void sleepUntil(int64_t deadlineMicros);
+
+	/// Record a tick in the current measurement window
+	void recordTick(int64_t now, int64_t deadline, int64_t previousTick);
+
+	/// Publish and log the current measurement window and start a new one
+	void finishWindow(int64_t now);
+
+	std::function<void()> _tick;
+	Logger* _log;
+
+	std::atomic<int64_t> _intervalMicros;
+	std::atomic<bool> _stopRequested;
+
+	/// Measurement window, only accessed by the output thread
+	JitterStatistics _window;
+	int64_t _windowStart;
+	double _intervalSum;
+	double _jitterSum;
+
+	/// The last completed measurement window
+	mutable QMutex _statisticsMutex;
+	JitterStatistics _statistics;
+};
+
+#endif // SMOOTHINGOUTPUTTHREAD_H
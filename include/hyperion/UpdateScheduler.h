@@ -0,0 +1,59 @@
+#pragma once
+
+// STL includes
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+// Qt includes
+#include <QObject>
+#include <QTimer>
+#include <QJsonObject>
+
+///
+/// @brief Coalesces the updates of the visible priority to the output rate
+///
+/// The priority muxer keeps the latest input of every priority, i.e. it acts as mailbox holding the latest frame only.
+/// A new frame requests an update, which is processed immediately if the last update is at least one output tick ago
+/// (e.g. the first frame after an idle phase). Otherwise the update is deferred to the next tick, where it processes
+/// the latest frame received in the meantime; the frames received before are superseded without being processed.
+/// The output tick is provided by the owner, e.g. the smoothing update interval or the LED-device latch time.
+///
+class UpdateScheduler : public QObject
+{
+	Q_OBJECT
+
+public:
+	///
+	/// @param process         The update to be scheduled
+	/// @param outputInterval  Provides the current output tick in microseconds, zero disables the coalescing
+	/// @param parent          The parent object
+	///
+	UpdateScheduler(std::function<void()> process, std::function<int64_t()> outputInterval, QObject* parent = nullptr);
+
+	///
+	/// @brief Request an update for a new frame, the update is processed now or at the next output tick
+	///
+	void requestUpdate();
+
+	///
+	/// @brief Get the number of frames processed and superseded since the start
+	///
+	QJsonObject getStatistics() const;
+
+private slots:
+	void process();
+
+private:
+	static int64_t micros();
+
+	std::function<void()> _process;
+	std::function<int64_t()> _outputInterval;
+
+	QTimer _timer;
+	/// Time of the last update processed (µsec)
+	int64_t _lastUpdateMicros;
+
+	std::atomic<uint64_t> _processed;
+	std::atomic<uint64_t> _superseded;
+};
@@ -290,6 +290,13 @@ signals:
 	///
 	void enableStateChanged(bool newState);
 
+	///
+	/// @brief Emits whenever the latch time of the LED-Device is set.
+	///
+	/// @param[in] latchTime_ms The latch time in milliseconds
+	///
+	void latchTimeChanged(int latchTime_ms);
+
 protected:
 
 	///
@@ -322,6 +329,27 @@ protected:
 	///
 	virtual int write(const std::vector<ColorRgb>& ledValues) = 0;
 
+	/// Range of consecutive LEDs, which changed since the last write
+	struct DirtyRange
+	{
+		/// Index of the first LED
+		int start;
+		/// Number of LEDs
+		int length;
+	};
+
+	///
+	/// @brief Writes the changed RGB-Color values to the LEDs.
+	///
+	/// Called instead of write(), if delta writes are enabled and supported by the device and only parts of the LEDs changed.
+	/// The default implementation writes all LEDs.
+	///
+	/// @param[in] ledValues The RGB-color per LED
+	/// @param[in] dirtyRanges The ranges of LEDs changed since the last write, ascending and not overlapping
+	/// @return Zero on success, else negative
+	///
+	virtual int writeDelta(const std::vector<ColorRgb>& ledValues, const std::vector<DirtyRange>& dirtyRanges);
+
 	///
 	/// @brief Writes "BLACK" to the output stream,
 	/// even if the device is not in enabled state (allowing to have a defined state during device power-off).
@@ -443,6 +471,9 @@ protected:
 	/// Does the device should be kept on after streaming
 	bool _isStayOnAfterStreaming;
 
+	/// Does the device support writing parts of the LEDs via writeDelta?
+	bool _isDeltaWriteSupported;
+
 	/// Device, lights state before streaming via hyperion
 	QJsonObject _orignalStateValues;
 
@@ -494,6 +525,24 @@ private:
 	/// @brief Stop refresh cycle
 	void stopRefreshTimer();
 
+	///
+	/// @brief Write the LED values, only the LEDs changed since the last write if delta writes are enabled
+	///
+	/// @param[in] ledValues The RGB-color per LED
+	/// @return Zero on success, else negative
+	///
+	int writeChanges(const std::vector<ColorRgb>& ledValues);
+
+	///
+	/// @brief Collect the LEDs differing from the written ones by more than the threshold
+	///
+	/// @param[in] ledValues The RGB-color per LED
+	///
+	void collectDirtyRanges(const std::vector<ColorRgb>& ledValues);
+
+	/// @brief Forget the written LED values, i.e. the next write is a full one
+	void resetWrittenLeds() { _writtenLedValues.clear(); }
+
 	/// Timer that enables a device (used to retry enablement, if enabled failed before)
 	QTimer*	_enableAttemptsTimer;
 
@@ -515,6 +564,24 @@ private:
 
 	/// Last LED values written
 	std::vector<ColorRgb> _lastLedValues;
+
+	/// Are only changed LEDs written?
+	bool _isDeltaWriteEnabled;
+
+	/// Maximum difference per color channel, which does not mark a LED dirty
+	int _deltaThreshold;
+
+	/// Interval of full writes, while delta writes are enabled (in milliseconds)
+	int _fullRefreshInterval_ms;
+
+	/// Timestamp of the last full write (in milliseconds since epoch)
+	qint64 _lastFullWriteTime_ms;
+
+	/// LED values as shown by the device, i.e. the reference for delta writes
+	std::vector<ColorRgb> _writtenLedValues;
+
+	/// Ranges of LEDs changed, buffer reused per write
+	std::vector<DirtyRange> _dirtyRanges;
 };
 
 #endif // LEDEVICE_H
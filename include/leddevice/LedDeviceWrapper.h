@@ -106,6 +106,13 @@ signals:
 	
 	void stopLedDevice();
 
+	///
+	/// PIPER signal for LedDevice -> Hyperion
+	///
+	/// @param[in] latchTime_ms  The latch time of the device in milliseconds
+	///
+	void latchTimeChanged(int latchTime_ms);
+
 private slots:
 	///
 	/// @brief Is called whenever the led device switches between on/off. The led device can disable it's component state
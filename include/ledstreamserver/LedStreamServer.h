@@ -0,0 +1,149 @@
+#pragma once
+
+// system includes
+#include <cstdint>
+#include <vector>
+
+// Qt includes
+#include <QHostAddress>
+#include <QJsonDocument>
+
+// Hyperion includes
+#include <utils/Logger.h>
+#include <utils/Components.h>
+#include <utils/ColorRgb.h>
+
+// settings
+#include <utils/settings.h>
+
+class Hyperion;
+class QUdpSocket;
+
+///
+/// This class creates a UDP server which receives realtime LED data via DDP or E1.31 (sACN).
+///
+/// Frames spanning several DDP packets or E1.31 universes are assembled in place into a LED buffer,
+/// which is allocated for the LED layout of the instance. A completed frame is handed to the
+/// registered priority. DDP frames are completed by the push flag, E1.31 frames once all universes
+/// of the layout were received or by a synchronisation packet.
+///
+class LedStreamServer : public QObject
+{
+	Q_OBJECT
+
+public:
+	enum class Protocol
+	{
+		DDP,
+		E131
+	};
+
+	///
+	/// LedStreamServer constructor
+	/// @param hyperion Hyperion instance
+	/// @param config   The server configuration
+	///
+	LedStreamServer(Hyperion* hyperion, const QJsonDocument& config);
+	~LedStreamServer() override;
+
+	///
+	/// @return the port number on which this server receives data
+	///
+	uint16_t getPort() const;
+
+	/// @return true if server is active (bind to a port)
+	///
+	bool active() const;
+
+public slots:
+	///
+	/// bind server to network
+	///
+	void start();
+
+	///
+	/// close server
+	///
+	void stop();
+
+	void compStateChangeRequest(hyperion::Components component, bool enable);
+
+	///
+	/// @brief Handle settings update from Hyperion Settingsmanager emit or this constructor
+	/// @param type   settingyType from enum
+	/// @param config configuration object
+	///
+	void handleSettingsUpdate(settings::type type, const QJsonDocument& config);
+
+private slots:
+	///
+	/// Slot which is called when datagrams are pending
+	///
+	void readPendingDatagrams();
+
+private:
+	///
+	/// @brief Copy the LED data of a DDP packet into the LED buffer, push the frame if flagged
+	///
+	void processDdp(const uint8_t* data, int size, const QHostAddress& sender);
+
+	///
+	/// @brief Copy the DMX data of an E1.31 packet into the LED buffer, push the frame once complete
+	///
+	void processE131(const uint8_t* data, int size, const QHostAddress& sender);
+
+	///
+	/// @brief Resize the LED buffer and the universe bookkeeping to the current LED layout
+	///
+	void updateLayout();
+
+	///
+	/// @brief Join or leave the multicast groups of the configured universes
+	///
+	void updateMulticastGroups(bool join);
+
+	///
+	/// @brief Hand the LED buffer to the registered priority
+	///
+	void pushFrame(const QHostAddress& sender);
+
+	/// Hyperion instance
+	Hyperion * _hyperion;
+
+	/// The UDP socket
+	QUdpSocket * _socket;
+
+	/// Logger instance
+	Logger * _log;
+
+	/// Configuration
+	Protocol _protocol;
+	uint16_t _port;
+	int _priority;
+	int _timeout;
+	int _universe;
+	int _channelsPerUniverse;
+
+	/// The LED buffer the frames are assembled in
+	std::vector<ColorRgb> _ledColors;
+
+	/// Receive buffer for a single datagram
+	std::vector<char> _datagram;
+
+	/// E1.31: number of universes spanned by the LED layout
+	int _universeCount;
+	/// E1.31: bitmap of the universes received for the current frame
+	std::vector<bool> _universeReceived;
+	int _universesPending;
+	/// E1.31: last sequence number per universe
+	std::vector<int> _sequence;
+	/// E1.31: frame is completed by a synchronisation packet
+	int _syncUniverse;
+
+	/// Multicast groups joined
+	std::vector<QHostAddress> _multicastGroups;
+
+	/// The origin the priority is registered for
+	QHostAddress _registeredSender;
+	bool _isRegistered;
+};
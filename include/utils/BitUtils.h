@@ -0,0 +1,42 @@
+#ifndef BITUTILS_H
+#define BITUTILS_H
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace BitUtils {
+
+///
+/// @brief Index of the most significant set bit, i.e. floor(log2(value))
+///
+/// @param[in] value Value, must not be zero
+/// @return Index of the highest set bit (0..63)
+///
+inline int highestBitIndex(uint64_t value)
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+	unsigned long index = 0;
+	_BitScanReverse64(&index, value);
+	return static_cast<int>(index);
+#elif defined(_MSC_VER)
+	// 32-bit targets provide the 32-bit bit scan only
+	unsigned long index = 0;
+	const auto high = static_cast<unsigned long>(value >> 32);
+	if (high != 0)
+	{
+		_BitScanReverse(&index, high);
+		return static_cast<int>(index) + 32;
+	}
+	_BitScanReverse(&index, static_cast<unsigned long>(value));
+	return static_cast<int>(index);
+#else
+	return 63 - __builtin_clzll(static_cast<unsigned long long>(value));
+#endif
+}
+
+} // namespace BitUtils
+
+#endif // BITUTILS_H
@@ -20,6 +20,9 @@ enum Components
 #endif
 #if defined(ENABLE_BOBLIGHT_SERVER)
 	COMP_BOBLIGHTSERVER,
+#endif
+#if defined(ENABLE_LEDSTREAM_SERVER)
+	COMP_LEDSTREAMSERVER,
 #endif
 	COMP_GRABBER,
 	COMP_V4L,
@@ -48,6 +51,9 @@ inline const char* componentToString(Components c)
 #endif
 #if defined(ENABLE_BOBLIGHT_SERVER)
 		case COMP_BOBLIGHTSERVER:return "Boblight server";
+#endif
+#if defined(ENABLE_LEDSTREAM_SERVER)
+		case COMP_LEDSTREAMSERVER:return "DDP/E1.31 receiver";
 #endif
 		case COMP_GRABBER:       return "Framegrabber";
 		case COMP_V4L:           return "V4L capture device";
@@ -78,6 +84,9 @@ inline const char* componentToIdString(Components c)
 #endif
 #if defined(ENABLE_BOBLIGHT_SERVER)
 		case COMP_BOBLIGHTSERVER:return "BOBLIGHTSERVER";
+#endif
+#if defined(ENABLE_LEDSTREAM_SERVER)
+		case COMP_LEDSTREAMSERVER:return "LEDSTREAMSERVER";
 #endif
 		case COMP_GRABBER:       return "GRABBER";
 		case COMP_V4L:           return "V4L";
@@ -107,6 +116,9 @@ inline Components stringToComponent(const QString& component)
 #endif
 #if defined(ENABLE_BOBLIGHT_SERVER)
 	if (cmp == "BOBLIGHTSERVER")return COMP_BOBLIGHTSERVER;
+#endif
+#if defined(ENABLE_LEDSTREAM_SERVER)
+	if (cmp == "LEDSTREAMSERVER")return COMP_LEDSTREAMSERVER;
 #endif
 	if (cmp == "GRABBER")       return COMP_GRABBER;
 	if (cmp == "V4L")           return COMP_V4L;
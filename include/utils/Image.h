@@ -32,6 +32,18 @@ public:
 	{
 	}
 
+	///
+	/// Constructor for an image with specified width and height, whose pixels are not initialised.
+	/// To be used, if every pixel is written afterwards, e.g. by a decoder or a copy.
+	///
+	/// @param width The width of the image
+	/// @param height The height of the image
+	///
+	Image(int width, int height, ImageNoInit_t) :
+		_d_ptr(new ImageData<Pixel_T>(width, height, ImageNoInit))
+	{
+	}
+
 	///
 	/// Copy constructor for an image
 	/// @param other The image which will be copied
@@ -138,6 +150,19 @@ public:
 	/// @param height The height of the image
 	void resize(int width, int height)
 	{
+		const ImageData<Pixel_T>* data = _d_ptr.constData();
+		if (width == data->width() && height == data->height())
+		{
+			return;
+		}
+
+		// The content is not preserved, i.e. a shared buffer does not need to be copied before
+		if (data->ref.loadAcquire() > 1)
+		{
+			_d_ptr = new ImageData<Pixel_T>(width, height, ImageNoInit);
+			return;
+		}
+
 		_d_ptr->resize(width, height);
 	}
 
@@ -0,0 +1,43 @@
+#pragma once
+
+// STL includes
+#include <cstddef>
+
+class QJsonObject;
+
+///
+/// @brief Pool of the pixel buffers of images
+///
+/// Images are created and destroyed at frame rate by grabbers and network servers. Their buffers are recycled
+/// instead of being allocated each time. Buffers are grouped into size classes (eight per power of two, i.e. at most
+/// 12.5% unused capacity) and are aligned to 64 bytes for SIMD processing. Released buffers are kept in a small
+/// cache of the releasing thread first, further ones in a global free list shared by all threads, as images are
+/// usually created in one thread (e.g. a grabber) and released in another one (e.g. Hyperion).
+///
+namespace ImageBufferPool
+{
+	/// Alignment of all buffers
+	constexpr size_t ALIGNMENT = 64;
+
+	///
+	/// @brief Get a buffer of at least the given size
+	///
+	/// @param bytes         Required size of the buffer
+	/// @param[out] capacity The usable size of the buffer, which has to be passed to release()
+	/// @return The uninitialised buffer
+	///
+	void* allocate(size_t bytes, size_t& capacity);
+
+	///
+	/// @brief Return a buffer to the pool
+	///
+	/// @param buffer    The buffer (nullptr is ignored)
+	/// @param capacity  The capacity returned by allocate()
+	///
+	void release(void* buffer, size_t capacity);
+
+	///
+	/// @brief Get the pool statistics, i.e. the number of buffers allocated from the system versus reused and the memory in use and pooled
+	///
+	QJsonObject getStatistics();
+}
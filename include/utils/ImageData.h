@@ -4,7 +4,9 @@
 #include <cstdint>
 #include <cstring>
 #include <algorithm>
+#include <type_traits>
 #include <utils/ColorRgb.h>
+#include <utils/ImageBufferPool.h>
 
 // QT includes
 #include <QSharedData>
@@ -15,16 +17,30 @@
 typedef SSIZE_T ssize_t;
 #endif
 
+///
+/// @brief Tag to create an image without initialising its pixels, e.g. as target of a decoder or a copy
+///
+struct ImageNoInit_t { explicit ImageNoInit_t() = default; };
+inline constexpr ImageNoInit_t ImageNoInit{};
+
 template <typename Pixel_T>
 class ImageData : public QSharedData
 {
+	static_assert(std::is_trivially_copyable<Pixel_T>::value, "Pixels are copied and recycled bytewise");
+
 public:
 	typedef Pixel_T pixel_type;
 
-	ImageData(int width, int height, const Pixel_T background) :
+	ImageData(int width, int height, ImageNoInit_t) :
 		_width(width),
 		_height(height),
-		_pixels(new Pixel_T[static_cast<size_t>(width) * static_cast<size_t>(height)])
+		_capacity(0),
+		_pixels(allocate(width, height, _capacity))
+	{
+	}
+
+	ImageData(int width, int height, const Pixel_T background) :
+		ImageData(width, height, ImageNoInit)
 	{
 		std::fill(_pixels, _pixels + width * height, background);
 	}
@@ -33,7 +49,8 @@ public:
 		QSharedData(other),
 		_width(other._width),
 		_height(other._height),
-		_pixels(new Pixel_T[static_cast<size_t>(other._width) * static_cast<size_t>(other._height)])
+		_capacity(0),
+		_pixels(allocate(other._width, other._height, _capacity))
 	{
 		memcpy(_pixels, other._pixels, static_cast<size_t>(other._width) * static_cast<size_t>(other._height) * sizeof(Pixel_T));
 	}
@@ -49,12 +66,14 @@ public:
 		using std::swap;
 		swap(this->_width, s._width);
 		swap(this->_height, s._height);
+		swap(this->_capacity, s._capacity);
 		swap(this->_pixels, s._pixels);
 	}
 
 	ImageData(ImageData&& src) noexcept
 		: _width(0)
 		, _height(0)
+		, _capacity(0)
 		, _pixels(NULL)
 	{
 		src.swap(*this);
@@ -68,7 +87,7 @@ public:
 
 	~ImageData()
 	{
-		delete[] _pixels;
+		ImageBufferPool::release(_pixels, _capacity);
 	}
 
 	inline int width() const
@@ -113,14 +132,14 @@ public:
 			return;
 		}
 
-		// Allocate a new buffer without initializing the content
-		Pixel_T* newPixels = new Pixel_T[static_cast<size_t>(width) * static_cast<size_t>(height)];
-
-		// Release the old buffer without copying data
-		delete[] _pixels;
-
-		// Update the pointer to the new buffer
-		_pixels = newPixels;
+		// Keep the buffer if it is large enough, the content is not preserved anyway
+		if (static_cast<size_t>(width) * static_cast<size_t>(height) * sizeof(Pixel_T) > _capacity)
+		{
+			ImageBufferPool::release(_pixels, _capacity);
+			_pixels = nullptr;
+			_capacity = 0;
+			_pixels = allocate(width, height, _capacity);
+		}
 
 		_width = width;
 		_height = height;
@@ -173,10 +192,17 @@ private:
 		return y * _width + x;
 	}
 
+	static Pixel_T* allocate(int width, int height, size_t& capacity)
+	{
+		return static_cast<Pixel_T*>(ImageBufferPool::allocate(static_cast<size_t>(width) * static_cast<size_t>(height) * sizeof(Pixel_T), capacity));
+	}
+
 	/// The width of the image
 	int _width;
 	/// The height of the image
 	int _height;
+	/// The size of the pixel buffer in bytes, which may exceed the size of the image
+	size_t _capacity;
 	/// The pixels of the image
 	Pixel_T* _pixels;
 };
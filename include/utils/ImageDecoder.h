@@ -0,0 +1,44 @@
+#pragma once
+
+// Qt includes
+#include <QByteArray>
+#include <QString>
+
+// Utils includes
+#include <utils/Image.h>
+#include <utils/ColorRgb.h>
+
+///
+/// @brief Decoding of images received via the network APIs into RGB images
+///
+/// Encoded images are downscaled while decoding, instead of decoding them in full size and scaling them in further
+/// passes. JPEG images are decoded by libjpeg-turbo (if available) with DCT-domain scaling, i.e. the image is only
+/// reconstructed in the reduced size. Other formats are decoded by the Qt image plugins at the scaled size.
+/// The pixels are written into the (pooled) buffer of the resulting image.
+///
+namespace ImageDecoder
+{
+	///
+	/// @brief Decode an encoded image (e.g. JPEG, PNG), keeping its aspect ratio while reducing it to the given bound
+	///
+	/// @param data          The encoded image
+	/// @param format        The image format, e.g. "png", detected from the data if empty
+	/// @param maxSize       Upper bound of width and height, zero for the image's size
+	/// @param[out] image    The decoded image
+	/// @param[out] error    The reason of a failure
+	/// @return True on success
+	///
+	bool decode(const QByteArray& data, const QByteArray& format, int maxSize, Image<ColorRgb>& image, QString& error);
+
+	///
+	/// @brief Decode base64 encoded raw RGB data directly into the image buffer
+	///
+	/// @param base64        The base64 encoded pixels, 3 bytes (red, green, blue) per pixel
+	/// @param width         The width of the image
+	/// @param height        The height of the image
+	/// @param[out] image    The decoded image
+	/// @param[out] error    The reason of a failure
+	/// @return True on success
+	///
+	bool decodeRawRgb(const QString& base64, int width, int height, Image<ColorRgb>& image, QString& error);
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <utils/FileUtils.h>
+#include <utils/jsonschema/QJsonSchemaChecker.h>
 
 #include <QJsonObject>
 #include <utils/Logger.h>
@@ -75,6 +76,16 @@ namespace JsonUtils {
 	///
 	bool validate(const QString& file, const QJsonObject& json, const QJsonObject& schema, Logger* log);
 
+	///
+	/// @brief Validate json data against a compiled schema
+	/// @param[in]   file     The path/name of json file just used for log messages
+	/// @param[in]   json     The json data
+	/// @param[in]   schema   The compiled schema
+	/// @param[in]   log      The logger of the caller to print errors
+	/// @return               true on success else false
+	///
+	bool validate(const QString& file, const QJsonObject& json, const QJsonSchemaChecker::CompiledSchema& schema, Logger* log);
+
 	///
 	/// @brief Write json data to file
 	/// @param[in]   filenameThe file path to write
@@ -0,0 +1,124 @@
+#ifndef LATESTFRAMESLOT_H
+#define LATESTFRAMESLOT_H
+
+// STL includes
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+///
+/// @brief Lock-free single-producer/single-consumer hand-over slot with "latest frame wins" semantics.
+///
+/// The slot is implemented as a triple buffer. The producer fills the write buffer and publishes it,
+/// the consumer picks up the most recently published buffer. Neither side ever blocks or waits for the
+/// other one; frames which are published before the consumer picked up the previous one are superseded.
+///
+/// Buffers are recycled, i.e. containers stored in the slot keep their capacity between frames.
+///
+template <typename T>
+class LatestFrameSlot
+{
+public:
+	LatestFrameSlot()
+		: _buffers()
+		, _writeIndex(0)
+		, _readIndex(2)
+		, _shared(1)
+		, _published(0)
+		, _superseded(0)
+	{
+	}
+
+	LatestFrameSlot(const LatestFrameSlot&) = delete;
+	LatestFrameSlot& operator=(const LatestFrameSlot&) = delete;
+
+	///
+	/// @brief Producer side: The buffer to be filled before calling publish()
+	///
+	T& writeBuffer()
+	{
+		return _buffers[_writeIndex];
+	}
+
+	///
+	/// @brief Producer side: Publish the write buffer to the consumer
+	///
+	void publish()
+	{
+		const uint8_t previous = _shared.exchange(static_cast<uint8_t>(_writeIndex | DIRTY), std::memory_order_acq_rel);
+		_writeIndex = previous & INDEX_MASK;
+		if ((previous & DIRTY) != 0)
+		{
+			_superseded.fetch_add(1, std::memory_order_relaxed);
+		}
+		_published.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	///
+	/// @brief Producer side: Copy a value into the write buffer and publish it
+	///
+	void push(const T& value)
+	{
+		writeBuffer() = value;
+		publish();
+	}
+
+	///
+	/// @brief Consumer side: Pick up the latest published buffer, if any
+	///
+	/// @return True, if a new buffer was published since the last call, readBuffer() is valid then
+	///
+	bool consume()
+	{
+		if ((_shared.load(std::memory_order_acquire) & DIRTY) == 0)
+		{
+			return false;
+		}
+
+		const uint8_t previous = _shared.exchange(_readIndex, std::memory_order_acq_rel);
+		_readIndex = previous & INDEX_MASK;
+		return true;
+	}
+
+	///
+	/// @brief Consumer side: The buffer picked up by the last successful consume()
+	///
+	T& readBuffer()
+	{
+		return _buffers[_readIndex];
+	}
+
+	///
+	/// @brief Whether a published buffer is waiting to be consumed (can be called from any thread)
+	///
+	bool pending() const
+	{
+		return (_shared.load(std::memory_order_acquire) & DIRTY) != 0;
+	}
+
+	/// @return The number of buffers published in total
+	uint64_t publishedCount() const { return _published.load(std::memory_order_relaxed); }
+
+	/// @return The number of published buffers which were replaced before the consumer picked them up
+	uint64_t supersededCount() const { return _superseded.load(std::memory_order_relaxed); }
+
+private:
+	static constexpr uint8_t INDEX_MASK = 0x03;
+	static constexpr uint8_t DIRTY = 0x04;
+
+	std::array<T, 3> _buffers;
+
+	/// Index of the buffer owned by the producer
+	uint8_t _writeIndex;
+
+	/// Index of the buffer owned by the consumer
+	uint8_t _readIndex;
+
+	/// Index of the buffer in between, including the dirty flag
+	std::atomic<uint8_t> _shared;
+
+	std::atomic<uint64_t> _published;
+	std::atomic<uint64_t> _superseded;
+};
+
+#endif // LATESTFRAMESLOT_H
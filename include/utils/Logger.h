@@ -38,6 +38,8 @@
 
 // ================================================================
 
+class AsyncLogWorker;
+
 class Logger : public QObject
 {
 	Q_OBJECT
@@ -70,6 +72,21 @@ public:
 	static void     setLogLevel(LogLevel level, const QString & name = "", const QString & subName = "__");
 	static LogLevel getLogLevel(const QString & name = "", const QString & subName = "__");
 
+	///
+	/// @brief Enable/disable asynchronous logging.
+	///        Messages are then only formatted by the caller and pushed to a lock-free queue,
+	///        console/syslog output and signal emission are done by a background thread.
+	///
+	/// @param enable True, to log asynchronously
+	///
+	static void     setAsynchronous(bool enable);
+	static bool     isAsynchronous();
+
+	///
+	/// @brief Get the number of messages dropped, as the asynchronous queue was full
+	///
+	static quint64  getAsyncOverrunCount();
+
 	void     Message(LogLevel level, const char* sourceFile, const char* func, unsigned int line, const char* fmt, ...);
 	void     setMinLevel(LogLevel level) { _minLevel = static_cast<int>(level); }
 	LogLevel getMinLevel() const { return static_cast<LogLevel>(int(_minLevel)); }
@@ -84,8 +101,22 @@ protected:
 	~Logger() override;
 
 private:
+	friend class AsyncLogWorker;
+
 	void write(const Logger::T_LOG_MESSAGE & message);
 
+	///
+	/// @brief Handle a formatted message incl. repeat detection, write it to console/syslog and emit it
+	///
+	/// @param repeatCount    Repeat count of the message stream (per thread)
+	/// @param repeatMessage  Last message of the message stream (per thread)
+	///
+	void dispatch(LogLevel level, const char* sourceFile, const char* func, unsigned int line, const char* msg, qint64 utime,
+				  int& repeatCount, Logger::T_LOG_MESSAGE& repeatMessage);
+
+	/// Flush and stop asynchronous logging, e.g. before loggers are deleted
+	static void stopAsynchronous();
+
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 14, 0))
 	static QRecursiveMutex       MapLock;
 #else
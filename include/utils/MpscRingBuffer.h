@@ -0,0 +1,128 @@
+#ifndef MPSCRINGBUFFER_H
+#define MPSCRINGBUFFER_H
+
+// STL includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+///
+/// @brief Bounded lock-free multi-producer/single-consumer ring buffer
+///
+/// Every cell carries a sequence number which tells producers and the consumer whether the cell is free,
+/// being filled or ready to be consumed (D. Vyukov's bounded queue). Producers only compete for the
+/// enqueue position, the consumer never blocks a producer. Records are filled and consumed in place,
+/// i.e. no additional copies of (larger) records are required.
+///
+/// @tparam T        The record type, must be default constructible
+/// @tparam Capacity The number of cells, must be a power of two
+///
+template <typename T, size_t Capacity>
+class MpscRingBuffer
+{
+	static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+	MpscRingBuffer()
+		: _cells(new Cell[Capacity])
+		, _enqueuePos(0)
+		, _dequeuePos(0)
+	{
+		for (size_t i = 0; i < Capacity; ++i)
+		{
+			_cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	MpscRingBuffer(const MpscRingBuffer&) = delete;
+	MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+	///
+	/// @brief Producer side: Claim a cell, fill it in place and publish it
+	///
+	/// @param fill Function called with a reference to the claimed record
+	/// @return False, if the buffer is full (nothing was written)
+	///
+	template <typename F>
+	bool tryPush(F&& fill)
+	{
+		size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+		Cell* cell;
+		for (;;)
+		{
+			cell = &_cells[pos & MASK];
+			const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+			if (diff == 0)
+			{
+				if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (diff < 0)
+			{
+				// The consumer has not released the cell yet
+				return false;
+			}
+			else
+			{
+				pos = _enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		fill(cell->data);
+		cell->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	///
+	/// @brief Consumer side: Consume the oldest published record in place
+	///
+	/// @param consume Function called with a reference to the record
+	/// @return False, if no published record is available
+	///
+	template <typename F>
+	bool tryPop(F&& consume)
+	{
+		Cell* cell = &_cells[_dequeuePos & MASK];
+		const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+		if (sequence != _dequeuePos + 1)
+		{
+			return false;
+		}
+
+		consume(cell->data);
+		cell->sequence.store(_dequeuePos + Capacity, std::memory_order_release);
+		++_dequeuePos;
+		return true;
+	}
+
+	///
+	/// @brief Consumer side: Whether a published record is available
+	///
+	bool isReadable() const
+	{
+		return _cells[_dequeuePos & MASK].sequence.load(std::memory_order_acquire) == _dequeuePos + 1;
+	}
+
+	static constexpr size_t capacity() { return Capacity; }
+
+private:
+	static constexpr size_t MASK = Capacity - 1;
+
+	struct Cell
+	{
+		std::atomic<size_t> sequence;
+		T data;
+	};
+
+	std::unique_ptr<Cell[]> _cells;
+
+	/// Producers and consumer positions live on different cache lines
+	alignas(64) std::atomic<size_t> _enqueuePos;
+	alignas(64) size_t _dequeuePos;
+};
+
+#endif // MPSCRINGBUFFER_H
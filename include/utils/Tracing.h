@@ -0,0 +1,131 @@
+#ifndef TRACING_H
+#define TRACING_H
+
+// STL includes
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Qt includes
+#include <QJsonObject>
+
+///
+/// Low-overhead tracing of the main processing stages.
+///
+/// Static probes are placed in the hot paths, e.g.
+///
+///     TRACE_SCOPE(tracing::Stage::MAPPING);
+///
+/// The duration of the enclosing scope is measured with the monotonic clock and recorded into a latency histogram
+/// owned by the calling thread (HDR-style log-linear buckets), i.e. recording does neither lock nor allocate.
+/// In addition, the most recent spans of every thread are kept in a small ring, which can be exported in
+/// Chrome trace format (chrome://tracing, Perfetto) to analyse the latency of the complete capture-to-LED pipeline.
+///
+/// Tracing is enabled by default and can be switched at runtime.
+///
+namespace tracing {
+
+enum class Stage : uint8_t
+{
+	GRAB = 0,
+	RESAMPLE,
+	BORDER_DETECTION,
+	MAPPING,
+	ADJUSTMENT,
+	SMOOTHING,
+	DEVICE_WRITE,
+	COUNT
+};
+
+///
+/// @brief Get the name of a stage as used in metrics and traces
+///
+const char* stageToString(Stage stage);
+
+///
+/// @brief Enable/disable recording of probes
+///
+void setEnabled(bool enable);
+
+/// Recording state, use setEnabled()/isEnabled()
+extern std::atomic<bool> RECORDING_ENABLED;
+
+///
+/// @brief Whether probes are recorded
+///
+inline bool isEnabled()
+{
+	return RECORDING_ENABLED.load(std::memory_order_relaxed);
+}
+
+///
+/// @brief Get the current time of the monotonic tracing clock
+///
+/// @return Time in nanoseconds
+///
+inline int64_t nowNanos()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+///
+/// @brief Record the duration of a stage for the calling thread
+///
+/// @param stage    The processing stage
+/// @param startNs  Start time of the stage
+/// @param endNs    End time of the stage
+///
+void record(Stage stage, int64_t startNs, int64_t endNs);
+
+///
+/// @brief Get the latency metrics of all stages (count, mean, percentiles and max in microseconds), aggregated over all threads
+///
+QJsonObject getMetrics();
+
+///
+/// @brief Get the recently recorded spans of all threads in Chrome trace event format
+///
+QJsonObject getChromeTrace();
+
+///
+/// @brief Reset the metrics, i.e. the next getMetrics() only covers stages recorded from now on
+///
+void reset();
+
+///
+/// @brief Measures the lifetime of the probe object as duration of the given stage
+///
+class ScopedProbe
+{
+public:
+	explicit ScopedProbe(Stage stage)
+		: _stage(stage)
+		, _startNs(isEnabled() ? nowNanos() : 0)
+	{
+	}
+
+	~ScopedProbe()
+	{
+		if (_startNs != 0)
+		{
+			record(_stage, _startNs, nowNanos());
+		}
+	}
+
+	ScopedProbe(const ScopedProbe&) = delete;
+	ScopedProbe& operator=(const ScopedProbe&) = delete;
+
+private:
+	const Stage _stage;
+	const int64_t _startNs;
+};
+
+} // namespace tracing
+
+#define TRACE_PROBE_CONCAT_INNER(a, b) a##b
+#define TRACE_PROBE_CONCAT(a, b) TRACE_PROBE_CONCAT_INNER(a, b)
+
+/// Record the duration of the enclosing scope as given tracing::Stage
+#define TRACE_SCOPE(stage) tracing::ScopedProbe TRACE_PROBE_CONCAT(traceProbe_, __LINE__)(stage)
+
+#endif // TRACING_H
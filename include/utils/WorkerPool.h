@@ -0,0 +1,69 @@
+#pragma once
+
+// STL includes
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+///
+/// @brief Persistent pool of worker threads shared by all instances to process data-parallel work, e.g. the LED areas of an image
+///
+/// A job is split by the caller into chunks, which are claimed one by one by the calling thread and by all idle workers.
+/// Idle workers join any job with unclaimed chunks, i.e. they take over the work of other instances if their own is done.
+/// With no worker threads configured, jobs are processed sequentially by the calling thread.
+///
+class WorkerPool
+{
+public:
+	static WorkerPool& getInstance();
+
+	///
+	/// @brief Set the number of worker threads
+	///
+	/// @param count  Number of threads in addition to the calling ones, 0 disables parallel processing
+	///
+	void setThreadCount(int count);
+
+	/// @return The number of worker threads
+	int threadCount() const { return _threadCount.load(std::memory_order_relaxed); }
+
+	///
+	/// @brief Process the chunks of a job and wait until all are done
+	///
+	/// @param chunkCount  The number of chunks
+	/// @param task        Processes the chunk with the given index, called concurrently for different chunks
+	///
+	void run(size_t chunkCount, const std::function<void(size_t)>& task);
+
+private:
+	WorkerPool() = default;
+	~WorkerPool();
+
+	struct Job
+	{
+		const std::function<void(size_t)>* task;
+		size_t chunkCount;
+		std::atomic<size_t> nextChunk { 0 };
+		/// Number of workers processing chunks of the job
+		int workers { 0 };
+	};
+
+	static void process(Job& job);
+	void work();
+	void stopThreads();
+
+	std::mutex _configMutex;
+	std::vector<std::thread> _threads;
+	std::atomic<int> _threadCount { 0 };
+
+	std::mutex _mutex;
+	std::condition_variable _jobAvailable;
+	std::condition_variable _jobDone;
+	std::list<Job*> _jobs;
+	bool _stop { false };
+};
@@ -1,5 +1,8 @@
 #pragma once
 
+// stl includes
+#include <memory>
+
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonValue>
@@ -28,15 +31,36 @@
 class QJsonSchemaChecker
 {
 public:
+	///
+	/// A schema compiled into an immutable tree of validator nodes. The keywords, property names, enum values and
+	/// defaults are resolved once, validations walk the tree without any lookups in the schema. A compiled schema
+	/// can be shared by checkers of different threads.
+	///
+	struct Node;
+	using CompiledSchema = std::shared_ptr<const Node>;
+
 	QJsonSchemaChecker();
 	virtual ~QJsonSchemaChecker();
 
 	///
-	/// @param schema The schema to use
+	/// @brief Compile a schema, which is validated against repeatedly
+	/// @param schema The schema to compile, $refs are already resolved
+	/// @return The compiled schema
+	///
+	static CompiledSchema compile(const QJsonObject& schema);
+
+	///
+	/// @param schema The schema to use, it is compiled
 	/// @return true upon succes
 	///
 	bool setSchema(const QJsonObject& schema);
 
+	///
+	/// @param schema The compiled schema to use
+	/// @return true upon succes
+	///
+	bool setSchema(const CompiledSchema& schema);
+
 	///
 	/// @brief Validate a JSON structure
 	/// @param value The JSON value to check
@@ -67,7 +91,7 @@ private:
 	/// @param[in] value The value to validate
 	/// @param[in] schema The schema against which the value is validated
 	///
-	void validate(const QJsonValue& value, const QJsonObject& schema);
+	void validate(const QJsonValue& value, const Node& schema);
 
 	///
 	/// Adds the given message to the message-queue (with reference to current line-number)
@@ -83,9 +107,9 @@ private:
 	/// to true and an error-message is added to the message-queue
 	///
 	/// @param[in] value The given value
-	/// @param[in] schema The specified type (as json-value)
+	/// @param[in] schema The schema with the specified type
 	///
-	void checkType(const QJsonValue& value, const QJsonValue& schema, const QJsonValue& defaultValue);
+	void checkType(const QJsonValue& value, const Node& schema);
 
 	///
 	/// Checks is required properties of an json-object exist and if all properties are of the
@@ -95,9 +119,7 @@ private:
 	/// @param[in] value The given json-object
 	/// @param[in] schema The schema of the json-object
 	///
-	void checkProperties(const QJsonObject& value, const QJsonObject& schema);
-
-	bool verifyDeps(const QString& property, const QJsonObject& value, const QJsonObject& schema);
+	void checkProperties(const QJsonObject& value, const Node& schema);
 
 	///
 	/// Checks whether certain properties of a JSON object exist under certain dependencies and are the same.
@@ -107,7 +129,7 @@ private:
 	/// @param[in] value The given json-object
 	/// @param[in] schema The schema of the json-object
 	///
-	void checkDependencies(const QJsonObject& value, const QJsonObject& schema);
+	void checkDependencies(const QJsonObject& value, const Node& schema);
 
 	///
 	/// Verifies the additional configured properties of an json-object. If this is not the case
@@ -115,45 +137,44 @@ private:
 	///
 	/// @param value The given json-object
 	/// @param schema The schema for the json-object
-	/// @param ignoredProperties The properties that were ignored
 	///
-	void checkAdditionalProperties(const QJsonObject& value, const QJsonValue& schema, const QStringList& ignoredProperties);
+	void checkAdditionalProperties(const QJsonObject& value, const Node& schema);
 
 	///
 	/// Checks if the given value is larger or equal to the specified value. If this is not the case
 	/// _error is set to true and an error-message is added to the message-queue.
 	///
 	/// @param[in] value The given value
-	/// @param[in] schema The minimum value (as json-value)
+	/// @param[in] schema The schema with the minimum value
 	///
-	void checkMinimum(const QJsonValue& value, const QJsonValue& schema, const QJsonValue& defaultValue);
+	void checkMinimum(const QJsonValue& value, const Node& schema);
 
 	///
 	/// Checks if the given value is smaller or equal to the specified value. If this is not the
 	/// case _error is set to true and an error-message is added to the message-queue.
 	///
 	/// @param[in] value The given value
-	/// @param[in] schema The maximum value (as json-value)
+	/// @param[in] schema The schema with the maximum value
 	///
-	void checkMaximum(const QJsonValue& value, const QJsonValue& schema, const QJsonValue& defaultValue);
+	void checkMaximum(const QJsonValue& value, const Node& schema);
 
 	///
 	/// Checks if the given value is hugher than the specified value. If this is the
 	/// case _error is set to true and an error-message is added to the message-queue.
 	///
 	/// @param value The given value
-	/// @param schema The minimum size specification (as json-value)
+	/// @param schema The schema with the minimum size specification
 	///
-	void checkMinLength(const QJsonValue& value, const QJsonValue& schema, const QJsonValue& defaultValue);
+	void checkMinLength(const QJsonValue& value, const Node& schema);
 
 	///
 	/// Checks if the given value is smaller than the specified value. If this is the
 	/// case _error is set to true and an error-message is added to the message-queue.
 	///
 	/// @param value The given value
-	/// @param schema The maximum size specification (as json-value)
+	/// @param schema The schema with the maximum size specification
 	///
-	void checkMaxLength(const QJsonValue& value, const QJsonValue& schema, const QJsonValue& defaultValue);
+	void checkMaxLength(const QJsonValue& value, const Node& schema);
 
 	///
 	/// Validates all the items of an array.
@@ -161,47 +182,52 @@ private:
 	/// @param value The json-array
 	/// @param schema The schema for the items in the array
 	///
-	void checkItems(const QJsonValue& value, const QJsonObject& schema);
+	void checkItems(const QJsonValue& value, const Node& schema);
 
 	///
 	/// Checks if a given array has at least a minimum number of items. If this is not the case
 	/// _error is set to true and an error-message is added to the message-queue.
 	///
 	/// @param value The json-array
-	/// @param schema The minimum size specification (as json-value)
+	/// @param schema The schema with the minimum size specification
 	///
-	void checkMinItems(const QJsonValue& value, const QJsonValue& schema, const QJsonValue& defaultValue);
+	void checkMinItems(const QJsonValue& value, const Node& schema);
 
 	///
 	/// Checks if a given array has at most a maximum number of items. If this is not the case
 	/// _error is set to true and an error-message is added to the message-queue.
 	///
 	/// @param value The json-array
-	/// @param schema The maximum size specification (as json-value)
+	/// @param schema The schema with the maximum size specification
 	///
-	void checkMaxItems(const QJsonValue& value, const QJsonValue& schema, const QJsonValue& defaultValue);
+	void checkMaxItems(const QJsonValue& value, const Node& schema);
 
 	///
 	/// Checks if a given array contains only unique items. If this is not the case
 	/// _error is set to true and an error-message is added to the message-queue.
 	///
 	/// @param value The json-array
-	/// @param schema Bool to enable the check (as json-value)
+	/// @param schema The schema enabling the check
 	///
-	void checkUniqueItems(const QJsonValue& value, const QJsonValue& schema);
+	void checkUniqueItems(const QJsonValue& value, const Node& schema);
 
 	///
 	/// Checks if an enum value is actually a valid value for that enum. If this is not the case
 	/// _error is set to true and an error-message is added to the message-queue.
 	///
 	/// @param value The enum value
-	/// @param schema The enum schema definition
+	/// @param schema The schema with the enum definition
+	///
+	void checkEnum(const QJsonValue& value, const Node& schema);
+
+	///
+	/// Corrects the current value to the default value of the schema, or the given value if there is no default
 	///
-	void checkEnum(const QJsonValue& value, const QJsonValue& schema, const QJsonValue& defaultValue);
+	void correctValue(const Node& schema, const QJsonValue& fallback);
 
 private:
-	/// The schema of the entire json-configuration
-	QJsonObject _qSchema;
+	/// The compiled schema of the entire json-configuration
+	CompiledSchema _schema;
 	/// ignore the required value in json schema
 	bool _ignoreRequired;
 	/// Auto correction variable
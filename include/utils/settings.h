@@ -33,6 +33,7 @@ namespace settings {
 		OSEVENTS,
 		CECEVENTS,
 		SCHEDEVENTS,
+		LEDSTREAMSERVER,
 		INVALID
 	};
 
@@ -70,6 +71,7 @@ namespace settings {
 		case OSEVENTS:      return "osEvents";
 		case CECEVENTS:     return "cecEvents";
 		case SCHEDEVENTS:   return "schedEvents";
+		case LEDSTREAMSERVER: return "ledStreamServer";
 		default:            return "invalid";
 		}
 	}
@@ -106,6 +108,7 @@ namespace settings {
 		else if (type == "osEvents")             return OSEVENTS;
 		else if (type == "cecEvents")            return CECEVENTS;
 		else if (type == "schedEvents")          return SCHEDEVENTS;
+		else if (type == "ledStreamServer")      return LEDSTREAMSERVER;
 		else                                     return INVALID;
 	}
 }
@@ -9,9 +9,7 @@
 #include <QResource>
 #include <QDateTime>
 #include <QCryptographicHash>
-#include <QImage>
 #include <QImageReader>
-#include <QBuffer>
 #include <QByteArray>
 #include <QTimer>
 #include <QThread>
@@ -23,6 +21,7 @@
 #include <utils/SysInfo.h>
 #include <utils/ColorSys.h>
 #include <utils/Process.h>
+#include <utils/ImageDecoder.h>
 
 // ledmapping int <> string transform methods
 #include <hyperion/ImageProcessor.h>
@@ -109,8 +108,7 @@ void API::setColor(int priority, const std::vector<uint8_t> &ledColors, int time
 
 bool API::setImage(ImageCmdData &data, hyperion::Components comp, QString &replyMsg, hyperion::Components callerComp)
 {
-    // truncate name length
-    data.imgName.truncate(16);
+	Image<ColorRgb> image;
 
 	if (!data.format.isEmpty())
 	{
@@ -127,76 +125,45 @@ bool API::setImage(ImageCmdData &data, hyperion::Components comp, QString &reply
 			}
 		}
 
-		QImage img = QImage::fromData(data.data, QSTRING_CSTR(data.format));
-        if (img.isNull())
-        {
-			replyMsg = "Failed to parse picture, the file might be corrupted or content does not match the given format [" + data.format + "]";
-            return false;
-        }
-
-        // check for requested scale
-        if (data.scale > 24)
-        {
-            if (img.height() > data.scale)
-            {
-                img = img.scaledToHeight(data.scale);
-            }
-            if (img.width() > data.scale)
-            {
-                img = img.scaledToWidth(data.scale);
-            }
-        }
+		// downscale to the requested scale while decoding, larger images than 2000 pixels are always reduced
+		const int maxSize = (data.scale > 24) ? qMin(data.scale, 2000) : 2000;
 
-        // check if we need to force a scale
-        if (img.width() > 2000 || img.height() > 2000)
-        {
-            data.scale = 2000;
-            if (img.height() > data.scale)
-            {
-                img = img.scaledToHeight(data.scale);
-            }
-            if (img.width() > data.scale)
-            {
-                img = img.scaledToWidth(data.scale);
-            }
-        }
+		QString error;
+		if (!ImageDecoder::decode(data.data, data.format.toUtf8(), maxSize, image, error))
+		{
+			replyMsg = "Failed to parse picture, the file might be corrupted or content does not match the given format [" + data.format + "]";
+			Debug(_log, "%s", QSTRING_CSTR(error));
+			return false;
+		}
 
-        data.width = img.width();
-        data.height = img.height();
+		data.width = image.width();
+		data.height = image.height();
+	}
+	else
+	{
+		// check consistency of the size of the received data
+		if (data.data.size() != data.width * data.height * 3)
+		{
+			replyMsg = "Size of image data does not match with the width and height";
+			return false;
+		}
 
-        // extract image
-        img = img.convertToFormat(QImage::Format_ARGB32_Premultiplied);
-        data.data.clear();
-        data.data.reserve(img.width() * img.height() * 3);
-        for (int i = 0; i < img.height(); ++i)
-        {
-            const QRgb *scanline = reinterpret_cast<const QRgb *>(img.scanLine(i));
-            for (int j = 0; j < img.width(); ++j)
-            {
-                data.data.append((char)qRed(scanline[j]));
-                data.data.append((char)qGreen(scanline[j]));
-                data.data.append((char)qBlue(scanline[j]));
-            }
-        }
-    }
-    else
-    {
-        // check consistency of the size of the received data
-        if (data.data.size() != data.width * data.height * 3)
-        {
-            replyMsg = "Size of image data does not match with the width and height";
-            return false;
-        }
-    }
+		// copy image
+		image = Image<ColorRgb>(data.width, data.height, ImageNoInit);
+		memcpy(image.memptr(), data.data.data(), data.data.size());
+	}
 
-    // copy image
-    Image<ColorRgb> image(data.width, data.height);
-    memcpy(image.memptr(), data.data.data(), data.data.size());
+	setImage(data, image, comp);
+	return true;
+}
 
-    QMetaObject::invokeMethod(_hyperion, "registerInput", Qt::QueuedConnection, Q_ARG(int, data.priority), Q_ARG(hyperion::Components, comp), Q_ARG(QString, data.origin), Q_ARG(QString, data.imgName));
-    QMetaObject::invokeMethod(_hyperion, "setInputImage", Qt::QueuedConnection, Q_ARG(int, data.priority), Q_ARG(Image<ColorRgb>, image), Q_ARG(int64_t, data.duration));
+void API::setImage(ImageCmdData &data, const Image<ColorRgb> &image, hyperion::Components comp)
+{
+	// truncate name length
+	data.imgName.truncate(16);
 
-    return true;
+	QMetaObject::invokeMethod(_hyperion, "registerInput", Qt::QueuedConnection, Q_ARG(int, data.priority), Q_ARG(hyperion::Components, comp), Q_ARG(QString, data.origin), Q_ARG(QString, data.imgName));
+	QMetaObject::invokeMethod(_hyperion, "setInputImage", Qt::QueuedConnection, Q_ARG(int, data.priority), Q_ARG(Image<ColorRgb>, image), Q_ARG(int64_t, data.duration));
 }
 
 bool API::clearPriority(int priority, QString &replyMsg, hyperion::Components callerComp)
@@ -509,6 +476,13 @@ bool API::getUserToken(QString &userToken)
 
 bool API::isTokenAuthorized(const QString &token)
 {
+	// known tokens are answered by the token cache without a call into the AuthManager's thread
+	if (_authManager->isTokenAuthorizedCached(token))
+	{
+		_authorized = true;
+		return _authorized;
+	}
+
 	(_authManager->thread() != this->thread())
 	? QMetaObject::invokeMethod(_authManager, "isTokenAuthorized", Qt::BlockingQueuedConnection, Q_RETURN_ARG(bool, _authorized), Q_ARG(QString, token))
 	: _authorized = _authManager->isTokenAuthorized(token);
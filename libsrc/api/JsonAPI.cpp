@@ -79,6 +79,9 @@
 #include <utils/ColorSys.h>
 #include <utils/Process.h>
 #include <utils/JsonUtils.h>
+#include <utils/Tracing.h>
+#include <utils/ImageBufferPool.h>
+#include <utils/ImageDecoder.h>
 
 // ledmapping int <> string transform methods
 #include <hyperion/ImageProcessor.h>
@@ -132,6 +135,7 @@ void JsonAPI::initialize()
 
 	// pipe callbacks from subscriptions to parent
 	connect(_jsonCB, &JsonCB::newCallback, this, &JsonAPI::callbackMessage);
+	connect(_jsonCB, &JsonCB::newCallbackData, this, &JsonAPI::callbackData);
 
 	// notify hyperion about a jsonMessageForward
 	if (_hyperion != nullptr)
@@ -307,9 +311,23 @@ void JsonAPI::handleImageCommand(const QJsonObject &message, const QString &comm
 	idata.scale = message["scale"].toInt(-1);
 	idata.format = message["format"].toString();
 	idata.imgName = message["name"].toString("");
-	idata.data = QByteArray::fromBase64(QByteArray(message["imagedata"].toString().toUtf8()));
 	QString replyMsg;
 
+	if (idata.format.isEmpty())
+	{
+		// raw RGB data is decoded directly into the image buffer
+		Image<ColorRgb> image;
+		if (!ImageDecoder::decodeRawRgb(message["imagedata"].toString(), idata.width, idata.height, image, replyMsg))
+		{
+			sendErrorReply(replyMsg, command, tan);
+			return;
+		}
+		API::setImage(idata, image, COMP_IMAGE);
+		sendSuccessReply(command, tan);
+		return;
+	}
+
+	idata.data = QByteArray::fromBase64(QByteArray(message["imagedata"].toString().toUtf8()));
 	if (!API::setImage(idata, COMP_IMAGE, replyMsg))
 	{
 		sendErrorReply(replyMsg, command, tan);
@@ -658,6 +676,10 @@ void JsonAPI::handleServerInfoCommand(const QJsonObject &message, const QString
 	services.append("boblight");
 #endif
 
+#if defined(ENABLE_LEDSTREAM_SERVER)
+	services.append("ledstream");
+#endif
+
 #if defined(ENABLE_CEC)
 	services.append("cec");
 #endif
@@ -827,6 +849,9 @@ void JsonAPI::handleServerInfoCommand(const QJsonObject &message, const QString
 		if (_noListener)
 			return;
 
+		// published state updates as JSON merge patches on request
+		_jsonCB->setDeltaUpdates(message["delta"].toBool(false));
+
 		QJsonArray subsArr = message["subscribe"].toArray();
 		// catch the all keyword and build a list of all cmds
 		if (subsArr.contains("all"))
@@ -1882,6 +1907,28 @@ void JsonAPI::handleSystemCommand(const QJsonObject &message, const QString &com
 		emit signalEvent(Event::ToggleIdle);
 		sendSuccessReply(command + "-" + subc, tan);
 	}
+	else if (subc == "metrics")
+	{
+		if (message.contains("enable"))
+		{
+			tracing::setEnabled(message["enable"].toBool());
+		}
+
+		QJsonObject metrics = tracing::getMetrics();
+		if (message["trace"].toBool(false))
+		{
+			metrics["trace"] = tracing::getChromeTrace();
+		}
+		metrics["imagePool"] = ImageBufferPool::getStatistics();
+		metrics["updates"] = _hyperion->getUpdateStatistics();
+
+		// Metrics of the next request cover the time from now on
+		if (message["reset"].toBool(false))
+		{
+			tracing::reset();
+		}
+		sendSuccessDataReply(QJsonDocument(metrics), command + "-" + subc, tan);
+	}
 	else
 	{
 		QString full_command = command + "-" + subc;
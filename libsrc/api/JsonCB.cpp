@@ -1,5 +1,6 @@
 // proj incl
 #include <api/JsonCB.h>
+#include <api/JsonCBPublisher.h>
 
 // hyperion
 #include <hyperion/Hyperion.h>
@@ -13,11 +14,7 @@
 
 #include <hyperion/PriorityMuxer.h>
 
-// utils
-#include <utils/ColorSys.h>
-
 // qt
-#include <QDateTime>
 #include <QVariant>
 
 // Image to led map helper
@@ -28,8 +25,10 @@ using namespace hyperion;
 JsonCB::JsonCB(QObject* parent)
 	: QObject(parent)
 	, _hyperion(nullptr)
+	, _instance(0)
 	, _componentRegister(nullptr)
 	, _prioMuxer(nullptr)
+	, _deltaUpdates(false)
 {
 	_availableCommands << "components-update" << "priorities-update" << "imageToLedMapping-update"
 	<< "adjustment-update" << "videomode-update" << "settings-update" << "leds-update" << "instance-update" << "token-update";
@@ -39,6 +38,19 @@ JsonCB::JsonCB(QObject* parent)
 	#endif
 
 	qRegisterMetaType<PriorityMuxer::InputsMap>("InputsMap");
+
+	// the state updates are built once for all clients
+	connect(JsonCBPublisher::getInstance(), &JsonCBPublisher::published, this, &JsonCB::handlePublished);
+}
+
+JsonCB::~JsonCB()
+{
+	QStringList subscribedCommands(_subscribedCommands);
+	subscribedCommands.removeDuplicates();
+	for (const auto & entry : subscribedCommands)
+	{
+		JsonCBPublisher::getInstance()->unsubscribe(_instance, entry);
+	}
 }
 
 bool JsonCB::subscribeFor(const QString& type, bool unsubscribe)
@@ -46,6 +58,16 @@ bool JsonCB::subscribeFor(const QString& type, bool unsubscribe)
 	if(!_availableCommands.contains(type))
 		return false;
 
+	if(JsonCBPublisher::isPublished(type))
+	{
+		const bool subscribed = _subscribedCommands.contains(type);
+		if(unsubscribe && subscribed)
+			JsonCBPublisher::getInstance()->unsubscribe(_instance, type);
+		else if(!unsubscribe && !subscribed)
+			JsonCBPublisher::getInstance()->subscribe(_hyperion, type);
+		_deltaBase.removeAll(type);
+	}
+
 	if(unsubscribe)
 		_subscribedCommands.removeAll(type);
 	else
@@ -59,14 +81,6 @@ bool JsonCB::subscribeFor(const QString& type, bool unsubscribe)
 			connect(_componentRegister, &ComponentRegister::updatedComponentState, this, &JsonCB::handleComponentState, Qt::UniqueConnection);
 	}
 
-	if(type == "priorities-update")
-	{
-		if (unsubscribe)
-			disconnect(_prioMuxer, &PriorityMuxer::prioritiesChanged, this, &JsonCB::handlePriorityUpdate);
-		else
-			connect(_prioMuxer, &PriorityMuxer::prioritiesChanged, this, &JsonCB::handlePriorityUpdate, Qt::UniqueConnection);
-	}
-
 	if(type == "imageToLedMapping-update")
 	{
 		if(unsubscribe)
@@ -75,14 +89,6 @@ bool JsonCB::subscribeFor(const QString& type, bool unsubscribe)
 			connect(_hyperion, &Hyperion::imageToLedsMappingChanged, this, &JsonCB::handleImageToLedsMappingChange, Qt::UniqueConnection);
 	}
 
-	if(type == "adjustment-update")
-	{
-		if(unsubscribe)
-			disconnect(_hyperion, &Hyperion::adjustmentChanged, this, &JsonCB::handleAdjustmentChange);
-		else
-			connect(_hyperion, &Hyperion::adjustmentChanged, this, &JsonCB::handleAdjustmentChange, Qt::UniqueConnection);
-	}
-
 	if(type == "videomode-update")
 	{
 		if(unsubscribe)
@@ -101,14 +107,6 @@ bool JsonCB::subscribeFor(const QString& type, bool unsubscribe)
 	}
 #endif
 
-	if(type == "settings-update")
-	{
-		if(unsubscribe)
-			disconnect(_hyperion, &Hyperion::settingsChanged, this, &JsonCB::handleSettingsChange);
-		else
-			connect(_hyperion, &Hyperion::settingsChanged, this, &JsonCB::handleSettingsChange, Qt::UniqueConnection);
-	}
-
 	if(type == "leds-update")
 	{
 		if(unsubscribe)
@@ -137,6 +135,15 @@ bool JsonCB::subscribeFor(const QString& type, bool unsubscribe)
 	return true;
 }
 
+void JsonCB::setDeltaUpdates(bool enable)
+{
+	if(_deltaUpdates != enable)
+	{
+		_deltaUpdates = enable;
+		_deltaBase.clear();
+	}
+}
+
 void JsonCB::resetSubscriptions()
 {
 	for(const auto & entry : getSubscribedCommands())
@@ -157,6 +164,7 @@ void JsonCB::setSubscriptionsTo(Hyperion* hyperion)
 
 	// update pointer
 	_hyperion = hyperion;
+	_instance = _hyperion->getInstanceIndex();
 	_componentRegister = _hyperion->getComponentRegister();
 	_prioMuxer = _hyperion->getMuxerInstance();
 
@@ -181,83 +189,34 @@ void JsonCB::doCallback(const QString& cmd, const QVariant& data)
 	emit newCallback(obj);
 }
 
-void JsonCB::handleComponentState(hyperion::Components comp, bool state)
+void JsonCB::handlePublished(quint8 instance, const QString& cmd, const QByteArray& message, const QByteArray& snapshot, const QByteArray& delta)
 {
-	QJsonObject data;
-	data["name"] = componentToIdString(comp);
-	data["enabled"] = state;
+	if(instance != _instance || !_subscribedCommands.contains(cmd))
+		return;
 
-	doCallback("components-update", QVariant(data));
+	if(!_deltaUpdates)
+	{
+		emit newCallbackData(message);
+	}
+	else if(!_deltaBase.contains(cmd))
+	{
+		// the following deltas are based on the complete state
+		_deltaBase << cmd;
+		emit newCallbackData(snapshot);
+	}
+	else
+	{
+		emit newCallbackData(delta);
+	}
 }
 
-void JsonCB::handlePriorityUpdate(int currentPriority, const PriorityMuxer::InputsMap& activeInputs)
+void JsonCB::handleComponentState(hyperion::Components comp, bool state)
 {
 	QJsonObject data;
-	QJsonArray priorities;
-	uint64_t now = QDateTime::currentMSecsSinceEpoch();
-	QList<int> activePriorities = activeInputs.keys();
-
-	activePriorities.removeAll(PriorityMuxer::LOWEST_PRIORITY);
-
-	for (int priority : std::as_const(activePriorities)) {
-
-		const Hyperion::InputInfo& priorityInfo = activeInputs[priority];
-
-		QJsonObject item;
-		item["priority"] = priority;
-
-		if (priorityInfo.timeoutTime_ms > 0 )
-		{
-			item["duration_ms"] = int(priorityInfo.timeoutTime_ms - now);
-		}
-
-		// owner has optional informations to the component
-		if(!priorityInfo.owner.isEmpty())
-		{
-			item["owner"] = priorityInfo.owner;
-		}
-
-		item["componentId"] = QString(hyperion::componentToIdString(priorityInfo.componentId));
-		item["origin"] = priorityInfo.origin;
-		item["active"] = (priorityInfo.timeoutTime_ms >= -1);
-		item["visible"] = (priority == currentPriority);
-
-		if(priorityInfo.componentId == hyperion::COMP_COLOR && !priorityInfo.ledColors.empty())
-		{
-			QJsonObject LEDcolor;
-
-			// add RGB Value to Array
-			QJsonArray RGBValue;
-			RGBValue.append(priorityInfo.ledColors.begin()->red);
-			RGBValue.append(priorityInfo.ledColors.begin()->green);
-			RGBValue.append(priorityInfo.ledColors.begin()->blue);
-			LEDcolor.insert("RGB", RGBValue);
-
-			uint16_t Hue;
-			float Saturation;
-			float Luminace;
-
-			// add HSL Value to Array
-			QJsonArray HSLValue;
-			ColorSys::rgb2hsl(priorityInfo.ledColors.begin()->red,
-					priorityInfo.ledColors.begin()->green,
-					priorityInfo.ledColors.begin()->blue,
-					Hue, Saturation, Luminace);
-
-			HSLValue.append(Hue);
-			HSLValue.append(Saturation);
-			HSLValue.append(Luminace);
-			LEDcolor.insert("HSL", HSLValue);
-
-			item["value"] = LEDcolor;
-		}
-		priorities.append(item);
-	}
-
-	data["priorities"] = priorities;
-	data["priorities_autoselect"] = _hyperion->sourceAutoSelectEnabled();
+	data["name"] = componentToIdString(comp);
+	data["enabled"] = state;
 
-	doCallback("priorities-update", QVariant(data));
+	doCallback("components-update", QVariant(data));
 }
 
 void JsonCB::handleImageToLedsMappingChange(int mappingType)
@@ -268,76 +227,6 @@ void JsonCB::handleImageToLedsMappingChange(int mappingType)
 	doCallback("imageToLedMapping-update", QVariant(data));
 }
 
-void JsonCB::handleAdjustmentChange()
-{
-	QJsonArray adjustmentArray;
-	for (const QString& adjustmentId : _hyperion->getAdjustmentIds())
-	{
-		const ColorAdjustment * colorAdjustment = _hyperion->getAdjustment(adjustmentId);
-		if (colorAdjustment == nullptr)
-		{
-			continue;
-		}
-
-		QJsonObject adjustment;
-		adjustment["id"] = adjustmentId;
-
-		QJsonArray whiteAdjust;
-		whiteAdjust.append(colorAdjustment->_rgbWhiteAdjustment.getAdjustmentR());
-		whiteAdjust.append(colorAdjustment->_rgbWhiteAdjustment.getAdjustmentG());
-		whiteAdjust.append(colorAdjustment->_rgbWhiteAdjustment.getAdjustmentB());
-		adjustment.insert("white", whiteAdjust);
-
-		QJsonArray redAdjust;
-		redAdjust.append(colorAdjustment->_rgbRedAdjustment.getAdjustmentR());
-		redAdjust.append(colorAdjustment->_rgbRedAdjustment.getAdjustmentG());
-		redAdjust.append(colorAdjustment->_rgbRedAdjustment.getAdjustmentB());
-		adjustment.insert("red", redAdjust);
-
-		QJsonArray greenAdjust;
-		greenAdjust.append(colorAdjustment->_rgbGreenAdjustment.getAdjustmentR());
-		greenAdjust.append(colorAdjustment->_rgbGreenAdjustment.getAdjustmentG());
-		greenAdjust.append(colorAdjustment->_rgbGreenAdjustment.getAdjustmentB());
-		adjustment.insert("green", greenAdjust);
-
-		QJsonArray blueAdjust;
-		blueAdjust.append(colorAdjustment->_rgbBlueAdjustment.getAdjustmentR());
-		blueAdjust.append(colorAdjustment->_rgbBlueAdjustment.getAdjustmentG());
-		blueAdjust.append(colorAdjustment->_rgbBlueAdjustment.getAdjustmentB());
-		adjustment.insert("blue", blueAdjust);
-
-		QJsonArray cyanAdjust;
-		cyanAdjust.append(colorAdjustment->_rgbCyanAdjustment.getAdjustmentR());
-		cyanAdjust.append(colorAdjustment->_rgbCyanAdjustment.getAdjustmentG());
-		cyanAdjust.append(colorAdjustment->_rgbCyanAdjustment.getAdjustmentB());
-		adjustment.insert("cyan", cyanAdjust);
-
-		QJsonArray magentaAdjust;
-		magentaAdjust.append(colorAdjustment->_rgbMagentaAdjustment.getAdjustmentR());
-		magentaAdjust.append(colorAdjustment->_rgbMagentaAdjustment.getAdjustmentG());
-		magentaAdjust.append(colorAdjustment->_rgbMagentaAdjustment.getAdjustmentB());
-		adjustment.insert("magenta", magentaAdjust);
-
-		QJsonArray yellowAdjust;
-		yellowAdjust.append(colorAdjustment->_rgbYellowAdjustment.getAdjustmentR());
-		yellowAdjust.append(colorAdjustment->_rgbYellowAdjustment.getAdjustmentG());
-		yellowAdjust.append(colorAdjustment->_rgbYellowAdjustment.getAdjustmentB());
-		adjustment.insert("yellow", yellowAdjust);
-
-		adjustment["backlightThreshold"] = colorAdjustment->_rgbTransform.getBacklightThreshold();
-		adjustment["backlightColored"]   = colorAdjustment->_rgbTransform.getBacklightColored();
-		adjustment["brightness"] = colorAdjustment->_rgbTransform.getBrightness();
-		adjustment["brightnessCompensation"] = colorAdjustment->_rgbTransform.getBrightnessCompensation();
-		adjustment["gammaRed"]   = colorAdjustment->_rgbTransform.getGammaR();
-		adjustment["gammaGreen"] = colorAdjustment->_rgbTransform.getGammaG();
-		adjustment["gammaBlue"]  = colorAdjustment->_rgbTransform.getGammaB();
-
-		adjustmentArray.append(adjustment);
-	}
-
-	doCallback("adjustment-update", QVariant(adjustmentArray));
-}
-
 void JsonCB::handleVideoModeChange(VideoMode mode)
 {
 	QJsonObject data;
@@ -365,17 +254,6 @@ void JsonCB::handleEffectListChange()
 }
 #endif
 
-void JsonCB::handleSettingsChange(settings::type type, const QJsonDocument& data)
-{
-	QJsonObject dat;
-	if(data.isObject())
-		dat[typeToString(type)] = data.object();
-	else
-		dat[typeToString(type)] = data.array();
-
-	doCallback("settings-update", QVariant(dat));
-}
-
 void JsonCB::handleLedsConfigChange(settings::type type, const QJsonDocument& data)
 {
 	if(type == settings::LEDS)
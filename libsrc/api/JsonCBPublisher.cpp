@@ -0,0 +1,391 @@
+// proj incl
+#include <api/JsonCBPublisher.h>
+
+// hyperion
+#include <hyperion/Hyperion.h>
+
+// utils
+#include <utils/ColorSys.h>
+
+// qt
+#include <QCoreApplication>
+#include <QDateTime>
+
+namespace {
+	// window to coalesce bursts of changes into one update
+	const int UPDATE_WINDOW_MS = 50;
+
+	const char PRIORITIES_UPDATE[] = "priorities-update";
+	const char ADJUSTMENT_UPDATE[] = "adjustment-update";
+	const char SETTINGS_UPDATE[] = "settings-update";
+}
+
+JsonCBPublisher* JsonCBPublisher::getInstance()
+{
+	// lives until the application exits
+	static JsonCBPublisher* instance = new JsonCBPublisher();
+	return instance;
+}
+
+JsonCBPublisher::JsonCBPublisher()
+	: QObject(nullptr)
+	, _timer(this)
+{
+	// the clients run in the threads of their servers, the states are published in the main thread
+	moveToThread(QCoreApplication::instance()->thread());
+
+	_timer.setSingleShot(true);
+	_timer.setInterval(UPDATE_WINDOW_MS);
+	connect(&_timer, &QTimer::timeout, this, &JsonCBPublisher::publishDirty);
+
+	qRegisterMetaType<PriorityMuxer::InputsMap>("InputsMap");
+}
+
+bool JsonCBPublisher::isPublished(const QString& cmd)
+{
+	return cmd == PRIORITIES_UPDATE || cmd == ADJUSTMENT_UPDATE || cmd == SETTINGS_UPDATE;
+}
+
+void JsonCBPublisher::subscribe(Hyperion* hyperion, const QString& cmd)
+{
+	if (hyperion == nullptr || !isPublished(cmd))
+		return;
+
+	const quint8 instance = hyperion->getInstanceIndex();
+	const QPointer<Hyperion> pointer(hyperion);
+	QMetaObject::invokeMethod(this, [this, instance, pointer, cmd]() { addSubscriber(instance, pointer, cmd); }, Qt::QueuedConnection);
+}
+
+void JsonCBPublisher::unsubscribe(quint8 instance, const QString& cmd)
+{
+	if (!isPublished(cmd))
+		return;
+
+	QMetaObject::invokeMethod(this, [this, instance, cmd]() { removeSubscriber(instance, cmd); }, Qt::QueuedConnection);
+}
+
+void JsonCBPublisher::addSubscriber(quint8 instance, const QPointer<Hyperion>& hyperion, const QString& cmd)
+{
+	Channel& channel = _channels[instance];
+	if (!hyperion.isNull() && channel.hyperion != hyperion)
+	{
+		// new or restarted instance, the connections to a stopped instance are gone
+		channel.hyperion = hyperion;
+		channel.dirtySettings.clear();
+		for (auto it = channel.topics.begin(); it != channel.topics.end(); ++it)
+		{
+			if (it.value().subscribers > 0)
+				connectTopic(channel, it.key(), it.value());
+		}
+	}
+
+	Topic& topic = channel.topics[cmd];
+	if (topic.subscribers++ == 0)
+		connectTopic(channel, cmd, topic);
+}
+
+void JsonCBPublisher::removeSubscriber(quint8 instance, const QString& cmd)
+{
+	auto channel = _channels.find(instance);
+	if (channel == _channels.end() || !channel->topics.contains(cmd))
+		return;
+
+	Topic& topic = channel->topics[cmd];
+	if (topic.subscribers > 0 && --topic.subscribers == 0)
+	{
+		disconnect(topic.connection);
+		topic.dirty = false;
+		// subscribers returning later get a current state
+		topic.state = QJsonValue();
+		if (cmd == SETTINGS_UPDATE)
+			channel->dirtySettings.clear();
+	}
+}
+
+void JsonCBPublisher::connectTopic(Channel& channel, const QString& cmd, Topic& topic)
+{
+	disconnect(topic.connection);
+
+	Hyperion* hyperion = channel.hyperion.data();
+	if (hyperion == nullptr)
+		return;
+
+	const quint8 instance = hyperion->getInstanceIndex();
+	if (cmd == PRIORITIES_UPDATE)
+	{
+		topic.connection = connect(hyperion->getMuxerInstance(), &PriorityMuxer::prioritiesChanged, this,
+			[this, instance](int currentPriority, const PriorityMuxer::InputsMap& activeInputs) {
+				Channel& channel = _channels[instance];
+				channel.currentPriority = currentPriority;
+				channel.activeInputs = activeInputs;
+				markDirty(instance, PRIORITIES_UPDATE);
+			});
+	}
+	else if (cmd == ADJUSTMENT_UPDATE)
+	{
+		topic.connection = connect(hyperion, &Hyperion::adjustmentChanged, this, [this, instance]() {
+			markDirty(instance, ADJUSTMENT_UPDATE);
+		});
+	}
+	else if (cmd == SETTINGS_UPDATE)
+	{
+		topic.connection = connect(hyperion, &Hyperion::settingsChanged, this, [this, instance](settings::type type, const QJsonDocument& data) {
+			_channels[instance].dirtySettings.insert(type, data);
+			markDirty(instance, SETTINGS_UPDATE);
+		});
+	}
+}
+
+void JsonCBPublisher::markDirty(quint8 instance, const QString& cmd)
+{
+	_channels[instance].topics[cmd].dirty = true;
+	if (!_timer.isActive())
+		_timer.start();
+}
+
+void JsonCBPublisher::publishDirty()
+{
+	for (auto channel = _channels.begin(); channel != _channels.end(); ++channel)
+	{
+		for (auto topic = channel->topics.begin(); topic != channel->topics.end(); ++topic)
+		{
+			if (topic->dirty)
+				publish(channel.key(), topic.key(), channel.value(), topic.value());
+		}
+	}
+}
+
+void JsonCBPublisher::publish(quint8 instance, const QString& cmd, Channel& channel, Topic& topic)
+{
+	topic.dirty = false;
+	if (channel.hyperion.isNull() || topic.subscribers == 0)
+		return;
+
+	// data holds the changes of the update, state the complete state deltas are based on
+	QJsonValue data;
+	QJsonValue state;
+	if (cmd == PRIORITIES_UPDATE)
+	{
+		data = buildPriorities(channel);
+		state = data;
+	}
+	else if (cmd == ADJUSTMENT_UPDATE)
+	{
+		data = buildAdjustments(channel);
+		state = data;
+	}
+	else if (cmd == SETTINGS_UPDATE)
+	{
+		QJsonObject changes;
+		// the first snapshot after subscribing is the complete configuration, which the later deltas are based on
+		QJsonObject allSettings = topic.state.isObject() ? topic.state.toObject() : channel.hyperion->getQJsonConfig();
+		for (auto it = channel.dirtySettings.constBegin(); it != channel.dirtySettings.constEnd(); ++it)
+		{
+			const QJsonValue value = it.value().isObject() ? QJsonValue(it.value().object()) : QJsonValue(it.value().array());
+			changes[settings::typeToString(it.key())] = value;
+			allSettings[settings::typeToString(it.key())] = value;
+		}
+		channel.dirtySettings.clear();
+		data = changes;
+		state = allSettings;
+	}
+
+	const QJsonValue patch = createMergePatch(topic.state, state);
+	if (patch.isUndefined())
+		return;
+
+	++topic.version;
+	topic.state = state;
+
+	// serialised once for all clients, terminated like the messages of the transports
+	QJsonObject obj;
+	obj["instance"] = instance;
+	obj["command"] = cmd;
+	obj["version"] = static_cast<qint64>(topic.version);
+	obj["data"] = data;
+	const QByteArray message = QJsonDocument(obj).toJson(QJsonDocument::Compact) + "\n";
+
+	QByteArray snapshot = message;
+	if (state != data)
+	{
+		obj["data"] = state;
+		snapshot = QJsonDocument(obj).toJson(QJsonDocument::Compact) + "\n";
+	}
+
+	obj.remove("data");
+	obj["patch"] = patch;
+	const QByteArray delta = QJsonDocument(obj).toJson(QJsonDocument::Compact) + "\n";
+
+	emit published(instance, cmd, message, snapshot, delta);
+}
+
+QJsonValue JsonCBPublisher::createMergePatch(const QJsonValue& source, const QJsonValue& target)
+{
+	if (source == target)
+		return QJsonValue(QJsonValue::Undefined);
+
+	// arrays and values are replaced as a whole
+	if (!source.isObject() || !target.isObject())
+		return target;
+
+	const QJsonObject sourceObj = source.toObject();
+	const QJsonObject targetObj = target.toObject();
+	QJsonObject patch;
+
+	for (auto it = sourceObj.constBegin(); it != sourceObj.constEnd(); ++it)
+	{
+		if (!targetObj.contains(it.key()))
+			patch[it.key()] = QJsonValue::Null;
+	}
+
+	for (auto it = targetObj.constBegin(); it != targetObj.constEnd(); ++it)
+	{
+		const QJsonValue member = createMergePatch(sourceObj.value(it.key()), it.value());
+		if (!member.isUndefined())
+			patch[it.key()] = member;
+	}
+
+	return patch;
+}
+
+QJsonObject JsonCBPublisher::buildPriorities(const Channel& channel) const
+{
+	QJsonObject data;
+	QJsonArray priorities;
+	uint64_t now = QDateTime::currentMSecsSinceEpoch();
+	QList<int> activePriorities = channel.activeInputs.keys();
+
+	activePriorities.removeAll(PriorityMuxer::LOWEST_PRIORITY);
+
+	for (int priority : std::as_const(activePriorities)) {
+
+		const Hyperion::InputInfo& priorityInfo = channel.activeInputs[priority];
+
+		QJsonObject item;
+		item["priority"] = priority;
+
+		if (priorityInfo.timeoutTime_ms > 0 )
+		{
+			item["duration_ms"] = int(priorityInfo.timeoutTime_ms - now);
+		}
+
+		// owner has optional informations to the component
+		if(!priorityInfo.owner.isEmpty())
+		{
+			item["owner"] = priorityInfo.owner;
+		}
+
+		item["componentId"] = QString(hyperion::componentToIdString(priorityInfo.componentId));
+		item["origin"] = priorityInfo.origin;
+		item["active"] = (priorityInfo.timeoutTime_ms >= -1);
+		item["visible"] = (priority == channel.currentPriority);
+
+		if(priorityInfo.componentId == hyperion::COMP_COLOR && !priorityInfo.ledColors.empty())
+		{
+			QJsonObject LEDcolor;
+
+			// add RGB Value to Array
+			QJsonArray RGBValue;
+			RGBValue.append(priorityInfo.ledColors.begin()->red);
+			RGBValue.append(priorityInfo.ledColors.begin()->green);
+			RGBValue.append(priorityInfo.ledColors.begin()->blue);
+			LEDcolor.insert("RGB", RGBValue);
+
+			uint16_t Hue;
+			float Saturation;
+			float Luminace;
+
+			// add HSL Value to Array
+			QJsonArray HSLValue;
+			ColorSys::rgb2hsl(priorityInfo.ledColors.begin()->red,
+					priorityInfo.ledColors.begin()->green,
+					priorityInfo.ledColors.begin()->blue,
+					Hue, Saturation, Luminace);
+
+			HSLValue.append(Hue);
+			HSLValue.append(Saturation);
+			HSLValue.append(Luminace);
+			LEDcolor.insert("HSL", HSLValue);
+
+			item["value"] = LEDcolor;
+		}
+		priorities.append(item);
+	}
+
+	data["priorities"] = priorities;
+	data["priorities_autoselect"] = channel.hyperion->sourceAutoSelectEnabled();
+
+	return data;
+}
+
+QJsonArray JsonCBPublisher::buildAdjustments(const Channel& channel) const
+{
+	Hyperion* hyperion = channel.hyperion.data();
+
+	QJsonArray adjustmentArray;
+	for (const QString& adjustmentId : hyperion->getAdjustmentIds())
+	{
+		const ColorAdjustment * colorAdjustment = hyperion->getAdjustment(adjustmentId);
+		if (colorAdjustment == nullptr)
+		{
+			continue;
+		}
+
+		QJsonObject adjustment;
+		adjustment["id"] = adjustmentId;
+
+		QJsonArray whiteAdjust;
+		whiteAdjust.append(colorAdjustment->_rgbWhiteAdjustment.getAdjustmentR());
+		whiteAdjust.append(colorAdjustment->_rgbWhiteAdjustment.getAdjustmentG());
+		whiteAdjust.append(colorAdjustment->_rgbWhiteAdjustment.getAdjustmentB());
+		adjustment.insert("white", whiteAdjust);
+
+		QJsonArray redAdjust;
+		redAdjust.append(colorAdjustment->_rgbRedAdjustment.getAdjustmentR());
+		redAdjust.append(colorAdjustment->_rgbRedAdjustment.getAdjustmentG());
+		redAdjust.append(colorAdjustment->_rgbRedAdjustment.getAdjustmentB());
+		adjustment.insert("red", redAdjust);
+
+		QJsonArray greenAdjust;
+		greenAdjust.append(colorAdjustment->_rgbGreenAdjustment.getAdjustmentR());
+		greenAdjust.append(colorAdjustment->_rgbGreenAdjustment.getAdjustmentG());
+		greenAdjust.append(colorAdjustment->_rgbGreenAdjustment.getAdjustmentB());
+		adjustment.insert("green", greenAdjust);
+
+		QJsonArray blueAdjust;
+		blueAdjust.append(colorAdjustment->_rgbBlueAdjustment.getAdjustmentR());
+		blueAdjust.append(colorAdjustment->_rgbBlueAdjustment.getAdjustmentG());
+		blueAdjust.append(colorAdjustment->_rgbBlueAdjustment.getAdjustmentB());
+		adjustment.insert("blue", blueAdjust);
+
+		QJsonArray cyanAdjust;
+		cyanAdjust.append(colorAdjustment->_rgbCyanAdjustment.getAdjustmentR());
+		cyanAdjust.append(colorAdjustment->_rgbCyanAdjustment.getAdjustmentG());
+		cyanAdjust.append(colorAdjustment->_rgbCyanAdjustment.getAdjustmentB());
+		adjustment.insert("cyan", cyanAdjust);
+
+		QJsonArray magentaAdjust;
+		magentaAdjust.append(colorAdjustment->_rgbMagentaAdjustment.getAdjustmentR());
+		magentaAdjust.append(colorAdjustment->_rgbMagentaAdjustment.getAdjustmentG());
+		magentaAdjust.append(colorAdjustment->_rgbMagentaAdjustment.getAdjustmentB());
+		adjustment.insert("magenta", magentaAdjust);
+
+		QJsonArray yellowAdjust;
+		yellowAdjust.append(colorAdjustment->_rgbYellowAdjustment.getAdjustmentR());
+		yellowAdjust.append(colorAdjustment->_rgbYellowAdjustment.getAdjustmentG());
+		yellowAdjust.append(colorAdjustment->_rgbYellowAdjustment.getAdjustmentB());
+		adjustment.insert("yellow", yellowAdjust);
+
+		adjustment["backlightThreshold"] = colorAdjustment->_rgbTransform.getBacklightThreshold();
+		adjustment["backlightColored"]   = colorAdjustment->_rgbTransform.getBacklightColored();
+		adjustment["brightness"] = colorAdjustment->_rgbTransform.getBrightness();
+		adjustment["brightnessCompensation"] = colorAdjustment->_rgbTransform.getBrightnessCompensation();
+		adjustment["gammaRed"]   = colorAdjustment->_rgbTransform.getGammaR();
+		adjustment["gammaGreen"] = colorAdjustment->_rgbTransform.getGammaG();
+		adjustment["gammaBlue"]  = colorAdjustment->_rgbTransform.getGammaB();
+
+		adjustmentArray.append(adjustment);
+	}
+
+	return adjustmentArray;
+}
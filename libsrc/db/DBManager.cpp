@@ -5,6 +5,7 @@
 #include <QSqlQuery>
 #include <QSqlRecord>
 #include <QThreadStorage>
+#include <QHash>
 #include <QUuid>
 #include <QDir>
 #include <QMetaType>
@@ -16,6 +17,24 @@
 // not in header because of linking
 static QString _rootPath;
 static QThreadStorage<QSqlDatabase> _databasePool;
+// connections of read-only tables, they leave the journal mode of the database file untouched
+static QThreadStorage<QSqlDatabase> _readonlyDatabasePool;
+
+namespace {
+// Upper bound of the prepared statements kept per thread
+const int STATEMENT_CACHE_MAX = 64;
+
+struct Transaction
+{
+	int depth = 0;
+	bool rollback = false;
+};
+}
+
+// prepared statements of the thread's database connection
+static QThreadStorage<QHash<QString, QSqlQuery>> _statementCache;
+// transaction state of the thread's database connection
+static QThreadStorage<Transaction> _transactions;
 
 DBManager::DBManager(QObject* parent)
 	: QObject(parent)
@@ -42,18 +61,35 @@ void DBManager::setTable(const QString& table)
 
 QSqlDatabase DBManager::getDB() const
 {
-	if(_databasePool.hasLocalData())
-		return _databasePool.localData();
+	QThreadStorage<QSqlDatabase>& pool = _readonlyMode ? _readonlyDatabasePool : _databasePool;
+	if(pool.hasLocalData())
+		return pool.localData();
 	else
 	{
 		auto db = QSqlDatabase::addDatabase("QSQLITE", QUuid::createUuid().toString());
-		_databasePool.setLocalData(db);
+		pool.setLocalData(db);
 		db.setDatabaseName(_rootPath+"/db/"+_dbn+".db");
 		if(!db.open())
 		{
 			Error(_log, "%s", QSTRING_CSTR(db.lastError().text()));
 			throw std::runtime_error("Failed to open database connection!");
 		}
+
+		// switching the journal mode writes to the database file
+		if(_readonlyMode)
+			return db;
+
+		QSqlQuery pragma(db);
+		// with the write ahead log a write appends the changed pages instead of rewriting the database file
+		if(!pragma.exec("PRAGMA journal_mode=WAL"))
+		{
+			Warning(_log, "Failed to enable the write ahead log: %s", QSTRING_CSTR(pragma.lastError().text()));
+		}
+		// sync on checkpoints only, the write ahead log keeps the database consistent on power loss
+		if(!pragma.exec("PRAGMA synchronous=NORMAL"))
+		{
+			Warning(_log, "Failed to set the synchronous mode: %s", QSTRING_CSTR(pragma.lastError().text()));
+		}
 		return db;
 	}
 }
@@ -77,10 +113,6 @@ bool DBManager::createRecord(const VectorPair& conditions, const QVariantMap& co
 		return true;
 	}
 
-	QSqlDatabase idb = getDB();
-	QSqlQuery query(idb);
-	query.setForwardOnly(true);
-
 	QVariantList cValues;
 	QStringList prep;
 	QStringList placeh;
@@ -101,12 +133,12 @@ bool DBManager::createRecord(const VectorPair& conditions, const QVariantMap& co
 		cValues << pair.second;
 		placeh.append("?");
 	}
-	query.prepare(QString("INSERT INTO %1 ( %2 ) VALUES ( %3 )").arg(_table,prep.join(", ")).arg(placeh.join(", ")));
+	QSqlQuery query = cachedQuery(QString("INSERT INTO %1 ( %2 ) VALUES ( %3 )").arg(_table,prep.join(", ")).arg(placeh.join(", ")));
 	// add column & condition values
 	doAddBindValue(query, cValues);
 	if(!query.exec())
 	{
-		Error(_log, "Failed to create record: '%s' in table: '%s' Error: %s", QSTRING_CSTR(prep.join(", ")), QSTRING_CSTR(_table), QSTRING_CSTR(idb.lastError().text()));
+		Error(_log, "Failed to create record: '%s' in table: '%s' Error: %s", QSTRING_CSTR(prep.join(", ")), QSTRING_CSTR(_table), QSTRING_CSTR(query.lastError().text()));
 		return false;
 	}
 	return true;
@@ -117,10 +149,6 @@ bool DBManager::recordExists(const VectorPair& conditions) const
 	if(conditions.isEmpty())
 		return false;
 
-	QSqlDatabase idb = getDB();
-	QSqlQuery query(idb);
-	query.setForwardOnly(true);
-
 	QStringList prepCond;
 	QVariantList bindVal;
 	prepCond << "WHERE";
@@ -130,23 +158,17 @@ bool DBManager::recordExists(const VectorPair& conditions) const
 		prepCond << pair.first+"=?";
 		bindVal << pair.second;
 	}
-	query.prepare(QString("SELECT * FROM %1 %2").arg(_table,prepCond.join(" ")));
+	QSqlQuery query = cachedQuery(QString("SELECT 1 FROM %1 %2 LIMIT 1").arg(_table,prepCond.join(" ")));
 	doAddBindValue(query, bindVal);
 	if(!query.exec())
 	{
-		Error(_log, "Failed recordExists(): '%s' in table: '%s' Error: %s", QSTRING_CSTR(prepCond.join(" ")), QSTRING_CSTR(_table), QSTRING_CSTR(idb.lastError().text()));
+		Error(_log, "Failed recordExists(): '%s' in table: '%s' Error: %s", QSTRING_CSTR(prepCond.join(" ")), QSTRING_CSTR(_table), QSTRING_CSTR(query.lastError().text()));
 		return false;
 	}
 
-	int entry = 0;
-	while (query.next()) {
-		entry++;
-	}
-
-	if(entry)
-		return true;
-
-	return false;
+	const bool exists = query.next();
+	query.finish();
+	return exists;
 }
 
 bool DBManager::updateRecord(const VectorPair& conditions, const QVariantMap& columns) const
@@ -156,10 +178,6 @@ bool DBManager::updateRecord(const VectorPair& conditions, const QVariantMap& co
 		return false;
 	}
 
-	QSqlDatabase idb = getDB();
-	QSqlQuery query(idb);
-	query.setForwardOnly(true);
-
 	QVariantList values;
 	QStringList prep;
 
@@ -184,14 +202,14 @@ bool DBManager::updateRecord(const VectorPair& conditions, const QVariantMap& co
 		prepBindVal << pair.second;
 	}
 
-	query.prepare(QString("UPDATE %1 SET %2 %3").arg(_table,prep.join(", ")).arg(prepCond.join(" ")));
+	QSqlQuery query = cachedQuery(QString("UPDATE %1 SET %2 %3").arg(_table,prep.join(", ")).arg(prepCond.join(" ")));
 	// add column values
 	doAddBindValue(query, values);
 	// add condition values
 	doAddBindValue(query, prepBindVal);
 	if(!query.exec())
 	{
-		Error(_log, "Failed to update record: '%s' in table: '%s' Error: %s", QSTRING_CSTR(prepCond.join(" ")), QSTRING_CSTR(_table), QSTRING_CSTR(idb.lastError().text()));
+		Error(_log, "Failed to update record: '%s' in table: '%s' Error: %s", QSTRING_CSTR(prepCond.join(" ")), QSTRING_CSTR(_table), QSTRING_CSTR(query.lastError().text()));
 		return false;
 	}
 	return true;
@@ -199,10 +217,6 @@ bool DBManager::updateRecord(const VectorPair& conditions, const QVariantMap& co
 
 bool DBManager::getRecord(const VectorPair& conditions, QVariantMap& results, const QStringList& tColumns, const QStringList& tOrder) const
 {
-	QSqlDatabase idb = getDB();
-	QSqlQuery query(idb);
-	query.setForwardOnly(true);
-
 	QString sColumns("*");
 	if(!tColumns.isEmpty())
 		sColumns = tColumns.join(", ");
@@ -224,12 +238,12 @@ bool DBManager::getRecord(const VectorPair& conditions, QVariantMap& results, co
 		prepCond << pair.first+"=?";
 		bindVal << pair.second;
 	}
-	query.prepare(QString("SELECT %1 FROM %2%3%4").arg(sColumns,_table).arg(prepCond.join(" ")).arg(sOrder));
+	QSqlQuery query = cachedQuery(QString("SELECT %1 FROM %2%3%4").arg(sColumns,_table).arg(prepCond.join(" ")).arg(sOrder));
 	doAddBindValue(query, bindVal);
 
 	if(!query.exec())
 	{
-		Error(_log, "Failed to get record: '%s' in table: '%s' Error: %s", QSTRING_CSTR(prepCond.join(" ")), QSTRING_CSTR(_table), QSTRING_CSTR(idb.lastError().text()));
+		Error(_log, "Failed to get record: '%s' in table: '%s' Error: %s", QSTRING_CSTR(prepCond.join(" ")), QSTRING_CSTR(_table), QSTRING_CSTR(query.lastError().text()));
 		return false;
 	}
 
@@ -241,16 +255,13 @@ bool DBManager::getRecord(const VectorPair& conditions, QVariantMap& results, co
 	{
 		results[rec.fieldName(i)] = rec.value(i);
 	}
+	query.finish();
 
 	return true;
 }
 
 bool DBManager::getRecords(QVector<QVariantMap>& results, const QStringList& tColumns, const QStringList& tOrder) const
 {
-	QSqlDatabase idb = getDB();
-	QSqlQuery query(idb);
-	query.setForwardOnly(true);
-
 	QString sColumns("*");
 	if(!tColumns.isEmpty())
 		sColumns = tColumns.join(", ");
@@ -262,11 +273,11 @@ bool DBManager::getRecords(QVector<QVariantMap>& results, const QStringList& tCo
 		sOrder.append(tOrder.join(", "));
 	}
 
-	query.prepare(QString("SELECT %1 FROM %2%3").arg(sColumns,_table,sOrder));
+	QSqlQuery query = cachedQuery(QString("SELECT %1 FROM %2%3").arg(sColumns,_table,sOrder));
 
 	if(!query.exec())
 	{
-		Error(_log, "Failed to get records: '%s' in table: '%s' Error: %s", QSTRING_CSTR(sColumns), QSTRING_CSTR(_table), QSTRING_CSTR(idb.lastError().text()));
+		Error(_log, "Failed to get records: '%s' in table: '%s' Error: %s", QSTRING_CSTR(sColumns), QSTRING_CSTR(_table), QSTRING_CSTR(query.lastError().text()));
 		return false;
 	}
 
@@ -281,6 +292,7 @@ bool DBManager::getRecords(QVector<QVariantMap>& results, const QStringList& tCo
 		}
 		results.append(entry);
 	}
+	query.finish();
 
 	return true;
 }
@@ -301,9 +313,6 @@ bool DBManager::deleteRecord(const VectorPair& conditions) const
 
 	if(recordExists(conditions))
 	{
-		QSqlDatabase idb = getDB();
-		QSqlQuery query(idb);
-
 		// prep conditions
 		QStringList prepCond("WHERE");
 		QVariantList bindValues;
@@ -314,11 +323,11 @@ bool DBManager::deleteRecord(const VectorPair& conditions) const
 			bindValues << pair.second;
 		}
 
-		query.prepare(QString("DELETE FROM %1 %2").arg(_table,prepCond.join(" ")));
+		QSqlQuery query = cachedQuery(QString("DELETE FROM %1 %2").arg(_table,prepCond.join(" ")));
 		doAddBindValue(query, bindValues);
 		if(!query.exec())
 		{
-			Error(_log, "Failed to delete record: '%s' in table: '%s' Error: %s", QSTRING_CSTR(prepCond.join(" ")), QSTRING_CSTR(_table), QSTRING_CSTR(idb.lastError().text()));
+			Error(_log, "Failed to delete record: '%s' in table: '%s' Error: %s", QSTRING_CSTR(prepCond.join(" ")), QSTRING_CSTR(_table), QSTRING_CSTR(query.lastError().text()));
 			return false;
 		}
 		return true;
@@ -409,6 +418,8 @@ bool DBManager::deleteTable(const QString& table) const
 	if(tableExists(table))
 	{
 		QSqlDatabase idb = getDB();
+		// prepared statements of the table prevent dropping it
+		_statementCache.localData().clear();
 		QSqlQuery query(idb);
 		if(!query.exec(QString("DROP TABLE %1").arg(table)))
 		{
@@ -443,3 +454,109 @@ void DBManager::doAddBindValue(QSqlQuery& query, const QVariantList& variants) c
 		}
 	}
 }
+
+QSqlQuery DBManager::cachedQuery(const QString& statement) const
+{
+	QSqlDatabase idb = getDB();
+	QHash<QString, QSqlQuery>& statements = _statementCache.localData();
+
+	// the read-only and read/write connections of a thread prepare their own statements
+	const QString key = idb.connectionName() + '\n' + statement;
+	auto it = statements.constFind(key);
+	if(it != statements.constEnd())
+		return it.value();
+
+	QSqlQuery query(idb);
+	query.setForwardOnly(true);
+	if(!query.prepare(statement))
+	{
+		// not cached, exec() reports the error
+		return query;
+	}
+
+	if(statements.size() >= STATEMENT_CACHE_MAX)
+		statements.clear();
+	statements.insert(key, query);
+
+	return query;
+}
+
+bool DBManager::startTransaction() const
+{
+	if ( _readonlyMode )
+	{
+		return false;
+	}
+
+	Transaction& transaction = _transactions.localData();
+	if(transaction.depth > 0)
+	{
+		++transaction.depth;
+		return true;
+	}
+
+	// take the write lock at the start, a deferred transaction may fail to upgrade its read lock
+	QSqlQuery query = cachedQuery("BEGIN IMMEDIATE");
+	if(!query.exec())
+	{
+		Error(_log, "Failed to start transaction: %s", QSTRING_CSTR(query.lastError().text()));
+		return false;
+	}
+
+	transaction.depth = 1;
+	transaction.rollback = false;
+	return true;
+}
+
+bool DBManager::commitTransaction() const
+{
+	Transaction& transaction = _transactions.localData();
+	if(transaction.depth == 0)
+	{
+		Error(_log, "Commit without a started transaction");
+		return false;
+	}
+
+	if(--transaction.depth > 0)
+		return true;
+
+	// a nested transaction was rolled back
+	if(transaction.rollback)
+	{
+		endTransaction(false);
+		return false;
+	}
+	return endTransaction(true);
+}
+
+bool DBManager::rollbackTransaction() const
+{
+	Transaction& transaction = _transactions.localData();
+	if(transaction.depth == 0)
+	{
+		Error(_log, "Rollback without a started transaction");
+		return false;
+	}
+
+	transaction.rollback = true;
+	if(--transaction.depth > 0)
+		return true;
+
+	return endTransaction(false);
+}
+
+bool DBManager::endTransaction(bool commit) const
+{
+	QSqlQuery query = cachedQuery(commit ? "COMMIT" : "ROLLBACK");
+	if(!query.exec())
+	{
+		Error(_log, "Failed to %s transaction: %s", commit ? "commit" : "roll back", QSTRING_CSTR(query.lastError().text()));
+		if(commit)
+		{
+			// release the write lock
+			cachedQuery("ROLLBACK").exec();
+		}
+		return false;
+	}
+	return true;
+}
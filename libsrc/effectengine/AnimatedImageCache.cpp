@@ -0,0 +1,188 @@
+#include <effectengine/AnimatedImageCache.h>
+
+// STL includes
+#include <cstring>
+
+// Qt includes
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QEventLoop>
+#include <QFile>
+#include <QImage>
+#include <QImageReader>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QUrl>
+
+AnimatedImageCache& AnimatedImageCache::getInstance()
+{
+	static AnimatedImageCache instance;
+	return instance;
+}
+
+std::shared_ptr<const AnimatedImageCache::Frames> AnimatedImageCache::getFrames(const Source& source, const QSize& size, QString& error)
+{
+	const QString key = cacheKey(source, size);
+	{
+		QMutexLocker lock(&_mutex);
+		std::shared_ptr<const Frames> frames = _frames.value(key).lock();
+		if (frames != nullptr)
+		{
+			return frames;
+		}
+	}
+
+	// load and decode without holding the lock, an image may be downloaded
+	QByteArray data;
+	auto frames = std::make_shared<Frames>();
+	if (!loadImage(source, data, error) || !decodeFrames(data, source, size, *frames, error))
+	{
+		return nullptr;
+	}
+
+	QMutexLocker lock(&_mutex);
+
+	// frames decoded by another instance meanwhile are shared
+	std::shared_ptr<const Frames> cached = _frames.value(key).lock();
+	if (cached != nullptr)
+	{
+		return cached;
+	}
+
+	// remove the entries of finished effects
+	for (auto it = _frames.begin(); it != _frames.end();)
+	{
+		it = it.value().expired() ? _frames.erase(it) : ++it;
+	}
+
+	_frames.insert(key, frames);
+	return frames;
+}
+
+QString AnimatedImageCache::cacheKey(const Source& source, const QSize& size)
+{
+	QString image;
+	if (!source.imageData.isEmpty())
+	{
+		image = "data:" + QCryptographicHash::hash(source.imageData.toUtf8(), QCryptographicHash::Md5).toHex();
+	}
+	else if (!source.url.isEmpty())
+	{
+		image = "url:" + source.url;
+	}
+	else
+	{
+		image = "file:" + source.file;
+	}
+
+	return QString("%1|%2,%3,%4,%5|%6|%7x%8").arg(image)
+			.arg(source.cropLeft).arg(source.cropTop).arg(source.cropRight).arg(source.cropBottom)
+			.arg(source.grayscale).arg(size.width()).arg(size.height());
+}
+
+bool AnimatedImageCache::loadImage(const Source& source, QByteArray& data, QString& error)
+{
+	if (!source.imageData.isEmpty())
+	{
+		data = QByteArray::fromBase64(source.imageData.toUtf8());
+		return true;
+	}
+
+	if (!source.url.isEmpty())
+	{
+		QNetworkAccessManager networkManager;
+		QNetworkReply* networkReply = networkManager.get(QNetworkRequest(QUrl(source.url)));
+
+		QEventLoop eventLoop;
+		QObject::connect(networkReply, &QNetworkReply::finished, &eventLoop, &QEventLoop::quit);
+		eventLoop.exec();
+
+		const bool success = (networkReply->error() == QNetworkReply::NoError);
+		if (success)
+		{
+			data = networkReply->readAll();
+		}
+		else
+		{
+			error = QString("Failed to download image '%1': %2").arg(source.url, networkReply->errorString());
+		}
+		delete networkReply;
+		return success;
+	}
+
+	QString fileName = source.file;
+	if (fileName.startsWith(':'))
+	{
+		fileName = ":/effects/" + fileName.mid(1);
+	}
+
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		error = QString("Failed to open image '%1': %2").arg(fileName, file.errorString());
+		return false;
+	}
+	data = file.readAll();
+	return true;
+}
+
+bool AnimatedImageCache::decodeFrames(const QByteArray& data, const Source& source, const QSize& size, Frames& frames, QString& error)
+{
+	QBuffer buffer;
+	buffer.setData(data);
+	buffer.open(QIODevice::ReadOnly);
+
+	QImageReader reader(&buffer);
+	reader.setDecideFormatFromContent(true);
+
+	QImage frame;
+	while (reader.read(&frame))
+	{
+		const int width = frame.width();
+		const int height = frame.height();
+		if (source.cropLeft > 0 || source.cropTop > 0 || source.cropRight > 0 || source.cropBottom > 0)
+		{
+			if (source.cropLeft + source.cropRight >= width || source.cropTop + source.cropBottom >= height)
+			{
+				error = QString("Rejecting invalid crop values: left: %1, right: %2, top: %3, bottom: %4, higher than height/width %5/%6")
+						.arg(source.cropLeft).arg(source.cropRight).arg(source.cropTop).arg(source.cropBottom).arg(height).arg(width);
+				return false;
+			}
+			frame = frame.copy(source.cropLeft, source.cropTop, width - source.cropLeft - source.cropRight, height - source.cropTop - source.cropBottom);
+		}
+
+		// transparent pixels are black
+		if (frame.hasAlphaChannel())
+		{
+			frame = frame.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+		}
+
+		// the scaling averages the pixels of a LED grid cell
+		if (!size.isEmpty() && frame.size() != size)
+		{
+			frame = frame.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+		}
+
+		if (source.grayscale)
+		{
+			frame = frame.convertToFormat(QImage::Format_Grayscale8);
+		}
+		frame = frame.convertToFormat(QImage::Format_RGB888);
+
+		Image<ColorRgb> image(frame.width(), frame.height(), ImageNoInit);
+		const size_t lineSize = static_cast<size_t>(frame.width()) * sizeof(ColorRgb);
+		for (int y = 0; y < frame.height(); ++y)
+		{
+			memcpy(&image(0, y), frame.constScanLine(y), lineSize);
+		}
+		frames.append(image);
+	}
+
+	if (frames.isEmpty())
+	{
+		error = QString("Failed to decode image: %1").arg(reader.errorString());
+		return false;
+	}
+	return true;
+}
@@ -2,10 +2,12 @@
 #include <QDateTime>
 #include <QFile>
 #include <QResource>
+#include <QTimer>
 
 // effect engin eincludes
 #include <effectengine/Effect.h>
 #include <effectengine/EffectModule.h>
+#include <effectengine/NativeEffect.h>
 #include <utils/Logger.h>
 #include <hyperion/Hyperion.h>
 #include <hyperion/PriorityMuxer.h>
@@ -93,16 +95,24 @@ void Effect::setModuleParameters()
 
 void Effect::run()
 {
-	PythonProgram program(_name, _log);
-
-	setModuleParameters();
-
 	// Set the end time if applicable
 	if (_timeout > 0)
 	{
 		_endTime = QDateTime::currentMSecsSinceEpoch() + _timeout;
 	}
 
+	// built-in effects with a native implementation do not require Python
+	std::unique_ptr<NativeEffect> nativeEffect = NativeEffect::create(_script);
+	if (nativeEffect != nullptr)
+	{
+		runNative(*nativeEffect);
+		return;
+	}
+
+	PythonProgram program(_name, _log);
+
+	setModuleParameters();
+
 	// Run the effect script
 	QFile file (_script);
 	if (file.open(QIODevice::ReadOnly))
@@ -115,3 +125,46 @@ void Effect::run()
 	}
 	file.close();
 }
+
+void Effect::runNative(NativeEffect &effect)
+{
+	NativeEffect::Context context;
+	QMetaObject::invokeMethod(_hyperion, "getLedCount", Qt::BlockingQueuedConnection, Q_RETURN_ARG(int, context.ledCount));
+	QMetaObject::invokeMethod(_hyperion, "getLatchTime", Qt::BlockingQueuedConnection, Q_RETURN_ARG(int, context.latchTime));
+	context.imageSize = _imageSize;
+	context.imageData = _imageData;
+
+	QString error;
+	if (!effect.init(_args, context, error))
+	{
+		Error(_log, "Effect \"%s\": %s", QSTRING_CSTR(_name), QSTRING_CSTR(error));
+		return;
+	}
+
+	std::vector<ColorRgb> ledColors(static_cast<size_t>(context.ledCount), ColorRgb::BLACK);
+	Image<ColorRgb> image;
+
+	QTimer timer;
+	timer.setTimerType(Qt::PreciseTimer);
+	timer.setInterval(effect.getInterval());
+	connect(&timer, &QTimer::timeout, &timer, [&]()
+	{
+		if (isInterruptionRequested())
+		{
+			quit();
+			return;
+		}
+
+		if (effect.render(ledColors, image))
+		{
+			emit setInputImage(_priority, image, getRemaining(), false);
+		}
+		else
+		{
+			emit setInput(_priority, ledColors, getRemaining(), false);
+		}
+	});
+
+	timer.start();
+	exec();
+}
@@ -197,7 +197,7 @@ PyObject* EffectModule::wrapSetImage(PyObject *self, PyObject *args)
 			int length = PyByteArray_Size(bytearray);
 			if (length == 3 * width * height)
 			{
-				Image<ColorRgb> image(width, height);
+				Image<ColorRgb> image(width, height, ImageNoInit);
 				char * data = PyByteArray_AS_STRING(bytearray);
 				memcpy(image.memptr(), data, length);
 				emit getEffect()->setInputImage(getEffect()->_priority, image, getEffect()->getRemaining(), false);
@@ -367,7 +367,7 @@ PyObject* EffectModule::wrapImageShow(PyObject *self, PyObject *args)
 	int width = qimage->width();
 	int height = qimage->height();
 
-	Image<ColorRgb> image(width, height);
+	Image<ColorRgb> image(width, height, ImageNoInit);
 	QByteArray binaryImage;
 
 	for (int i = 0; i<height; ++i)
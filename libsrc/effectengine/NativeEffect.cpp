@@ -0,0 +1,43 @@
+#include <effectengine/NativeEffect.h>
+
+// Qt includes
+#include <QMap>
+
+// native effects
+#include "native/AnimatedImageEffect.h"
+#include "native/KnightRiderEffect.h"
+#include "native/MoodBlobsEffect.h"
+#include "native/RainbowMoodEffect.h"
+#include "native/SwirlEffect.h"
+
+namespace {
+
+template <typename Effect_T>
+std::unique_ptr<NativeEffect> createEffect()
+{
+	return std::unique_ptr<NativeEffect>(new Effect_T());
+}
+
+using EffectCreator = std::unique_ptr<NativeEffect> (*)();
+
+// Native implementations by the scripts of the built-in effects
+const QMap<QString, EffectCreator>& nativeEffects()
+{
+	static const QMap<QString, EffectCreator> effects {
+		{ ":/effects/gif.py", createEffect<AnimatedImageEffect> },
+		{ ":/effects/knight-rider.py", createEffect<KnightRiderEffect> },
+		{ ":/effects/mood-blobs.py", createEffect<MoodBlobsEffect> },
+		{ ":/effects/rainbow-mood.py", createEffect<RainbowMoodEffect> },
+		{ ":/effects/swirl.py", createEffect<SwirlEffect> },
+	};
+	return effects;
+}
+
+}
+
+std::unique_ptr<NativeEffect> NativeEffect::create(const QString& script)
+{
+	// scripts of users are not built-in resources, they are run by Python
+	const EffectCreator creator = nativeEffects().value(script, nullptr);
+	return (creator != nullptr) ? creator() : nullptr;
+}
@@ -0,0 +1,43 @@
+#include "AnimatedImageEffect.h"
+
+bool AnimatedImageEffect::init(const QJsonObject& args, const Context& context, QString& error)
+{
+	AnimatedImageCache::Source source;
+	if (!context.imageData.isEmpty())
+	{
+		source.imageData = context.imageData;
+	}
+	else if (args["imageSource"].toString() == "url")
+	{
+		source.url = args["url"].toString();
+	}
+	else
+	{
+		source.file = args["file"].toString();
+	}
+	source.cropLeft = args["cropLeft"].toInt(0);
+	source.cropTop = args["cropTop"].toInt(0);
+	source.cropRight = args["cropRight"].toInt(0);
+	source.cropBottom = args["cropBottom"].toInt(0);
+	source.grayscale = args["grayscale"].toBool(false);
+
+	// the frames are scaled to the LED grid, the resolution relevant for the LED mapping
+	_frames = AnimatedImageCache::getInstance().getFrames(source, context.imageSize, error);
+	if (_frames == nullptr)
+	{
+		return false;
+	}
+
+	const double framesPerSecond = args["fps"].toDouble(25);
+	_interval = qMax(1, qRound(1000 / (framesPerSecond > 0 ? framesPerSecond : 25)));
+	_reverse = args["reverse"].toBool(false);
+	return true;
+}
+
+bool AnimatedImageEffect::render(std::vector<ColorRgb>& /*ledColors*/, Image<ColorRgb>& image)
+{
+	const int frameCount = _frames->size();
+	image = _frames->at(_reverse ? frameCount - 1 - _frame : _frame);
+	_frame = (_frame + 1) % frameCount;
+	return true;
+}
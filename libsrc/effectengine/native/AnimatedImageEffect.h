@@ -0,0 +1,21 @@
+#pragma once
+
+#include <effectengine/NativeEffect.h>
+#include <effectengine/AnimatedImageCache.h>
+
+///
+/// @brief Plays an animated image (GIF, APNG), native implementation of gif.py
+///
+/// The frames are taken from the AnimatedImageCache, i.e. decoded once and shared with other instances
+///
+class AnimatedImageEffect : public NativeEffect
+{
+public:
+	bool init(const QJsonObject& args, const Context& context, QString& error) override;
+	bool render(std::vector<ColorRgb>& ledColors, Image<ColorRgb>& image) override;
+
+private:
+	std::shared_ptr<const AnimatedImageCache::Frames> _frames;
+	bool _reverse = false;
+	int _frame = 0;
+};
@@ -0,0 +1,69 @@
+#include "KnightRiderEffect.h"
+
+// STL includes
+#include <algorithm>
+
+// Qt includes
+#include <QJsonArray>
+
+bool KnightRiderEffect::init(const QJsonObject& args, const Context& /*context*/, QString& /*error*/)
+{
+	const double speed = qMax(0.0001, args["speed"].toDouble(1.0));
+	_fadeFactor = qBound(0.0, args["fadeFactor"].toDouble(0.7), 1.0);
+
+	const QJsonArray color = args["color"].toArray();
+	if (color.size() == 3)
+	{
+		_color = { static_cast<uint8_t>(color[0].toInt()), static_cast<uint8_t>(color[1].toInt()), static_cast<uint8_t>(color[2].toInt()) };
+	}
+
+	_row.assign(WIDTH, ColorRgb::BLACK);
+	_row[0] = _color;
+
+	// move several positions per frame for high speeds
+	double sleepTime = 1.0 / (speed * WIDTH);
+	_increment = 1;
+	while (sleepTime < 0.05)
+	{
+		_increment *= 2;
+		sleepTime *= 2;
+	}
+	_interval = qMax(1, qRound(sleepTime * 1000));
+	return true;
+}
+
+bool KnightRiderEffect::render(std::vector<ColorRgb>& /*ledColors*/, Image<ColorRgb>& image)
+{
+	if (image.width() != WIDTH || image.height() != 1)
+	{
+		image = Image<ColorRgb>(WIDTH, 1, ImageNoInit);
+	}
+	std::copy(_row.begin(), _row.end(), &image(0, 0));
+
+	// move data into next state
+	for (int step = 0; step < _increment; ++step)
+	{
+		_position += _direction;
+		if (_position == -1)
+		{
+			_position = 1;
+			_direction = 1;
+		}
+		else if (_position == WIDTH)
+		{
+			_position = WIDTH - 2;
+			_direction = -1;
+		}
+
+		// fade the old data
+		for (ColorRgb& color : _row)
+		{
+			color.red = static_cast<uint8_t>(_fadeFactor * color.red);
+			color.green = static_cast<uint8_t>(_fadeFactor * color.green);
+			color.blue = static_cast<uint8_t>(_fadeFactor * color.blue);
+		}
+
+		_row[static_cast<size_t>(_position)] = _color;
+	}
+	return true;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <effectengine/NativeEffect.h>
+
+///
+/// @brief A light moving back and forth with a fading trail, native implementation of knight-rider.py
+///
+class KnightRiderEffect : public NativeEffect
+{
+public:
+	bool init(const QJsonObject& args, const Context& context, QString& error) override;
+	bool render(std::vector<ColorRgb>& ledColors, Image<ColorRgb>& image) override;
+
+private:
+	/// Width of the rendered image, a single row
+	static constexpr int WIDTH = 25;
+
+	ColorRgb _color {255, 0, 0};
+	double _fadeFactor = 0.7;
+	int _increment = 1;
+	int _position = 0;
+	int _direction = 1;
+	std::vector<ColorRgb> _row;
+};
@@ -0,0 +1,150 @@
+#include "MoodBlobsEffect.h"
+
+// Qt includes
+#include <QColor>
+#include <QJsonArray>
+#include <QRandomGenerator>
+
+// STL includes
+#include <cmath>
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+// Modulo with the sign of the divisor, as in Python
+double floorMod(double value, double divisor)
+{
+	if (divisor <= 0.0)
+	{
+		return value;
+	}
+	return value - divisor * std::floor(value / divisor);
+}
+
+}
+
+bool MoodBlobsEffect::init(const QJsonObject& args, const Context& context, QString& error)
+{
+	_ledCount = context.ledCount;
+	if (_ledCount <= 0)
+	{
+		error = "The effect requires LEDs";
+		return false;
+	}
+
+	const double rotationTime = qMax(0.1, args["rotationTime"].toDouble(20.0));
+	_blobs = qMax(1, args["blobs"].toInt(5));
+	_hueChange = qBound(0.0, std::abs(args["hueChange"].toDouble(60.0) / 360.0), 0.5);
+
+	_baseColorChange = args["baseChange"].toBool(false);
+	const double rangeLeft = args["baseColorRangeLeft"].toDouble(0.0);
+	const double rangeRight = args["baseColorRangeRight"].toDouble(360.0);
+	const double changeRate = qMax(0.0, args["baseColorChangeRate"].toDouble(10.0));
+
+	// switch the base color change off, if left and right are too close together to see a difference in color
+	if ((rangeRight > rangeLeft && (rangeRight - rangeLeft) < 10) ||
+		(rangeLeft > rangeRight && ((rangeRight + 360) - rangeLeft) < 10))
+	{
+		_baseColorChange = false;
+	}
+	_fullColorWheelAvailable = std::fmod(rangeRight, 360.0) == std::fmod(rangeLeft, 360.0);
+	_baseColorRangeLeft = rangeLeft / 360.0;
+	_baseColorRangeRight = rangeRight / 360.0;
+
+	// base color
+	QColor color(0, 0, 255);
+	const QJsonArray colorArray = args["color"].toArray();
+	if (colorArray.size() == 3)
+	{
+		color.setRgb(colorArray[0].toInt(), colorArray[1].toInt(), colorArray[2].toInt());
+	}
+	// achromatic colors have no hue
+	_baseHue = qMax(0.0, static_cast<double>(color.hsvHueF()));
+	_saturation = color.hsvSaturationF();
+	_value = color.valueF();
+	if (args["colorRandom"].toBool(false))
+	{
+		_baseHue = QRandomGenerator::global()->generateDouble();
+	}
+
+	_interval = 100;
+	const double sleepTime = _interval / 1000.0;
+	_amplitudePhaseIncrement = _blobs * PI * sleepTime / rotationTime;
+	_baseColorChangeSteps = changeRate / sleepTime;
+	_rotationDirection = 1;
+
+	if (args["reverse"].toBool(false))
+	{
+		_amplitudePhaseIncrement = -_amplitudePhaseIncrement;
+		_rotationDirection = -1;
+	}
+
+	updateColorData();
+	return true;
+}
+
+void MoodBlobsEffect::updateColorData()
+{
+	_colorData.resize(static_cast<size_t>(_ledCount));
+	for (int i = 0; i < _ledCount; ++i)
+	{
+		const double hue = floorMod(_baseHue + _hueChange * std::sin(2 * PI * i / _ledCount), 1.0);
+		const QColor color = QColor::fromHsvF(hue, _saturation, _value);
+		_colorData[static_cast<size_t>(i)] = { static_cast<uint8_t>(color.red()), static_cast<uint8_t>(color.green()), static_cast<uint8_t>(color.blue()) };
+	}
+}
+
+bool MoodBlobsEffect::render(std::vector<ColorRgb>& ledColors, Image<ColorRgb>& /*image*/)
+{
+	// move the base color
+	if (_baseColorChange)
+	{
+		if (_baseColorChangeStepCount >= _baseColorChangeSteps)
+		{
+			_baseColorChangeStepCount = 0;
+			// cyclic increment when the full color wheel is available, move up and down otherwise
+			if (_fullColorWheelAvailable)
+			{
+				_baseHue = floorMod(_baseHue + _baseColorChangeIncrement, _baseColorRangeRight);
+			}
+			else
+			{
+				// switch increment direction at the borders of the range
+				if (_baseColorChangeIncrement < 0 && _baseHue > _baseColorRangeLeft && (_baseHue + _baseColorChangeIncrement) <= _baseColorRangeLeft)
+				{
+					_baseColorChangeIncrement = std::abs(_baseColorChangeIncrement);
+				}
+				else if (_baseColorChangeIncrement > 0 && _baseHue < _baseColorRangeRight && (_baseHue + _baseColorChangeIncrement) >= _baseColorRangeRight)
+				{
+					_baseColorChangeIncrement = -std::abs(_baseColorChangeIncrement);
+				}
+				_baseHue = floorMod(_baseHue + _baseColorChangeIncrement, 1.0);
+			}
+			updateColorData();
+		}
+		++_baseColorChangeStepCount;
+	}
+
+	// calculate the new colors, the color data is rotated by _rotation LEDs
+	ledColors.resize(static_cast<size_t>(_ledCount));
+	for (int i = 0; i < _ledCount; ++i)
+	{
+		const double amplitude = qMax(0.0, std::sin(-_amplitudePhase + 2 * PI * _blobs * i / _ledCount));
+		const ColorRgb& color = _colorData[static_cast<size_t>(((i - _rotation) % _ledCount + _ledCount) % _ledCount)];
+		ColorRgb& led = ledColors[static_cast<size_t>(i)];
+		led.red = static_cast<uint8_t>(color.red * amplitude);
+		led.green = static_cast<uint8_t>(color.green * amplitude);
+		led.blue = static_cast<uint8_t>(color.blue * amplitude);
+	}
+
+	// increment the phase
+	_amplitudePhase = floorMod(_amplitudePhase + _amplitudePhaseIncrement, 2 * PI);
+
+	if (_rotateColors)
+	{
+		_rotation = (_rotation + _rotationDirection) % _ledCount;
+	}
+	_rotateColors = !_rotateColors;
+	return false;
+}
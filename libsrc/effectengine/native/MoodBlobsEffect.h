@@ -0,0 +1,41 @@
+#pragma once
+
+#include <effectengine/NativeEffect.h>
+
+///
+/// @brief Blobs of colors moving around the LEDs, native implementation of mood-blobs.py
+///
+class MoodBlobsEffect : public NativeEffect
+{
+public:
+	bool init(const QJsonObject& args, const Context& context, QString& error) override;
+	bool render(std::vector<ColorRgb>& ledColors, Image<ColorRgb>& image) override;
+
+private:
+	/// Calculate the colors of the LEDs around the base hue
+	void updateColorData();
+
+	int _ledCount = 0;
+	int _blobs = 5;
+	double _hueChange = 60.0 / 360.0;
+	double _saturation = 1.0;
+	double _value = 1.0;
+	double _baseHue = 0.0;
+
+	bool _baseColorChange = false;
+	bool _fullColorWheelAvailable = false;
+	double _baseColorRangeLeft = 0.0;
+	double _baseColorRangeRight = 1.0;
+	double _baseColorChangeIncrement = 1.0 / 360.0;
+	double _baseColorChangeSteps = 0.0;
+	int _baseColorChangeStepCount = 0;
+
+	double _amplitudePhase = 0.0;
+	double _amplitudePhaseIncrement = 0.0;
+	/// Direction of the color rotation, one LED per two frames
+	int _rotationDirection = 1;
+	int _rotation = 0;
+	bool _rotateColors = false;
+
+	std::vector<ColorRgb> _colorData;
+};
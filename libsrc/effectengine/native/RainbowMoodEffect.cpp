@@ -0,0 +1,33 @@
+#include "RainbowMoodEffect.h"
+
+// Qt includes
+#include <QColor>
+
+// STL includes
+#include <algorithm>
+#include <cmath>
+
+bool RainbowMoodEffect::init(const QJsonObject& args, const Context& /*context*/, QString& /*error*/)
+{
+	const double rotationTime = args["rotation-time"].toDouble(30.0);
+	_brightness = qBound(0.0, args["brightness"].toDouble(100) / 100.0, 1.0);
+	_saturation = qBound(0.0, args["saturation"].toDouble(100) / 100.0, 1.0);
+
+	_interval = 100;
+	_hueIncrement = (_interval / 1000.0) / qMax(0.1, rotationTime);
+	if (args["reverse"].toBool(false))
+	{
+		_hueIncrement = -_hueIncrement;
+	}
+	return true;
+}
+
+bool RainbowMoodEffect::render(std::vector<ColorRgb>& ledColors, Image<ColorRgb>& /*image*/)
+{
+	const QColor color = QColor::fromHsvF(_hue, _saturation, _brightness);
+	const ColorRgb rgb { static_cast<uint8_t>(color.red()), static_cast<uint8_t>(color.green()), static_cast<uint8_t>(color.blue()) };
+	std::fill(ledColors.begin(), ledColors.end(), rgb);
+
+	_hue = std::fmod(_hue + _hueIncrement + 1.0, 1.0);
+	return false;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <effectengine/NativeEffect.h>
+
+///
+/// @brief Rotates all LEDs through the hue circle, native implementation of rainbow-mood.py
+///
+class RainbowMoodEffect : public NativeEffect
+{
+public:
+	bool init(const QJsonObject& args, const Context& context, QString& error) override;
+	bool render(std::vector<ColorRgb>& ledColors, Image<ColorRgb>& image) override;
+
+private:
+	double _saturation = 1.0;
+	double _brightness = 1.0;
+	double _hue = 0.0;
+	double _hueIncrement = 0.0;
+};
@@ -0,0 +1,144 @@
+#include "SwirlEffect.h"
+
+// Qt includes
+#include <QJsonArray>
+#include <QPainter>
+#include <QRandomGenerator>
+
+namespace {
+
+// Minimum size of the canvas, smaller LED grids render the gradients too coarse
+const int MIN_CANVAS_SIZE = 64;
+
+// Rainbow of the swirl, if no custom colors are given
+const QGradientStops RAINBOW_STOPS {
+	{ 0 / 255.0, QColor(255, 0, 0) },
+	{ 25 / 255.0, QColor(255, 230, 0) },
+	{ 63 / 255.0, QColor(255, 255, 0) },
+	{ 100 / 255.0, QColor(0, 255, 0) },
+	{ 127 / 255.0, QColor(0, 255, 200) },
+	{ 159 / 255.0, QColor(0, 255, 255) },
+	{ 191 / 255.0, QColor(0, 0, 255) },
+	{ 224 / 255.0, QColor(255, 0, 255) },
+	{ 255 / 255.0, QColor(255, 0, 127) },
+};
+
+// Colors of the second swirl, if no custom colors are given
+QJsonArray defaultSecondColors()
+{
+	return QJsonArray {
+		QJsonArray { 255, 255, 255, 0 }, QJsonArray { 0, 255, 255, 0 }, QJsonArray { 255, 255, 255, 1 }, QJsonArray { 0, 255, 255, 0 },
+		QJsonArray { 0, 255, 255, 0 }, QJsonArray { 0, 255, 255, 0 }, QJsonArray { 255, 255, 255, 1 }, QJsonArray { 0, 255, 255, 0 },
+		QJsonArray { 0, 255, 255, 0 }, QJsonArray { 0, 255, 255, 0 }, QJsonArray { 255, 255, 255, 1 }, QJsonArray { 0, 255, 255, 0 }
+	};
+}
+
+}
+
+bool SwirlEffect::init(const QJsonObject& args, const Context& context, QString& /*error*/)
+{
+	// the canvas is at least 64x64 pixels, keeping the aspect ratio of the LED grid
+	QSize size = context.imageSize.isEmpty() ? QSize(MIN_CANVAS_SIZE, MIN_CANVAS_SIZE) : context.imageSize;
+	if (size.width() < MIN_CANVAS_SIZE || size.height() < MIN_CANVAS_SIZE)
+	{
+		size = size.scaled(qMax(size.width(), MIN_CANVAS_SIZE), qMax(size.height(), MIN_CANVAS_SIZE), Qt::KeepAspectRatioByExpanding);
+	}
+	_canvas = QImage(size, QImage::Format_ARGB32_Premultiplied);
+	_canvas.fill(Qt::black);
+
+	const double rotationTime = args["rotation-time"].toDouble(10.0);
+
+	_swirl.center = centerPoint(args["random-center"].toBool(false), args["center_x"].toDouble(0.5), args["center_y"].toDouble(0.5));
+	_swirl.increment = args["reverse"].toBool(false) ? -1 : 1;
+	const QJsonArray colors = args.contains("custom-colors") ? args["custom-colors"].toArray()
+			: QJsonArray { QJsonArray { 255, 0, 0 }, QJsonArray { 0, 255, 0 }, QJsonArray { 0, 0, 255 } };
+	_swirl.stops = (colors.size() > 1) ? buildGradient(colors) : RAINBOW_STOPS;
+
+	_secondSwirl.center = centerPoint(args["random-center2"].toBool(false), args["center_x2"].toDouble(0.5), args["center_y2"].toDouble(0.5));
+	_secondSwirl.increment = args["reverse2"].toBool(true) ? -1 : 1;
+	const QJsonArray secondColors = args.contains("custom-colors2") ? args["custom-colors2"].toArray() : defaultSecondColors();
+	_secondEnabled = args["enable-second"].toBool(false) && secondColors.size() > 1;
+	if (_secondEnabled)
+	{
+		_secondSwirl.stops = buildGradient(secondColors);
+	}
+
+	// one degree per frame, limited by the LED device
+	const int sleepTime = qRound(qMax(0.1, rotationTime) / 360 * 1000);
+	_interval = qMax(qMax(1, context.latchTime), sleepTime);
+	return true;
+}
+
+QPoint SwirlEffect::centerPoint(bool random, double x, double y) const
+{
+	if (random)
+	{
+		x = QRandomGenerator::global()->generateDouble();
+		y = QRandomGenerator::global()->generateDouble();
+	}
+	return QPoint(qRound(x * _canvas.width()), qRound(y * _canvas.height()));
+}
+
+QGradientStops SwirlEffect::buildGradient(const QJsonArray& colors)
+{
+	// the stop positions are distributed by the number of colors, the last color closes the circle
+	const int positionFactor = 255 / colors.size();
+	QGradientStops stops;
+	int position = 0;
+	QColor color;
+	for (const QJsonValue& value : colors)
+	{
+		const QJsonArray rgba = value.toArray();
+		color = QColor(rgba[0].toInt(), rgba[1].toInt(), rgba[2].toInt(), (rgba.size() == 4) ? static_cast<int>(rgba[3].toDouble() * 255) : 255);
+		position += positionFactor;
+		stops.append({ position / 255.0, color });
+	}
+	stops.prepend({ 0.0, color });
+	return stops;
+}
+
+void SwirlEffect::rotate(Swirl& swirl)
+{
+	swirl.angle += swirl.increment;
+	if (swirl.angle > 360)
+	{
+		swirl.angle = 0;
+	}
+	if (swirl.angle < 0)
+	{
+		swirl.angle = 360;
+	}
+}
+
+bool SwirlEffect::render(std::vector<ColorRgb>& /*ledColors*/, Image<ColorRgb>& image)
+{
+	rotate(_swirl);
+	rotate(_secondSwirl);
+
+	QPainter painter(&_canvas);
+	QConicalGradient gradient(_swirl.center, _swirl.angle);
+	gradient.setStops(_swirl.stops);
+	painter.fillRect(_canvas.rect(), gradient);
+	if (_secondEnabled)
+	{
+		QConicalGradient secondGradient(_secondSwirl.center, _secondSwirl.angle);
+		secondGradient.setStops(_secondSwirl.stops);
+		painter.fillRect(_canvas.rect(), secondGradient);
+	}
+	painter.end();
+
+	if (image.width() != _canvas.width() || image.height() != _canvas.height())
+	{
+		image = Image<ColorRgb>(_canvas.width(), _canvas.height(), ImageNoInit);
+	}
+	for (int y = 0; y < _canvas.height(); ++y)
+	{
+		const QRgb* scanline = reinterpret_cast<const QRgb*>(_canvas.constScanLine(y));
+		ColorRgb* pixel = &image(0, y);
+		for (int x = 0; x < _canvas.width(); ++x)
+		{
+			pixel[x] = { static_cast<uint8_t>(qRed(scanline[x])), static_cast<uint8_t>(qGreen(scanline[x])), static_cast<uint8_t>(qBlue(scanline[x])) };
+		}
+	}
+	return true;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <effectengine/NativeEffect.h>
+
+// Qt includes
+#include <QConicalGradient>
+#include <QJsonArray>
+#include <QImage>
+#include <QPoint>
+
+///
+/// @brief One or two rotating conical gradients, native implementation of swirl.py
+///
+class SwirlEffect : public NativeEffect
+{
+public:
+	bool init(const QJsonObject& args, const Context& context, QString& error) override;
+	bool render(std::vector<ColorRgb>& ledColors, Image<ColorRgb>& image) override;
+
+private:
+	struct Swirl
+	{
+		QPoint center;
+		QGradientStops stops;
+		int angle = 0;
+		int increment = 1;
+	};
+
+	QPoint centerPoint(bool random, double x, double y) const;
+	static QGradientStops buildGradient(const QJsonArray& colors);
+	static void rotate(Swirl& swirl);
+
+	QImage _canvas;
+	Swirl _swirl;
+	Swirl _secondSwirl;
+	bool _secondEnabled = false;
+};
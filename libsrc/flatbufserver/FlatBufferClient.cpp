@@ -2,6 +2,7 @@
 
 // qt
 #include <QTcpSocket>
+#include <QLocalSocket>
 #include <QHostAddress>
 #include <QTimer>
 #include <QRgb>
@@ -11,9 +12,30 @@ FlatBufferClient::FlatBufferClient(QTcpSocket* socket, int timeout, QObject *par
 	, _log(Logger::getInstance("FLATBUFSERVER"))
 	, _socket(socket)
 	, _clientAddress("@"+socket->peerAddress().toString())
+	, _isLocal(false)
 	, _timeoutTimer(new QTimer(this))
 	, _timeout(timeout * 1000)
 	, _priority()
+{
+	connect(socket, &QTcpSocket::disconnected, this, &FlatBufferClient::disconnected);
+	init();
+}
+
+FlatBufferClient::FlatBufferClient(QLocalSocket* socket, int timeout, QObject *parent)
+	: QObject(parent)
+	, _log(Logger::getInstance("FLATBUFSERVER"))
+	, _socket(socket)
+	, _clientAddress("@local")
+	, _isLocal(true)
+	, _timeoutTimer(new QTimer(this))
+	, _timeout(timeout * 1000)
+	, _priority()
+{
+	connect(socket, &QLocalSocket::disconnected, this, &FlatBufferClient::disconnected);
+	init();
+}
+
+void FlatBufferClient::init()
 {
 	// timer setup
 	_timeoutTimer->setSingleShot(true);
@@ -21,8 +43,7 @@ FlatBufferClient::FlatBufferClient(QTcpSocket* socket, int timeout, QObject *par
 	connect(_timeoutTimer, &QTimer::timeout, this, &FlatBufferClient::forceClose);
 
 	// connect socket signals
-	connect(_socket, &QTcpSocket::readyRead, this, &FlatBufferClient::readyRead);
-	connect(_socket, &QTcpSocket::disconnected, this, &FlatBufferClient::disconnected);
+	connect(_socket, &QIODevice::readyRead, this, &FlatBufferClient::readyRead);
 }
 
 void FlatBufferClient::readyRead()
@@ -69,6 +90,12 @@ void FlatBufferClient::disconnected()
 {
 	Debug(_log, "Socket Closed");
 	_socket->deleteLater();
+
+	// a frame interrupted by the disconnect is never completed
+	_receiveBuffer.clear();
+	_sharedImages.releaseSlots();
+	_sharedImages.detach();
+
 	if (_priority != 0 && _priority >= 100 && _priority < 200)
 		emit clearGlobalInput(_priority);
 
@@ -167,7 +194,7 @@ void FlatBufferClient::handleImageCommand(const hyperionnet::Image *image)
 		}
 
 		// create ImageRgb
-		Image<ColorRgb> imageRGB(width, height);
+		Image<ColorRgb> imageRGB(width, height, ImageNoInit);
 		if (channelCount == 3)
 		{
 			memmove(imageRGB.memptr(), imageData->data(), imageData->size());
@@ -184,11 +211,52 @@ void FlatBufferClient::handleImageCommand(const hyperionnet::Image *image)
 		emit setGlobalInputImage(_priority, imageRGB, duration);
 		emit setBufferImage("FlatBuffer", imageRGB);
 	}
+	else if ((reqPtr = image->data_as_SharedImage()) != nullptr)
+	{
+		handleSharedImage(static_cast<const hyperionnet::SharedImage*>(reqPtr), duration);
+		return;
+	}
 
 	// send reply
 	sendSuccessReply();
 }
 
+void FlatBufferClient::handleSharedImage(const hyperionnet::SharedImage *sharedImage, int duration)
+{
+	if (!_isLocal)
+	{
+		sendErrorReply(SharedImageRing::ERROR_NOT_LOCAL);
+		return;
+	}
+
+	// the memory key is only provided when the producer (re)created its segment
+	if (sharedImage->memory() != nullptr && sharedImage->memory()->size() > 0)
+	{
+		const QString key = QString::fromStdString(sharedImage->memory()->str());
+		if (!_sharedImages.isAttached() || _sharedImages.key() != key)
+		{
+			if (!_sharedImages.attach(key))
+			{
+				Error(_log, "Failed to attach shared image memory of client %s", QSTRING_CSTR(_clientAddress));
+				sendErrorReply(SharedImageRing::ERROR_ATTACH);
+				return;
+			}
+			Debug(_log, "Attached shared image memory: %s", QSTRING_CSTR(key));
+		}
+	}
+
+	Image<ColorRgb> imageRGB;
+	if (!_sharedImages.read(sharedImage->slot(), imageRGB))
+	{
+		sendErrorReply("Shared image slot does not contain a valid image");
+		return;
+	}
+
+	emit setGlobalInputImage(_priority, imageRGB, duration);
+	emit setBufferImage("FlatBuffer", imageRGB);
+
+	sendSuccessReply();
+}
 
 void FlatBufferClient::handleClearCommand(const hyperionnet::Clear *clear)
 {
@@ -217,7 +285,15 @@ void FlatBufferClient::sendMessage()
 	uint8_t sizeData[] = {uint8_t(size >> 24), uint8_t(size >> 16), uint8_t(size >> 8), uint8_t(size)};
 	_socket->write((const char *) sizeData, sizeof(sizeData));
 	_socket->write((const char *)buffer, size);
-	_socket->flush();
+
+	if (_isLocal)
+	{
+		static_cast<QLocalSocket*>(_socket)->flush();
+	}
+	else
+	{
+		static_cast<QTcpSocket*>(_socket)->flush();
+	}
 }
 
 void FlatBufferClient::sendSuccessReply()
@@ -7,11 +7,15 @@
 #include <utils/ColorRgba.h>
 #include <utils/Components.h>
 
+#include <flatbufserver/SharedImageRing.h>
+
 // flatbuffer FBS
 #include "hyperion_reply_generated.h"
 #include "hyperion_request_generated.h"
 
+class QIODevice;
 class QTcpSocket;
+class QLocalSocket;
 class QTimer;
 
 namespace flatbuf {
@@ -33,6 +37,14 @@ public:
 	///
 	explicit FlatBufferClient(QTcpSocket* socket, int timeout, QObject *parent = nullptr);
 
+	///
+	/// @brief Construct the client of a local connection, which can provide images via shared memory
+	/// @param socket   The local socket
+	/// @param timeout  The timeout when a client is automatically disconnected and the priority unregistered
+	/// @param parent   The parent
+	///
+	explicit FlatBufferClient(QLocalSocket* socket, int timeout, QObject *parent = nullptr);
+
 signals:
 	///
 	/// @brief forward register data to HyperionDaemon
@@ -138,16 +150,33 @@ private:
 	///
 	void sendErrorReply(const std::string & error);
 
+	///
+	/// Handle an image provided via shared memory
+	///
+	/// @param sharedImage the incoming image reference
+	/// @param duration the duration of the image
+	///
+	void handleSharedImage(const hyperionnet::SharedImage *sharedImage, int duration);
+
+	///
+	/// Setup timer and socket connections
+	///
+	void init();
+
 private:
 	Logger *_log;
-	QTcpSocket *_socket;
+	QIODevice *_socket;
 	const QString _clientAddress;
+	const bool _isLocal;
 	QTimer *_timeoutTimer;
 	int _timeout;
 	int _priority;
 
 	QByteArray _receiveBuffer;
 
+	/// Images of local clients
+	SharedImageRing _sharedImages;
+
 	// Flatbuffers builder
 	flatbuffers::FlatBufferBuilder _builder;
 };
@@ -13,6 +13,10 @@
 
 FlatBufferConnection::FlatBufferConnection(const QString& origin, const QString& host, int priority, bool skipReply, quint16 port)
 	: _socket()
+	, _localSocket()
+	, _useLocalSocket(false)
+	, _isLocalHost(false)
+	, _sharedImagesEnabled(true)
 	, _origin(origin)
 	, _priority(priority)
 	, _host(host)
@@ -20,10 +24,28 @@ FlatBufferConnection::FlatBufferConnection(const QString& origin, const QString&
 	, _prevSocketState(QAbstractSocket::UnconnectedState)
 	, _log(Logger::getInstance("FLATBUFCONN"))
 	, _registered(false)
+	, _skipReply(skipReply)
 {
 	if(!skipReply)
 		connect(&_socket, &QTcpSocket::readyRead, this, &FlatBufferConnection::readData, Qt::UniqueConnection);
 
+	// replies of a local server are always evaluated, to fall back to serialised images if shared memory is refused
+	connect(&_localSocket, &QLocalSocket::readyRead, this, &FlatBufferConnection::readData, Qt::UniqueConnection);
+
+	connect(&_socket, &QTcpSocket::bytesWritten, this, &FlatBufferConnection::handleBytesWritten);
+	connect(&_localSocket, &QLocalSocket::bytesWritten, this, &FlatBufferConnection::handleBytesWritten);
+
+	connect(&_localSocket, &QLocalSocket::connected, this, &FlatBufferConnection::handleLocalSocketConnected);
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 15, 0))
+	connect(&_localSocket, &QLocalSocket::errorOccurred, this, &FlatBufferConnection::handleLocalSocketError);
+#else
+	connect(&_localSocket, static_cast<void (QLocalSocket::*)(QLocalSocket::LocalSocketError)>(&QLocalSocket::error), this, &FlatBufferConnection::handleLocalSocketError);
+#endif
+
+	// a server on the same host is connected via its local socket
+	const QHostAddress address(_host);
+	_isLocalHost = (_host.compare("localhost", Qt::CaseInsensitive) == 0 || address == QHostAddress::LocalHost || address == QHostAddress::LocalHostIPv6);
+
 	// init connect
 	Info(_log, "Connecting to Hyperion: %s:%u", QSTRING_CSTR(_host), _port);
 	connectToHost();
@@ -40,11 +62,12 @@ FlatBufferConnection::~FlatBufferConnection()
 	Debug(_log, "Closing connection to: %s:%u", QSTRING_CSTR(_host), _port);
 	_timer.stop();
 	_socket.close();
+	_localSocket.close();
 }
 
 void FlatBufferConnection::readData()
 {
-	_receiveBuffer += _socket.readAll();
+	_receiveBuffer += _useLocalSocket ? _localSocket.readAll() : _socket.readAll();
 
 	// check if we can read a header
 	while(_receiveBuffer.size() >= 4)
@@ -74,8 +97,22 @@ void FlatBufferConnection::readData()
 	}
 }
 
+void FlatBufferConnection::handleBytesWritten()
+{
+	if (isWriteBufferEmpty())
+	{
+		emit writeBufferEmpty();
+	}
+}
+
+bool FlatBufferConnection::isWriteBufferEmpty() const
+{
+	return (_useLocalSocket ? _localSocket.bytesToWrite() : _socket.bytesToWrite()) == 0;
+}
+
 void FlatBufferConnection::setSkipReply(bool skip)
 {
+	_skipReply = skip;
 	if(skip)
 		disconnect(&_socket, &QTcpSocket::readyRead, 0, 0);
 	else
@@ -88,18 +125,7 @@ void FlatBufferConnection::setRegister(const QString& origin, int priority)
 	auto req = hyperionnet::CreateRequest(_builder, hyperionnet::Command_Register, registerReq.Union());
 
 	_builder.Finish(req);
-	uint32_t size = _builder.GetSize();
-	const uint8_t header[] = {
-		uint8_t((size >> 24) & 0xFF),
-		uint8_t((size >> 16) & 0xFF),
-		uint8_t((size >>  8) & 0xFF),
-		uint8_t((size	  ) & 0xFF)};
-
-	// write message
-	int count = 0;
-	count += _socket.write(reinterpret_cast<const char *>(header), 4);
-	count += _socket.write(reinterpret_cast<const char *>(_builder.GetBufferPointer()), size);
-	_socket.flush();
+	writeMessage(_builder.GetBufferPointer(), _builder.GetSize());
 	_builder.Clear();
 }
 
@@ -115,6 +141,36 @@ void FlatBufferConnection::setColor(const ColorRgb & color, int priority, int du
 
 void FlatBufferConnection::setImage(const Image<ColorRgb> &image)
 {
+	if (_useLocalSocket && _sharedImagesEnabled && _registered && socketState() == QAbstractSocket::ConnectedState)
+	{
+		const int slot = _sharedImages.write(image);
+		if (slot < 0)
+		{
+			if (!_sharedImages.isAttached())
+			{
+				Warning(_log, "Failed to create shared image memory, images are serialised");
+				_sharedImagesEnabled = false;
+			}
+			// otherwise Hyperion is busy with the previous images, skip this one
+			return;
+		}
+
+		// announce the memory only if it was (re)created
+		flatbuffers::Offset<flatbuffers::String> memory;
+		if (_sharedImages.takeKeyChanged())
+		{
+			memory = _builder.CreateString(QSTRING_CSTR(_sharedImages.key()));
+		}
+		auto sharedImg = hyperionnet::CreateSharedImage(_builder, memory, slot);
+		auto imageReq = hyperionnet::CreateImage(_builder, hyperionnet::ImageType_SharedImage, sharedImg.Union(), -1);
+		auto req = hyperionnet::CreateRequest(_builder, hyperionnet::Command_Image, imageReq.Union());
+
+		_builder.Finish(req);
+		writeMessage(_builder.GetBufferPointer(), _builder.GetSize());
+		_builder.Clear();
+		return;
+	}
+
 	auto imgData = _builder.CreateVector(reinterpret_cast<const uint8_t*>(image.memptr()), image.size());
 	auto rawImg = hyperionnet::CreateRawImage(_builder, imgData, image.width(), image.height());
 	auto imageReq = hyperionnet::CreateImage(_builder, hyperionnet::ImageType_RawImage, rawImg.Union(), -1);
@@ -142,34 +198,91 @@ void FlatBufferConnection::clearAll()
 
 void FlatBufferConnection::connectToHost()
 {
+	// prefer the local socket of a server on the same host, the TCP connection is tried if the local one fails
+	if (_isLocalHost && _socket.state() == QAbstractSocket::UnconnectedState && _localSocket.state() == QLocalSocket::UnconnectedState)
+	{
+		_useLocalSocket = false;
+		_localSocket.connectToServer(SharedImageRing::localServerName(_port));
+		return;
+	}
+
 	// try connection only when
+	if (!_useLocalSocket && _socket.state() == QAbstractSocket::UnconnectedState)
+	   _socket.connectToHost(_host, _port);
+}
+
+void FlatBufferConnection::handleLocalSocketConnected()
+{
+	_useLocalSocket = true;
+}
+
+void FlatBufferConnection::handleLocalSocketError(QLocalSocket::LocalSocketError error)
+{
+	// server does not provide a local socket or it was closed, continue via TCP
+	Debug(_log, "Local socket to Hyperion not available (%d), using TCP", static_cast<int>(error));
+	_localSocket.abort();
+	_useLocalSocket = false;
+
 	if (_socket.state() == QAbstractSocket::UnconnectedState)
 	   _socket.connectToHost(_host, _port);
 }
 
+QAbstractSocket::SocketState FlatBufferConnection::socketState() const
+{
+	// the local socket states correspond to QAbstractSocket::SocketState
+	return _useLocalSocket ? static_cast<QAbstractSocket::SocketState>(_localSocket.state()) : _socket.state();
+}
+
+void FlatBufferConnection::writeMessage(const uint8_t* buffer, uint32_t size)
+{
+	const uint8_t header[] = {
+		uint8_t((size >> 24) & 0xFF),
+		uint8_t((size >> 16) & 0xFF),
+		uint8_t((size >>  8) & 0xFF),
+		uint8_t((size	  ) & 0xFF)};
+
+	// write message
+	if (_useLocalSocket)
+	{
+		_localSocket.write(reinterpret_cast<const char *>(header), 4);
+		_localSocket.write(reinterpret_cast<const char *>(buffer), size);
+		_localSocket.flush();
+	}
+	else
+	{
+		_socket.write(reinterpret_cast<const char *>(header), 4);
+		_socket.write(reinterpret_cast<const char *>(buffer), size);
+		_socket.flush();
+	}
+}
+
 void FlatBufferConnection::sendMessage(const uint8_t* buffer, uint32_t size)
 {
+	const QAbstractSocket::SocketState state = socketState();
+
 	// print out connection message only when state is changed
-	if (_socket.state() != _prevSocketState )
+	if (state != _prevSocketState )
 	{
 		_registered = false;
-		switch (_socket.state() )
+		// a new server connection requires a new shared memory announcement
+		_sharedImages.detach();
+		switch (state)
 		{
 			case QAbstractSocket::UnconnectedState:
 				Info(_log, "No connection to Hyperion: %s:%u", QSTRING_CSTR(_host), _port);
 				break;
 			case QAbstractSocket::ConnectedState:
-				Info(_log, "Connected to Hyperion: %s:%u", QSTRING_CSTR(_host), _port);
+				Info(_log, "Connected to Hyperion: %s:%u%s", QSTRING_CSTR(_host), _port, _useLocalSocket ? " (local socket)" : "");
 				break;
 			default:
 				Debug(_log, "Connecting to Hyperion: %s:%u", QSTRING_CSTR(_host), _port);
 				break;
 	  }
-	  _prevSocketState = _socket.state();
+	  _prevSocketState = state;
 	}
 
 
-	if (_socket.state() != QAbstractSocket::ConnectedState)
+	if (state != QAbstractSocket::ConnectedState)
 		return;
 
 	if(!_registered)
@@ -178,17 +291,12 @@ void FlatBufferConnection::sendMessage(const uint8_t* buffer, uint32_t size)
 		return;
 	}
 
-	const uint8_t header[] = {
-		uint8_t((size >> 24) & 0xFF),
-		uint8_t((size >> 16) & 0xFF),
-		uint8_t((size >>  8) & 0xFF),
-		uint8_t((size	  ) & 0xFF)};
+	writeMessage(buffer, size);
+}
 
-	// write message
-	int count = 0;
-	count += _socket.write(reinterpret_cast<const char *>(header), 4);
-	count += _socket.write(reinterpret_cast<const char *>(buffer), size);
-	_socket.flush();
+bool FlatBufferConnection::isSharedImageRefused(const std::string& error)
+{
+	return error == SharedImageRing::ERROR_NOT_LOCAL || error == SharedImageRing::ERROR_ATTACH;
 }
 
 bool FlatBufferConnection::parseReply(const hyperionnet::Reply *reply)
@@ -212,6 +320,17 @@ bool FlatBufferConnection::parseReply(const hyperionnet::Reply *reply)
 
 		return true;
 	}
+	else if (_useLocalSocket && _sharedImagesEnabled && isSharedImageRefused(reply->error()->str()))
+	{
+		// e.g. the shared memory cannot be accessed by Hyperion running as a different user
+		Warning(_log, "Hyperion refused a shared memory image (%s), images are serialised", reply->error()->c_str());
+		_sharedImagesEnabled = false;
+		_sharedImages.detach();
+	}
+	else if (_useLocalSocket && _skipReply)
+	{
+		Error(_log, "Reply error: %s", reply->error()->c_str());
+	}
 	else
 		throw std::runtime_error(reply->error()->str());
 
@@ -5,11 +5,14 @@
 // util
 #include <utils/NetOrigin.h>
 #include <utils/GlobalSignals.h>
+#include <flatbufserver/SharedImageRing.h>
 
 // qt
 #include <QJsonObject>
 #include <QTcpServer>
 #include <QTcpSocket>
+#include <QLocalServer>
+#include <QLocalSocket>
 
 // Constants
 namespace {
@@ -21,6 +24,7 @@ const char SERVICE_TYPE[] = "flatbuffer";
 FlatBufferServer::FlatBufferServer(const QJsonDocument& config, QObject* parent)
 	: QObject(parent)
 	, _server(new QTcpServer(this))
+	, _localServer(new QLocalServer(this))
 	, _log(Logger::getInstance("FLATBUFSERVER"))
 	, _timeout(5000)
 	, _config(config)
@@ -38,6 +42,7 @@ void FlatBufferServer::initServer()
 {
 	_netOrigin = NetOrigin::getInstance();
 	connect(_server, &QTcpServer::newConnection, this, &FlatBufferServer::newConnection);
+	connect(_localServer, &QLocalServer::newConnection, this, &FlatBufferServer::newLocalConnection);
 
 	// apply config
 	handleSettingsUpdate(settings::FLATBUFSERVER, _config);
@@ -74,16 +79,7 @@ void FlatBufferServer::newConnection()
 			if(_netOrigin->accessAllowed(socket->peerAddress(), socket->localAddress()))
 			{
 				Debug(_log, "New connection from %s", QSTRING_CSTR(socket->peerAddress().toString()));
-				FlatBufferClient *client = new FlatBufferClient(socket, _timeout, this);
-				// internal
-				connect(client, &FlatBufferClient::clientDisconnected, this, &FlatBufferServer::clientDisconnected);
-				connect(client, &FlatBufferClient::registerGlobalInput, GlobalSignals::getInstance(), &GlobalSignals::registerGlobalInput);
-				connect(client, &FlatBufferClient::clearGlobalInput, GlobalSignals::getInstance(), &GlobalSignals::clearGlobalInput);
-				connect(client, &FlatBufferClient::setGlobalInputImage, GlobalSignals::getInstance(), &GlobalSignals::setGlobalImage);
-				connect(client, &FlatBufferClient::setGlobalInputColor, GlobalSignals::getInstance(), &GlobalSignals::setGlobalColor);
-				connect(client, &FlatBufferClient::setBufferImage, GlobalSignals::getInstance(), &GlobalSignals::setBufferImage);
-				connect(GlobalSignals::getInstance(), &GlobalSignals::globalRegRequired, client, &FlatBufferClient::registationRequired);
-				_openConnections.append(client);
+				setupClient(new FlatBufferClient(socket, _timeout, this));
 			}
 			else
 				socket->close();
@@ -91,6 +87,37 @@ void FlatBufferServer::newConnection()
 	}
 }
 
+void FlatBufferServer::newLocalConnection()
+{
+	while(_localServer->hasPendingConnections())
+	{
+		if(QLocalSocket* socket = _localServer->nextPendingConnection())
+		{
+			// A local socket is reachable from the same host only, i.e. the peer is subject to the same policy as a TCP client via loopback
+			if(_netOrigin->accessAllowed(QHostAddress(QHostAddress::LocalHost), QHostAddress(QHostAddress::LocalHost)))
+			{
+				Debug(_log, "New local connection");
+				setupClient(new FlatBufferClient(socket, _timeout, this));
+			}
+			else
+				socket->close();
+		}
+	}
+}
+
+void FlatBufferServer::setupClient(FlatBufferClient* client)
+{
+	// internal
+	connect(client, &FlatBufferClient::clientDisconnected, this, &FlatBufferServer::clientDisconnected);
+	connect(client, &FlatBufferClient::registerGlobalInput, GlobalSignals::getInstance(), &GlobalSignals::registerGlobalInput);
+	connect(client, &FlatBufferClient::clearGlobalInput, GlobalSignals::getInstance(), &GlobalSignals::clearGlobalInput);
+	connect(client, &FlatBufferClient::setGlobalInputImage, GlobalSignals::getInstance(), &GlobalSignals::setGlobalImage);
+	connect(client, &FlatBufferClient::setGlobalInputColor, GlobalSignals::getInstance(), &GlobalSignals::setGlobalColor);
+	connect(client, &FlatBufferClient::setBufferImage, GlobalSignals::getInstance(), &GlobalSignals::setBufferImage);
+	connect(GlobalSignals::getInstance(), &GlobalSignals::globalRegRequired, client, &FlatBufferClient::registationRequired);
+	_openConnections.append(client);
+}
+
 void FlatBufferServer::clientDisconnected()
 {
 	FlatBufferClient* client = qobject_cast<FlatBufferClient*>(sender());
@@ -113,6 +140,17 @@ void FlatBufferServer::startServer()
 			emit publishService(SERVICE_TYPE, _port);
 		}
 	}
+
+	// local clients negotiate shared memory images via the local socket
+	if(!_localServer->isListening())
+	{
+		const QString name = SharedImageRing::localServerName(_port);
+		QLocalServer::removeServer(name);
+		if(!_localServer->listen(name))
+		{
+			Warning(_log,"Failed to start local server '%s': %s", QSTRING_CSTR(name), QSTRING_CSTR(_localServer->errorString()));
+		}
+	}
 }
 
 void FlatBufferServer::stopServer()
@@ -125,6 +163,7 @@ void FlatBufferServer::stopServer()
 			client->forceClose();
 		}
 		_server->close();
+		_localServer->close();
 		Info(_log, "FlatBuffer-Server stopped");
 	}
 }
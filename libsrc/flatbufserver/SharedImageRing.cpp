@@ -0,0 +1,245 @@
+#include <flatbufserver/SharedImageRing.h>
+
+// stl includes
+#include <atomic>
+#include <cstring>
+#include <new>
+
+// Qt includes
+#include <QCoreApplication>
+
+namespace {
+
+const uint32_t RING_MAGIC = 0x48594952; // "HYIR"
+const uint32_t RING_VERSION = 1;
+
+constexpr size_t ALIGNMENT = 64;
+
+enum SlotState : uint32_t
+{
+	SLOT_FREE = 0,
+	SLOT_WRITING,
+	SLOT_READY,
+	SLOT_READING
+};
+
+struct RingHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t slotCount;
+	uint32_t slotCapacity;
+};
+
+struct alignas(ALIGNMENT) SlotHeader
+{
+	std::atomic<uint32_t> state;
+	int32_t width;
+	int32_t height;
+	uint32_t size;
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Slot state must be lock-free to be shared between processes");
+
+constexpr size_t alignUp(size_t value)
+{
+	return (value + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+constexpr size_t HEADER_SIZE = alignUp(sizeof(RingHeader));
+constexpr size_t SLOT_HEADERS_SIZE = SharedImageRing::SLOT_COUNT * sizeof(SlotHeader);
+
+size_t segmentSize(size_t slotCapacity)
+{
+	return HEADER_SIZE + SLOT_HEADERS_SIZE + SharedImageRing::SLOT_COUNT * slotCapacity;
+}
+
+SlotHeader* slotHeader(void* memory, int slot)
+{
+	return reinterpret_cast<SlotHeader*>(static_cast<uint8_t*>(memory) + HEADER_SIZE) + slot;
+}
+
+uint8_t* slotData(void* memory, size_t slotCapacity, int slot)
+{
+	return static_cast<uint8_t*>(memory) + HEADER_SIZE + SLOT_HEADERS_SIZE + slot * slotCapacity;
+}
+
+} // End of constants
+
+SharedImageRing::SharedImageRing()
+	: _slotCapacity(0)
+	, _nextSlot(0)
+	, _keyChanged(false)
+{
+}
+
+SharedImageRing::~SharedImageRing()
+{
+	detach();
+}
+
+bool SharedImageRing::create(size_t slotCapacity)
+{
+	detach();
+
+	static int segmentCounter = 0;
+	_memory.setKey(QString("hyperion-image-%1-%2").arg(QCoreApplication::applicationPid()).arg(++segmentCounter));
+
+	const size_t capacity = alignUp(slotCapacity);
+	if (!_memory.create(static_cast<int>(segmentSize(capacity))))
+	{
+		return false;
+	}
+
+	void* memory = _memory.data();
+	for (int slot = 0; slot < SLOT_COUNT; ++slot)
+	{
+		SlotHeader* header = new (slotHeader(memory, slot)) SlotHeader();
+		header->state.store(SLOT_FREE, std::memory_order_relaxed);
+	}
+
+	RingHeader* header = static_cast<RingHeader*>(memory);
+	header->slotCount = SLOT_COUNT;
+	header->slotCapacity = static_cast<uint32_t>(capacity);
+	header->version = RING_VERSION;
+	std::atomic_thread_fence(std::memory_order_release);
+	header->magic = RING_MAGIC;
+
+	_slotCapacity = capacity;
+	_nextSlot = 0;
+	_keyChanged = true;
+	return true;
+}
+
+int SharedImageRing::write(const Image<ColorRgb>& image)
+{
+	const size_t size = static_cast<size_t>(image.size());
+	if (size == 0)
+	{
+		return -1;
+	}
+
+	if (!_memory.isAttached() || size > _slotCapacity)
+	{
+		if (!create(size))
+		{
+			return -1;
+		}
+	}
+
+	void* memory = _memory.data();
+	for (int i = 0; i < SLOT_COUNT; ++i)
+	{
+		const int slot = (_nextSlot + i) % SLOT_COUNT;
+		SlotHeader* header = slotHeader(memory, slot);
+
+		uint32_t expected = SLOT_FREE;
+		if (header->state.compare_exchange_strong(expected, SLOT_WRITING, std::memory_order_acquire))
+		{
+			memcpy(slotData(memory, _slotCapacity, slot), image.memptr(), size);
+			header->width = static_cast<int32_t>(image.width());
+			header->height = static_cast<int32_t>(image.height());
+			header->size = static_cast<uint32_t>(size);
+			header->state.store(SLOT_READY, std::memory_order_release);
+
+			_nextSlot = (slot + 1) % SLOT_COUNT;
+			return slot;
+		}
+	}
+
+	// consumer did not keep up, drop the image
+	return -1;
+}
+
+bool SharedImageRing::takeKeyChanged()
+{
+	const bool changed = _keyChanged;
+	_keyChanged = false;
+	return changed;
+}
+
+bool SharedImageRing::attach(const QString& key)
+{
+	detach();
+
+	_memory.setKey(key);
+	if (!_memory.attach())
+	{
+		return false;
+	}
+
+	const RingHeader* header = static_cast<const RingHeader*>(_memory.constData());
+	if (static_cast<size_t>(_memory.size()) < HEADER_SIZE
+		|| header->magic != RING_MAGIC
+		|| header->version != RING_VERSION
+		|| header->slotCount != SLOT_COUNT
+		|| static_cast<size_t>(_memory.size()) < segmentSize(header->slotCapacity))
+	{
+		detach();
+		return false;
+	}
+
+	_slotCapacity = header->slotCapacity;
+	return true;
+}
+
+bool SharedImageRing::read(int slot, Image<ColorRgb>& image)
+{
+	if (!_memory.isAttached() || slot < 0 || slot >= SLOT_COUNT)
+	{
+		return false;
+	}
+
+	void* memory = _memory.data();
+	SlotHeader* header = slotHeader(memory, slot);
+
+	uint32_t expected = SLOT_READY;
+	if (!header->state.compare_exchange_strong(expected, SLOT_READING, std::memory_order_acquire))
+	{
+		return false;
+	}
+
+	const int width = header->width;
+	const int height = header->height;
+	const size_t size = header->size;
+
+	bool valid = width > 0 && height > 0 && size <= _slotCapacity && size == static_cast<size_t>(width) * height * sizeof(ColorRgb);
+	if (valid)
+	{
+		image.resize(width, height);
+		memcpy(image.memptr(), slotData(memory, _slotCapacity, slot), size);
+	}
+
+	header->state.store(SLOT_FREE, std::memory_order_release);
+	return valid;
+}
+
+void SharedImageRing::releaseSlots()
+{
+	if (!_memory.isAttached())
+	{
+		return;
+	}
+
+	void* memory = _memory.data();
+	for (int slot = 0; slot < SLOT_COUNT; ++slot)
+	{
+		// Slots being written are released by the producer
+		SlotHeader* header = slotHeader(memory, slot);
+		uint32_t expected = SLOT_READY;
+		if (!header->state.compare_exchange_strong(expected, SLOT_FREE, std::memory_order_acq_rel))
+		{
+			expected = SLOT_READING;
+			header->state.compare_exchange_strong(expected, SLOT_FREE, std::memory_order_acq_rel);
+		}
+	}
+}
+
+void SharedImageRing::detach()
+{
+	if (_memory.isAttached())
+	{
+		_memory.detach();
+	}
+	_slotCapacity = 0;
+}
@@ -0,0 +1,252 @@
+// STL includes
+#include <algorithm>
+#include <chrono>
+
+// project includes
+#include "JsonForwardClient.h"
+
+// qt includes
+#include <QTcpSocket>
+
+// Constants
+namespace {
+
+// Max. number of messages waiting to be written
+constexpr size_t MAX_QUEUED_MESSAGES = 32;
+// Max. number of messages written without a reply
+constexpr size_t MAX_IN_FLIGHT_MESSAGES = 8;
+// Queued messages older than that are outdated and dropped
+constexpr qint64 MAX_MESSAGE_AGE_MS = 5000;
+// A connection without a reply for that long while messages are in flight is considered broken
+constexpr int REPLY_TIMEOUT_MS = 5000;
+
+constexpr int RECONNECT_DELAY_MIN_MS = 500;
+constexpr int RECONNECT_DELAY_MAX_MS = 30000;
+
+constexpr int REPORT_INTERVAL_MS = 30000;
+// Lag which is reported as warning
+constexpr qint64 LAG_WARNING_MS = 1000;
+
+qint64 nowMs()
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} //End of constants
+
+JsonForwardClient::JsonForwardClient(const TargetHost& target, Logger* log, QObject* parent)
+	: QObject(parent)
+	, _target(target)
+	, _log(log)
+	, _socket(new QTcpSocket(this))
+	, _backoffMs(RECONNECT_DELAY_MIN_MS)
+	, _forwarded(0)
+	, _dropped(0)
+	, _lagSumMs(0)
+	, _lagMaxMs(0)
+	, _lagging(false)
+{
+	_reconnectTimer.setSingleShot(true);
+	_replyTimer.setSingleShot(true);
+	_replyTimer.setInterval(REPLY_TIMEOUT_MS);
+	_reportTimer.setInterval(REPORT_INTERVAL_MS);
+
+	connect(_socket, &QTcpSocket::stateChanged, this, &JsonForwardClient::handleStateChanged);
+	connect(_socket, &QTcpSocket::readyRead, this, &JsonForwardClient::handleReadyRead);
+	connect(_socket, &QTcpSocket::bytesWritten, this, &JsonForwardClient::flush);
+	connect(&_reconnectTimer, &QTimer::timeout, this, &JsonForwardClient::connectToHost);
+	connect(&_replyTimer, &QTimer::timeout, this, &JsonForwardClient::handleReplyTimeout);
+	connect(&_reportTimer, &QTimer::timeout, this, &JsonForwardClient::report);
+
+	_reportTimer.start();
+	connectToHost();
+}
+
+JsonForwardClient::~JsonForwardClient()
+{
+	_reconnectTimer.stop();
+	_replyTimer.stop();
+	_socket->disconnect(this);
+	_socket->abort();
+}
+
+QString JsonForwardClient::targetName() const
+{
+	return QString("%1:%2").arg(_target.host.toString()).arg(_target.port);
+}
+
+void JsonForwardClient::enqueue(const QByteArray& message, const QString& key)
+{
+	const qint64 now = nowMs();
+
+	// a newer command replaces the queued one, e.g. only the latest color of a priority matters
+	if (!key.isEmpty())
+	{
+		auto it = std::find_if(_queue.begin(), _queue.end(), [&key](const Message& queued) { return queued.key == key; });
+		if (it != _queue.end())
+		{
+			_queue.erase(it);
+			++_dropped;
+		}
+	}
+
+	if (_queue.size() >= MAX_QUEUED_MESSAGES)
+	{
+		_queue.pop_front();
+		++_dropped;
+	}
+
+	_queue.push_back({message, key, now});
+	flush();
+}
+
+void JsonForwardClient::flush()
+{
+	if (_socket->state() != QAbstractSocket::ConnectedState)
+	{
+		return;
+	}
+
+	const qint64 now = nowMs();
+
+	while (!_queue.empty() && _inFlight.size() < MAX_IN_FLIGHT_MESSAGES)
+	{
+		Message message = std::move(_queue.front());
+		_queue.pop_front();
+
+		if (now - message.queuedMs > MAX_MESSAGE_AGE_MS)
+		{
+			++_dropped;
+			continue;
+		}
+
+		_socket->write(message.data);
+		_inFlight.push_back(message.queuedMs);
+
+		// a running timer waits for the reply of an older message already
+		if (!_replyTimer.isActive())
+		{
+			_replyTimer.start();
+		}
+	}
+}
+
+void JsonForwardClient::handleReadyRead()
+{
+	_replyBuffer.append(_socket->readAll());
+
+	// every reply is terminated by a newline, a reply might be split across reads
+	const int end = _replyBuffer.lastIndexOf('\n');
+	if (end < 0)
+	{
+		return;
+	}
+
+	int replies = static_cast<int>(_replyBuffer.left(end + 1).count('\n'));
+	_replyBuffer.remove(0, end + 1);
+
+	const qint64 now = nowMs();
+	for (; replies > 0 && !_inFlight.empty(); --replies)
+	{
+		const qint64 lag = now - _inFlight.front();
+		_inFlight.pop_front();
+
+		++_forwarded;
+		_lagSumMs += lag;
+		_lagMaxMs = std::max(_lagMaxMs, lag);
+
+		if (lag > LAG_WARNING_MS && !_lagging)
+		{
+			Warning(_log, "JSON-target %s is lagging behind by %lld ms", QSTRING_CSTR(targetName()), static_cast<long long>(lag));
+			_lagging = true;
+		}
+		else if (lag < LAG_WARNING_MS / 2 && _lagging)
+		{
+			Info(_log, "JSON-target %s caught up, lag %lld ms", QSTRING_CSTR(targetName()), static_cast<long long>(lag));
+			_lagging = false;
+		}
+	}
+
+	// the target is alive, wait for the replies of the remaining messages anew
+	if (_inFlight.empty())
+	{
+		_replyTimer.stop();
+	}
+	else
+	{
+		_replyTimer.start();
+	}
+
+	flush();
+}
+
+void JsonForwardClient::handleReplyTimeout()
+{
+	if (_socket->state() == QAbstractSocket::ConnectedState && !_inFlight.empty())
+	{
+		Warning(_log, "JSON-target %s does not reply, reconnecting", QSTRING_CSTR(targetName()));
+		_socket->abort();
+	}
+}
+
+void JsonForwardClient::handleStateChanged(QAbstractSocket::SocketState state)
+{
+	switch (state)
+	{
+	case QAbstractSocket::ConnectedState:
+		Debug(_log, "Connected to JSON-target %s", QSTRING_CSTR(targetName()));
+		_socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+		_socket->setSocketOption(QAbstractSocket::KeepAliveOption, 1);
+		_backoffMs = RECONNECT_DELAY_MIN_MS;
+		flush();
+		break;
+	case QAbstractSocket::UnconnectedState:
+		// replies to messages written are lost with the connection
+		_replyTimer.stop();
+		_inFlight.clear();
+		_replyBuffer.clear();
+		scheduleReconnect();
+		break;
+	default:
+		break;
+	}
+}
+
+void JsonForwardClient::connectToHost()
+{
+	if (_socket->state() == QAbstractSocket::UnconnectedState)
+	{
+		_socket->connectToHost(_target.host, _target.port);
+	}
+}
+
+void JsonForwardClient::scheduleReconnect()
+{
+	if (_reconnectTimer.isActive())
+	{
+		return;
+	}
+
+	Debug(_log, "JSON-target %s not connected (%s), retry in %d ms", QSTRING_CSTR(targetName()), QSTRING_CSTR(_socket->errorString()), _backoffMs);
+	_reconnectTimer.start(_backoffMs);
+	_backoffMs = std::min(_backoffMs * 2, RECONNECT_DELAY_MAX_MS);
+}
+
+void JsonForwardClient::report()
+{
+	if (_forwarded > 0 || _dropped > 0)
+	{
+		Debug(_log, "JSON-target %s: %d messages forwarded, lag avg %lld ms, max %lld ms, %d dropped, %u queued",
+			  QSTRING_CSTR(targetName()),
+			  _forwarded,
+			  static_cast<long long>(_forwarded > 0 ? _lagSumMs / _forwarded : 0),
+			  static_cast<long long>(_lagMaxMs),
+			  _dropped,
+			  static_cast<unsigned>(_queue.size()));
+	}
+
+	_forwarded = 0;
+	_dropped = 0;
+	_lagSumMs = 0;
+	_lagMaxMs = 0;
+}
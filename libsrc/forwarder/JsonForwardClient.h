@@ -0,0 +1,95 @@
+#pragma once
+
+// STL includes
+#include <deque>
+
+// Qt includes
+#include <QObject>
+#include <QByteArray>
+#include <QString>
+#include <QTimer>
+#include <QAbstractSocket>
+
+// Hyperion includes
+#include <forwarder/MessageForwarder.h>
+#include <utils/Logger.h>
+
+class QTcpSocket;
+
+///
+/// @brief Persistent, non-blocking connection to a JSON forwarding target
+///
+/// Messages are queued and written pipelined, i.e. without waiting for the reply of the previous one.
+/// The queue is bounded: a queued command superseding an older one of the same kind and priority
+/// (e.g. color, effect) replaces it, the oldest messages are dropped if the target does not keep up.
+/// A lost connection is reestablished with an increasing delay.
+///
+class JsonForwardClient : public QObject
+{
+	Q_OBJECT
+
+public:
+	///
+	/// @param target  The target host
+	/// @param log     The logger of the forwarder
+	/// @param parent  The parent object
+	///
+	JsonForwardClient(const TargetHost& target, Logger* log, QObject* parent = nullptr);
+	~JsonForwardClient() override;
+
+	///
+	/// @brief Queue a serialised message and send it as soon as possible
+	///
+	/// @param message  The serialised message (incl. line termination)
+	/// @param key      Messages with the same non-empty key supersede each other while queued
+	///
+	void enqueue(const QByteArray& message, const QString& key);
+
+	/// @return the target as "host:port"
+	QString targetName() const;
+
+private slots:
+	void handleStateChanged(QAbstractSocket::SocketState state);
+	void handleReadyRead();
+	void connectToHost();
+	void handleReplyTimeout();
+	void report();
+
+private:
+	struct Message
+	{
+		QByteArray data;
+		QString key;
+		qint64 queuedMs;
+	};
+
+	///
+	/// @brief Write queued messages as long as the pipeline allows
+	///
+	void flush();
+
+	void scheduleReconnect();
+
+	TargetHost _target;
+	Logger* _log;
+	QTcpSocket* _socket;
+	QTimer _reconnectTimer;
+	/// Runs while messages await their reply, restarted with every reply received
+	QTimer _replyTimer;
+	QTimer _reportTimer;
+	int _backoffMs;
+
+	/// Messages not yet written
+	std::deque<Message> _queue;
+	/// Queue time of the messages written, but not yet replied
+	std::deque<qint64> _inFlight;
+	/// Received data not yet terminated by a newline, i.e. an incomplete reply
+	QByteArray _replyBuffer;
+
+	// statistics since the last report
+	int _forwarded;
+	int _dropped;
+	qint64 _lagSumMs;
+	qint64 _lagMaxMs;
+	bool _lagging;
+};
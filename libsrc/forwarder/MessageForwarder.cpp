@@ -1,8 +1,9 @@
 // STL includes
-#include <chrono>
+#include <algorithm>
 
 // project includes
 #include <forwarder/MessageForwarder.h>
+#include "JsonForwardClient.h"
 
 // hyperion includes
 #include <hyperion/Hyperion.h>
@@ -12,7 +13,6 @@
 #include <utils/NetUtils.h>
 
 // qt includes
-#include <QTcpSocket>
 #include <QHostInfo>
 #include <QNetworkInterface>
 #include <QThread>
@@ -30,7 +30,53 @@ namespace {
 
 const int DEFAULT_FORWARDER_FLATBUFFFER_PRIORITY = 140;
 
-constexpr std::chrono::milliseconds CONNECT_TIMEOUT{500};		 // JSON-socket connect timeout in ms
+///
+/// @brief Downscale an image by an integer factor, so that it does not exceed the given width
+///
+/// Every pixel of the result is the mean of the pixels it covers, which keeps the mean colors the receiving
+/// instance derives for its LEDs.
+///
+Image<ColorRgb> downscaleImage(const Image<ColorRgb>& image, int maxWidth)
+{
+	if (maxWidth <= 0 || image.width() <= maxWidth)
+	{
+		return image;
+	}
+
+	const int factor = (image.width() + maxWidth - 1) / maxWidth;
+	const int width = image.width() / factor;
+	const int height = std::max(image.height() / factor, 1);
+	const int blockHeight = std::min(factor, image.height());
+	const int blockSize = factor * blockHeight;
+
+	Image<ColorRgb> result(width, height, ImageNoInit);
+	std::vector<uint32_t> sums(static_cast<size_t>(width) * 3);
+
+	for (int y = 0; y < height; ++y)
+	{
+		std::fill(sums.begin(), sums.end(), 0);
+		for (int by = 0; by < blockHeight; ++by)
+		{
+			const ColorRgb* line = image.memptr() + static_cast<size_t>(y * blockHeight + by) * image.width();
+			for (int x = 0; x < width * factor; ++x)
+			{
+				uint32_t* sum = &sums[static_cast<size_t>(x / factor) * 3];
+				sum[0] += line[x].red;
+				sum[1] += line[x].green;
+				sum[2] += line[x].blue;
+			}
+		}
+
+		ColorRgb* out = result.memptr() + static_cast<size_t>(y) * width;
+		for (int x = 0; x < width; ++x)
+		{
+			out[x].red   = static_cast<uint8_t>(sums[x * 3]     / blockSize);
+			out[x].green = static_cast<uint8_t>(sums[x * 3 + 1] / blockSize);
+			out[x].blue  = static_cast<uint8_t>(sums[x * 3 + 2] / blockSize);
+		}
+	}
+	return result;
+}
 
 } //End of constants
 
@@ -251,6 +297,8 @@ int MessageForwarder::startJsonTargets(const QJsonObject& config)
 {
 	if (!config["jsonapi"].isNull())
 	{
+		qDeleteAll(_jsonClients);
+		_jsonClients.clear();
 		_jsonTargets.clear();
 		const QJsonArray& addr = config["jsonapi"].toArray();
 
@@ -272,6 +320,7 @@ int MessageForwarder::startJsonTargets(const QJsonObject& config)
 			for (const auto& targetHost : std::as_const(_jsonTargets))
 			{
 				Info(_log, "Forwarding now to JSON-target host: %s port: %u", QSTRING_CSTR(targetHost.host.toString()), targetHost.port);
+				_jsonClients << new JsonForwardClient(targetHost, _log, this);
 			}
 
 			connect(_hyperion, &Hyperion::forwardJsonMessage, this, &MessageForwarder::forwardJsonMessage, Qt::UniqueConnection);
@@ -286,6 +335,8 @@ void MessageForwarder::stopJsonTargets()
 	if (!_jsonTargets.isEmpty())
 	{
 		disconnect(_hyperion, &Hyperion::forwardJsonMessage, nullptr, nullptr);
+		qDeleteAll(_jsonClients);
+		_jsonClients.clear();
 		for (const auto& targetHost : std::as_const(_jsonTargets))
 		{
 			Info(_log, "Stopped forwarding to JSON-target host: %s port: %u", QSTRING_CSTR(targetHost.host.toString()), targetHost.port);
@@ -300,6 +351,7 @@ void MessageForwarder::addFlatbufferTarget(const QJsonObject& targetConfig)
 
 	QString hostName = targetConfig["host"].toString();
 	int port = targetConfig["port"].toInt();
+	int imageWidth = targetConfig["imageWidth"].toInt(0);
 
 	if (!hostName.isEmpty())
 	{
@@ -325,12 +377,12 @@ void MessageForwarder::addFlatbufferTarget(const QJsonObject& targetConfig)
 				{
 					if (_flatbufferTargets.indexOf(targetHost) == -1)
 					{
-						Debug(_log, "Flatbuffer-Forwarder settings: Adding target host: %s port: %u", QSTRING_CSTR(targetHost.host.toString()), targetHost.port);
+						Debug(_log, "Flatbuffer-Forwarder settings: Adding target host: %s port: %u, image width: %d", QSTRING_CSTR(targetHost.host.toString()), targetHost.port, imageWidth);
 						_flatbufferTargets << targetHost;
 
 						if (_messageForwarderFlatBufHelper != nullptr)
 						{
-							emit _messageForwarderFlatBufHelper->addClient("Forwarder", targetHost, _priority, false);
+							emit _messageForwarderFlatBufHelper->addClient("Forwarder", targetHost, _priority, false, imageWidth);
 						}
 					}
 					else
@@ -409,17 +461,29 @@ void MessageForwarder::stopFlatbufferTargets()
 
 void MessageForwarder::forwardJsonMessage(const QJsonObject& message)
 {
-	if (_forwarder_enabled)
+	if (_forwarder_enabled && !_jsonClients.isEmpty())
 	{
-		QTcpSocket client;
-		for (const auto& targetHost : std::as_const(_jsonTargets))
+		// for hyperion classic compatibility
+		QJsonObject jsonMessage = message;
+		if (jsonMessage.contains("tan") && jsonMessage["tan"].isNull())
 		{
-			client.connectToHost(targetHost.host, targetHost.port);
-			if (client.waitForConnected(CONNECT_TIMEOUT.count()))
-			{
-				sendJsonMessage(message, &client);
-				client.close();
-			}
+			jsonMessage["tan"] = 100;
+		}
+
+		// serialize message once for all targets
+		const QByteArray serializedMessage = QJsonDocument(jsonMessage).toJson(QJsonDocument::Compact) + "\n";
+
+		// a newer color or effect of the same priority supersedes a queued one
+		QString key;
+		const QString command = jsonMessage["command"].toString();
+		if (command == "color" || command == "effect")
+		{
+			key = command + ":" + QString::number(jsonMessage["priority"].toInt());
+		}
+
+		for (JsonForwardClient* client : std::as_const(_jsonClients))
+		{
+			client->enqueue(serializedMessage, key);
 		}
 	}
 }
@@ -437,52 +501,6 @@ void MessageForwarder::forwardFlatbufferMessage(const QString& /*name*/, const I
 	}
 }
 
-void MessageForwarder::sendJsonMessage(const QJsonObject& message, QTcpSocket* socket)
-{
-	// for hyperion classic compatibility
-	QJsonObject jsonMessage = message;
-	if (jsonMessage.contains("tan") && jsonMessage["tan"].isNull())
-	{
-		jsonMessage["tan"] = 100;
-	}
-
-	// serialize message
-	QJsonDocument writer(jsonMessage);
-	QByteArray serializedMessage = writer.toJson(QJsonDocument::Compact) + "\n";
-
-	// write message
-	socket->write(serializedMessage);
-	if (!socket->waitForBytesWritten())
-	{
-		Debug(_log, "Error while writing data to host");
-		return;
-	}
-
-	// read reply data
-	QByteArray serializedReply;
-	while (!serializedReply.contains('\n'))
-	{
-		// receive reply
-		if (!socket->waitForReadyRead())
-		{
-			Debug(_log, "Error while writing data from host");
-			return;
-		}
-
-		serializedReply += socket->readAll();
-	}
-
-	// parse reply data
-	QJsonParseError error;
-	/* QJsonDocument reply = */ QJsonDocument::fromJson(serializedReply, &error);
-
-	if (error.error != QJsonParseError::NoError)
-	{
-		Error(_log, "Error while parsing reply: invalid JSON");
-		return;
-	}
-}
-
 MessageForwarderFlatbufferClientsHelper::MessageForwarderFlatbufferClientsHelper()
 {
 	QThread* mainThread = new QThread();
@@ -500,7 +518,10 @@ MessageForwarderFlatbufferClientsHelper::~MessageForwarderFlatbufferClientsHelpe
 	_free=false;
 	while (!_forwardClients.isEmpty())
 	{
-		_forwardClients.takeFirst()->deleteLater();
+		ForwardTarget* target = _forwardClients.takeFirst();
+		target->connection->disconnect(this);
+		target->connection->deleteLater();
+		delete target;
 	}
 
 
@@ -511,10 +532,16 @@ MessageForwarderFlatbufferClientsHelper::~MessageForwarderFlatbufferClientsHelpe
 	delete oldThread;
 }
 
-void MessageForwarderFlatbufferClientsHelper::addClientHandler(const QString& origin, const TargetHost& targetHost, int priority, bool skipReply)
+void MessageForwarderFlatbufferClientsHelper::addClientHandler(const QString& origin, const TargetHost& targetHost, int priority, bool skipReply, int imageWidth)
 {
-	FlatBufferConnection* flatbuf = new FlatBufferConnection(origin, targetHost.host.toString(), priority, skipReply, targetHost.port);
-	_forwardClients << flatbuf;
+	ForwardTarget* target = new ForwardTarget();
+	target->connection = new FlatBufferConnection(origin, targetHost.host.toString(), priority, skipReply, targetHost.port);
+	target->imageWidth = imageWidth;
+	target->hasPendingImage = false;
+
+	connect(target->connection, &FlatBufferConnection::writeBufferEmpty, this, [this, target]() { sendPendingImage(target); });
+
+	_forwardClients << target;
 	_free = true;
 }
 
@@ -522,7 +549,9 @@ void MessageForwarderFlatbufferClientsHelper::clearClientsHandler()
 {
 	while (!_forwardClients.isEmpty())
 	{
-		delete _forwardClients.takeFirst();
+		ForwardTarget* target = _forwardClients.takeFirst();
+		delete target->connection;
+		delete target;
 	}
 	_free = false;
 }
@@ -536,10 +565,35 @@ void MessageForwarderFlatbufferClientsHelper::forwardImage(const Image<ColorRgb>
 {
 	_free = false;
 
-	for (int i = 0; i < _forwardClients.size(); i++)
+	// targets with the same image width share the downscaled image
+	std::map<int, Image<ColorRgb>> scaledImages;
+
+	for (ForwardTarget* target : std::as_const(_forwardClients))
 	{
-		_forwardClients.at(i)->setImage(image);
+		auto it = scaledImages.find(target->imageWidth);
+		if (it == scaledImages.end())
+		{
+			it = scaledImages.emplace(target->imageWidth, downscaleImage(image, target->imageWidth)).first;
+		}
+
+		// the latest image replaces one still waiting for the target
+		target->pendingImage = it->second;
+		target->hasPendingImage = true;
+
+		if (target->connection->isWriteBufferEmpty())
+		{
+			sendPendingImage(target);
+		}
 	}
 
 	_free = true;
 }
+
+void MessageForwarderFlatbufferClientsHelper::sendPendingImage(ForwardTarget* target)
+{
+	if (target->hasPendingImage)
+	{
+		target->hasPendingImage = false;
+		target->connection->setImage(target->pendingImage);
+	}
+}
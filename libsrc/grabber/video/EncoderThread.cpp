@@ -318,7 +318,7 @@ void EncoderThread::processImageMjpeg()
 		}
 	}
 
-	Image<ColorRgb> srcImage(_width, _height);
+	Image<ColorRgb> srcImage(_width, _height, ImageNoInit);
 
 	if (tjDecompress2(_tjInstance, _localData , _size,
 					  reinterpret_cast<unsigned char*>(srcImage.memptr()), _width, 0, _height,
@@ -4,9 +4,25 @@
 #include <xcb/randr.h>
 #include <xcb/xcb_event.h>
 
+// STL includes
+#include <chrono>
+#include <cmath>
+
 // Constants
 namespace {
 	const bool verbose = false;
+
+	// Without damage the last image is reused, but the screen is grabbed completely at least that often,
+	// which covers content not reporting damage (e.g. some video overlays)
+	constexpr qint64 FULL_GRAB_INTERVAL_MS = 1000;
+	// Share of the screen up to which only the damaged areas are updated
+	constexpr double PARTIAL_GRAB_MAX_AREA = 0.5;
+	constexpr qint64 REPORT_INTERVAL_MS = 60000;
+
+	qint64 nowMs()
+	{
+		return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
 } //End of constants
 
 X11Grabber::X11Grabber(int cropLeft, int cropRight, int cropTop, int cropBottom)
@@ -25,7 +41,19 @@ X11Grabber::X11Grabber(int cropLeft, int cropRight, int cropTop, int cropBottom)
 	, _xShmAvailable(false)
 	, _xRenderAvailable(false)
 	, _xRandRAvailable(false)
+	, _xDamageAvailable(false)
 	, _isWayland (false)
+#ifdef HAVE_XDAMAGE
+	, _damage(None)
+	, _damageRegion(None)
+	, _xDamageEventBase(0)
+#endif
+	, _fullRefresh(true)
+	, _lastFullGrabTime(0)
+	, _lastReportTime(nowMs())
+	, _fullFrames(0)
+	, _partialFrames(0)
+	, _skippedFrames(0)
 	, _logger{}
 {
 	_useImageResampler = false;
@@ -66,6 +94,15 @@ void X11Grabber::freeResources()
 		XRenderFreePicture(_x11Display, _dstPicture);
 		XFreePixmap(_x11Display, _pixmap);
 	}
+#ifdef HAVE_XDAMAGE
+	if (_damage != None)
+	{
+		XDamageDestroy(_x11Display, _damage);
+		XFixesDestroyRegion(_x11Display, _damageRegion);
+		_damage = None;
+		_damageRegion = None;
+	}
+#endif
 }
 
 void X11Grabber::setupResources()
@@ -112,6 +149,15 @@ void X11Grabber::setupResources()
 		_imageResampler.setHorizontalPixelDecimation(_pixelDecimation);
 		_imageResampler.setVerticalPixelDecimation(_pixelDecimation);
 	}
+
+#ifdef HAVE_XDAMAGE
+	if (_xDamageAvailable)
+	{
+		_damage = XDamageCreate(_x11Display, _window, XDamageReportNonEmpty);
+		_damageRegion = XFixesCreateRegion(_x11Display, nullptr, 0);
+	}
+#endif
+	_fullRefresh = true;
 }
 
 bool X11Grabber::open()
@@ -168,11 +214,23 @@ bool X11Grabber::setupDisplay()
 		XShmQueryVersion(_x11Display, &dummy, &dummy, &pixmaps_supported);
 		_xShmPixmapAvailable = (pixmaps_supported != 0) && XShmPixmapFormat(_x11Display) == ZPixmap;
 
-		Info(_log, "%s", QSTRING_CSTR(QString("XRandR=[%1] XRender=[%2] XShm=[%3] XPixmap=[%4]")
+#ifdef HAVE_XDAMAGE
+		int damageMajor = 0;
+		int damageMinor = 0;
+		int fixesMajor = 0;
+		int fixesMinor = 0;
+		_xDamageAvailable = (XDamageQueryExtension(_x11Display, &_xDamageEventBase, &dummy) != 0)
+				&& (XDamageQueryVersion(_x11Display, &damageMajor, &damageMinor) != 0)
+				&& (XFixesQueryExtension(_x11Display, &dummy, &dummy) != 0)
+				&& (XFixesQueryVersion(_x11Display, &fixesMajor, &fixesMinor) != 0) && fixesMajor >= 2;
+#endif
+
+		Info(_log, "%s", QSTRING_CSTR(QString("XRandR=[%1] XRender=[%2] XShm=[%3] XPixmap=[%4] XDamage=[%5]")
 			 .arg(_xRandRAvailable     ? "available" : "unavailable",
 			 _xRenderAvailable    ? "available" : "unavailable",
 			 _xShmAvailable       ? "available" : "unavailable",
-			 _xShmPixmapAvailable ? "available" : "unavailable"))
+			 _xShmPixmapAvailable ? "available" : "unavailable",
+			 _xDamageAvailable    ? "available" : "unavailable"))
 			 );
 
 		result = (updateScreenDimensions(true) >=0);
@@ -192,6 +250,30 @@ int X11Grabber::grabFrame(Image<ColorRgb> & image, bool forceUpdate)
 	if (forceUpdate)
 	{
 		updateScreenDimensions(forceUpdate);
+		_fullRefresh = true;
+	}
+
+	const qint64 now = nowMs();
+	bool partial = false;
+	if (_xDamageAvailable)
+	{
+		const bool damaged = fetchDamage();
+		if (!_fullRefresh && now - _lastFullGrabTime < FULL_GRAB_INTERVAL_MS)
+		{
+			if (!damaged)
+			{
+				++_skippedFrames;
+				reportStatistics(now);
+				return FRAME_UNCHANGED;
+			}
+
+			double damagedArea = 0;
+			for (const XRectangle& rect : _damagedRects)
+			{
+				damagedArea += static_cast<double>(rect.width) * rect.height;
+			}
+			partial = _xRenderAvailable && damagedArea <= PARTIAL_GRAB_MAX_AREA * _screenWidth * _screenHeight;
+		}
 	}
 
 	if (_xRenderAvailable)
@@ -223,11 +305,19 @@ int X11Grabber::grabFrame(Image<ColorRgb> & image, bool forceUpdate)
 
 		XRenderSetPictureTransform (_x11Display, _srcPicture, &_transform);
 
-		// display, op, src, mask, dest, src_x = cropLeft,
-		// src_y = cropTop, mask_x, mask_y, dest_x, dest_y, width, height
-		XRenderComposite(
-			_x11Display, PictOpSrc, _srcPicture, None, _dstPicture, ( _src_x/_pixelDecimation),
-			(_src_y/_pixelDecimation), 0, 0, 0, 0, _width, _height);
+		if (partial)
+		{
+			// the pixmap keeps the last frame, update the changed areas only
+			compositeDamage(scale);
+		}
+		else
+		{
+			// display, op, src, mask, dest, src_x = cropLeft,
+			// src_y = cropTop, mask_x, mask_y, dest_x, dest_y, width, height
+			XRenderComposite(
+				_x11Display, PictOpSrc, _srcPicture, None, _dstPicture, ( _src_x/_pixelDecimation),
+				(_src_y/_pixelDecimation), 0, 0, 0, 0, _width, _height);
+		}
 
 		XSync(_x11Display, False);
 
@@ -259,9 +349,84 @@ int X11Grabber::grabFrame(Image<ColorRgb> & image, bool forceUpdate)
 
 	_imageResampler.processImage(reinterpret_cast<const uint8_t *>(_xImage->data), _xImage->width, _xImage->height, _xImage->bytes_per_line, PixelFormat::BGR32, image);
 
+	if (partial)
+	{
+		++_partialFrames;
+	}
+	else
+	{
+		++_fullFrames;
+		_fullRefresh = false;
+		_lastFullGrabTime = now;
+	}
+	reportStatistics(now);
+
 	return 0;
 }
 
+bool X11Grabber::fetchDamage()
+{
+	_damagedRects.clear();
+
+#ifdef HAVE_XDAMAGE
+	// take over the damage accumulated since the last grab and reset it
+	XDamageSubtract(_x11Display, _damage, None, _damageRegion);
+
+	int count = 0;
+	XRectangle* rects = XFixesFetchRegion(_x11Display, _damageRegion, &count);
+	if (rects != nullptr)
+	{
+		_damagedRects.assign(rects, rects + count);
+		XFree(rects);
+	}
+
+	// damage is polled, drop the notify events
+	XEvent event;
+	while (XCheckTypedEvent(_x11Display, _xDamageEventBase + XDamageNotify, &event) != 0)
+	{
+	}
+#endif
+
+	return !_damagedRects.empty();
+}
+
+void X11Grabber::compositeDamage(double scale)
+{
+	const int offsetX = _src_x / _pixelDecimation;
+	const int offsetY = _src_y / _pixelDecimation;
+
+	for (const XRectangle& rect : _damagedRects)
+	{
+		// map the screen area to the pixmap, extended by a pixel covered by the bilinear filter
+		const int x1 = qMax(static_cast<int>(std::floor(rect.x * scale)) - offsetX - 1, 0);
+		const int y1 = qMax(static_cast<int>(std::floor(rect.y * scale)) - offsetY - 1, 0);
+		const int x2 = qMin(static_cast<int>(std::ceil((rect.x + rect.width) * scale)) - offsetX + 1, _width);
+		const int y2 = qMin(static_cast<int>(std::ceil((rect.y + rect.height) * scale)) - offsetY + 1, _height);
+
+		if (x2 > x1 && y2 > y1)
+		{
+			XRenderComposite(
+				_x11Display, PictOpSrc, _srcPicture, None, _dstPicture, offsetX + x1,
+				offsetY + y1, 0, 0, x1, y1, static_cast<unsigned int>(x2 - x1), static_cast<unsigned int>(y2 - y1));
+		}
+	}
+}
+
+void X11Grabber::reportStatistics(qint64 now)
+{
+	if (now - _lastReportTime < REPORT_INTERVAL_MS)
+	{
+		return;
+	}
+
+	Debug(_log, "Frames grabbed: %d full, %d partial, %d skipped as unchanged", _fullFrames, _partialFrames, _skippedFrames);
+
+	_lastReportTime = now;
+	_fullFrames = 0;
+	_partialFrames = 0;
+	_skippedFrames = 0;
+}
+
 int X11Grabber::updateScreenDimensions(bool force)
 {
 	const Status status = XGetWindowAttributes(_x11Display, _window, &_windowAttr);
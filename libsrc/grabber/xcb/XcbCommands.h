@@ -4,6 +4,10 @@
 #include <xcb/shm.h>
 #include <xcb/xcb.h>
 #include <xcb/xcb_image.h>
+#ifdef HAVE_XCB_DAMAGE
+#include <xcb/damage.h>
+#include <xcb/xfixes.h>
+#endif
 
 struct GetImage
 {
@@ -141,3 +145,68 @@ struct FreePixmap
 	static constexpr auto ReplyFunction = xcb_request_check;
 };
 
+#ifdef HAVE_XCB_DAMAGE
+struct DamageQueryVersion
+{
+	typedef xcb_damage_query_version_reply_t ResponseType;
+
+	static constexpr auto RequestFunction = xcb_damage_query_version;
+	static constexpr auto ReplyFunction = xcb_damage_query_version_reply;
+};
+
+struct XFixesQueryVersion
+{
+	typedef xcb_xfixes_query_version_reply_t ResponseType;
+
+	static constexpr auto RequestFunction = xcb_xfixes_query_version;
+	static constexpr auto ReplyFunction = xcb_xfixes_query_version_reply;
+};
+
+struct XFixesFetchRegion
+{
+	typedef xcb_xfixes_fetch_region_reply_t ResponseType;
+
+	static constexpr auto RequestFunction = xcb_xfixes_fetch_region;
+	static constexpr auto ReplyFunction = xcb_xfixes_fetch_region_reply;
+};
+
+struct DamageCreate
+{
+	typedef xcb_void_cookie_t ResponseType;
+
+	static constexpr auto RequestFunction = xcb_damage_create_checked;
+	static constexpr auto ReplyFunction = xcb_request_check;
+};
+
+struct DamageDestroy
+{
+	typedef xcb_void_cookie_t ResponseType;
+
+	static constexpr auto RequestFunction = xcb_damage_destroy_checked;
+	static constexpr auto ReplyFunction = xcb_request_check;
+};
+
+struct DamageSubtract
+{
+	typedef xcb_void_cookie_t ResponseType;
+
+	static constexpr auto RequestFunction = xcb_damage_subtract_checked;
+	static constexpr auto ReplyFunction = xcb_request_check;
+};
+
+struct XFixesCreateRegion
+{
+	typedef xcb_void_cookie_t ResponseType;
+
+	static constexpr auto RequestFunction = xcb_xfixes_create_region_checked;
+	static constexpr auto ReplyFunction = xcb_request_check;
+};
+
+struct XFixesDestroyRegion
+{
+	typedef xcb_void_cookie_t ResponseType;
+
+	static constexpr auto RequestFunction = xcb_xfixes_destroy_region_checked;
+	static constexpr auto ReplyFunction = xcb_request_check;
+};
+#endif
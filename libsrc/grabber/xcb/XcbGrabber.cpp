@@ -8,11 +8,25 @@
 
 #include <QCoreApplication>
 
+#include <chrono>
+#include <cmath>
 #include <memory>
 
 // Constants
 namespace {
 	const bool verbose = false;
+
+	// Without damage the last image is reused, but the screen is grabbed completely at least that often,
+	// which covers content not reporting damage (e.g. some video overlays)
+	constexpr qint64 FULL_GRAB_INTERVAL_MS = 1000;
+	// Share of the screen up to which only the damaged areas are updated
+	constexpr double PARTIAL_GRAB_MAX_AREA = 0.5;
+	constexpr qint64 REPORT_INTERVAL_MS = 60000;
+
+	qint64 nowMs()
+	{
+		return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
 } //End of constants
 
 #define DOUBLE_TO_FIXED(d) ((xcb_render_fixed_t) ((d) * 65536))
@@ -36,7 +50,16 @@ XcbGrabber::XcbGrabber(int cropLeft, int cropRight, int cropTop, int cropBottom)
 	, _XcbRandRAvailable{}
 	, _XcbShmAvailable{}
 	, _XcbShmPixmapAvailable{}
+	, _XcbDamageAvailable{}
 	, _isWayland (false)
+	, _damage{}
+	, _damageRegion{}
+	, _fullRefresh(true)
+	, _lastFullGrabTime(0)
+	, _lastReportTime(nowMs())
+	, _fullFrames(0)
+	, _partialFrames(0)
+	, _skippedFrames(0)
 	, _logger{}
 	, _shmData{}
 	, _XcbRandREventBase{-1}
@@ -76,6 +99,16 @@ void XcbGrabber::freeResources()
 		query<RenderFreePicture>(_connection, _srcPicture);
 		query<RenderFreePicture>(_connection, _dstPicture);
 	}
+
+#ifdef HAVE_XCB_DAMAGE
+	if (_damage != 0)
+	{
+		query<DamageDestroy>(_connection, _damage);
+		query<XFixesDestroyRegion>(_connection, _damageRegion);
+		_damage = 0;
+		_damageRegion = 0;
+	}
+#endif
 }
 
 void XcbGrabber::setupResources()
@@ -133,6 +166,17 @@ void XcbGrabber::setupResources()
 		_imageResampler.setHorizontalPixelDecimation(_pixelDecimation);
 		_imageResampler.setVerticalPixelDecimation(_pixelDecimation);
 	}
+
+#ifdef HAVE_XCB_DAMAGE
+	if (_XcbDamageAvailable)
+	{
+		_damage = xcb_generate_id(_connection);
+		query<DamageCreate>(_connection, _damage, _screen->root, XCB_DAMAGE_REPORT_LEVEL_NON_EMPTY);
+		_damageRegion = xcb_generate_id(_connection);
+		query<XFixesCreateRegion>(_connection, _damageRegion, 0, nullptr);
+	}
+#endif
+	_fullRefresh = true;
 }
 
 xcb_screen_t * XcbGrabber::getScreen(const xcb_setup_t *setup, int screen_num) const
@@ -166,6 +210,22 @@ void XcbGrabber::setupRender()
 	_XcbRenderAvailable = renderQueryVersionReply != nullptr;
 }
 
+void XcbGrabber::setupDamage()
+{
+	_XcbDamageAvailable = false;
+
+#ifdef HAVE_XCB_DAMAGE
+	if (xcb_get_extension_data(_connection, &xcb_damage_id) != nullptr && xcb_get_extension_data(_connection, &xcb_xfixes_id) != nullptr)
+	{
+		// the versions have to be negotiated before any other request of the extensions
+		auto xfixesQueryVersionReply = query<XFixesQueryVersion>(_connection, XCB_XFIXES_MAJOR_VERSION, XCB_XFIXES_MINOR_VERSION);
+		auto damageQueryVersionReply = query<DamageQueryVersion>(_connection, XCB_DAMAGE_MAJOR_VERSION, XCB_DAMAGE_MINOR_VERSION);
+
+		_XcbDamageAvailable = xfixesQueryVersionReply != nullptr && xfixesQueryVersionReply->major_version >= 2 && damageQueryVersionReply != nullptr;
+	}
+#endif
+}
+
 void XcbGrabber::setupShm()
 {
 	auto shmQueryExtensionReply = xcb_get_extension_data(_connection, &xcb_render_id);
@@ -239,12 +299,14 @@ bool XcbGrabber::setupDisplay()
 		setupRandr();
 		setupRender();
 		setupShm();
+		setupDamage();
 
-		Info(_log, "%s", QSTRING_CSTR(QString("XcbRandR=[%1] XcbRender=[%2] XcbShm=[%3] XcbPixmap=[%4]")
+		Info(_log, "%s", QSTRING_CSTR(QString("XcbRandR=[%1] XcbRender=[%2] XcbShm=[%3] XcbPixmap=[%4] XcbDamage=[%5]")
 			 .arg(_XcbRandRAvailable ? "available" : "unavailable",
 			 _XcbRenderAvailable     ? "available" : "unavailable",
 			 _XcbShmAvailable        ? "available" : "unavailable",
-			 _XcbShmPixmapAvailable  ? "available" : "unavailable"))
+			 _XcbShmPixmapAvailable  ? "available" : "unavailable",
+			 _XcbDamageAvailable     ? "available" : "unavailable"))
 			 );
 
 		result = (updateScreenDimensions(true) >= 0);
@@ -260,7 +322,33 @@ int XcbGrabber::grabFrame(Image<ColorRgb> & image, bool forceUpdate)
 		return 0;
 
 	if (forceUpdate)
+	{
 		updateScreenDimensions(forceUpdate);
+		_fullRefresh = true;
+	}
+
+	const qint64 now = nowMs();
+	bool partial = false;
+	if (_XcbDamageAvailable)
+	{
+		const bool damaged = fetchDamage();
+		if (!_fullRefresh && now - _lastFullGrabTime < FULL_GRAB_INTERVAL_MS)
+		{
+			if (!damaged)
+			{
+				++_skippedFrames;
+				reportStatistics(now);
+				return FRAME_UNCHANGED;
+			}
+
+			double damagedArea = 0;
+			for (const xcb_rectangle_t& rect : _damagedRects)
+			{
+				damagedArea += static_cast<double>(rect.width) * rect.height;
+			}
+			partial = _XcbRenderAvailable && damagedArea <= PARTIAL_GRAB_MAX_AREA * _screenWidth * _screenHeight;
+		}
+	}
 
 	if (_XcbRenderAvailable)
 	{
@@ -275,12 +363,20 @@ int XcbGrabber::grabFrame(Image<ColorRgb> & image, bool forceUpdate)
 		};
 
 		query<RenderSetPictureTransform>(_connection, _srcPicture, _transform);
-		query<RenderComposite>(_connection,
-			XCB_RENDER_PICT_OP_SRC, _srcPicture,
-			XCB_RENDER_PICTURE_NONE, _dstPicture,
-			(_src_x/_pixelDecimation),
-			(_src_y/_pixelDecimation),
-			0, 0, 0, 0, _width, _height);
+		if (partial)
+		{
+			// the pixmap keeps the last frame, update the changed areas only
+			compositeDamage(scale);
+		}
+		else
+		{
+			query<RenderComposite>(_connection,
+				XCB_RENDER_PICT_OP_SRC, _srcPicture,
+				XCB_RENDER_PICTURE_NONE, _dstPicture,
+				(_src_x/_pixelDecimation),
+				(_src_y/_pixelDecimation),
+				0, 0, 0, 0, _width, _height);
+		}
 
 		xcb_flush(_connection);
 
@@ -331,9 +427,85 @@ int XcbGrabber::grabFrame(Image<ColorRgb> & image, bool forceUpdate)
 			_width, _height, _width * 4, PixelFormat::BGR32, image);
 	}
 
+	if (partial)
+	{
+		++_partialFrames;
+	}
+	else
+	{
+		++_fullFrames;
+		_fullRefresh = false;
+		_lastFullGrabTime = now;
+	}
+	reportStatistics(now);
+
 	return 0;
 }
 
+bool XcbGrabber::fetchDamage()
+{
+	_damagedRects.clear();
+
+#ifdef HAVE_XCB_DAMAGE
+	// take over the damage accumulated since the last grab and reset it
+	query<DamageSubtract>(_connection, _damage, XCB_NONE, _damageRegion);
+
+	auto region = query<XFixesFetchRegion>(_connection, _damageRegion);
+	if (region != nullptr)
+	{
+		const xcb_rectangle_t* rects = xcb_xfixes_fetch_region_rectangles(region.get());
+		_damagedRects.assign(rects, rects + xcb_xfixes_fetch_region_rectangles_length(region.get()));
+	}
+
+	// damage is polled, drop the notify events (no other events are read from this connection)
+	while (xcb_generic_event_t* event = xcb_poll_for_queued_event(_connection))
+	{
+		free(event);
+	}
+#endif
+
+	return !_damagedRects.empty();
+}
+
+void XcbGrabber::compositeDamage(double scale)
+{
+	const int offsetX = static_cast<int>(_src_x / _pixelDecimation);
+	const int offsetY = static_cast<int>(_src_y / _pixelDecimation);
+
+	for (const xcb_rectangle_t& rect : _damagedRects)
+	{
+		// map the screen area to the pixmap, extended by a pixel to cover rounding
+		const int x1 = qMax(static_cast<int>(std::floor(rect.x * scale)) - offsetX - 1, 0);
+		const int y1 = qMax(static_cast<int>(std::floor(rect.y * scale)) - offsetY - 1, 0);
+		const int x2 = qMin(static_cast<int>(std::ceil((rect.x + rect.width) * scale)) - offsetX + 1, _width);
+		const int y2 = qMin(static_cast<int>(std::ceil((rect.y + rect.height) * scale)) - offsetY + 1, _height);
+
+		if (x2 > x1 && y2 > y1)
+		{
+			query<RenderComposite>(_connection,
+				XCB_RENDER_PICT_OP_SRC, _srcPicture,
+				XCB_RENDER_PICTURE_NONE, _dstPicture,
+				offsetX + x1, offsetY + y1,
+				0, 0, x1, y1, x2 - x1, y2 - y1);
+		}
+	}
+}
+
+void XcbGrabber::reportStatistics(qint64 now)
+{
+	if (now - _lastReportTime < REPORT_INTERVAL_MS)
+	{
+		return;
+	}
+
+	Debug(_log, "Frames grabbed: %d full, %d partial, %d skipped as unchanged", _fullFrames, _partialFrames, _skippedFrames);
+
+	_lastReportTime = now;
+	_fullFrames = 0;
+	_partialFrames = 0;
+	_skippedFrames = 0;
+}
+
 int XcbGrabber::updateScreenDimensions(bool force)
 {
 	auto geometry = query<GetGeometry>(_connection, _screen->root);
@@ -8,6 +8,13 @@
 #include <QJsonObject>
 #include <QTimer>
 
+namespace {
+// Number of recently verified tokens kept with their hash
+const int VERIFIED_TOKENS_MAX = 32;
+// Interval for writing the 'last_use' timestamps of tokens to the database
+const int TOKEN_USE_FLUSH_INTERVAL_MS = 10000;
+}
+
 AuthManager *AuthManager::manager = nullptr;
 
 AuthManager::AuthManager(QObject *parent, bool readonlyMode)
@@ -18,6 +25,9 @@ AuthManager::AuthManager(QObject *parent, bool readonlyMode)
 	, _authRequired(true)
 	, _timer(new QTimer(this))
 	, _authBlockTimer(new QTimer(this))
+	, _tokenAuthBlocked(false)
+	, _verifiedTokens(VERIFIED_TOKENS_MAX)
+	, _tokenUseTimer(new QTimer(this))
 {
 	AuthManager::manager = this;
 
@@ -35,6 +45,11 @@ AuthManager::AuthManager(QObject *parent, bool readonlyMode)
 	_authBlockTimer->setInterval(60000);
 	connect(_authBlockTimer, &QTimer::timeout, this, &AuthManager::checkAuthBlockTimeout);
 
+	// setup tokenUseTimer
+	_tokenUseTimer->setInterval(TOKEN_USE_FLUSH_INTERVAL_MS);
+	connect(_tokenUseTimer, &QTimer::timeout, this, &AuthManager::flushTokenUse);
+	_tokenUseTimer->start();
+
 	// init with default user and password
 	if (!_authTable->userExist("Hyperion"))
 	{
@@ -43,6 +58,13 @@ AuthManager::AuthManager(QObject *parent, bool readonlyMode)
 
 	// update Hyperion user token on startup
 	_authTable->setUserToken("Hyperion");
+
+	loadTokenCache();
+}
+
+AuthManager::~AuthManager()
+{
+	flushTokenUse();
 }
 
 AuthManager::AuthDefinition AuthManager::createToken(const QString &comment)
@@ -51,6 +73,7 @@ AuthManager::AuthDefinition AuthManager::createToken(const QString &comment)
 	const QString id = QUuid::createUuid().toString().mid(1, 36).left(5);
 
 	_authTable->createToken(token, comment, id);
+	loadTokenCache();
 
 	AuthDefinition def;
 	def.comment = comment;
@@ -93,6 +116,7 @@ void AuthManager::setAuthBlock(bool user)
 	else
 		_tokenAuthAttempts.append(QDateTime::currentMSecsSinceEpoch() + 600000);
 
+	_tokenAuthBlocked = isTokenAuthBlocked();
 	_authBlockTimer->start();
 }
 
@@ -114,16 +138,60 @@ bool AuthManager::isTokenAuthorized(const QString &token)
 	if (isTokenAuthBlocked())
 		return false;
 
-	if (!_authTable->tokenExist(token))
+	if (!isTokenAuthorizedCached(token))
 	{
 		setAuthBlock();
 		return false;
 	}
-	// timestamp update
-	tokenChange(getTokenList());
 	return true;
 }
 
+bool AuthManager::isTokenAuthorizedCached(const QString &token)
+{
+	if (_tokenAuthBlocked)
+		return false;
+
+	QMutexLocker lock(&_tokenCacheMutex);
+
+	const QByteArray *cachedHash = _verifiedTokens.object(token);
+	const QByteArray hash = (cachedHash != nullptr) ? *cachedHash : _authTable->hashToken(token);
+	if (!_tokenHashes.contains(hash))
+		return false;
+
+	if (cachedHash == nullptr)
+		_verifiedTokens.insert(token, new QByteArray(hash));
+
+	// timestamp update, written with the next flush
+	_pendingTokenUse.insert(hash, QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+	return true;
+}
+
+void AuthManager::loadTokenCache()
+{
+	const QVector<QByteArray> hashes = _authTable->getTokenHashes();
+
+	QMutexLocker lock(&_tokenCacheMutex);
+	_tokenHashes.clear();
+	for (const auto &hash : hashes)
+		_tokenHashes.insert(hash);
+	_verifiedTokens.clear();
+}
+
+void AuthManager::flushTokenUse()
+{
+	QHash<QByteArray, QString> pendingTokenUse;
+	{
+		QMutexLocker lock(&_tokenCacheMutex);
+		pendingTokenUse.swap(_pendingTokenUse);
+	}
+
+	if (pendingTokenUse.isEmpty())
+		return;
+
+	_authTable->updateTokensUsed(pendingTokenUse);
+	emit tokenChange(getTokenList());
+}
+
 bool AuthManager::isUserTokenAuthorized(const QString &usr, const QString &token)
 {
 	if (isUserAuthBlocked())
@@ -182,6 +250,7 @@ void AuthManager::handlePendingTokenRequest(const QString &id, bool accept)
 		{
 			const QString token = QUuid::createUuid().toString().remove("{").remove("}");
 			_authTable->createToken(token, def.comment, id);
+			loadTokenCache();
 			emit tokenResponse(true, def.caller, token, def.comment, id, def.tan);
 			emit tokenChange(getTokenList());
 		}
@@ -220,6 +289,7 @@ bool AuthManager::deleteToken(const QString &id)
 {
 	if (_authTable->deleteToken(id))
 	{
+		loadTokenCache();
 		emit tokenChange(getTokenList());
 		return true;
 	}
@@ -275,6 +345,7 @@ void AuthManager::checkAuthBlockTimeout()
 		if (itTokenAuth.next() < static_cast<uint64_t>(QDateTime::currentMSecsSinceEpoch()))
 			itTokenAuth.remove();
 	}
+	_tokenAuthBlocked = isTokenAuthBlocked();
 
 	// if the lists are empty we stop
 	if (_userAuthAttempts.empty() && _tokenAuthAttempts.empty())
@@ -57,6 +57,10 @@ ComponentRegister::ComponentRegister(Hyperion* hyperion)
 	vect << COMP_BOBLIGHTSERVER;
 #endif
 
+#if defined(ENABLE_LEDSTREAM_SERVER)
+	vect << COMP_LEDSTREAMSERVER;
+#endif
+
 #if defined(ENABLE_FORWARDER)
 	vect << COMP_FORWARDER;
 #endif
@@ -21,12 +21,14 @@
 #include <utils/hyperion.h>
 #include <utils/GlobalSignals.h>
 #include <utils/Logger.h>
+#include <utils/Tracing.h>
 
 // LedDevice includes
 #include <leddevice/LedDeviceWrapper.h>
 
 #include <hyperion/MultiColorAdjustment.h>
 #include <hyperion/LinearColorSmoothing.h>
+#include <hyperion/UpdateScheduler.h>
 
 #if defined(ENABLE_EFFECTENGINE)
 // effect engine includes
@@ -47,6 +49,11 @@
 #include <boblightserver/BoblightServer.h>
 #endif
 
+// DDP/E1.31 receiver
+#if defined(ENABLE_LEDSTREAM_SERVER)
+#include <ledstreamserver/LedStreamServer.h>
+#endif
+
 Hyperion::Hyperion(quint8 instance, bool readonlyMode)
 	: QObject()
 	, _instIndex(instance)
@@ -58,6 +65,8 @@ Hyperion::Hyperion(quint8 instance, bool readonlyMode)
 	, _raw2ledAdjustment(hyperion::createLedColorsAdjustment(static_cast<int>(_ledString.leds().size()), getSetting(settings::COLOR).object()))
 	, _ledDeviceWrapper(nullptr)
 	, _deviceSmooth(nullptr)
+	, _updateScheduler(nullptr)
+	, _ledDeviceLatchTime(0)
 #if defined(ENABLE_EFFECTENGINE)
 	, _effectEngine(nullptr)
 #endif
@@ -72,6 +81,9 @@ Hyperion::Hyperion(quint8 instance, bool readonlyMode)
 	, _ledBuffer(_ledString.leds().size(), ColorRgb::BLACK)
 #if defined(ENABLE_BOBLIGHT_SERVER)
 	, _boblightServer(nullptr)
+#endif
+#if defined(ENABLE_LEDSTREAM_SERVER)
+	, _ledStreamServer(nullptr)
 #endif
 	, _readOnlyMode(readonlyMode)
 {
@@ -138,6 +150,7 @@ void Hyperion::start()
 	_ledDeviceWrapper = new LedDeviceWrapper(this);
 	connect(this, &Hyperion::compStateChangeRequest, _ledDeviceWrapper, &LedDeviceWrapper::handleComponentState);
 	connect(this, &Hyperion::ledDeviceData, _ledDeviceWrapper, &LedDeviceWrapper::updateLeds);
+	connect(_ledDeviceWrapper, &LedDeviceWrapper::latchTimeChanged, this, [this](int latchTime_ms) { _ledDeviceLatchTime = latchTime_ms; });
 	_ledDeviceWrapper->createLedDevice(ledDevice);
 
 	// smoothing
@@ -147,6 +160,15 @@ void Hyperion::start()
 	//Start in pause mode, a new priority will activate smoothing (either start-effect or grabber)
 	_deviceSmooth->setPause(true);
 
+	// process incoming frames not faster than smoothing or the LED-device outputs them
+	_updateScheduler = new UpdateScheduler([this]() { update(); }, [this]() -> int64_t {
+		if (_deviceSmooth->enabled())
+		{
+			return _deviceSmooth->getUpdateIntervalMicros();
+		}
+		return static_cast<int64_t>(_ledDeviceLatchTime) * 1000;
+	}, this);
+
 #if defined(ENABLE_FORWARDER)
 	// create the message forwarder only on main instance
 	if (_instIndex == 0)
@@ -188,6 +210,12 @@ void Hyperion::start()
 	connect(this, &Hyperion::settingsChanged, _boblightServer, &BoblightServer::handleSettingsUpdate);
 #endif
 
+#if defined(ENABLE_LEDSTREAM_SERVER)
+	// DDP/E1.31 receiver, depends on layout as well
+	_ledStreamServer = new LedStreamServer(this, getSetting(settings::LEDSTREAMSERVER));
+	connect(this, &Hyperion::settingsChanged, _ledStreamServer, &LedStreamServer::handleSettingsUpdate);
+#endif
+
 	// instance initiated, enter thread event loop
 	emit started();
 }
@@ -200,20 +228,29 @@ void Hyperion::stop()
 
 void Hyperion::freeObjects()
 {
-	//Disconnect Background effect first that it does not kick in when other priorities are stopped
-	_BGEffectHandler->disconnect();
+	// An instance which was never started has no components to stop
+	if (_BGEffectHandler != nullptr)
+	{
+		//Disconnect Background effect first that it does not kick in when other priorities are stopped
+		_BGEffectHandler->disconnect();
 
-	//Remove all priorities to switch off all leds
-	clear(-1,true);
+		//Remove all priorities to switch off all leds
+		clear(-1,true);
+	}
 
 	// delete components on exit of hyperion core
 
 	delete _BGEffectHandler;
+	delete _updateScheduler;
 
 #if defined(ENABLE_BOBLIGHT_SERVER)
 	delete _boblightServer;
 #endif
 
+#if defined(ENABLE_LEDSTREAM_SERVER)
+	delete _ledStreamServer;
+#endif
+
 	delete _captureCont;
 
 #if defined(ENABLE_EFFECTENGINE)
@@ -335,6 +372,11 @@ int Hyperion::getLatchTime() const
 	return _ledDeviceWrapper->getLatchTime();
 }
 
+QJsonObject Hyperion::getUpdateStatistics() const
+{
+	return (_updateScheduler != nullptr) ? _updateScheduler->getStatistics() : QJsonObject();
+}
+
 unsigned Hyperion::addSmoothingConfig(int settlingTime_ms, double ledUpdateFrequency_hz, unsigned updateDelay)
 {
 	return _deviceSmooth->addConfig(settlingTime_ms, ledUpdateFrequency_hz, updateDelay);
@@ -411,10 +453,10 @@ bool Hyperion::setInput(int priority, const std::vector<ColorRgb>& ledColors, in
 		}
 		#endif
 
-		// if this priority is visible, update immediately
+		// if this priority is visible, update with the next output tick
 		if(priority == _muxer->getCurrentPriority())
 		{
-			update();
+			_updateScheduler->requestUpdate();
 		}
 
 		return true;
@@ -440,10 +482,10 @@ bool Hyperion::setInputImage(int priority, const Image<ColorRgb>& image, int64_t
 		}
 		#endif
 
-		// if this priority is visible, update immediately
+		// if this priority is visible, update with the next output tick
 		if(priority == _muxer->getCurrentPriority())
 		{
-			update();
+			_updateScheduler->requestUpdate();
 		}
 
 		return true;
@@ -691,7 +733,10 @@ void Hyperion::update()
 	// emit rawLedColors before transform
 	emit rawLedColors(_ledBuffer);
 
-	_raw2ledAdjustment->applyAdjustment(_ledBuffer);
+	{
+		TRACE_SCOPE(tracing::Stage::ADJUSTMENT);
+		_raw2ledAdjustment->applyAdjustment(_ledBuffer);
+	}
 
 	int i = 0;
 	for (ColorRgb& color : _ledBuffer)
@@ -143,10 +143,11 @@ void ImageProcessor::setSize(int width, int height)
 void ImageProcessor::setLedString(const LedString& ledString)
 {
 	Debug(_log,"");
+	_ledString = ledString;
+
+	// the mapping of a layout set before the first image is created with the image
 	if ( !_imageToLedColors.isNull() )
 	{
-		_ledString = ledString;
-
 		// get current width/height
 		int width = _imageToLedColors->width();
 		int height = _imageToLedColors->height();
@@ -1,3 +1,6 @@
+// STL includes
+#include <algorithm>
+
 #include <hyperion/ImageToLedsMap.h>
 
 using namespace hyperion;
@@ -112,6 +115,37 @@ ImageToLedsMap::ImageToLedsMap(
 	Debug(_log, "Total index number is: %d (memory: %d). Reduced pixel set factor: %d, Accuracy level: %d, Image size: %d x %d, LED areas: %d",
 		totalCount, totalCapacity, reducedPixelSetFactor, accuracyLevel, width, height, leds.size());
 
+	createChunks();
+}
+
+void ImageToLedsMap::createChunks()
+{
+	size_t totalPixels = 0;
+	for (const std::vector<int>& pixels : _colorsMap)
+	{
+		totalPixels += pixels.size();
+	}
+
+	// Chunks smaller than that are not worth to be handed over to another thread
+	constexpr size_t MIN_CHUNK_PIXELS = 4096;
+	constexpr size_t MAX_CHUNKS = 64;
+	const size_t chunkPixels = std::max(totalPixels / MAX_CHUNKS, MIN_CHUNK_PIXELS);
+
+	_chunkStarts.clear();
+	_chunkStarts.push_back(0);
+
+	size_t pixelCount = 0;
+	for (size_t led = 0; led < _colorsMap.size(); ++led)
+	{
+		// LEDs without area still cost a little
+		pixelCount += std::max(_colorsMap[led].size(), size_t(1));
+		if (pixelCount >= chunkPixels && led + 1 < _colorsMap.size())
+		{
+			_chunkStarts.push_back(led + 1);
+			pixelCount = 0;
+		}
+	}
+	_chunkStarts.push_back(_colorsMap.size());
 }
 
 int ImageToLedsMap::width() const
@@ -3,11 +3,15 @@
 #include <QTimer>
 
 #include <hyperion/LinearColorSmoothing.h>
+#include <hyperion/SmoothingOutputThread.h>
+#include <hyperion/SmoothingKernels.h>
 #include <hyperion/Hyperion.h>
+#include <utils/Tracing.h>
 
 #include <cmath>
 #include <chrono>
 #include <thread>
+#include <type_traits>
 
 #if defined(COMPILER_GCC)
 #define ALWAYS_INLINE inline __attribute__((__always_inline__))
@@ -17,10 +21,8 @@
 #define ALWAYS_INLINE inline
 #endif
 
-/// Clamps the rounded values to the byte-interval of [0, 255].
-ALWAYS_INLINE long clampRounded(const floatT x) {
-	return std::min(255L, std::max(0L, std::lroundf(x)));
-}
+static_assert(sizeof(ColorRgb) == 3, "The smoothing kernels process LED colors as packed RGB components");
+static_assert(std::is_same<floatT, float>::value, "The smoothing kernels operate on single precision components");
 
 // Constants
 namespace {
@@ -30,14 +32,8 @@ const bool verbose = false;
 /// The number of microseconds per millisecond = 1000.
 const int64_t MS_PER_MICRO = 1000;
 
-/// The number of bits that are used for shifting the fixed point values
-const int FPShift = (sizeof(uint64_t)*8 - (12 + 9));
-
-/// The number of bits that are reduce the shifting when converting from fixed to floating point. 8 bits = 256 values
-const int SmallShiftBis = sizeof(uint8_t)*8;
-
-/// The number of bits that are used for shifting the fixed point values plus SmallShiftBis
-const int FPShiftSmall = (sizeof(uint64_t)*8 - (12 + 9 + SmallShiftBis));
+/// The number of microseconds per second.
+const double MICROS_PER_SECOND = 1000000.0;
 
 const char* SETTINGS_KEY_SMOOTHING_TYPE = "type";
 
@@ -48,6 +44,7 @@ const char* SETTINGS_KEY_OUTPUT_DELAY = "updateDelay";
 const char* SETTINGS_KEY_DECAY = "decay";
 const char* SETTINGS_KEY_INTERPOLATION_RATE = "interpolationRate";
 const char* SETTINGS_KEY_DITHERING = "dithering";
+const char* SETTINGS_KEY_OUTPUT_THREAD = "outputThread";
 
 const int64_t DEFAULT_SETTLINGTIME = 200;	// in ms
 const int DEFAULT_UPDATEFREQUENCY = 25;		// in Hz
@@ -66,17 +63,21 @@ LinearColorSmoothing::LinearColorSmoothing(const QJsonDocument &config, Hyperion
 	  , _updateInterval(DEFAULT_UPDATEINTERVALL.count())
 	  , _settlingTime(DEFAULT_SETTLINGTIME)
 	  , _timer(nullptr)
+	  , _outputThread(nullptr)
+	  , _updateIntervalMicros(DEFAULT_UPDATEINTERVALL.count() * MS_PER_MICRO)
 	  , _outputDelay(DEFAULT_OUTPUTDEPLAY)
 	  , _pause(false)
 	  , _currentConfigId(SmoothingConfigID::SYSTEM)
 	  , _enabled(false)
 	  , _enabledSystemCfg(false)
 	  , _smoothingType(SmoothingType::Linear)
-	  , tempValues(std::vector<uint64_t>())
+	  , tempValues(std::vector<floatT>())
 {
 	QString subComponent = hyperion->property("instance").toString();
 	_log= Logger::getInstance("SMOOTHING", subComponent);
 
+	DebugIf(verbose, _log, "Using %s smoothing kernels", smoothing::kernels().name);
+
 	// timer
 	_timer = new QTimer(this);
 	_timer->setTimerType(Qt::PreciseTimer);
@@ -105,6 +106,7 @@ LinearColorSmoothing::LinearColorSmoothing(const QJsonDocument &config, Hyperion
 
 LinearColorSmoothing::~LinearColorSmoothing()
 {
+	delete _outputThread;
 	delete _timer;
 }
 
@@ -118,9 +120,11 @@ void LinearColorSmoothing::handleSettingsUpdate(settings::type type, const QJson
 		_enabledSystemCfg = _enabled;
 
 		int64_t settlingTime_ms = static_cast<int64_t>(obj[SETTINGS_KEY_SETTLING_TIME].toInt(DEFAULT_SETTLINGTIME));
-		int _updateInterval_ms =static_cast<int>(MS_PER_MICRO / obj[SETTINGS_KEY_UPDATE_FREQUENCY].toDouble(DEFAULT_UPDATEFREQUENCY));
+		const double updateFrequency_hz = obj[SETTINGS_KEY_UPDATE_FREQUENCY].toDouble(DEFAULT_UPDATEFREQUENCY);
+		int _updateInterval_ms =static_cast<int>(MS_PER_MICRO / updateFrequency_hz);
 
 		SmoothingCfg cfg(false, settlingTime_ms, _updateInterval_ms);
+		cfg._updateIntervalMicros = static_cast<int64_t>(MICROS_PER_SECOND / updateFrequency_hz);
 
 		const QString typeString = obj[SETTINGS_KEY_SMOOTHING_TYPE].toString();
 
@@ -141,6 +145,8 @@ void LinearColorSmoothing::handleSettingsUpdate(settings::type type, const QJson
 		_cfgList[SmoothingConfigID::SYSTEM] = cfg;
 		DebugIf(_enabled,_log,"%s", QSTRING_CSTR(getConfig(SmoothingConfigID::SYSTEM)));
 
+		setOutputThreadEnabled(obj[SETTINGS_KEY_OUTPUT_THREAD].toBool(false));
+
 		// if current id is 0, we need to apply the settings (forced)
 		if (_currentConfigId == SmoothingConfigID::SYSTEM)
 		{
@@ -151,19 +157,24 @@ void LinearColorSmoothing::handleSettingsUpdate(settings::type type, const QJson
 
 int LinearColorSmoothing::write(const std::vector<ColorRgb> &ledValues)
 {
-	_targetTime = micros() + (MS_PER_MICRO * _settlingTime);
-	_targetValues = ledValues;
+	if (_outputThread != nullptr)
+	{
+		// Hand the frame over to the output thread, the buffers of the slot are recycled
+		REMEMBERED_FRAME &frame = _frameSlot.writeBuffer();
+		frame.time = micros();
+		frame.colors = ledValues;
+		_frameSlot.publish();
 
-	rememberFrame(ledValues);
+		if (!_pause)
+		{
+			_outputThread->startOutput();
+		}
+		return 0;
+	}
 
 	// received a new target color
-	if (_previousValues.empty())
+	if (ingestFrame(micros(), ledValues))
 	{
-		// not initialized yet
-		_previousWriteTime = micros();
-		_previousValues = ledValues;
-		_previousInterpolationTime = micros();
-
 		if (!_pause)
 		{
 			_timer->start(_updateInterval);
@@ -173,6 +184,25 @@ int LinearColorSmoothing::write(const std::vector<ColorRgb> &ledValues)
 	return 0;
 }
 
+bool LinearColorSmoothing::ingestFrame(int64_t time, const std::vector<ColorRgb> &ledValues)
+{
+	_targetTime = time + (MS_PER_MICRO * _settlingTime);
+	_targetValues = ledValues;
+
+	rememberFrame(time, ledValues);
+
+	if (_previousValues.empty())
+	{
+		// not initialized yet
+		_previousWriteTime = time;
+		_previousValues = ledValues;
+		_previousInterpolationTime = time;
+		return true;
+	}
+
+	return false;
+}
+
 int LinearColorSmoothing::updateLedValues(const std::vector<ColorRgb> &ledValues)
 {
 	int retval = 0;
@@ -198,11 +228,11 @@ void LinearColorSmoothing::intitializeComponentVectors(const size_t ledCount)
 
 		meanValues = std::vector<floatT>(len, 0.0F);
 		residualErrors = std::vector<floatT>(len, 0.0F);
-		tempValues = std::vector<uint64_t>(len, 0L);
+		tempValues = std::vector<floatT>(len, 0.0F);
 	}
 
 	// Zero the temp vector
-	std::fill(tempValues.begin(), tempValues.end(), 0L);
+	std::fill(tempValues.begin(), tempValues.end(), 0.0F);
 }
 
 void LinearColorSmoothing::writeDirect()
@@ -236,32 +266,11 @@ void LinearColorSmoothing::assembleAndDitherFrame()
 		return;
 	}
 
-	// The number of LEDs present in each frame
-	const size_t N = _targetValues.size();
-
-	for (size_t i = 0; i < N; ++i)
-	{
-		// Add residuals for error diffusion (temporal dithering)
-		const floatT fr = meanValues[3 * i + 0] + residualErrors[3 * i + 0];
-		const floatT fg = meanValues[3 * i + 1] + residualErrors[3 * i + 1];
-		const floatT fb = meanValues[3 * i + 2] + residualErrors[3 * i + 2];
-
-		// Convert to to 8-bit value
-		const long ir = clampRounded(fr);
-		const long ig = clampRounded(fg);
-		const long ib = clampRounded(fb);
-
-		// Update the colors
-		ColorRgb &prev = _previousValues[i];
-		prev.red = static_cast<uint8_t>(ir);
-		prev.green = static_cast<uint8_t>(ig);
-		prev.blue = static_cast<uint8_t>(ib);
+	// The number of LED components present in each frame
+	const size_t N = std::min(meanValues.size(), 3 * _previousValues.size());
 
-		// Determine the component errors
-		residualErrors[3 * i + 0] = fr - ir;
-		residualErrors[3 * i + 1] = fg - ig;
-		residualErrors[3 * i + 2] = fb - ib;
-	}
+	// Convert to 8-bit values, adding the residuals for error diffusion (temporal dithering) and determine the new component errors
+	smoothing::kernels().quantizeDithered(meanValues.data(), residualErrors.data(), reinterpret_cast<uint8_t*>(_previousValues.data()), N);
 }
 
 void LinearColorSmoothing::assembleFrame()
@@ -271,44 +280,17 @@ void LinearColorSmoothing::assembleFrame()
 		return;
 	}
 
-	// The number of LEDs present in each frame
-	const size_t N = _targetValues.size();
-
-	for (size_t i = 0; i < N; ++i)
-	{
-		// Convert to to 8-bit value
-		const long ir = clampRounded(meanValues[3 * i + 0]);
-		const long ig = clampRounded(meanValues[3 * i + 1]);
-		const long ib = clampRounded(meanValues[3 * i + 2]);
+	// The number of LED components present in each frame
+	const size_t N = std::min(meanValues.size(), 3 * _previousValues.size());
 
-		// Update the colors
-		ColorRgb &prev = _previousValues[i];
-		prev.red = static_cast<uint8_t>(ir);
-		prev.green = static_cast<uint8_t>(ig);
-		prev.blue = static_cast<uint8_t>(ib);
-	}
+	// Convert to 8-bit values
+	smoothing::kernels().quantize(meanValues.data(), reinterpret_cast<uint8_t*>(_previousValues.data()), N);
 }
 
-ALWAYS_INLINE void LinearColorSmoothing::aggregateComponents(const std::vector<ColorRgb>& colors, std::vector<uint64_t>& weighted, const floatT weight) {
-	// Determine the integer-scale by converting the weight to fixed point
-	const uint64_t scale = (static_cast<uint64_t>(1L)<<FPShift) * static_cast<double>(weight);
-
-	const size_t N = colors.size();
-
-	for (size_t i = 0; i < N; ++i)
-	{
-		const ColorRgb &color = colors[i];
-
-		// Scale the colors
-		const uint64_t red = scale * color.red;
-		const uint64_t green = scale * color.green;
-		const uint64_t blue = scale * color.blue;
-
-		// Accumulate in the vector
-		weighted[3 * i + 0] += red;
-		weighted[3 * i + 1] += green;
-		weighted[3 * i + 2] += blue;
-	}
+ALWAYS_INLINE void LinearColorSmoothing::aggregateComponents(const std::vector<ColorRgb>& colors, std::vector<floatT>& weighted, const floatT weight) {
+	// Scale the color components and accumulate in the vector
+	const size_t N = std::min(weighted.size(), 3 * colors.size());
+	smoothing::kernels().accumulate(reinterpret_cast<const uint8_t*>(colors.data()), weighted.data(), N, weight);
 }
 
 void LinearColorSmoothing::interpolateFrame()
@@ -352,13 +334,10 @@ void LinearColorSmoothing::interpolateFrame()
 	}
 
 	/// The inverse scaling factor for the color components, clamped to (0, 1.0]; 1.0 for fs < 1, 1 : fs otherwise
-	const floatT inv_fs = ((fs < 1.0F) ? 1.0F : 1.0F / fs) / (1 << SmallShiftBis);
+	const floatT inv_fs = (fs < 1.0F) ? 1.0F : 1.0F / fs;
 
 	// Normalize the mean component values for the window (fs)
-	for (size_t i = 0; i < 3 * N; ++i)
-	{
-		meanValues[i] = (tempValues[i] >> FPShiftSmall) * inv_fs;
-	}
+	smoothing::kernels().scale(tempValues.data(), meanValues.data(), 3 * N, inv_fs);
 
 	_previousInterpolationTime = now;
 }
@@ -403,7 +382,8 @@ void LinearColorSmoothing::performDecay(const int64_t now) {
 	// Check for sleep when no operation is pending.
 	// As our QTimer is not capable of sub 1ms timing but instead performs spinning -
 	// we have to do µsec-sleep to free CPU time; otherwise the thread would consume 100% CPU time.
-	if(_updateInterval <= 0 && !(interpolatePending || writePending)) {
+	// Not required on the output thread, which is paced by absolute deadlines.
+	if(_outputThread == nullptr && _updateInterval <= 0 && !(interpolatePending || writePending)) {
 		const int64_t nextActionExpected = std::min(interpolationTarget, writeTarget);
 		const int64_t microsTillNextAction = nextActionExpected - now;
 		const int64_t SLEEP_MAX_MICROS = 1000L; // We want to use usleep for up to 1ms
@@ -433,28 +413,20 @@ void LinearColorSmoothing::performDecay(const int64_t now) {
 
 void LinearColorSmoothing::performLinear(const int64_t now) {
 	const int64_t deltaTime = _targetTime - now;
-	const float k = 1.0F - 1.0F * deltaTime / (_targetTime - _previousWriteTime);
-	const size_t N = _previousValues.size();
+	const int64_t transitionTime = _targetTime - _previousWriteTime;
+	const float k = (transitionTime > 0) ? std::min(1.0F, std::max(0.0F, 1.0F - 1.0F * deltaTime / transitionTime)) : 1.0F;
+	const size_t N = std::min(_previousValues.size(), _targetValues.size());
 
-	for (size_t i = 0; i < N; ++i)
-	{
-		const ColorRgb &target = _targetValues[i];
-		ColorRgb &prev         = _previousValues[i];
-
-		const int reddif   = target.red   - prev.red;
-		const int greendif = target.green - prev.green;
-		const int bluedif  = target.blue  - prev.blue;
-
-		prev.red   += (reddif   < 0 ? -1:1) * std::ceil(k * std::abs(reddif));
-		prev.green += (greendif < 0 ? -1:1) * std::ceil(k * std::abs(greendif));
-		prev.blue  += (bluedif  < 0 ? -1:1) * std::ceil(k * std::abs(bluedif));
-	}
+	// Move each color component towards its target
+	smoothing::kernels().linearStep(reinterpret_cast<const uint8_t*>(_targetValues.data()), reinterpret_cast<uint8_t*>(_previousValues.data()), 3 * N, k);
 
 	writeFrame();
 }
 
 void LinearColorSmoothing::updateLeds()
 {
+	TRACE_SCOPE(tracing::Stage::SMOOTHING);
+
 	const int64_t now = micros();
 	const int64_t deltaTime = _targetTime - now;
 
@@ -477,10 +449,26 @@ void LinearColorSmoothing::updateLeds()
 	}
 }
 
-void LinearColorSmoothing::rememberFrame(const std::vector<ColorRgb> &ledColors)
+void LinearColorSmoothing::updateLedsOutputThread()
 {
-	const int64_t now = micros();
+	// Take over the latest frame received by the instance thread
+	if (_frameSlot.consume())
+	{
+		const REMEMBERED_FRAME &frame = _frameSlot.readBuffer();
+		ingestFrame(frame.time, frame.colors);
+	}
+
+	// No frame received yet
+	if (_previousValues.empty())
+	{
+		return;
+	}
+
+	updateLeds();
+}
 
+void LinearColorSmoothing::rememberFrame(const int64_t now, const std::vector<ColorRgb> &ledColors)
+{
 	// Maintain the queue by removing outdated frames
 	const int64_t windowStart = now - (MS_PER_MICRO * _settlingTime);
 
@@ -547,7 +535,14 @@ void LinearColorSmoothing::queueColors(const std::vector<ColorRgb> &ledColors)
 
 void LinearColorSmoothing::clearQueuedColors()
 {
-	_timer->stop();
+	stopOutput();
+
+	// Discard a frame not yet taken over by the output thread
+	if (_frameSlot.consume())
+	{
+		_frameSlot.readBuffer().colors.clear();
+	}
+
 	_previousValues.clear();
 
 	_targetValues.clear();
@@ -555,6 +550,54 @@ void LinearColorSmoothing::clearQueuedColors()
 	clearRememberedFrames();
 }
 
+void LinearColorSmoothing::setOutputThreadEnabled(bool enable)
+{
+	if (enable == (_outputThread != nullptr))
+	{
+		return;
+	}
+
+	// The smoothing state is handed over between timer and output thread, restart from scratch
+	clearQueuedColors();
+
+	if (enable)
+	{
+		_outputThread = new SmoothingOutputThread([this]() { updateLedsOutputThread(); }, _log);
+		_outputThread->setInterval(_updateIntervalMicros);
+		Debug(_log, "Use dedicated output thread");
+	}
+	else
+	{
+		delete _outputThread;
+		_outputThread = nullptr;
+		Debug(_log, "Use instance thread for output");
+	}
+}
+
+void LinearColorSmoothing::startOutput()
+{
+	if (_outputThread != nullptr)
+	{
+		_outputThread->startOutput();
+	}
+	else
+	{
+		_timer->start(_updateInterval);
+	}
+}
+
+void LinearColorSmoothing::stopOutput()
+{
+	if (_outputThread != nullptr)
+	{
+		_outputThread->stopOutput();
+	}
+	else
+	{
+		_timer->stop();
+	}
+}
+
 void LinearColorSmoothing::componentStateChange(hyperion::Components component, bool state)
 {
 	if (component == hyperion::COMP_SMOOTHING)
@@ -592,6 +635,7 @@ unsigned LinearColorSmoothing::addConfig(int settlingTime_ms, double ledUpdateFr
 		ledUpdateFrequency_hz,
 		updateDelay
 	};
+	cfg._updateIntervalMicros = static_cast<int64_t>(MICROS_PER_SECOND / ledUpdateFrequency_hz);
 	_cfgList.append(std::move(cfg));
 
 	DebugIf(verbose && _enabled, _log,"%s", QSTRING_CSTR(getConfig(_cfgList.count()-1)));
@@ -612,6 +656,7 @@ unsigned LinearColorSmoothing::updateConfig(int cfgID, int settlingTime_ms, doub
 			ledUpdateFrequency_hz,
 			updateDelay
 		};
+		cfg._updateIntervalMicros = static_cast<int64_t>(MICROS_PER_SECOND / ledUpdateFrequency_hz);
 		_cfgList[updatedCfgID] = cfg;
 		Debug(_log,"%s", QSTRING_CSTR(getConfig(updatedCfgID)));
 	}
@@ -631,13 +676,21 @@ bool LinearColorSmoothing::selectConfig(int cfgID, bool force)
 
 	if (cfgID < _cfgList.count() )
 	{
+		// The output thread owns the smoothing state while running, stop it while the configuration is applied
+		const bool isOutputThreadRunning = _outputThread != nullptr && _outputThread->isRunning();
+		if (isOutputThreadRunning)
+		{
+			_outputThread->stopOutput();
+		}
+
 		_smoothingType = _cfgList[cfgID]._type;
 		_settlingTime = _cfgList[cfgID]._settlingTime;
 		_outputDelay = _cfgList[cfgID]._outputDelay;
 		_pause = _cfgList[cfgID]._pause;
-		_outputIntervalMicros = int64_t(1000000.0 / _updateInterval); // 1s = 1e6 µs
+		_updateIntervalMicros = _cfgList[cfgID]._updateIntervalMicros;
+		_outputIntervalMicros = _updateIntervalMicros;
 		_interpolationRate = _cfgList[cfgID]._interpolationRate;
-		_interpolationIntervalMicros = int64_t(1000000.0 / _interpolationRate);
+		_interpolationIntervalMicros = int64_t(MICROS_PER_SECOND / _interpolationRate);
 		_dithering = _cfgList[cfgID]._dithering;
 		_decay = _cfgList[cfgID]._decay;
 		_invWindow = 1.0F / (MS_PER_MICRO * _settlingTime);
@@ -683,7 +736,24 @@ bool LinearColorSmoothing::selectConfig(int cfgID, bool force)
 			setEnable(_enabledSystemCfg);
 		}
 
-		if (_cfgList[cfgID]._updateInterval != _updateInterval)
+		if (_outputThread != nullptr)
+		{
+			_updateInterval = _cfgList[cfgID]._updateInterval;
+
+			// Decay smoothing interpolates independently of the output rate
+			int64_t tickIntervalMicros = _updateIntervalMicros;
+			if (_smoothingType == SmoothingType::Decay && _interpolationIntervalMicros > 0)
+			{
+				tickIntervalMicros = std::min(tickIntervalMicros, _interpolationIntervalMicros);
+			}
+			_outputThread->setInterval(tickIntervalMicros);
+
+			if (this->enabled() && !_pause && (isOutputThreadRunning || !_targetValues.empty() || _frameSlot.pending()))
+			{
+				_outputThread->startOutput();
+			}
+		}
+		else if (_cfgList[cfgID]._updateInterval != _updateInterval)
 		{
 
 			_timer->stop();
@@ -752,6 +822,7 @@ LinearColorSmoothing::SmoothingCfg::SmoothingCfg() :
 	  _pause(false),
 	  _settlingTime(DEFAULT_SETTLINGTIME),
 	  _updateInterval(DEFAULT_UPDATEFREQUENCY),
+	  _updateIntervalMicros(DEFAULT_UPDATEINTERVALL.count() * MS_PER_MICRO),
 	  _type(SmoothingType::Linear)
 {
 }
@@ -760,6 +831,7 @@ LinearColorSmoothing::SmoothingCfg::SmoothingCfg(bool pause, int64_t settlingTim
 	  _pause(pause),
 	  _settlingTime(settlingTime),
 	  _updateInterval(updateInterval),
+	  _updateIntervalMicros(updateInterval * MS_PER_MICRO),
 	  _type(type),
 	  _interpolationRate(interpolationRate),
 	  _outputDelay(outputDelay),
@@ -1,5 +1,6 @@
 // STL includes
 #include <algorithm>
+#include <functional>
 #include <limits>
 
 // qt incl
@@ -20,6 +21,21 @@ const int PriorityMuxer::TIMEOUT_NOT_ACTIVE_PRIO = -100;
 const int PriorityMuxer::REMOVE_CLEARED_PRIO = -101;
 const int PriorityMuxer::ENDLESS = -1;
 
+namespace {
+
+// COLOR, EFFECT and (non streaming) IMAGE inputs with a timeout report their remaining duration in 1s interval, blacklist prio 255
+bool hasDurationUpdates(const PriorityMuxer::InputInfo& input)
+{
+	return input.priority < PriorityMuxer::BG_PRIORITY &&
+		   input.timeoutTime_ms > 0 &&
+		   ( input.componentId == hyperion::COMP_EFFECT ||
+			 input.componentId == hyperion::COMP_COLOR ||
+			 (input.componentId == hyperion::COMP_IMAGE && input.owner != "Streaming")
+			 );
+}
+
+} // namespace
+
 PriorityMuxer::PriorityMuxer(int ledCount, QObject * parent)
 	: QObject(parent)
 	  , _log(nullptr)
@@ -29,6 +45,9 @@ PriorityMuxer::PriorityMuxer(int ledCount, QObject * parent)
 	  , _prevVisComp (hyperion::Components::COMP_COLOR)
 	  , _sourceAutoSelectEnabled(true)
 	  , _updateTimer(new QTimer(this))
+	  , _armedDeadline(-1)
+	  , _updatePending(false)
+	  , _enabled(true)
 	  , _timer(new QTimer(this))
 	  , _blockTimer(new QTimer(this))
 {
@@ -54,10 +73,10 @@ PriorityMuxer::PriorityMuxer(int ledCount, QObject * parent)
 	_blockTimer->setSingleShot(true);
 	connect(this, &PriorityMuxer::signalTimeTrigger, this, &PriorityMuxer::timeTrigger);
 
-	// start muxer timer
+	// the priorities are updated on changes and exactly at the next timeout, there is no polling
 	connect(_updateTimer, &QTimer::timeout, this, &PriorityMuxer::updatePriorities);
-	_updateTimer->setInterval(250);
-	_updateTimer->start();
+	_updateTimer->setSingleShot(true);
+	_updateTimer->setTimerType(Qt::PreciseTimer);
 }
 
 PriorityMuxer::~PriorityMuxer()
@@ -66,7 +85,18 @@ PriorityMuxer::~PriorityMuxer()
 
 void PriorityMuxer::setEnable(bool enable)
 {
-	enable ? _updateTimer->start() : _updateTimer->stop();
+	_enabled = enable;
+	if (enable)
+	{
+		// apply the changes and timeouts meanwhile
+		scheduleUpdate();
+	}
+	else
+	{
+		_updateTimer->stop();
+		_armedDeadline = -1;
+		_updatePending = false;
+	}
 }
 
 bool PriorityMuxer::setSourceAutoSelectEnabled(bool enable, bool update)
@@ -87,6 +117,7 @@ bool PriorityMuxer::setSourceAutoSelectEnabled(bool enable, bool update)
 		if(update)
 		{
 			emit prioritiesChanged(_currentPriority,_activeInputs);
+			scheduleUpdate();
 		}
 
 		return true;
@@ -98,9 +129,16 @@ bool PriorityMuxer::setPriority(int priority)
 {
 	if(_activeInputs.contains(priority))
 	{
+		const bool isChanged = (_manualSelectedPriority != priority);
 		_manualSelectedPriority = priority;
 		// update auto select state -> update _currentPriority
 		setSourceAutoSelectEnabled(false);
+
+		// auto selection might be disabled already, apply another manual selection anyway
+		if (isChanged)
+		{
+			scheduleUpdate();
+		}
 		return true;
 	}
 	return false;
@@ -152,8 +190,9 @@ void PriorityMuxer::registerInput(int priority, hyperion::Components component,
 {
 	// detect new registers
 	bool newInput = false;
+	const bool isRegistered = _activeInputs.contains(priority);
 
-	if (!_activeInputs.contains(priority))
+	if (!isRegistered)
 	{
 		newInput = true;
 	}
@@ -166,6 +205,8 @@ void PriorityMuxer::registerInput(int priority, hyperion::Components component,
 	}
 
 	InputInfo& input     = _activeInputs[priority];
+	// a changed component or owner of an existing input may change the visible priority or its duration updates
+	const bool inputChanged = isRegistered && (input.componentId != component || input.owner != owner);
 	input.priority       = priority;
 	input.timeoutTime_ms = newInput ? TIMEOUT_NOT_ACTIVE_PRIO : input.timeoutTime_ms;
 	input.componentId    = component;
@@ -181,6 +222,11 @@ void PriorityMuxer::registerInput(int priority, hyperion::Components component,
 	{
 		Debug(_log,"Reuse input '%s/%s' (%s) with priority %d", QSTRING_CSTR(origin), hyperion::componentToIdString(component), QSTRING_CSTR(owner), priority);
 	}
+
+	if (inputChanged)
+	{
+		scheduleUpdate();
+	}
 }
 
 bool PriorityMuxer::setInput(int priority, const std::vector<ColorRgb>& ledColors, int64_t timeout_ms)
@@ -230,10 +276,16 @@ bool PriorityMuxer::setInput(int priority, const std::vector<ColorRgb>& ledColor
 	}
 
 	// update input
+	const bool deadlineChanged = (timeout_ms > 0 && timeout_ms != input.timeoutTime_ms);
 	input.timeoutTime_ms = timeout_ms;
 	input.ledColors      = ledColors;
 	input.image.clear();
 
+	if (deadlineChanged)
+	{
+		addDeadline(priority, timeout_ms);
+	}
+
 	// emit active change
 	if(activeChange)
 	{
@@ -281,10 +333,16 @@ bool PriorityMuxer::setInputImage(int priority, const Image<ColorRgb>& image, in
 		activeChange = true;
 	}
 	// update input
+	const bool deadlineChanged = (timeout_ms > 0 && timeout_ms != input.timeoutTime_ms);
 	input.timeoutTime_ms = timeout_ms;
 	input.image          = image;
 	input.ledColors.clear();
 
+	if (deadlineChanged)
+	{
+		addDeadline(priority, timeout_ms);
+	}
+
 	// emit active change
 	if(activeChange)
 	{
@@ -310,6 +368,7 @@ bool PriorityMuxer::clearInput(int priority)
 	if (priority < PriorityMuxer::LOWEST_PRIORITY)
 	{
 		_activeInputs[priority].timeoutTime_ms = REMOVE_CLEARED_PRIO;
+		scheduleUpdate();
 		return true;
 	}
 	return false;
@@ -338,8 +397,83 @@ void PriorityMuxer::clearAll(bool forceClearAll)
 	}
 }
 
+void PriorityMuxer::addDeadline(int priority, int64_t timeoutTime_ms)
+{
+	if (_deadlines.size() >= 2 * static_cast<size_t>(_activeInputs.size()) + 16)
+	{
+		// mostly outdated entries of channels updating their timeout, rebuild the index from the channels
+		_deadlines.clear();
+		for (const InputInfo& input : std::as_const(_activeInputs))
+		{
+			if (input.timeoutTime_ms > 0)
+			{
+				_deadlines.push_back({input.timeoutTime_ms, input.priority});
+			}
+		}
+		std::make_heap(_deadlines.begin(), _deadlines.end(), std::greater<Deadline>());
+	}
+	else
+	{
+		_deadlines.push_back({timeoutTime_ms, priority});
+		std::push_heap(_deadlines.begin(), _deadlines.end(), std::greater<Deadline>());
+	}
+
+	if (_armedDeadline < 0 || timeoutTime_ms < _armedDeadline)
+	{
+		armDeadlineTimer();
+	}
+}
+
+void PriorityMuxer::armDeadlineTimer()
+{
+	// drop the deadlines of removed channels or channels with a changed timeout
+	while (!_deadlines.empty())
+	{
+		const Deadline& next = _deadlines.front();
+		auto inputIt = _activeInputs.constFind(next.priority);
+		if (inputIt != _activeInputs.constEnd() && inputIt->timeoutTime_ms == next.timeoutTime_ms)
+		{
+			break;
+		}
+		std::pop_heap(_deadlines.begin(), _deadlines.end(), std::greater<Deadline>());
+		_deadlines.pop_back();
+	}
+
+	if (!_enabled || _updatePending)
+	{
+		return;
+	}
+
+	if (_deadlines.empty())
+	{
+		_armedDeadline = -1;
+		_updateTimer->stop();
+		return;
+	}
+
+	const int64_t next = _deadlines.front().timeoutTime_ms;
+	if (next != _armedDeadline || !_updateTimer->isActive())
+	{
+		_armedDeadline = next;
+		const int64_t remaining = qBound<int64_t>(0, next - QDateTime::currentMSecsSinceEpoch(), std::numeric_limits<int>::max());
+		_updateTimer->start(static_cast<int>(remaining));
+	}
+}
+
+void PriorityMuxer::scheduleUpdate()
+{
+	if (_enabled && !_updatePending)
+	{
+		_updatePending = true;
+		_armedDeadline = -1;
+		_updateTimer->start(0);
+	}
+}
+
 void PriorityMuxer::updatePriorities()
 {
+	_updatePending = false;
+
 	const int64_t now = QDateTime::currentMSecsSinceEpoch();
 	int newPriority;
 	bool priorityChanged {false};
@@ -379,14 +513,8 @@ void PriorityMuxer::updatePriorities()
 					newPriority = qMin(newPriority, i.value().priority);
 				}
 
-				// call timeTrigger when effect or color is running with timeout > 0, blacklist prio 255
-				if (i.value().priority < BG_PRIORITY &&
-					 i.value().timeoutTime_ms > 0 &&
-					 ( i.value().componentId == hyperion::COMP_EFFECT ||
-					   i.value().componentId == hyperion::COMP_COLOR ||
-					   (i.value().componentId == hyperion::COMP_IMAGE && i.value().owner != "Streaming")
-					   )
-					 )
+				// call timeTrigger when effect or color is running with timeout > 0
+				if (hasDurationUpdates(i.value()))
 				{
 					timeTrigger = true;
 				}
@@ -394,7 +522,8 @@ void PriorityMuxer::updatePriorities()
 		}
 	}
 
-	if (timeTrigger)
+	// the 1s interval continues on its own while running
+	if (timeTrigger && !_timer->isActive())
 	{
 		emit signalTimeTrigger(); // signal to prevent Threading issues
 	}
@@ -434,6 +563,8 @@ void PriorityMuxer::updatePriorities()
 	{
 		emit prioritiesChanged(_currentPriority,_activeInputs);
 	}
+
+	armDeadlineTimer();
 }
 
 void PriorityMuxer::timeTrigger()
@@ -446,5 +577,15 @@ void PriorityMuxer::timeTrigger()
 	{
 		_blockTimer->start(1000);
 		emit prioritiesChanged(_currentPriority,_activeInputs);
+
+		// continue as long as inputs with a timeout are running, idle instances are not woken up
+		for (const InputInfo& input : std::as_const(_activeInputs))
+		{
+			if (hasDurationUpdates(input))
+			{
+				_timer->start(1000);
+				break;
+			}
+		}
 	}
 }
@@ -26,16 +26,24 @@ namespace {
 
 QJsonObject SettingsManager::schemaJson;
 
+namespace {
+	// the schema is compiled once for all instances and validations
+	const QJsonSchemaChecker::CompiledSchema& compiledSchema(const QJsonObject& schema)
+	{
+		static const QJsonSchemaChecker::CompiledSchema compiled = QJsonSchemaChecker::compile(schema);
+		return compiled;
+	}
+}
+
 SettingsManager::SettingsManager(quint8 instance, QObject* parent, bool readonlyMode)
 	: QObject(parent)
 	, _log(Logger::getInstance("SETTINGSMGR", "I" + QString::number(instance)))
 	, _instance(instance)
-	, _sTable(new SettingsTable(instance, this))
+	, _sTable(new SettingsTable(instance, this, readonlyMode))
 	, _configVersion(DEFAULT_VERSION)
 	, _previousVersion(DEFAULT_VERSION)
 	, _readonlyMode(readonlyMode)
 {
-	_sTable->setReadonlyMode(_readonlyMode);
 	// get schema
 	if (schemaJson.isEmpty())
 	{
@@ -73,6 +81,7 @@ SettingsManager::SettingsManager(quint8 instance, QObject* parent, bool readonly
 	}
 
 	// fill database with default data if required
+	const bool transaction = _sTable->startTransaction();
 	for (const auto& key : keyList)
 	{
 		QString val = defValueList.takeFirst();
@@ -82,6 +91,10 @@ SettingsManager::SettingsManager(quint8 instance, QObject* parent, bool readonly
 			_sTable->createSettingsRecord(key, val);
 		}
 	}
+	if (transaction)
+	{
+		_sTable->commitTransaction();
+	}
 
 	// need to validate all data in database construct the entire data object
 	// TODO refactor schemaChecker to accept QJsonArray in validate(); QJsonDocument container? To validate them per entry...
@@ -155,7 +168,7 @@ SettingsManager::SettingsManager(quint8 instance, QObject* parent, bool readonly
 
 	// validate full dbconfig against schema, on error we need to rewrite entire table
 	QJsonSchemaChecker schemaChecker;
-	schemaChecker.setSchema(schemaJson);
+	schemaChecker.setSchema(compiledSchema(schemaJson));
 	QPair<bool, bool> valid = schemaChecker.validate(dbConfig);
 	// check if our main schema syntax is IO
 	if (!valid.second)
@@ -221,7 +234,7 @@ bool SettingsManager::saveSettings(QJsonObject config, bool correct)
 {
 	// we need to validate data against schema
 	QJsonSchemaChecker schemaChecker;
-	schemaChecker.setSchema(schemaJson);
+	schemaChecker.setSchema(compiledSchema(schemaJson));
 	if (!schemaChecker.validate(config).first)
 	{
 		if (!correct)
@@ -257,6 +270,10 @@ bool SettingsManager::saveSettings(QJsonObject config, bool correct)
 	}
 
 	bool rc = true;
+	// all changes are written at once, the changed settings are emitted after the commit
+	const bool transaction = _sTable->startTransaction();
+	QVector<QPair<settings::type, QJsonDocument>> changedSettings;
+
 	// compare database data with new data to emit/save changes accordingly
 	for (const auto& key : keyList)
 	{
@@ -276,11 +293,21 @@ bool SettingsManager::saveSettings(QJsonObject config, bool correct)
 					rc = false;
 				}
 				else {
-					emit settingsChanged(settings::stringToType(key), jsonDocument);
+					changedSettings.append(qMakePair(settings::stringToType(key), jsonDocument));
 				}
 			}
 		}
 	}
+
+	if (transaction && !_sTable->commitTransaction())
+	{
+		return false;
+	}
+
+	for (const auto& setting : changedSettings)
+	{
+		emit settingsChanged(setting.first, setting.second);
+	}
 	return rc;
 }
 
@@ -0,0 +1,458 @@
+#include <hyperion/SmoothingKernels.h>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__)) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SMOOTHING_KERNELS_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define SMOOTHING_KERNELS_AVX2
+#include <immintrin.h>
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SMOOTHING_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace smoothing {
+
+namespace {
+
+/// Rounds half away from zero and clamps to the byte-interval of [0, 255]
+inline uint8_t roundClamp(float value)
+{
+	return static_cast<uint8_t>(static_cast<int>(std::min(255.0F, std::max(0.0F, value)) + 0.5F));
+}
+
+//
+// Scalar reference implementation
+//
+
+void accumulateScalar(const uint8_t* src, float* acc, size_t count, float weight)
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		acc[i] += weight * static_cast<float>(src[i]);
+	}
+}
+
+void scaleScalar(const float* src, float* dst, size_t count, float factor)
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		dst[i] = src[i] * factor;
+	}
+}
+
+void quantizeScalar(const float* values, uint8_t* dst, size_t count)
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		dst[i] = roundClamp(values[i]);
+	}
+}
+
+void quantizeDitheredScalar(const float* values, float* residuals, uint8_t* dst, size_t count)
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		// Add residuals for error diffusion (temporal dithering)
+		const float value = values[i] + residuals[i];
+		const uint8_t quantized = roundClamp(value);
+
+		dst[i] = quantized;
+		residuals[i] = value - static_cast<float>(quantized);
+	}
+}
+
+void linearStepScalar(const uint8_t* target, uint8_t* current, size_t count, float k)
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		const int diff = target[i] - current[i];
+		const float step = std::ceil(k * static_cast<float>(std::abs(diff)));
+		current[i] = static_cast<uint8_t>(current[i] + (diff < 0 ? -step : step));
+	}
+}
+
+const Kernels SCALAR_KERNELS = {
+	"scalar",
+	accumulateScalar,
+	scaleScalar,
+	quantizeScalar,
+	quantizeDitheredScalar,
+	linearStepScalar
+};
+
+#if defined(SMOOTHING_KERNELS_SSE2)
+//
+// SSE2 implementation, processes 16 components per iteration
+//
+
+/// Widens 16 bytes to four vectors of floats
+inline void unpackBytesSse2(const uint8_t* src, __m128 out[4])
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+	const __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+	const __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+	out[0] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero));
+	out[1] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero));
+	out[2] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero));
+	out[3] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero));
+}
+
+/// Rounds and clamps four vectors of floats to [0, 255] as integers
+inline __m128i roundClampSse2(__m128 value)
+{
+	const __m128 clamped = _mm_min_ps(_mm_set1_ps(255.0F), _mm_max_ps(_mm_setzero_ps(), value));
+	return _mm_cvttps_epi32(_mm_add_ps(clamped, _mm_set1_ps(0.5F)));
+}
+
+/// Narrows four vectors of integers in [0, 255] to 16 bytes
+inline void packBytesSse2(const __m128i in[4], uint8_t* dst)
+{
+	const __m128i lo = _mm_packs_epi32(in[0], in[1]);
+	const __m128i hi = _mm_packs_epi32(in[2], in[3]);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(lo, hi));
+}
+
+void accumulateSse2(const uint8_t* src, float* acc, size_t count, float weight)
+{
+	const __m128 w = _mm_set1_ps(weight);
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16)
+	{
+		__m128 v[4];
+		unpackBytesSse2(src + i, v);
+		for (int j = 0; j < 4; ++j)
+		{
+			float* a = acc + i + 4 * j;
+			_mm_storeu_ps(a, _mm_add_ps(_mm_loadu_ps(a), _mm_mul_ps(w, v[j])));
+		}
+	}
+	accumulateScalar(src + i, acc + i, count - i, weight);
+}
+
+void scaleSse2(const float* src, float* dst, size_t count, float factor)
+{
+	const __m128 f = _mm_set1_ps(factor);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(src + i), f));
+	}
+	scaleScalar(src + i, dst + i, count - i, factor);
+}
+
+void quantizeSse2(const float* values, uint8_t* dst, size_t count)
+{
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16)
+	{
+		__m128i q[4];
+		for (int j = 0; j < 4; ++j)
+		{
+			q[j] = roundClampSse2(_mm_loadu_ps(values + i + 4 * j));
+		}
+		packBytesSse2(q, dst + i);
+	}
+	quantizeScalar(values + i, dst + i, count - i);
+}
+
+void quantizeDitheredSse2(const float* values, float* residuals, uint8_t* dst, size_t count)
+{
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16)
+	{
+		__m128i q[4];
+		for (int j = 0; j < 4; ++j)
+		{
+			const __m128 value = _mm_add_ps(_mm_loadu_ps(values + i + 4 * j), _mm_loadu_ps(residuals + i + 4 * j));
+			q[j] = roundClampSse2(value);
+			_mm_storeu_ps(residuals + i + 4 * j, _mm_sub_ps(value, _mm_cvtepi32_ps(q[j])));
+		}
+		packBytesSse2(q, dst + i);
+	}
+	quantizeDitheredScalar(values + i, residuals + i, dst + i, count - i);
+}
+
+void linearStepSse2(const uint8_t* target, uint8_t* current, size_t count, float k)
+{
+	const __m128 vk = _mm_set1_ps(k);
+	const __m128 one = _mm_set1_ps(1.0F);
+	const __m128 signMask = _mm_set1_ps(-0.0F);
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16)
+	{
+		__m128 t[4];
+		__m128 c[4];
+		__m128i q[4];
+		unpackBytesSse2(target + i, t);
+		unpackBytesSse2(current + i, c);
+		for (int j = 0; j < 4; ++j)
+		{
+			const __m128 diff = _mm_sub_ps(t[j], c[j]);
+			const __m128 x = _mm_mul_ps(vk, _mm_andnot_ps(signMask, diff));
+
+			// ceil(x) for x >= 0
+			const __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+			const __m128 step = _mm_add_ps(truncated, _mm_and_ps(_mm_cmplt_ps(truncated, x), one));
+
+			q[j] = _mm_cvttps_epi32(_mm_add_ps(c[j], _mm_or_ps(step, _mm_and_ps(diff, signMask))));
+		}
+		packBytesSse2(q, current + i);
+	}
+	linearStepScalar(target + i, current + i, count - i, k);
+}
+
+const Kernels SSE2_KERNELS = {
+	"SSE2",
+	accumulateSse2,
+	scaleSse2,
+	quantizeSse2,
+	quantizeDitheredSse2,
+	linearStepSse2
+};
+#endif
+
+#if defined(SMOOTHING_KERNELS_AVX2)
+//
+// AVX2 implementation, processes 8 components per iteration
+//
+
+TARGET_AVX2 inline __m256 unpackBytesAvx2(const uint8_t* src)
+{
+	return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src))));
+}
+
+TARGET_AVX2 inline __m256i roundClampAvx2(__m256 value)
+{
+	const __m256 clamped = _mm256_min_ps(_mm256_set1_ps(255.0F), _mm256_max_ps(_mm256_setzero_ps(), value));
+	return _mm256_cvttps_epi32(_mm256_add_ps(clamped, _mm256_set1_ps(0.5F)));
+}
+
+TARGET_AVX2 inline void packBytesAvx2(__m256i in, uint8_t* dst)
+{
+	const __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(in), _mm256_extracti128_si256(in, 1));
+	_mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(words, words));
+}
+
+TARGET_AVX2 void accumulateAvx2(const uint8_t* src, float* acc, size_t count, float weight)
+{
+	const __m256 w = _mm256_set1_ps(weight);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		_mm256_storeu_ps(acc + i, _mm256_add_ps(_mm256_loadu_ps(acc + i), _mm256_mul_ps(w, unpackBytesAvx2(src + i))));
+	}
+	accumulateScalar(src + i, acc + i, count - i, weight);
+}
+
+TARGET_AVX2 void scaleAvx2(const float* src, float* dst, size_t count, float factor)
+{
+	const __m256 f = _mm256_set1_ps(factor);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		_mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(src + i), f));
+	}
+	scaleScalar(src + i, dst + i, count - i, factor);
+}
+
+TARGET_AVX2 void quantizeAvx2(const float* values, uint8_t* dst, size_t count)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		packBytesAvx2(roundClampAvx2(_mm256_loadu_ps(values + i)), dst + i);
+	}
+	quantizeScalar(values + i, dst + i, count - i);
+}
+
+TARGET_AVX2 void quantizeDitheredAvx2(const float* values, float* residuals, uint8_t* dst, size_t count)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		const __m256 value = _mm256_add_ps(_mm256_loadu_ps(values + i), _mm256_loadu_ps(residuals + i));
+		const __m256i q = roundClampAvx2(value);
+		_mm256_storeu_ps(residuals + i, _mm256_sub_ps(value, _mm256_cvtepi32_ps(q)));
+		packBytesAvx2(q, dst + i);
+	}
+	quantizeDitheredScalar(values + i, residuals + i, dst + i, count - i);
+}
+
+TARGET_AVX2 void linearStepAvx2(const uint8_t* target, uint8_t* current, size_t count, float k)
+{
+	const __m256 vk = _mm256_set1_ps(k);
+	const __m256 signMask = _mm256_set1_ps(-0.0F);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		const __m256 c = unpackBytesAvx2(current + i);
+		const __m256 diff = _mm256_sub_ps(unpackBytesAvx2(target + i), c);
+		const __m256 step = _mm256_round_ps(_mm256_mul_ps(vk, _mm256_andnot_ps(signMask, diff)), _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+		packBytesAvx2(_mm256_cvttps_epi32(_mm256_add_ps(c, _mm256_or_ps(step, _mm256_and_ps(diff, signMask)))), current + i);
+	}
+	linearStepScalar(target + i, current + i, count - i, k);
+}
+
+const Kernels AVX2_KERNELS = {
+	"AVX2",
+	accumulateAvx2,
+	scaleAvx2,
+	quantizeAvx2,
+	quantizeDitheredAvx2,
+	linearStepAvx2
+};
+#endif
+
+#if defined(SMOOTHING_KERNELS_NEON)
+//
+// NEON implementation, processes 8 components per iteration
+//
+
+inline void unpackBytesNeon(const uint8_t* src, float32x4_t out[2])
+{
+	const uint16x8_t words = vmovl_u8(vld1_u8(src));
+	out[0] = vcvtq_f32_u32(vmovl_u16(vget_low_u16(words)));
+	out[1] = vcvtq_f32_u32(vmovl_u16(vget_high_u16(words)));
+}
+
+inline uint32x4_t roundClampNeon(float32x4_t value)
+{
+	const float32x4_t clamped = vminq_f32(vdupq_n_f32(255.0F), vmaxq_f32(vdupq_n_f32(0.0F), value));
+	return vcvtq_u32_f32(vaddq_f32(clamped, vdupq_n_f32(0.5F)));
+}
+
+inline void packBytesNeon(uint32x4_t lo, uint32x4_t hi, uint8_t* dst)
+{
+	vst1_u8(dst, vmovn_u16(vcombine_u16(vmovn_u32(lo), vmovn_u32(hi))));
+}
+
+void accumulateNeon(const uint8_t* src, float* acc, size_t count, float weight)
+{
+	const float32x4_t w = vdupq_n_f32(weight);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		float32x4_t v[2];
+		unpackBytesNeon(src + i, v);
+		vst1q_f32(acc + i, vaddq_f32(vld1q_f32(acc + i), vmulq_f32(w, v[0])));
+		vst1q_f32(acc + i + 4, vaddq_f32(vld1q_f32(acc + i + 4), vmulq_f32(w, v[1])));
+	}
+	accumulateScalar(src + i, acc + i, count - i, weight);
+}
+
+void scaleNeon(const float* src, float* dst, size_t count, float factor)
+{
+	const float32x4_t f = vdupq_n_f32(factor);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		vst1q_f32(dst + i, vmulq_f32(vld1q_f32(src + i), f));
+	}
+	scaleScalar(src + i, dst + i, count - i, factor);
+}
+
+void quantizeNeon(const float* values, uint8_t* dst, size_t count)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		packBytesNeon(roundClampNeon(vld1q_f32(values + i)), roundClampNeon(vld1q_f32(values + i + 4)), dst + i);
+	}
+	quantizeScalar(values + i, dst + i, count - i);
+}
+
+void quantizeDitheredNeon(const float* values, float* residuals, uint8_t* dst, size_t count)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		uint32x4_t q[2];
+		for (int j = 0; j < 2; ++j)
+		{
+			const float32x4_t value = vaddq_f32(vld1q_f32(values + i + 4 * j), vld1q_f32(residuals + i + 4 * j));
+			q[j] = roundClampNeon(value);
+			vst1q_f32(residuals + i + 4 * j, vsubq_f32(value, vcvtq_f32_u32(q[j])));
+		}
+		packBytesNeon(q[0], q[1], dst + i);
+	}
+	quantizeDitheredScalar(values + i, residuals + i, dst + i, count - i);
+}
+
+void linearStepNeon(const uint8_t* target, uint8_t* current, size_t count, float k)
+{
+	const float32x4_t vk = vdupq_n_f32(k);
+	const float32x4_t one = vdupq_n_f32(1.0F);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		float32x4_t t[2];
+		float32x4_t c[2];
+		uint32x4_t q[2];
+		unpackBytesNeon(target + i, t);
+		unpackBytesNeon(current + i, c);
+		for (int j = 0; j < 2; ++j)
+		{
+			const float32x4_t diff = vsubq_f32(t[j], c[j]);
+			const float32x4_t x = vmulq_f32(vk, vabsq_f32(diff));
+
+			// ceil(x) for x >= 0
+			const float32x4_t truncated = vcvtq_f32_u32(vcvtq_u32_f32(x));
+			const float32x4_t step = vbslq_f32(vcltq_f32(truncated, x), vaddq_f32(truncated, one), truncated);
+
+			const float32x4_t result = vbslq_f32(vcltq_f32(diff, vdupq_n_f32(0.0F)), vsubq_f32(c[j], step), vaddq_f32(c[j], step));
+			q[j] = vcvtq_u32_f32(result);
+		}
+		packBytesNeon(q[0], q[1], current + i);
+	}
+	linearStepScalar(target + i, current + i, count - i, k);
+}
+
+const Kernels NEON_KERNELS = {
+	"NEON",
+	accumulateNeon,
+	scaleNeon,
+	quantizeNeon,
+	quantizeDitheredNeon,
+	linearStepNeon
+};
+#endif
+
+const Kernels& selectKernels()
+{
+#if defined(SMOOTHING_KERNELS_AVX2)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+	{
+		return AVX2_KERNELS;
+	}
+#endif
+#if defined(SMOOTHING_KERNELS_SSE2)
+	return SSE2_KERNELS;
+#elif defined(SMOOTHING_KERNELS_NEON)
+	return NEON_KERNELS;
+#else
+	return SCALAR_KERNELS;
+#endif
+}
+
+} // End of anonymous namespace
+
+const Kernels& kernels()
+{
+	static const Kernels& selected = selectKernels();
+	return selected;
+}
+
+const Kernels& scalarKernels()
+{
+	return SCALAR_KERNELS;
+}
+
+} // namespace smoothing
@@ -0,0 +1,194 @@
+#include <hyperion/SmoothingOutputThread.h>
+
+#include <utils/Logger.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+#ifdef __linux__
+#include <cerrno>
+#include <ctime>
+#endif
+
+namespace {
+
+/// The number of microseconds per second
+const int64_t MICROS_PER_SECOND = 1000000;
+
+/// Smallest supported tick interval (µs), protects against busy looping
+const int64_t MIN_INTERVAL_MICROS = 100;
+
+/// Length of a statistics measurement window (µs)
+const int64_t STATISTICS_WINDOW_MICROS = 30 * MICROS_PER_SECOND;
+
+} // End of constants
+
+SmoothingOutputThread::SmoothingOutputThread(std::function<void()> tick, Logger* log, QObject* parent)
+	: QThread(parent)
+	, _tick(std::move(tick))
+	, _log(log)
+	, _intervalMicros(MICROS_PER_SECOND / 25)
+	, _stopRequested(false)
+	, _windowStart(0)
+	, _intervalSum(0.0)
+	, _jitterSum(0.0)
+{
+}
+
+SmoothingOutputThread::~SmoothingOutputThread()
+{
+	stopOutput();
+}
+
+void SmoothingOutputThread::setInterval(int64_t intervalMicros)
+{
+	_intervalMicros = std::max(intervalMicros, MIN_INTERVAL_MICROS);
+}
+
+void SmoothingOutputThread::startOutput()
+{
+	if (!isRunning())
+	{
+		_stopRequested = false;
+		start(QThread::TimeCriticalPriority);
+	}
+}
+
+void SmoothingOutputThread::stopOutput()
+{
+	if (isRunning())
+	{
+		_stopRequested = true;
+		wait();
+	}
+}
+
+SmoothingOutputThread::JitterStatistics SmoothingOutputThread::getStatistics() const
+{
+	QMutexLocker lock(&_statisticsMutex);
+	return _statistics;
+}
+
+int64_t SmoothingOutputThread::monotonicMicros()
+{
+#ifdef __linux__
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<int64_t>(ts.tv_sec) * MICROS_PER_SECOND + ts.tv_nsec / 1000;
+#else
+	const auto now = std::chrono::steady_clock::now();
+	return std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+#endif
+}
+
+void SmoothingOutputThread::sleepUntil(int64_t deadlineMicros)
+{
+#ifdef __linux__
+	struct timespec deadline;
+	deadline.tv_sec = static_cast<time_t>(deadlineMicros / MICROS_PER_SECOND);
+	deadline.tv_nsec = static_cast<long>((deadlineMicros % MICROS_PER_SECOND) * 1000);
+
+	// Absolute deadlines are robust against signals, just resume sleeping
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR)
+	{
+	}
+#else
+	std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::microseconds(deadlineMicros)));
+#endif
+}
+
+void SmoothingOutputThread::run()
+{
+	const int64_t interval = _intervalMicros;
+
+	int64_t now = monotonicMicros();
+	int64_t deadline = now + interval;
+	int64_t previousTick = 0;
+
+	_window = JitterStatistics();
+	_window.intervalMicros = interval;
+	_windowStart = now;
+	_intervalSum = 0.0;
+	_jitterSum = 0.0;
+
+	Debug(_log, "Output thread started, interval: %lldµs (%.2fHz)", static_cast<long long>(interval), 1.0 * MICROS_PER_SECOND / interval);
+
+	while (!_stopRequested.load(std::memory_order_relaxed))
+	{
+		sleepUntil(deadline);
+
+		now = monotonicMicros();
+		recordTick(now, deadline, previousTick);
+		previousTick = now;
+
+		_tick();
+
+		// The next deadline is derived from the previous one and not from the current time to avoid drift.
+		// In case we are behind by more than one interval, the missed deadlines are skipped.
+		deadline += interval;
+		if (now - deadline >= interval)
+		{
+			const int64_t missed = (now - deadline) / interval;
+			_window.missedDeadlines += missed;
+			deadline += missed * interval;
+		}
+
+		if (now - _windowStart >= STATISTICS_WINDOW_MICROS)
+		{
+			finishWindow(now);
+		}
+	}
+
+	Debug(_log, "Output thread stopped");
+}
+
+void SmoothingOutputThread::recordTick(int64_t now, int64_t deadline, int64_t previousTick)
+{
+	_window.maxLatenessMicros = std::max(_window.maxLatenessMicros, now - deadline);
+
+	if (previousTick > 0)
+	{
+		const int64_t measured = now - previousTick;
+		if (_window.ticks == 0 || measured < _window.minIntervalMicros)
+		{
+			_window.minIntervalMicros = measured;
+		}
+		_window.maxIntervalMicros = std::max(_window.maxIntervalMicros, measured);
+
+		_intervalSum += measured;
+		_jitterSum += std::llabs(measured - _window.intervalMicros);
+		++_window.ticks;
+	}
+}
+
+void SmoothingOutputThread::finishWindow(int64_t now)
+{
+	if (_window.ticks > 0)
+	{
+		_window.avgIntervalMicros = _intervalSum / _window.ticks;
+		_window.meanJitterMicros = _jitterSum / _window.ticks;
+
+		Debug(_log, "output thread - ticks [%lld] (%f/s), interval min/avg/max [%lld/%.1f/%lld µs], jitter [%.1f µs], max. lateness [%lld µs], missed deadlines [%lld]"
+			  , static_cast<long long>(_window.ticks)
+			  , 1.0 * _window.ticks * MICROS_PER_SECOND / (now - _windowStart)
+			  , static_cast<long long>(_window.minIntervalMicros)
+			  , _window.avgIntervalMicros
+			  , static_cast<long long>(_window.maxIntervalMicros)
+			  , _window.meanJitterMicros
+			  , static_cast<long long>(_window.maxLatenessMicros)
+			  , static_cast<long long>(_window.missedDeadlines)
+			  );
+
+		QMutexLocker lock(&_statisticsMutex);
+		_statistics = _window;
+	}
+
+	const int64_t interval = _window.intervalMicros;
+	_window = JitterStatistics();
+	_window.intervalMicros = interval;
+	_windowStart = now;
+	_intervalSum = 0.0;
+	_jitterSum = 0.0;
+}
@@ -0,0 +1,59 @@
+#include <hyperion/UpdateScheduler.h>
+
+// STL includes
+#include <chrono>
+
+UpdateScheduler::UpdateScheduler(std::function<void()> process, std::function<int64_t()> outputInterval, QObject* parent)
+	: QObject(parent)
+	, _process(std::move(process))
+	, _outputInterval(std::move(outputInterval))
+	, _lastUpdateMicros(0)
+	, _processed(0)
+	, _superseded(0)
+{
+	_timer.setSingleShot(true);
+	_timer.setTimerType(Qt::PreciseTimer);
+	connect(&_timer, &QTimer::timeout, this, &UpdateScheduler::process);
+}
+
+void UpdateScheduler::requestUpdate()
+{
+	// the scheduled update will pick up the latest frame
+	if (_timer.isActive())
+	{
+		_superseded.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	const int64_t interval = _outputInterval();
+	const int64_t elapsed = micros() - _lastUpdateMicros;
+	if (interval <= 0 || elapsed >= interval)
+	{
+		process();
+		return;
+	}
+
+	// round up to the next millisecond, as an earlier update would be skipped by the output
+	_timer.start(static_cast<int>((interval - elapsed + 999) / 1000));
+}
+
+QJsonObject UpdateScheduler::getStatistics() const
+{
+	QJsonObject statistics;
+	statistics["processed"] = static_cast<qint64>(_processed.load(std::memory_order_relaxed));
+	statistics["superseded"] = static_cast<qint64>(_superseded.load(std::memory_order_relaxed));
+	return statistics;
+}
+
+void UpdateScheduler::process()
+{
+	_timer.stop();
+	_lastUpdateMicros = micros();
+	_processed.fetch_add(1, std::memory_order_relaxed);
+	_process();
+}
+
+int64_t UpdateScheduler::micros()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
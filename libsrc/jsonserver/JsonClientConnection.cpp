@@ -18,6 +18,7 @@ JsonClientConnection::JsonClientConnection(QTcpSocket *socket, bool localConnect
 	_jsonAPI = new JsonAPI(socket->peerAddress().toString(), _log, localConnection, this);
 	// get the callback messages from JsonAPI and send it to the client
 	connect(_jsonAPI, &JsonAPI::callbackMessage, this , &JsonClientConnection::sendMessage);
+	connect(_jsonAPI, &JsonAPI::callbackData, this , &JsonClientConnection::sendData);
 	connect(_jsonAPI, &JsonAPI::forceClose, this , [&](){ _socket->close(); } );
 
 	_jsonAPI->initialize();
@@ -47,8 +48,11 @@ void JsonClientConnection::readRequest()
 qint64 JsonClientConnection::sendMessage(QJsonObject message)
 {
 	QJsonDocument writer(message);
-	QByteArray data = writer.toJson(QJsonDocument::Compact) + "\n";
+	return sendData(writer.toJson(QJsonDocument::Compact) + "\n");
+}
 
+qint64 JsonClientConnection::sendData(const QByteArray& data)
+{
 	if (!_socket || (_socket->state() != QAbstractSocket::ConnectedState)) return 0;
 	return _socket->write(data.data(), data.size());
 }
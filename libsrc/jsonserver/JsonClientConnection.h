@@ -32,6 +32,7 @@ signals:
 
 public slots:
 	qint64 sendMessage(QJsonObject);
+	qint64 sendData(const QByteArray& data);
 
 private slots:
 	///
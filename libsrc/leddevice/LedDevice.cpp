@@ -11,9 +11,11 @@
 
 #include "hyperion/Hyperion.h"
 #include <utils/JsonUtils.h>
+#include <utils/Tracing.h>
 
 //std includes
 #include <sstream>
+#include <algorithm>
 #include <iomanip>
 #include <chrono>
 
@@ -26,11 +28,26 @@ namespace {
 	const char CONFIG_AUTOSTART[] = "autoStart";
 	const char CONFIG_LATCH_TIME[] = "latchTime";
 	const char CONFIG_REWRITE_TIME[] = "rewriteTime";
+	const char CONFIG_DELTA_WRITES[] = "deltaWrites";
+	const char CONFIG_DELTA_THRESHOLD[] = "deltaThreshold";
+	const char CONFIG_FULL_REFRESH_INTERVAL[] = "fullRefreshInterval";
 
 	int DEFAULT_LED_COUNT{ 1 };
 	const char DEFAULT_COLOR_ORDER[]{ "RGB" };
 	const bool DEFAULT_IS_AUTOSTART{ true };
 
+	const bool DEFAULT_IS_DELTA_WRITES{ false };
+	const int DEFAULT_DELTA_THRESHOLD{ 0 };
+	const int DEFAULT_FULL_REFRESH_INTERVAL_MS{ 1000 };
+	const int MAX_DELTA_THRESHOLD{ 32 };
+	// Devices like WLED or E1.31 receivers fall back to their own state, if no data is received for ~2.5s
+	const int MIN_FULL_REFRESH_INTERVAL_MS{ 100 };
+	const int MAX_FULL_REFRESH_INTERVAL_MS{ 2000 };
+
+	// Unchanged LEDs between two dirty ranges are written as well, if the gap is smaller than this,
+	// as the overhead of another packet/range is higher
+	const int DIRTY_RANGE_MERGE_GAP{ 16 };
+
 	const char CONFIG_ENABLE_ATTEMPTS[] = "enableAttempts";
 	const char CONFIG_ENABLE_ATTEMPTS_INTERVALL[] = "enableAttemptsInterval";
 
@@ -50,6 +67,7 @@ LedDevice::LedDevice(const QJsonObject& deviceConfig, QObject* parent)
 	, _ledCount(0)
 	, _isRestoreOrigState(false)
 	, _isStayOnAfterStreaming(false)
+	, _isDeltaWriteSupported(false)
 	, _isEnabled(false)
 	, _isDeviceInitialised(false)
 	, _isDeviceReady(false)
@@ -63,6 +81,10 @@ LedDevice::LedDevice(const QJsonObject& deviceConfig, QObject* parent)
 	, _maxEnableAttempts(DEFAULT_MAX_ENABLE_ATTEMPTS)
 	, _isRefreshEnabled(false)
 	, _isAutoStart(true)
+	, _isDeltaWriteEnabled(DEFAULT_IS_DELTA_WRITES)
+	, _deltaThreshold(DEFAULT_DELTA_THRESHOLD)
+	, _fullRefreshInterval_ms(DEFAULT_FULL_REFRESH_INTERVAL_MS)
+	, _lastFullWriteTime_ms(0)
 {
 	_activeDeviceType = deviceConfig["type"].toString("UNSPECIFIED").toLower();
 }
@@ -126,6 +148,7 @@ void LedDevice::setInError(const QString& errorMsg, bool isRecoverable)
 	_isDeviceReady = false;
 	_isEnabled = false;
 	this->stopRefreshTimer();
+	resetWrittenLeds();
 
 	if (isRecoverable)
 	{
@@ -138,6 +161,7 @@ void LedDevice::setInError(const QString& errorMsg, bool isRecoverable)
 void LedDevice::enable()
 {
 	Debug(_log, "Enable device %s'", QSTRING_CSTR(_activeDeviceType));
+	resetWrittenLeds();
 
 	if (!_isEnabled)
 	{
@@ -192,6 +216,7 @@ void LedDevice::enable()
 void LedDevice::disable()
 {
 	Debug(_log, "Disable device %s'", QSTRING_CSTR(_activeDeviceType));
+	resetWrittenLeds();
 	if (_isEnabled)
 	{
 		_isEnabled = false;
@@ -223,6 +248,15 @@ bool LedDevice::init(const QJsonObject& deviceConfig)
 	std::chrono::seconds(deviceConfig[CONFIG_ENABLE_ATTEMPTS_INTERVALL].toInt(DEFAULT_ENABLE_ATTEMPTS_INTERVAL.count()))
 	);
 
+	_isDeltaWriteEnabled = _isDeltaWriteSupported && deviceConfig[CONFIG_DELTA_WRITES].toBool(DEFAULT_IS_DELTA_WRITES);
+	_deltaThreshold = qBound(0, deviceConfig[CONFIG_DELTA_THRESHOLD].toInt(DEFAULT_DELTA_THRESHOLD), MAX_DELTA_THRESHOLD);
+	_fullRefreshInterval_ms = qBound(MIN_FULL_REFRESH_INTERVAL_MS, deviceConfig[CONFIG_FULL_REFRESH_INTERVAL].toInt(DEFAULT_FULL_REFRESH_INTERVAL_MS), MAX_FULL_REFRESH_INTERVAL_MS);
+	resetWrittenLeds();
+	if (_isDeltaWriteEnabled)
+	{
+		Debug(_log, "Delta writes enabled, threshold: %d, full refresh every %dms", _deltaThreshold, _fullRefreshInterval_ms);
+	}
+
 	return true;
 }
 
@@ -315,7 +349,10 @@ int LedDevice::updateLeds(std::vector<ColorRgb> ledValues)
 		qint64 elapsedTimeMs = _lastWriteTime.msecsTo(QDateTime::currentDateTime());
 		if (_latchTime_ms == 0 || elapsedTimeMs >= _latchTime_ms)
 		{
-			retval = write(ledValues);
+			{
+				TRACE_SCOPE(tracing::Stage::DEVICE_WRITE);
+				retval = writeChanges(ledValues);
+			}
 			_lastWriteTime = QDateTime::currentDateTime();
 
 			// if device requires refreshing, save Led-Values and restart the timer
@@ -348,6 +385,13 @@ int LedDevice::rewriteLEDs()
 		{
 			retval = write(_lastLedValues);
 			_lastWriteTime = QDateTime::currentDateTime();
+
+			if (_isDeltaWriteEnabled)
+			{
+				// The device shows the latest values completely now
+				_writtenLedValues = (retval == 0) ? _lastLedValues : std::vector<ColorRgb>();
+				_lastFullWriteTime_ms = _lastWriteTime.toMSecsSinceEpoch();
+			}
 		}
 	}
 	else
@@ -358,6 +402,93 @@ int LedDevice::rewriteLEDs()
 	return retval;
 }
 
+int LedDevice::writeDelta(const std::vector<ColorRgb>& ledValues, const std::vector<DirtyRange>& /*dirtyRanges*/)
+{
+	return write(ledValues);
+}
+
+int LedDevice::writeChanges(const std::vector<ColorRgb>& ledValues)
+{
+	if (!_isDeltaWriteEnabled)
+	{
+		return write(ledValues);
+	}
+
+	const qint64 now = QDateTime::currentMSecsSinceEpoch();
+	const bool isFullWriteDue = _writtenLedValues.size() != ledValues.size()
+								|| now - _lastFullWriteTime_ms >= _fullRefreshInterval_ms;
+
+	if (!isFullWriteDue)
+	{
+		collectDirtyRanges(ledValues);
+		if (_dirtyRanges.empty())
+		{
+			// Nothing changed, the device shows the values already
+			return 0;
+		}
+
+		if (_dirtyRanges.size() > 1 || _dirtyRanges.front().length < static_cast<int>(ledValues.size()))
+		{
+			int rc = writeDelta(ledValues, _dirtyRanges);
+			if (rc == 0)
+			{
+				for (const DirtyRange& range : _dirtyRanges)
+				{
+					std::copy_n(ledValues.begin() + range.start, range.length, _writtenLedValues.begin() + range.start);
+				}
+			}
+			else
+			{
+				resetWrittenLeds();
+			}
+			return rc;
+		}
+	}
+
+	int rc = write(ledValues);
+	if (rc == 0)
+	{
+		_writtenLedValues = ledValues;
+		_lastFullWriteTime_ms = now;
+	}
+	else
+	{
+		resetWrittenLeds();
+	}
+	return rc;
+}
+
+void LedDevice::collectDirtyRanges(const std::vector<ColorRgb>& ledValues)
+{
+	_dirtyRanges.clear();
+
+	const int ledCount = static_cast<int>(ledValues.size());
+	int lastDirty = -1;
+	for (int i = 0; i < ledCount; ++i)
+	{
+		const ColorRgb& color = ledValues[i];
+		const ColorRgb& written = _writtenLedValues[i];
+		const bool isDirty = (_deltaThreshold == 0)
+							 ? color != written
+							 : (qAbs(color.red - written.red) > _deltaThreshold
+								|| qAbs(color.green - written.green) > _deltaThreshold
+								|| qAbs(color.blue - written.blue) > _deltaThreshold);
+
+		if (isDirty)
+		{
+			if (lastDirty >= 0 && i - lastDirty <= DIRTY_RANGE_MERGE_GAP)
+			{
+				_dirtyRanges.back().length = i - _dirtyRanges.back().start + 1;
+			}
+			else
+			{
+				_dirtyRanges.push_back({i, 1});
+			}
+			lastDirty = i;
+		}
+	}
+}
+
 int LedDevice::writeBlack(int numberOfWrites)
 {
 	Debug(_log, "Set LED strip to black to switch LEDs off");
@@ -379,6 +510,7 @@ int LedDevice::writeColor(const ColorRgb& color, int numberOfWrites)
 		}
 		_lastLedValues = std::vector<ColorRgb>(static_cast<unsigned long>(_ledCount), color);
 		rc = write(_lastLedValues);
+		resetWrittenLeds();
 	}
 	return rc;
 }
@@ -576,6 +708,7 @@ void LedDevice::setLatchTime(int latchTime_ms)
 	assert(latchTime_ms >= 0);
 	_latchTime_ms = latchTime_ms;
 	Debug(_log, "LatchTime set to %dms", _latchTime_ms);
+	emit latchTimeChanged(_latchTime_ms);
 }
 
 void LedDevice::setAutoStart(bool isAutoStart)
@@ -73,6 +73,7 @@ void LedDeviceWrapper::createLedDevice(const QJsonObject& config)
 	connect(this, &LedDeviceWrapper::stopLedDevice, _ledDevice, &LedDevice::stop, Qt::BlockingQueuedConnection);
 
 	connect(_ledDevice, &LedDevice::enableStateChanged, this, &LedDeviceWrapper::handleInternalEnableState, Qt::QueuedConnection);
+	connect(_ledDevice, &LedDevice::latchTimeChanged, this, &LedDeviceWrapper::latchTimeChanged, Qt::QueuedConnection);
 
 	// start the thread
 	thread->start();
@@ -110,6 +110,8 @@ LedDeviceNanoleaf::LedDeviceNanoleaf(const QJsonObject& deviceConfig)
 	, _extControlVersion(EXTCTRLVER_V2)
 	, _panelLedCount(0)
 {
+	_isDeltaWriteSupported = true;
+
 #ifdef ENABLE_MDNS
 	QMetaObject::invokeMethod(MdnsBrowser::getInstance().data(), "browseForServiceType",
 		Qt::QueuedConnection, Q_ARG(QByteArray, MdnsServiceRegister::getServiceType(_activeDeviceType)));
@@ -820,6 +822,32 @@ bool LedDeviceNanoleaf::changeToExternalControlMode(QJsonDocument& resp)
 }
 
 int LedDeviceNanoleaf::write(const std::vector<ColorRgb>& ledValues)
+{
+	return writePanels(ledValues, { DirtyRange{ 0, _panelLedCount } });
+}
+
+int LedDeviceNanoleaf::writeDelta(const std::vector<ColorRgb>& ledValues, const std::vector<DirtyRange>& dirtyRanges)
+{
+	// A frame addresses the panels by id, i.e. panels not included keep their color
+	std::vector<DirtyRange> panelRanges;
+	panelRanges.reserve(dirtyRanges.size());
+	for (const DirtyRange& range : dirtyRanges)
+	{
+		const int length = qMin(range.start + range.length, _panelLedCount) - range.start;
+		if (length > 0)
+		{
+			panelRanges.push_back({range.start, length});
+		}
+	}
+
+	if (panelRanges.empty())
+	{
+		return 0;
+	}
+	return writePanels(ledValues, panelRanges);
+}
+
+int LedDeviceNanoleaf::writePanels(const std::vector<ColorRgb>& ledValues, const std::vector<DirtyRange>& panelRanges)
 {
 	int retVal = 0;
 
@@ -832,7 +860,13 @@ int LedDeviceNanoleaf::write(const std::vector<ColorRgb>& ledValues)
 	//
 	// Note: Nanoleaf Light Panels (Aurora) now support External Control V2 (tested with FW 3.2.0)
 
-	int udpBufferSize = STREAM_FRAME_PANEL_NUM_SIZE + _panelLedCount * STREAM_FRAME_PANEL_INFO_SIZE;
+	int panelCount = 0;
+	for (const DirtyRange& range : panelRanges)
+	{
+		panelCount += range.length;
+	}
+
+	int udpBufferSize = STREAM_FRAME_PANEL_NUM_SIZE + panelCount * STREAM_FRAME_PANEL_INFO_SIZE;
 
 	QByteArray udpbuffer;
 	udpbuffer.resize(udpBufferSize);
@@ -840,42 +874,45 @@ int LedDeviceNanoleaf::write(const std::vector<ColorRgb>& ledValues)
 	int i = 0;
 
 	// Set number of panels
-	qToBigEndian<quint16>(static_cast<quint16>(_panelLedCount), udpbuffer.data() + i);
+	qToBigEndian<quint16>(static_cast<quint16>(panelCount), udpbuffer.data() + i);
 	i += 2;
 
 	ColorRgb color;
 
-	for (int panelCounter = 0; panelCounter < _panelLedCount; ++panelCounter)
+	for (const DirtyRange& range : panelRanges)
 	{
-		// Set panelID
-		int panelID = _panelIds[panelCounter];
-		qToBigEndian<quint16>(static_cast<quint16>(panelID), udpbuffer.data() + i);
-		i += 2;
-
-		// Set panel's color LEDs
-		if (panelCounter < this->getLedCount()) {
-			color = static_cast<ColorRgb>(ledValues.at(panelCounter));
-		}
-		else
+		for (int panelCounter = range.start; panelCounter < range.start + range.length; ++panelCounter)
 		{
-			// Set panels not configured to black
-			color = ColorRgb::BLACK;
-			DebugIf(verbose3, _log, "[%u] >= panelLedCount [%u] => Set to BLACK", panelCounter, _panelLedCount);
-		}
+			// Set panelID
+			int panelID = _panelIds[panelCounter];
+			qToBigEndian<quint16>(static_cast<quint16>(panelID), udpbuffer.data() + i);
+			i += 2;
+
+			// Set panel's color LEDs
+			if (panelCounter < this->getLedCount()) {
+				color = static_cast<ColorRgb>(ledValues.at(panelCounter));
+			}
+			else
+			{
+				// Set panels not configured to black
+				color = ColorRgb::BLACK;
+				DebugIf(verbose3, _log, "[%u] >= panelLedCount [%u] => Set to BLACK", panelCounter, _panelLedCount);
+			}
 
-		udpbuffer[i++] = static_cast<char>(color.red);
-		udpbuffer[i++] = static_cast<char>(color.green);
-		udpbuffer[i++] = static_cast<char>(color.blue);
+			udpbuffer[i++] = static_cast<char>(color.red);
+			udpbuffer[i++] = static_cast<char>(color.green);
+			udpbuffer[i++] = static_cast<char>(color.blue);
 
-		// Set white LED
-		udpbuffer[i++] = 0; // W not set manually
+			// Set white LED
+			udpbuffer[i++] = 0; // W not set manually
 
-		// Set transition time
-		unsigned char tranitionTime = 1; // currently fixed at value 1 which corresponds to 100ms
-		qToBigEndian<quint16>(static_cast<quint16>(tranitionTime), udpbuffer.data() + i);
-		i += 2;
+			// Set transition time
+			unsigned char tranitionTime = 1; // currently fixed at value 1 which corresponds to 100ms
+			qToBigEndian<quint16>(static_cast<quint16>(tranitionTime), udpbuffer.data() + i);
+			i += 2;
 
-		DebugIf(verbose3, _log, "[%u] Color: {%u,%u,%u}", panelCounter, color.red, color.green, color.blue);
+			DebugIf(verbose3, _log, "[%u] Color: {%u,%u,%u}", panelCounter, color.red, color.green, color.blue);
+		}
 	}
 
 	if (verbose3)
@@ -126,6 +126,15 @@ protected:
 	//////
 	int write(const std::vector<ColorRgb>& ledValues) override;
 
+	///
+	/// @brief Writes the RGB-Color values of the changed panels only.
+	///
+	/// @param[in] ledValues The RGB-color per LED
+	/// @param[in] dirtyRanges The ranges of LEDs changed since the last write
+	/// @return Zero on success, else negative
+	///
+	int writeDelta(const std::vector<ColorRgb>& ledValues, const std::vector<DirtyRange>& dirtyRanges) override;
+
 	///
 	/// @brief Power-/turn on the Nanoleaf device.
 	///
@@ -186,6 +195,15 @@ private:
         SKYLIGHT_CONTROLLER_PASSIV = 32
 	};
 
+	///
+	/// @brief Writes a stream frame for the panels given
+	///
+	/// @param[in] ledValues The RGB-color per LED
+	/// @param[in] panelRanges The ranges of panels to be written
+	/// @return Zero on success, else negative
+	///
+	int writePanels(const std::vector<ColorRgb>& ledValues, const std::vector<DirtyRange>& panelRanges);
+
 	///
 	/// @brief Initialise the access to the REST-API wrapper
 	///
@@ -417,6 +417,8 @@ bool LedDevicePhilipsHueBridge::openRestAPI()
 	{
 		_restApi = new ProviderRestApi(_address.toString(), _apiPort);
 		_restApi->setLogger(_log);
+		connect(_restApi, &ProviderRestApi::asyncRequestSent, this, &LedDevicePhilipsHueBridge::handleAsyncRequestSent);
+		connect(_restApi, &ProviderRestApi::asyncRequestFinished, this, &LedDevicePhilipsHueBridge::onAsyncRequestFinished);
 	}
 	else
 	{
@@ -573,6 +575,11 @@ int LedDevicePhilipsHueBridge::close()
 	_isDeviceReady = false;
 	int retval = 0;
 
+	if (_restApi != nullptr)
+	{
+		_restApi->waitForAsyncRequests();
+	}
+
 	if( _useEntertainmentAPI )
 	{
 		retval = ProviderUdpSSL::close();
@@ -1249,6 +1256,37 @@ QJsonDocument LedDevicePhilipsHueBridge::put(const QStringList& routeElements, c
 	return response.getBody();
 }
 
+void LedDevicePhilipsHueBridge::putAsync(const QStringList& routeElements, const QJsonObject& content)
+{
+	_restApi->setPath(routeElements);
+	_restApi->putAsync(content);
+	_restApi->clearPath();
+}
+
+QUrl LedDevicePhilipsHueBridge::getUrl(const QStringList& routeElements)
+{
+	_restApi->setPath(routeElements);
+	const QUrl url = _restApi->getUrl();
+	_restApi->clearPath();
+	return url;
+}
+
+void LedDevicePhilipsHueBridge::onAsyncRequestFinished(const QUrl& url, const httpResponse& response)
+{
+	bool isSuccess {false};
+	if (response.error())
+	{
+		QString errorReason = QString("API request (Put) failed with error: '%1'").arg(response.getErrorReason());
+		this->setInError ( errorReason );
+	}
+	else
+	{
+		isSuccess = !checkApiError(response.getBody());
+	}
+
+	handleAsyncRequestResult(url, isSuccess);
+}
+
 bool LedDevicePhilipsHueBridge::isStreamOwner(const QString &streamOwner) const
 {
 	bool isOwner {false};
@@ -1925,6 +1963,7 @@ bool LedDevicePhilipsHue::updateLights(const QMap<QString, QJsonObject> &map)
 
 	// search user lightId inside map and create light if found
 	_lights.clear();
+	_lightRequests.clear();
 
 	if(!_lightIds.empty())
 	{
@@ -2427,6 +2466,7 @@ void LedDevicePhilipsHue::setOnOffState(PhilipsHueLight& light, bool on, bool fo
 			cmd.insert(API_STATE_ON, on);
 		}
 		put(resourcePath, cmd);
+		discardLightRequest(light);
 
 		if (!isInError())
 		{
@@ -2453,6 +2493,7 @@ void LedDevicePhilipsHue::setTransitionTime(PhilipsHueLight& light)
 			cmd.insert(API_TRANSITIONTIME, _transitionTime);
 		}
 		put(resourcePath, cmd);
+		discardLightRequest(light);
 
 		if (!isInError())
 		{
@@ -2498,6 +2539,7 @@ void LedDevicePhilipsHue::setColor(PhilipsHueLight& light, CiColor& color)
 				}
 			}
 			put(resourcePath, cmd);
+			discardLightRequest(light);
 		}
 		else
 		{
@@ -2515,9 +2557,13 @@ void LedDevicePhilipsHue::setState(PhilipsHueLight& light, bool on, const CiColo
 {
 	QStringList resourcePath;
 	QJsonObject cmd;
+	LightUpdate update;
 	bool forceCmd {false};
 
-	if (light.getOnOffState() != on)
+	// Compare with the state requested, the light's state is only updated when the bridge confirmed it
+	const LightUpdate requested = getRequestedState(light);
+
+	if (requested.on != on)
 	{
 		forceCmd = true;
 		if (_useApiV2)
@@ -2528,11 +2574,13 @@ void LedDevicePhilipsHue::setState(PhilipsHueLight& light, bool on, const CiColo
 		{
 			cmd.insert(API_STATE_ON, on);
 		}
+		update.hasOnOffState = true;
+		update.on = on;
 	}
 
-	if (!_useEntertainmentAPI && light.getOnOffState())
+	if (!_useEntertainmentAPI && requested.on)
 	{
-		if (light.getTransitionTime() != _transitionTime)
+		if (requested.transitionTime != _transitionTime)
 		{
 			if (_useApiV2)
 			{
@@ -2542,9 +2590,11 @@ void LedDevicePhilipsHue::setState(PhilipsHueLight& light, bool on, const CiColo
 			{
 				cmd.insert(API_TRANSITIONTIME, _transitionTime);
 			}
+			update.hasTransitionTime = true;
+			update.transitionTime = _transitionTime;
 		}
 
-		if (!light.hasColor() || light.getColor() != color)
+		if (!requested.hasColor || requested.color != color)
 		{
 			if (!light.isBusy() || forceCmd)
 			{
@@ -2568,6 +2618,8 @@ void LedDevicePhilipsHue::setState(PhilipsHueLight& light, bool on, const CiColo
 					cmd.insert(API_XY_COORDINATES, colorXY);
 					cmd.insert(API_BRIGHTNESS, bri);
 				}
+				update.hasColor = true;
+				update.color = color;
 			}
 		}
 	}
@@ -2582,14 +2634,121 @@ void LedDevicePhilipsHue::setState(PhilipsHueLight& light, bool on, const CiColo
 		{
 			resourcePath << API_RESOURCE_LIGHTS << light.getId() << API_STATE;
 		}
-		put(resourcePath, cmd);
 
-		if (!isInError())
+		// The update is merged with the pending one of the light, it is in flight once the request is sent
+		LightRequests& requests = _lightRequests[light.getId()];
+		requests.url = getUrl(resourcePath);
+		requests.pending.merge(update);
+
+		// Light updates are pipelined, the previous update of a light must not delay the others
+		putAsync(resourcePath, cmd);
+	}
+}
+
+void LedDevicePhilipsHue::LightUpdate::merge(const LightUpdate& update)
+{
+	if (update.hasOnOffState)
+	{
+		hasOnOffState = true;
+		on = update.on;
+	}
+	if (update.hasTransitionTime)
+	{
+		hasTransitionTime = true;
+		transitionTime = update.transitionTime;
+	}
+	if (update.hasColor)
+	{
+		hasColor = true;
+		color = update.color;
+	}
+}
+
+LedDevicePhilipsHue::LightUpdate LedDevicePhilipsHue::getRequestedState(const PhilipsHueLight& light) const
+{
+	LightUpdate state;
+	state.hasOnOffState = true;
+	state.on = light.getOnOffState();
+	state.hasTransitionTime = true;
+	state.transitionTime = light.getTransitionTime();
+	state.hasColor = light.hasColor();
+	state.color = light.getColor();
+
+	auto it = _lightRequests.constFind(light.getId());
+	if (it != _lightRequests.constEnd())
+	{
+		state.merge(it->inFlight);
+		state.merge(it->pending);
+	}
+	return state;
+}
+
+void LedDevicePhilipsHue::discardLightRequest(const PhilipsHueLight& light)
+{
+	auto it = _lightRequests.find(light.getId());
+	if (it != _lightRequests.end())
+	{
+		it->pending = LightUpdate();
+		if (it->inFlight.isEmpty())
 		{
-			light.setTransitionTime( _transitionTime );
-			light.setColor( color );
-			light.setOnOffState( on );
+			_lightRequests.erase(it);
+		}
+	}
+}
+
+void LedDevicePhilipsHue::handleAsyncRequestSent(const QUrl& url)
+{
+	for (auto it = _lightRequests.begin(); it != _lightRequests.end(); ++it)
+	{
+		if (it->url == url)
+		{
+			it->inFlight = it->pending;
+			it->pending = LightUpdate();
+			break;
+		}
+	}
+}
+
+void LedDevicePhilipsHue::handleAsyncRequestResult(const QUrl& url, bool isSuccess)
+{
+	for (auto it = _lightRequests.begin(); it != _lightRequests.end(); ++it)
+	{
+		if (it->url != url)
+		{
+			continue;
+		}
+
+		// A failed update is not applied, i.e. it is requested again by the next write
+		if (isSuccess)
+		{
+			const LightUpdate& confirmed = it->inFlight;
+			for (PhilipsHueLight& light : _lights)
+			{
+				if (light.getId() == it.key())
+				{
+					if (confirmed.hasTransitionTime)
+					{
+						light.setTransitionTime(confirmed.transitionTime);
+					}
+					if (confirmed.hasColor)
+					{
+						light.setColor(confirmed.color);
+					}
+					if (confirmed.hasOnOffState)
+					{
+						light.setOnOffState(confirmed.on);
+					}
+					break;
+				}
+			}
+		}
+
+		it->inFlight = LightUpdate();
+		if (it->pending.isEmpty())
+		{
+			_lightRequests.erase(it);
 		}
+		break;
 	}
 }
 
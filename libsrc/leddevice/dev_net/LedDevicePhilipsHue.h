@@ -255,6 +255,24 @@ public:
 	///
 	QJsonDocument put(const QStringList& routeElements, const QJsonObject& content, bool supressError = false);
 
+	///
+	/// @brief Perform a REST-API PUT asynchronously
+	///
+	/// Updates of the same resource are coalesced, errors are reported when the response is received.
+	///
+	/// @param routeElements the route's elements of the PUT request.
+	/// @param content the content of the PUT request.
+	///
+	void putAsync(const QStringList& routeElements, const QJsonObject& content);
+
+	///
+	/// @brief Get the URL of a REST-API resource
+	///
+	/// @param routeElements the route's elements of the resource.
+	/// @return The URL
+	///
+	QUrl getUrl(const QStringList& routeElements);
+
 	QJsonDocument retrieveBridgeDetails();
 	QJsonObject getDeviceDetails(const QString& deviceId);
 	QJsonObject getEntertainmentSrvDetails(const QString& deviceId);
@@ -305,6 +323,29 @@ protected:
 	///
 	bool checkApiError(const QJsonDocument& response, bool supressError = false);
 
+	///
+	/// @brief Handle the response of an asynchronous REST-API request
+	///
+	/// @param[in] url The URL of the request
+	/// @param[in] response The response from the Hue-Bridge
+	///
+	void onAsyncRequestFinished(const QUrl& url, const httpResponse& response);
+
+	///
+	/// @brief Handle an asynchronous REST-API request being sent
+	///
+	/// @param[in] url The URL of the request
+	///
+	virtual void handleAsyncRequestSent(const QUrl& /*url*/) {}
+
+	///
+	/// @brief Handle the result of an asynchronous REST-API request
+	///
+	/// @param[in] url The URL of the request
+	/// @param[in] isSuccess True, if the Hue-Bridge applied the request
+	///
+	virtual void handleAsyncRequestResult(const QUrl& /*url*/, bool /*isSuccess*/) {}
+
 	///
 	/// @brief Discover devices of this type available (for configuration).
 	/// @note Mainly used for network devices. Allows to find devices, e.g. via ssdp, mDNS or cloud ways.
@@ -489,6 +530,11 @@ public:
 	void setColor(PhilipsHueLight& light, CiColor& color);
 	void setState(PhilipsHueLight& light, bool on, const CiColor& color);
 
+protected:
+
+	void handleAsyncRequestSent(const QUrl& url) override;
+	void handleAsyncRequestResult(const QUrl& url, bool isSuccess) override;
+
 public slots:
 
 	///
@@ -626,6 +672,45 @@ private:
 	/// Array to save the lamps.
 	std::vector<PhilipsHueLight> _lights;
 
+	///
+	/// @brief Light state requested asynchronously, which is not confirmed by the bridge yet
+	///
+	struct LightUpdate
+	{
+		bool hasOnOffState {false};
+		bool on {false};
+		bool hasTransitionTime {false};
+		int transitionTime {0};
+		bool hasColor {false};
+		CiColor color {};
+
+		bool isEmpty() const { return !hasOnOffState && !hasTransitionTime && !hasColor; }
+		void merge(const LightUpdate& update);
+	};
+
+	/// Asynchronous updates of a light, the light's state is updated when the bridge confirms them
+	struct LightRequests
+	{
+		QUrl url;
+		/// merged updates not sent yet
+		LightUpdate pending;
+		/// update in flight
+		LightUpdate inFlight;
+	};
+
+	///
+	/// @brief Get the state of a light incl. the updates requested, i.e. the reference for further updates
+	///
+	LightUpdate getRequestedState(const PhilipsHueLight& light) const;
+
+	///
+	/// @brief Drop the pending update of a light, as a synchronous request supersedes it
+	///
+	void discardLightRequest(const PhilipsHueLight& light);
+
+	/// Asynchronous updates per light id
+	QMap<QString, LightRequests> _lightRequests;
+
 	int _lightsCount;
 	int _channelsCount;
 	QString _groupId;
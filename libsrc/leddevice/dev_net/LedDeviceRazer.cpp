@@ -121,6 +121,11 @@ bool LedDeviceRazer::initRestAPI(const QString& hostname, int port)
 		_restApi = new ProviderRestApi(hostname, port);
 		_restApi->setLogger(_log);
 
+		// Frames are written asynchronously, errors are reported with the response
+		connect(_restApi, &ProviderRestApi::asyncRequestFinished, this, [this](const QUrl& /*url*/, const httpResponse& response) {
+			checkApiError(response);
+		});
+
 		_restApi->setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
 
 		isInitOK = true;
@@ -230,6 +235,7 @@ int LedDeviceRazer::close()
 
 	if (!_uri.isEmpty())
 	{
+		_restApi->waitForAsyncRequests();
 		httpResponse response = _restApi->deleteResource(_uri);
 		if (!checkApiError(response))
 		{
@@ -298,9 +304,10 @@ int LedDeviceRazer::write(const std::vector<ColorRgb>& ledValues)
 		effectObj.insert("param", rowParams);
 	}
 
+	// The latest frame wins, while the previous one is still in flight
 	_restApi->setPath(_razerDeviceType);
-	httpResponse response = _restApi->put(effectObj);
-	if (!checkApiError(response))
+	_restApi->putAsync(effectObj);
+	if (!isInError())
 	{
 		retval = 0;
 	}
@@ -2,6 +2,8 @@
 
 #include <QtEndian>
 
+#include <cstring>
+
 #include <utils/NetUtils.h>
 
 // DDP header format
@@ -66,6 +68,7 @@ LedDeviceUdpDdp::LedDeviceUdpDdp(const QJsonObject &deviceConfig)
 	: ProviderUdp(deviceConfig)
 	  ,_packageSequenceNumber(0)
 {
+	_isDeltaWriteSupported = true;
 }
 
 LedDevice* LedDeviceUdpDdp::construct(const QJsonObject &deviceConfig)
@@ -114,12 +117,31 @@ int LedDeviceUdpDdp::open()
 }
 
 int LedDeviceUdpDdp::write(const std::vector<ColorRgb> &ledValues)
+{
+	int channelCount = static_cast<int>(_ledCount) * 3; // 1 channel for every R,G,B value
+	return writeChannels(ledValues, 0, channelCount, true);
+}
+
+int LedDeviceUdpDdp::writeDelta(const std::vector<ColorRgb>& ledValues, const std::vector<DirtyRange>& dirtyRanges)
+{
+	int rc {0};
+
+	// DDP addresses the channels by offset, only the changed ranges are sent. The last packet pushes the frame.
+	for (size_t i = 0; i < dirtyRanges.size() && rc == 0; ++i)
+	{
+		const DirtyRange& range = dirtyRanges[i];
+		rc = writeChannels(ledValues, range.start * 3, range.length * 3, i == dirtyRanges.size() - 1);
+	}
+	return rc;
+}
+
+int LedDeviceUdpDdp::writeChannels(const std::vector<ColorRgb> &ledValues, int firstChannel, int channelCount, bool push)
 {
 	int rc {0};
 
-	int channelCount = static_cast<int>(_ledCount) * 3; // 1 channel for every R,G,B value
 	int packetCount = ((channelCount-1) / DDP::CHANNELS_PER_PACKET) + 1;
-	int channel = 0;
+	int channel = firstChannel;
+	const char* data = reinterpret_cast<const char*>(ledValues.data());
 
 	_ddpData[0] = DDP::flags1::VER1;
 
@@ -135,7 +157,10 @@ int LedDeviceUdpDdp::write(const std::vector<ColorRgb> &ledValues)
 		if (currentPacket == (packetCount - 1))
 		{
 			// last packet, set the push flag
-			/*0*/_ddpData[0] = DDP::flags1::VER1 | DDP::flags1::PUSH;
+			if (push)
+			{
+				/*0*/_ddpData[0] = DDP::flags1::VER1 | DDP::flags1::PUSH;
+			}
 
 			if (channelCount % DDP::CHANNELS_PER_PACKET != 0)
 			{
@@ -147,8 +172,8 @@ int LedDeviceUdpDdp::write(const std::vector<ColorRgb> &ledValues)
 		/*4*/qToBigEndian<quint32>(static_cast<quint32>(channel), _ddpData.data() + 4);
 		/*8*/qToBigEndian<quint16>(static_cast<quint16>(packetSize), _ddpData.data() + 8);
 
-		_ddpData.replace(DDP::HEADER_LEN, channel, reinterpret_cast<const char*>(ledValues.data())+channel, packetSize);
 		_ddpData.resize(DDP::HEADER_LEN + packetSize);
+		memcpy(_ddpData.data() + DDP::HEADER_LEN, data + channel, static_cast<size_t>(packetSize));
 
 		rc = writeBytes(_ddpData);
 
@@ -160,4 +185,3 @@ int LedDeviceUdpDdp::write(const std::vector<ColorRgb> &ledValues)
 	}
 	return rc;
 }
-
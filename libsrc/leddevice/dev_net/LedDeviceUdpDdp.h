@@ -52,8 +52,28 @@ protected:
 	///
 	int write(const std::vector<ColorRgb> & ledValues) override;
 
+	///
+	/// @brief Writes the changed RGB-Color values to the LEDs, addressed by the DDP data offset.
+	///
+	/// @param[in] ledValues The RGB-color per LED
+	/// @param[in] dirtyRanges The ranges of LEDs changed since the last write
+	/// @return Zero on success, else negative
+	///
+	int writeDelta(const std::vector<ColorRgb>& ledValues, const std::vector<DirtyRange>& dirtyRanges) override;
+
 private:
 
+	///
+	/// @brief Writes a range of channels in DDP packets
+	///
+	/// @param[in] ledValues The RGB-color per LED
+	/// @param[in] firstChannel The first channel (offset) to be written
+	/// @param[in] channelCount The number of channels to be written
+	/// @param[in] push Set the push flag in the last packet, i.e. display the frame
+	/// @return Zero on success, else negative
+	///
+	int writeChannels(const std::vector<ColorRgb>& ledValues, int firstChannel, int channelCount, bool push);
+
 	QByteArray  _ddpData;
 
 	int _packageSequenceNumber;
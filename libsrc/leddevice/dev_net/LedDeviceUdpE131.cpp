@@ -40,6 +40,7 @@ const int DMX_MAX = 512; // 512 usable slots
 LedDeviceUdpE131::LedDeviceUdpE131(const QJsonObject &deviceConfig)
 	: ProviderUdp(deviceConfig)
 {
+	_isDeltaWriteSupported = true;
 }
 
 LedDevice* LedDeviceUdpE131::construct(const QJsonObject &deviceConfig)
@@ -139,40 +140,63 @@ void LedDeviceUdpE131::prepare(unsigned this_universe, unsigned this_dmxChannelC
 int LedDeviceUdpE131::write(const std::vector<ColorRgb> &ledValues)
 {
 	int retVal            = 0;
-	int thisChannelCount = 0;
 	int dmxChannelCount  = _ledRGBCount;
 	const uint8_t * rawdata = reinterpret_cast<const uint8_t *>(ledValues.data());
 
 	_e131_seq++;
 
-	for (int rawIdx = 0; rawIdx < dmxChannelCount; rawIdx++)
+	int universeCount = (dmxChannelCount + DMX_MAX - 1) / DMX_MAX;
+	for (int universeIdx = 0; universeIdx < universeCount; universeIdx++)
 	{
-		if (rawIdx % DMX_MAX == 0) // start of new packet
-		{
-			thisChannelCount = (dmxChannelCount - rawIdx < DMX_MAX) ? dmxChannelCount % DMX_MAX : DMX_MAX;
-//			                       is this the last packet?         ?       ^^ last packet      : ^^ earlier packets
+		retVal &= writeUniverse(rawdata, dmxChannelCount, universeIdx);
+	}
 
-			prepare(_e131_universe + rawIdx / DMX_MAX, thisChannelCount);
-			e131_packet.sequence_number = _e131_seq;
-		}
+	return retVal;
+}
+
+int LedDeviceUdpE131::writeDelta(const std::vector<ColorRgb> &ledValues, const std::vector<DirtyRange>& dirtyRanges)
+{
+	int retVal            = 0;
+	int dmxChannelCount  = _ledRGBCount;
+	const uint8_t * rawdata = reinterpret_cast<const uint8_t *>(ledValues.data());
 
-		e131_packet.property_values[1 + rawIdx%DMX_MAX] = rawdata[rawIdx];
+	_e131_seq++;
 
-//     is this the      last byte of last packet    ||   last byte of other packets
-		if ( (rawIdx == dmxChannelCount-1) || (rawIdx %DMX_MAX == DMX_MAX-1) )
+	// Only the universes holding changed channels are sent, each universe once
+	int universeCount = (dmxChannelCount + DMX_MAX - 1) / DMX_MAX;
+	int lastUniverseIdx = -1;
+	for (const DirtyRange& range : dirtyRanges)
+	{
+		int firstIdx = qMax((range.start * 3) / DMX_MAX, lastUniverseIdx + 1);
+		int lastIdx = qMin(((range.start + range.length) * 3 - 1) / DMX_MAX, universeCount - 1);
+		for (int universeIdx = firstIdx; universeIdx <= lastIdx; universeIdx++)
 		{
-#undef e131debug
-#if e131debug
-			Debug (_log, "send packet: rawidx %d dmxchannelcount %d universe: %d, packetsz %d"
-				, rawIdx
-				, dmxChannelCount
-				, _e131_universe + rawIdx / DMX_MAX
-				, E131_DMP_DATA + 1 + thisChannelCount
-				);
-#endif
-			retVal &= writeBytes(E131_DMP_DATA + 1 + thisChannelCount, e131_packet.raw);
+			retVal &= writeUniverse(rawdata, dmxChannelCount, universeIdx);
+			lastUniverseIdx = universeIdx;
 		}
 	}
 
 	return retVal;
 }
+
+int LedDeviceUdpE131::writeUniverse(const uint8_t * rawdata, int dmxChannelCount, int universeIdx)
+{
+	int firstChannel = universeIdx * DMX_MAX;
+	int thisChannelCount = qMin(dmxChannelCount - firstChannel, DMX_MAX);
+
+	prepare(_e131_universe + universeIdx, thisChannelCount);
+	e131_packet.sequence_number = _e131_seq;
+
+	memcpy(&e131_packet.property_values[1], rawdata + firstChannel, thisChannelCount);
+
+#undef e131debug
+#if e131debug
+	Debug (_log, "send packet: universeIdx %d dmxchannelcount %d universe: %d, packetsz %d"
+		, universeIdx
+		, dmxChannelCount
+		, _e131_universe + universeIdx
+		, E131_DMP_DATA + 1 + thisChannelCount
+		);
+#endif
+	return writeBytes(E131_DMP_DATA + 1 + thisChannelCount, e131_packet.raw);
+}
@@ -131,6 +131,25 @@ private:
 	///
 	int write(const std::vector<ColorRgb> & ledValues) override;
 
+	///
+	/// @brief Writes the universes holding changed RGB-Color values only.
+	///
+	/// @param[in] ledValues The RGB-color per LED
+	/// @param[in] dirtyRanges The ranges of LEDs changed since the last write
+	/// @return Zero on success, else negative
+	///
+	int writeDelta(const std::vector<ColorRgb> & ledValues, const std::vector<DirtyRange>& dirtyRanges) override;
+
+	///
+	/// @brief Write the channels of one universe
+	///
+	/// @param[in] rawdata The DMX channel values
+	/// @param[in] dmxChannelCount The total number of DMX channels
+	/// @param[in] universeIdx The index of the universe, relative to the first universe
+	/// @return Zero on success, else negative
+	///
+	int writeUniverse(const uint8_t * rawdata, int dmxChannelCount, int universeIdx);
+
 	///
 	/// @brief Generate E1.31 communication header
 	///
@@ -660,3 +660,19 @@ int LedDeviceWled::write(const std::vector<ColorRgb> &ledValues)
 
 	return rc;
 }
+
+int LedDeviceWled::writeDelta(const std::vector<ColorRgb>& ledValues, const std::vector<DirtyRange>& dirtyRanges)
+{
+	int rc {0};
+
+	if (_isStreamDDP)
+	{
+		rc = LedDeviceUdpDdp::writeDelta(ledValues, dirtyRanges);
+	}
+	else
+	{
+		rc = LedDeviceUdpRaw::write(ledValues);
+	}
+
+	return rc;
+}
@@ -105,6 +105,15 @@ protected:
 	///
 	int write(const std::vector<ColorRgb> & ledValues) override;
 
+	///
+	/// @brief Writes the changed RGB-Color values to the LEDs, if streamed via DDP. Raw UDP writes all LEDs.
+	///
+	/// @param[in] ledValues The RGB-color per LED
+	/// @param[in] dirtyRanges The ranges of LEDs changed since the last write
+	/// @return Zero on success, else negative
+	///
+	int writeDelta(const std::vector<ColorRgb>& ledValues, const std::vector<DirtyRange>& dirtyRanges) override;
+
 	///
 	/// @brief Power-/turn on the WLED device.
 	///
@@ -10,6 +10,7 @@
 
 #include <QList>
 #include <QHash>
+#include <QQueue>
 #include <QFile>
 #include <QDir>
 #include <QStandardPaths>
@@ -40,6 +41,8 @@ ProviderRestApi::ProviderRestApi(const QString& scheme, const QString& host, int
 	, _networkManager(nullptr)
 	, _requestTimeout(DEFAULT_REST_TIMEOUT)
 	,_isSeflSignedCertificateAccpeted(false)
+	, _asyncRequestsInFlight(0)
+	, _maxAsyncRequests(DEFAULT_MAX_ASYNC_REQUESTS)
 {
 	_networkManager = new QNetworkAccessManager();
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 9, 0))
@@ -65,6 +68,7 @@ ProviderRestApi::ProviderRestApi()
 
 ProviderRestApi::~ProviderRestApi()
 {
+	abortAsyncRequests();
 	delete _networkManager;
 }
 
@@ -219,8 +223,207 @@ httpResponse ProviderRestApi::deleteResource(const QUrl& url)
 	return executeOperation(QNetworkAccessManager::DeleteOperation, url);
 }
 
+void ProviderRestApi::putAsync(const QJsonObject& body)
+{
+	putAsync(getUrl(), body);
+}
+
+void ProviderRestApi::putAsync(const QUrl& url, const QJsonObject& body)
+{
+	const QString resource = url.toString();
+	AsyncResource& asyncResource = _asyncResources[resource];
+	asyncResource.url = url;
+
+	// Partial updates must not get lost, e.g. a state change followed by a color change
+	if (!asyncResource.isPending)
+	{
+		asyncResource.pendingJson = QJsonObject();
+	}
+	for (auto it = body.constBegin(); it != body.constEnd(); ++it)
+	{
+		asyncResource.pendingJson.insert(it.key(), it.value());
+	}
+	asyncResource.pendingBody = QJsonDocument(asyncResource.pendingJson).toJson(QJsonDocument::Compact);
+	asyncResource.isPending = true;
+
+	queueAsyncRequest(resource);
+}
+
+void ProviderRestApi::putAsync(const QUrl& url, const QByteArray& body)
+{
+	const QString resource = url.toString();
+	AsyncResource& asyncResource = _asyncResources[resource];
+	asyncResource.url = url;
+	asyncResource.pendingBody = body;
+	asyncResource.pendingJson = QJsonObject();
+	asyncResource.isPending = true;
+
+	queueAsyncRequest(resource);
+}
+
+void ProviderRestApi::queueAsyncRequest(const QString& resource)
+{
+	AsyncResource& asyncResource = _asyncResources[resource];
+
+	// A resource with a request in flight is queued again, when the reply is received
+	if (asyncResource.reply == nullptr && !asyncResource.isQueued)
+	{
+		asyncResource.isQueued = true;
+		_asyncQueue.enqueue(resource);
+	}
+
+	sendAsyncRequests();
+}
+
+void ProviderRestApi::setMaxAsyncRequests(int maxRequests)
+{
+	_maxAsyncRequests = qBound(1, maxRequests, MAX_ASYNC_REQUESTS);
+	sendAsyncRequests();
+}
+
+void ProviderRestApi::waitForAsyncRequests()
+{
+	if (_asyncResources.isEmpty())
+	{
+		return;
+	}
+
+	// Every request finishes latest by the transfer timeout
+	QEventLoop loop;
+	QObject::connect(this, &ProviderRestApi::asyncRequestFinished, &loop, [this, &loop]() {
+		if (_asyncResources.isEmpty())
+		{
+			loop.quit();
+		}
+	});
+	loop.exec();
+}
+
+void ProviderRestApi::abortAsyncRequests()
+{
+	for (const AsyncResource& asyncResource : std::as_const(_asyncResources))
+	{
+		if (asyncResource.reply != nullptr)
+		{
+			QObject::disconnect(asyncResource.reply, nullptr, this, nullptr);
+			asyncResource.reply->abort();
+			asyncResource.reply->deleteLater();
+		}
+	}
+	_asyncResources.clear();
+	_asyncQueue.clear();
+	_asyncRequestsInFlight = 0;
+}
+
+void ProviderRestApi::sendAsyncRequests()
+{
+	while (_asyncRequestsInFlight < _maxAsyncRequests && !_asyncQueue.isEmpty())
+	{
+		const QString resource = _asyncQueue.dequeue();
+		auto it = _asyncResources.find(resource);
+		if (it == _asyncResources.end())
+		{
+			continue;
+		}
+
+		it->isQueued = false;
+		if (!it->isPending || it->reply != nullptr)
+		{
+			continue;
+		}
+
+		QNetworkRequest request(_networkRequestHeaders);
+		request.setUrl(it->url);
+		request.setOriginatingObject(this);
+
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 15, 0))
+		_networkManager->setTransferTimeout(_requestTimeout.count());
+#endif
+
+		QNetworkReply* reply = _networkManager->put(request, it->pendingBody);
+		it->reply = reply;
+		it->pendingBody.clear();
+		it->pendingJson = QJsonObject();
+		it->isPending = false;
+		++_asyncRequestsInFlight;
+		const QUrl url = it->url;
+
+#if (QT_VERSION < QT_VERSION_CHECK(5, 15, 0))
+		ReplyTimeout::set(reply, _requestTimeout.count());
+#endif
+
+		QObject::connect(reply, &QNetworkReply::finished, this, [this, resource]() {
+			onAsyncReplyFinished(resource);
+		});
+
+		emit asyncRequestSent(url);
+	}
+}
+
+void ProviderRestApi::onAsyncReplyFinished(const QString& resource)
+{
+	auto it = _asyncResources.find(resource);
+	if (it == _asyncResources.end() || it->reply == nullptr)
+	{
+		return;
+	}
+
+	QNetworkReply* reply = it->reply;
+	it->reply = nullptr;
+	--_asyncRequestsInFlight;
+
+	const QUrl url = it->url;
+	httpResponse response = getResponse(reply);
+	reply->deleteLater();
+
+	if (response.error())
+	{
+		Debug(_log, "PUT (async) failed, HTTP %d: [%s] [%s]", response.getHttpStatusCode(), QSTRING_CSTR(url.toString()), QSTRING_CSTR(response.getErrorReason()));
+	}
+
+	if (it->isPending)
+	{
+		if (!it->isQueued)
+		{
+			it->isQueued = true;
+			_asyncQueue.enqueue(resource);
+		}
+	}
+	else
+	{
+		_asyncResources.erase(it);
+	}
+
+	sendAsyncRequests();
+
+	emit asyncRequestFinished(url, response);
+}
+
+void ProviderRestApi::discardAsyncRequest(const QUrl& url)
+{
+	auto it = _asyncResources.find(url.toString());
+	if (it != _asyncResources.end())
+	{
+		if (it->reply == nullptr)
+		{
+			_asyncResources.erase(it);
+		}
+		else
+		{
+			it->pendingBody.clear();
+			it->pendingJson = QJsonObject();
+			it->isPending = false;
+		}
+	}
+}
+
 httpResponse ProviderRestApi::executeOperation(QNetworkAccessManager::Operation operation, const QUrl& url, const QByteArray& body)
 {
+	if (operation != QNetworkAccessManager::GetOperation)
+	{
+		discardAsyncRequest(url);
+	}
+
 	// Perform request
 	QNetworkRequest request(_networkRequestHeaders);
 	request.setUrl(url);
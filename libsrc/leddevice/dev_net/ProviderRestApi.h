@@ -9,8 +9,11 @@
 #include <QNetworkReply>
 #include <QUrlQuery>
 #include <QJsonDocument>
+#include <QJsonObject>
 
 #include <QFile>
+#include <QHash>
+#include <QQueue>
 #include <QBasicTimer>
 #include <QTimerEvent>
 
@@ -18,6 +21,10 @@
 
 constexpr std::chrono::milliseconds DEFAULT_REST_TIMEOUT{ 2000 };
 
+// QNetworkAccessManager opens at most six connections per host, further requests would be queued internally
+constexpr int MAX_ASYNC_REQUESTS{ 6 };
+constexpr int DEFAULT_MAX_ASYNC_REQUESTS{ 4 };
+
 //Set QNetworkReply timeout without external timer
 //https://stackoverflow.com/questions/37444539/how-to-set-qnetworkreply-timeout-without-external-timer
 
@@ -374,6 +381,52 @@ public:
 	///
 	httpResponse deleteResource(const QUrl& url);
 
+	///
+	/// @brief Execute PUT request asynchronously, i.e. without waiting for the response
+	///
+	/// Requests to the same resource (URL) are coalesced, the latest state wins: A resource has at most one request
+	/// in flight and one pending. The keys of a new body are merged into the pending one, i.e. they replace the same keys
+	/// and keep the others. Requests to different resources are pipelined over the reused connections to the host,
+	/// limited by the maximum number of concurrent requests.
+	/// Sending the request is signalled by asyncRequestSent, the response by asyncRequestFinished.
+	///
+	/// @param[in] body The body of the request in JSON
+	///
+	void putAsync(const QJsonObject& body);
+
+	///
+	/// @brief Execute PUT request asynchronously, i.e. without waiting for the response
+	///
+	/// @param[in] URL (Resource) for PUT request
+	/// @param[in] body The body of the request in JSON, merged into the pending one
+	///
+	void putAsync(const QUrl& url, const QJsonObject& body);
+
+	///
+	/// @brief Execute PUT request asynchronously, i.e. without waiting for the response
+	///
+	/// @param[in] URL (Resource) for PUT request
+	/// @param[in] body The body of the request, replaces the pending one
+	///
+	void putAsync(const QUrl& url, const QByteArray& body);
+
+	///
+	/// @brief Set the maximum number of asynchronous requests in flight
+	///
+	/// @param[in] maxRequests Number of concurrent requests, limited to the connections per host
+	///
+	void setMaxAsyncRequests(int maxRequests);
+
+	///
+	/// @brief Wait until all asynchronous requests, in flight and pending, are finished
+	///
+	void waitForAsyncRequests();
+
+	///
+	/// @brief Abort all asynchronous requests in flight and drop the pending ones
+	///
+	void abortAsyncRequests();
+
 	///
 	/// @brief Handle responses for REST requests
 	///
@@ -425,6 +478,22 @@ public:
 	///
 	void setLogger(Logger* log) { _log = log; }
 
+signals:
+	///
+	/// @brief Emits when an asynchronous request was sent, i.e. the pending body of the resource is in flight
+	///
+	/// @param[in] url The URL (Resource) of the request
+	///
+	void asyncRequestSent(const QUrl& url);
+
+	///
+	/// @brief Emits when an asynchronous request finished
+	///
+	/// @param[in] url The URL (Resource) of the request
+	/// @param[in] response The response of the request
+	///
+	void asyncRequestFinished(const QUrl& url, const httpResponse& response);
+
 protected slots:
 	/// Handle the SSLErrors
 	void onSslErrors(QNetworkReply* reply, const QList<QSslError>& errors);
@@ -446,6 +515,47 @@ private:
 
 	bool matchesPinnedCertificate(const QSslCertificate& certificate);
 
+	///
+	/// @brief Send the pending asynchronous requests while below the maximum number of requests in flight
+	///
+	void sendAsyncRequests();
+
+	///
+	/// @brief Handle the reply of an asynchronous request and send the pending update of the resource
+	///
+	/// @param[in] resource The resource of the request
+	///
+	void onAsyncReplyFinished(const QString& resource);
+
+	///
+	/// @brief Drop the pending asynchronous update of a resource, as a synchronous request supersedes it
+	///
+	/// @param[in] url The URL (Resource)
+	///
+	void discardAsyncRequest(const QUrl& url);
+
+	///
+	/// @brief Queue the pending asynchronous update of a resource and send it, if possible
+	///
+	/// @param[in] resource The resource
+	///
+	void queueAsyncRequest(const QString& resource);
+
+	/// State of asynchronous requests per resource
+	struct AsyncResource
+	{
+		QUrl url;
+		/// latest body, not sent yet
+		QByteArray pendingBody;
+		/// latest body in JSON, if it is merged from JSON objects
+		QJsonObject pendingJson;
+		bool isPending = false;
+		/// true, if the resource waits in the queue for a free request slot
+		bool isQueued = false;
+		/// request in flight
+		QNetworkReply* reply = nullptr;
+	};
+
 	Logger* _log;
 
 	/// QNetworkAccessManager object for sending REST-requests.
@@ -464,6 +574,11 @@ private:
 
 	QString _serverIdentity;
 	bool _isSeflSignedCertificateAccpeted;
+
+	QHash<QString, AsyncResource> _asyncResources;
+	QQueue<QString> _asyncQueue;
+	int _asyncRequestsInFlight;
+	int _maxAsyncRequests;
 };
 
 #endif // PROVIDERRESTKAPI_H
@@ -27,19 +27,31 @@ const char DEFAULT_SEED_CUSTOM[] = "dtls_client";
 const int DEFAULT_HANDSHAKE_ATTEMPTS = 5;
 const int DEFAULT_HANDSHAKE_TIMEOUT_MIN = 300;
 const int DEFAULT_HANDSHAKE_TIMEOUT_MAX = 1000;
+
+// Delay between two handshake attempts
+const std::chrono::milliseconds HANDSHAKE_RETRY_DELAY{ 200 };
+
+// Maximum time waiting for the peer in a handshake step, the retransmission timer is evaluated by the next step
+const uint32_t HANDSHAKE_POLL_INTERVAL_MS = 10;
+
+// Pre-sized capacity of the frame buffers, e.g. a Hue Entertainment frame of 20 channels is < 300 bytes
+const int DEFAULT_RECORD_CAPACITY = 1024;
 }
 
+// Session fields are private since mbedtls 3
+#ifndef MBEDTLS_PRIVATE
+#define MBEDTLS_PRIVATE(member) member
+#endif
+
 
 ProviderUdpSSL::ProviderUdpSSL(const QJsonObject &deviceConfig)
 	: LedDevice(deviceConfig)
 	, _port(-1)
-	, client_fd()
 	, entropy()
-	, ssl()
 	, conf()
 	, cacert()
 	, ctr_drbg()
-	, timer()
+	, _streamThread(nullptr)
 	, _transport_type(DEFAULT_TRANSPORT_TYPE)
 	, _custom(DEFAULT_SEED_CUSTOM)
 	, _ssl_port(1)
@@ -69,6 +81,9 @@ ProviderUdpSSL::ProviderUdpSSL(const QJsonObject &deviceConfig)
 	{
 		Error(_log, "Failed to initialize mbedtls seed");
 	}
+
+	_streamThread = new DtlsStreamThread(&conf, _log, this);
+	connect(_streamThread, &DtlsStreamThread::streamFailed, this, &ProviderUdpSSL::onStreamFailed, Qt::QueuedConnection);
 }
 
 ProviderUdpSSL::~ProviderUdpSSL()
@@ -172,8 +187,6 @@ bool ProviderUdpSSL::initConnection()
 		return true;
 	}
 
-	mbedtls_net_init(&client_fd);
-	mbedtls_ssl_init(&ssl);
 	mbedtls_ssl_config_init(&conf);
 	mbedtls_x509_crt_init(&cacert);
 
@@ -200,7 +213,7 @@ bool ProviderUdpSSL::seedingRNG()
 
 	if (ret != 0)
 	{
-		Error(_log, "%s", QSTRING_CSTR(QString("mbedtls_ctr_drbg_seed FAILED %1").arg(errorMsg(ret))));
+		Error(_log, "%s", QSTRING_CSTR(QString("mbedtls_ctr_drbg_seed FAILED %1").arg(DtlsStreamThread::errorMsg(ret))));
 		return false;
 	}
 	return true;
@@ -214,7 +227,7 @@ bool ProviderUdpSSL::setupStructure()
 
 	if (ret != 0)
 	{
-		Error(_log, "%s", QSTRING_CSTR(QString("mbedtls_ssl_config_defaults FAILED %1").arg(errorMsg(ret))));
+		Error(_log, "%s", QSTRING_CSTR(QString("mbedtls_ssl_config_defaults FAILED %1").arg(DtlsStreamThread::errorMsg(ret))));
 		return false;
 	}
 
@@ -228,31 +241,12 @@ bool ProviderUdpSSL::setupStructure()
 	mbedtls_ssl_conf_ciphersuites(&conf, ciphersuites);
 	mbedtls_ssl_conf_rng(&conf, mbedtls_ctr_drbg_random, &ctr_drbg);
 
-	if ((ret = mbedtls_ssl_setup(&ssl, &conf)) != 0)
-	{
-		Error(_log, "%s", QSTRING_CSTR(QString("mbedtls_ssl_setup FAILED %1").arg(errorMsg(ret))));
-		return false;
-	}
-
 	return setupPSK();
 }
 
 bool ProviderUdpSSL::startConnection()
 {
-	mbedtls_ssl_session_reset(&ssl);
-
-	int ret = mbedtls_net_connect(&client_fd, _address.toString().toUtf8(), std::to_string(_ssl_port).c_str(), MBEDTLS_NET_PROTO_UDP);
-
-	if (ret != 0)
-	{
-		Error(_log, "%s", QSTRING_CSTR(QString("mbedtls_net_connect FAILED %1").arg(errorMsg(ret))));
-		return false;
-	}
-
-	mbedtls_ssl_set_bio(&ssl, &client_fd, mbedtls_net_send, mbedtls_net_recv, mbedtls_net_recv_timeout);
-	mbedtls_ssl_set_timer_cb(&ssl, &timer, mbedtls_timing_set_delay, mbedtls_timing_get_delay);
-
-	return startSSLHandshake();
+	return _streamThread->startStream(_address.toString(), _ssl_port, _handshake_attempts);
 }
 
 bool ProviderUdpSSL::setupPSK()
@@ -268,51 +262,18 @@ bool ProviderUdpSSL::setupPSK()
 
 	if (ret != 0)
 	{
-		Error(_log, "%s", QSTRING_CSTR(QString("mbedtls_ssl_conf_psk FAILED %1").arg(errorMsg(ret))));
+		Error(_log, "%s", QSTRING_CSTR(QString("mbedtls_ssl_conf_psk FAILED %1").arg(DtlsStreamThread::errorMsg(ret))));
 		return false;
 	}
 	return true;
 }
 
-bool ProviderUdpSSL::startSSLHandshake()
-{
-	int ret = 0;
-	for (int attempt = 1; attempt <= _handshake_attempts; ++attempt)
-	{
-		do
-		{
-			ret = mbedtls_ssl_handshake(&ssl);
-		} while (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE);
-
-		if (ret == 0)
-		{
-			break;
-		}
-
-		Warning(_log, "%s", QSTRING_CSTR(QString("mbedtls_ssl_handshake attempt %1/%2 FAILED. Reason: %3").arg(attempt).arg(_handshake_attempts).arg(errorMsg(ret))));
-		QThread::msleep(200);
-	}
-
-	if (ret != 0)
-	{
-		Error(_log, "%s", QSTRING_CSTR(QString("mbedtls_ssl_handshake FAILED %1").arg(errorMsg(ret))));
-		return false;
-	}
-
-	if (mbedtls_ssl_get_verify_result(&ssl) != 0)
-	{
-		Error(_log, "SSL certificate verification failed!");
-		return false;
-	}
-
-	return true;
-}
-
 void ProviderUdpSSL::stopConnection()
 {
+	_streamThread->stopStream();
+
 	if (_streamReady)
 	{
-		closeSSLNotify();
 		freeSSLConnection();
 		_streamReady = false;
 	}
@@ -323,9 +284,6 @@ void ProviderUdpSSL::freeSSLConnection()
 	try
 	{
 		Debug(_log, "Release mbedtls");
-		mbedtls_ssl_session_reset(&ssl);
-		mbedtls_net_free(&client_fd);
-		mbedtls_ssl_free(&ssl);
 		mbedtls_ssl_config_free(&conf);
 		mbedtls_x509_crt_free(&cacert);
 	}
@@ -351,35 +309,134 @@ void ProviderUdpSSL::writeBytes(unsigned int size, const uint8_t* data, bool flu
 		return;
 	}
 
-	if (!_streamReady || _streamPaused)
+	_streamPaused = flush;
+
+	_streamThread->postFrame(size, data);
+}
+
+void ProviderUdpSSL::onStreamFailed(const QString& reason)
+{
+	Error(_log, "Error while writing UDP SSL stream updates. %s", QSTRING_CSTR(reason));
+
+	if (_streamReady)
 	{
-		return;
+		stopConnection();
+		disable();
+
+		startEnableAttemptsTimer();
 	}
+}
 
-	_streamPaused = flush;
+DtlsStreamThread::DtlsStreamThread(const mbedtls_ssl_config* config, Logger* log, QObject* parent)
+	: QThread(parent)
+	, _config(config)
+	, _log(log)
+	, _netContext()
+	, _ssl()
+	, _timer()
+	, _session()
+	, _hasSession(false)
+	, _isSetup(false)
+	, _handshakeAttempts(DEFAULT_HANDSHAKE_ATTEMPTS)
+	, _stopRequested(false)
+	, _hasFrame(false)
+	, _state(State::Failed)
+	, _recordsSent(0)
+	, _recordsDropped(0)
+	, _sessionsResumed(0)
+{
+	_mailbox.reserve(DEFAULT_RECORD_CAPACITY);
+}
 
-	int ret = 0;
+DtlsStreamThread::~DtlsStreamThread()
+{
+	stopStream();
+}
 
-	do
+bool DtlsStreamThread::startStream(const QString& address, int port, int handshakeAttempts)
+{
+	stopStream();
+
+	mbedtls_net_init(&_netContext);
+	mbedtls_ssl_init(&_ssl);
+	mbedtls_ssl_session_init(&_session);
+	_isSetup = true;
+
+	int ret = mbedtls_ssl_setup(&_ssl, _config);
+	if (ret != 0)
 	{
-		ret = mbedtls_ssl_write(&ssl, data, size);
-	} while (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE);
+		Error(_log, "%s", QSTRING_CSTR(QString("mbedtls_ssl_setup FAILED %1").arg(errorMsg(ret))));
+		return false;
+	}
 
-	if (ret <= 0)
+	ret = mbedtls_net_connect(&_netContext, address.toUtf8(), std::to_string(port).c_str(), MBEDTLS_NET_PROTO_UDP);
+	if (ret != 0)
 	{
-		Error(_log, "Error while writing UDP SSL stream updates. mbedtls_ssl_write returned: %s", QSTRING_CSTR(errorMsg(ret)));
+		Error(_log, "%s", QSTRING_CSTR(QString("mbedtls_net_connect FAILED %1").arg(errorMsg(ret))));
+		return false;
+	}
 
-		if (_streamReady)
-		{
-			stopConnection();
-			disable();
+	// The handshake is stepped by the stream thread, the socket must not block
+	mbedtls_net_set_nonblock(&_netContext);
+	mbedtls_ssl_set_bio(&_ssl, &_netContext, mbedtls_net_send, mbedtls_net_recv, nullptr);
+	mbedtls_ssl_set_timer_cb(&_ssl, &_timer, mbedtls_timing_set_delay, mbedtls_timing_get_delay);
+
+	_handshakeAttempts = std::max(handshakeAttempts, 1);
+	_hasSession = false;
+	_sessionId.clear();
+	_recordsSent = 0;
+	_recordsDropped = 0;
+	_sessionsResumed = 0;
+
+	QMutexLocker lock(&_mutex);
+	_hasFrame = false;
+	_state = State::Handshake;
+	_stopRequested = false;
+	start(QThread::HighPriority);
+
+	while (_state == State::Handshake || _state == State::Backoff)
+	{
+		_condition.wait(&_mutex);
+	}
+	return _state == State::Streaming;
+}
 
-			startEnableAttemptsTimer();
+void DtlsStreamThread::stopStream()
+{
+	if (isRunning())
+	{
+		{
+			QMutexLocker lock(&_mutex);
+			_stopRequested = true;
+			_condition.wakeAll();
 		}
+		wait();
+
+		Debug(_log, "DTLS stream statistics - records sent: %llu, dropped: %llu, sessions resumed: %llu",
+			  static_cast<unsigned long long>(_recordsSent), static_cast<unsigned long long>(_recordsDropped), static_cast<unsigned long long>(_sessionsResumed));
 	}
+	freeSession();
 }
 
-QString ProviderUdpSSL::errorMsg(int ret)
+void DtlsStreamThread::postFrame(unsigned int size, const uint8_t* data)
+{
+	QMutexLocker lock(&_mutex);
+	if (_state != State::Streaming && _state != State::Handshake && _state != State::Backoff)
+	{
+		return;
+	}
+
+	if (_hasFrame)
+	{
+		++_recordsDropped;
+	}
+	_mailbox.resize(static_cast<int>(size));
+	memcpy(_mailbox.data(), data, size);
+	_hasFrame = true;
+	_condition.wakeAll();
+}
+
+QString DtlsStreamThread::errorMsg(int ret)
 {
 	char error_buf[1024];
 	mbedtls_strerror(ret, error_buf, 1024);
@@ -387,10 +444,229 @@ QString ProviderUdpSSL::errorMsg(int ret)
 	return QString("Last error was: code = %1, description = %2").arg(ret).arg(error_buf);
 }
 
-void ProviderUdpSSL::closeSSLNotify()
+void DtlsStreamThread::run()
+{
+	QByteArray record;
+	record.reserve(DEFAULT_RECORD_CAPACITY);
+
+	State state = State::Handshake;
+	bool isStreamStarted = false;
+	int attempt = 1;
+	std::chrono::steady_clock::time_point retryTime;
+
+	beginHandshake();
+
+	while (!_stopRequested && state != State::Failed)
+	{
+		switch (state)
+		{
+		case State::Handshake:
+		{
+			const int ret = mbedtls_ssl_handshake(&_ssl);
+			if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE)
+			{
+				mbedtls_net_poll(&_netContext, (ret == MBEDTLS_ERR_SSL_WANT_READ) ? MBEDTLS_NET_POLL_READ : MBEDTLS_NET_POLL_WRITE, HANDSHAKE_POLL_INTERVAL_MS);
+				break;
+			}
+
+			if (ret == 0 && mbedtls_ssl_get_verify_result(&_ssl) == 0)
+			{
+				if (finishHandshake())
+				{
+					++_sessionsResumed;
+					Debug(_log, "DTLS session resumed");
+				}
+				isStreamStarted = true;
+				attempt = 1;
+				state = State::Streaming;
+				publishState(state);
+				break;
+			}
+
+			const QString reason = (ret == 0) ? QString("SSL certificate verification failed!") : errorMsg(ret);
+			Warning(_log, "%s", QSTRING_CSTR(QString("mbedtls_ssl_handshake attempt %1/%2 FAILED. Reason: %3").arg(attempt).arg(_handshakeAttempts).arg(reason)));
+
+			if (attempt >= _handshakeAttempts)
+			{
+				Error(_log, "%s", QSTRING_CSTR(QString("mbedtls_ssl_handshake FAILED %1").arg(reason)));
+				state = State::Failed;
+				publishState(state);
+				if (isStreamStarted)
+				{
+					emit streamFailed(reason);
+				}
+				break;
+			}
+
+			++attempt;
+			retryTime = std::chrono::steady_clock::now() + HANDSHAKE_RETRY_DELAY;
+			state = State::Backoff;
+			publishState(state);
+			break;
+		}
+		case State::Backoff:
+		{
+			const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(retryTime - std::chrono::steady_clock::now());
+			if (remaining.count() > 0)
+			{
+				QMutexLocker lock(&_mutex);
+				if (!_stopRequested)
+				{
+					_condition.wait(&_mutex, static_cast<unsigned long>(remaining.count()));
+				}
+				break;
+			}
+
+			beginHandshake();
+			state = State::Handshake;
+			publishState(state);
+			break;
+		}
+		case State::Streaming:
+		{
+			{
+				QMutexLocker lock(&_mutex);
+				while (!_hasFrame && !_stopRequested)
+				{
+					_condition.wait(&_mutex);
+				}
+				if (_stopRequested)
+				{
+					break;
+				}
+
+				// The buffers are swapped, both keep their capacity
+				record.swap(_mailbox);
+				_hasFrame = false;
+			}
+
+			const int ret = writeRecord(record);
+			if (ret > 0)
+			{
+				++_recordsSent;
+			}
+			else
+			{
+				++_recordsDropped;
+				Warning(_log, "%s", QSTRING_CSTR(QString("mbedtls_ssl_write FAILED %1. Resuming session").arg(errorMsg(ret))));
+
+				beginHandshake();
+				state = State::Handshake;
+				publishState(state);
+			}
+			break;
+		}
+		case State::Failed:
+			break;
+		}
+	}
+
+	if (state == State::Streaming)
+	{
+		// Send the last frame posted before stopping, e.g. the black frame of switching off
+		bool hasFrame = false;
+		{
+			QMutexLocker lock(&_mutex);
+			if (_hasFrame)
+			{
+				record.swap(_mailbox);
+				_hasFrame = false;
+				hasFrame = true;
+			}
+		}
+		if (hasFrame)
+		{
+			if (writeRecord(record) > 0)
+			{
+				++_recordsSent;
+			}
+			else
+			{
+				++_recordsDropped;
+			}
+		}
+
+		/* No error checking, the connection might be closed already */
+		while (mbedtls_ssl_close_notify(&_ssl) == MBEDTLS_ERR_SSL_WANT_WRITE)
+		{
+		}
+	}
+
+	// Release startStream(), if the thread was stopped during the first handshake
+	if (state != State::Streaming && state != State::Failed)
+	{
+		publishState(State::Failed);
+	}
+}
+
+void DtlsStreamThread::beginHandshake()
+{
+	mbedtls_ssl_session_reset(&_ssl);
+
+	if (_hasSession)
+	{
+		int ret = mbedtls_ssl_set_session(&_ssl, &_session);
+		if (ret != 0)
+		{
+			Debug(_log, "%s", QSTRING_CSTR(QString("mbedtls_ssl_set_session FAILED %1, full handshake").arg(errorMsg(ret))));
+		}
+	}
+}
+
+bool DtlsStreamThread::finishHandshake()
+{
+	const QByteArray offeredSessionId = _hasSession ? _sessionId : QByteArray();
+
+	mbedtls_ssl_session_free(&_session);
+	mbedtls_ssl_session_init(&_session);
+	_hasSession = (mbedtls_ssl_get_session(&_ssl, &_session) == 0);
+
+	_sessionId.clear();
+	if (_hasSession)
+	{
+		_sessionId = QByteArray(reinterpret_cast<const char*>(_session.MBEDTLS_PRIVATE(id)), static_cast<int>(_session.MBEDTLS_PRIVATE(id_len)));
+	}
+
+	// The server resumes a session by echoing its identifier
+	return !offeredSessionId.isEmpty() && offeredSessionId == _sessionId;
+}
+
+int DtlsStreamThread::writeRecord(const QByteArray& record)
 {
-	/* No error checking, the connection might be closed already */
-	while (mbedtls_ssl_close_notify(&ssl) == MBEDTLS_ERR_SSL_WANT_WRITE)
+	int ret = 0;
+	do
 	{
+		ret = mbedtls_ssl_write(&_ssl, reinterpret_cast<const unsigned char*>(record.constData()), static_cast<size_t>(record.size()));
+		if (ret == MBEDTLS_ERR_SSL_WANT_WRITE)
+		{
+			mbedtls_net_poll(&_netContext, MBEDTLS_NET_POLL_WRITE, HANDSHAKE_POLL_INTERVAL_MS);
+		}
+	} while ((ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE) && !_stopRequested);
+
+	return ret;
+}
+
+void DtlsStreamThread::publishState(State state)
+{
+	QMutexLocker lock(&_mutex);
+	_state = state;
+	_condition.wakeAll();
+}
+
+void DtlsStreamThread::freeSession()
+{
+	if (_isSetup)
+	{
+		Debug(_log, "Release mbedtls session");
+		mbedtls_net_free(&_netContext);
+		mbedtls_ssl_free(&_ssl);
+		mbedtls_ssl_session_free(&_session);
+		_hasSession = false;
+		_sessionId.clear();
+		_isSetup = false;
 	}
+
+	QMutexLocker lock(&_mutex);
+	_state = State::Failed;
+	_hasFrame = false;
 }
@@ -9,6 +9,8 @@
 #include <QMutexLocker>
 #include <QHostInfo>
 #include <QThread>
+#include <QWaitCondition>
+#include <QByteArray>
 
 //----------- mbedtls
 #if defined(USE_MBEDTLS3)
@@ -28,8 +30,10 @@
 #include <string.h>
 #include <cstring>
 #include <chrono>
+#include <atomic>
 
 #include <mbedtls/net_sockets.h>
+#include <mbedtls/ssl.h>
 #include <mbedtls/ssl_ciphersuites.h>
 #include <mbedtls/entropy.h>
 #include <mbedtls/timing.h>
@@ -37,6 +41,119 @@
 #include <mbedtls/error.h>
 #include <mbedtls/debug.h>
 
+///
+/// @brief Streaming thread of a DTLS session
+///
+/// The handshake and the encryption of the records are done on a dedicated thread, i.e. they do not stall the LED-device
+/// thread. The handshake is a non-blocking state machine, attempts are retried without sleeping. Frames are handed over
+/// by a mailbox holding the latest frame only, a frame not sent yet is replaced by a newer one. After a write error
+/// the session is resumed (abbreviated handshake), if the peer supports it, before the stream is reported as failed.
+///
+class DtlsStreamThread : public QThread
+{
+	Q_OBJECT
+
+public:
+	///
+	/// @brief Constructor
+	///
+	/// @param config  The SSL configuration, must be valid while a stream is running
+	/// @param log     Logger of the LED-device
+	/// @param parent  Parent object
+	///
+	DtlsStreamThread(const mbedtls_ssl_config* config, Logger* log, QObject* parent = nullptr);
+	~DtlsStreamThread() override;
+
+	///
+	/// @brief Connect to the peer and start the stream thread
+	///
+	/// Blocks until the first handshake finished, i.e. succeeded or all attempts failed.
+	///
+	/// @param[in] address           The address of the peer
+	/// @param[in] port              The port of the peer
+	/// @param[in] handshakeAttempts The number of handshake attempts
+	/// @return True, if the stream is established
+	///
+	bool startStream(const QString& address, int port, int handshakeAttempts);
+
+	///
+	/// @brief Close the session, stop the stream thread and release the session
+	///
+	/// A frame still in the mailbox is sent before the session is closed.
+	///
+	void stopStream();
+
+	///
+	/// @brief Put a frame into the mailbox of the stream thread
+	///
+	/// @param[in] size The length of the data
+	/// @param[in] data The data
+	///
+	void postFrame(unsigned int size, const uint8_t* data);
+
+	///
+	/// @brief Get the description of an mbedtls error code
+	///
+	static QString errorMsg(int ret);
+
+signals:
+	///
+	/// @brief Emits on the stream thread, if a running stream failed and the session could not be resumed
+	///
+	/// @param[in] reason The reason of the failure
+	///
+	void streamFailed(const QString& reason);
+
+protected:
+	void run() override;
+
+private:
+	enum class State { Handshake, Backoff, Streaming, Failed };
+
+	/// Reset the session for a new handshake, offering the last session for resumption
+	void beginHandshake();
+
+	/// Keep the established session for a later resumption
+	/// @return True, if the peer resumed the offered session
+	bool finishHandshake();
+
+	/// Encrypt and send a record
+	int writeRecord(const QByteArray& record);
+
+	/// Publish the state to startStream()
+	void publishState(State state);
+
+	/// Release the mbedtls session contexts
+	void freeSession();
+
+	const mbedtls_ssl_config* _config;
+	Logger* _log;
+
+	mbedtls_net_context          _netContext;
+	mbedtls_ssl_context          _ssl;
+	mbedtls_timing_delay_context _timer;
+	mbedtls_ssl_session          _session;
+	bool                         _hasSession;
+	QByteArray                   _sessionId;
+	bool                         _isSetup;
+
+	int _handshakeAttempts;
+
+	std::atomic<bool> _stopRequested;
+
+	/// Mailbox and state, guarded by the mutex
+	QMutex _mutex;
+	QWaitCondition _condition;
+	QByteArray _mailbox;
+	bool _hasFrame;
+	State _state;
+
+	/// Counters of the current stream, logged when it stops
+	std::atomic<quint64> _recordsSent;
+	std::atomic<quint64> _recordsDropped;
+	std::atomic<quint64> _sessionsResumed;
+};
+
 class ProviderUdpSSL : public LedDevice
 {
 	Q_OBJECT
@@ -126,6 +243,15 @@ protected:
 
 	void setPSKidentity(const QString& pskIdentity);
 
+private slots:
+
+	///
+	/// @brief Handle a failed stream, i.e. disable the device and retry enabling it
+	///
+	/// @param[in] reason The reason of the failure
+	///
+	void onStreamFailed(const QString& reason);
+
 private:
 
 	bool initConnection();
@@ -134,19 +260,16 @@ private:
 	bool setupStructure();
 
 	bool setupPSK();
-	bool startSSLHandshake();
 
-	QString errorMsg(int ret);
-	void closeSSLNotify();
 	void freeSSLConnection();
 
-	mbedtls_net_context          client_fd;
 	mbedtls_entropy_context      entropy;
-	mbedtls_ssl_context          ssl;
 	mbedtls_ssl_config           conf;
 	mbedtls_x509_crt             cacert;
 	mbedtls_ctr_drbg_context     ctr_drbg;
-	mbedtls_timing_delay_context timer;
+
+	/// Stream thread of the DTLS session
+	DtlsStreamThread*            _streamThread;
 
 	QString      _transport_type;
 	QString      _custom;
@@ -0,0 +1,443 @@
+// system includes
+#include <algorithm>
+#include <cstring>
+
+// project includes
+#include <ledstreamserver/LedStreamServer.h>
+
+// hyperion includes
+#include <hyperion/Hyperion.h>
+
+// qt incl
+#include <QUdpSocket>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QtEndian>
+
+using namespace hyperion;
+
+// Constants
+namespace {
+
+const int MAX_DATAGRAM_SIZE = 65507;
+
+namespace DDP {
+
+	constexpr int DEFAULT_PORT = 4048;
+
+	// header is 10 bytes (14 if TIME flag used)
+	constexpr int HEADER_LEN = 10;
+	constexpr int HEADER_LEN_TIME = 14;
+
+	namespace flags1 {
+	constexpr uint8_t VER_MASK = 0xc0;
+	constexpr uint8_t VER1 = 0x40;
+	constexpr uint8_t PUSH = 0x01;
+	constexpr uint8_t QUERY = 0x02;
+	constexpr uint8_t REPLY = 0x04;
+	constexpr uint8_t TIME = 0x10;
+	}  // namespace flags1
+
+	namespace id {
+	constexpr uint8_t DISPLAY = 1;
+	constexpr uint8_t ALLDEVICES = 255;
+	}  // namespace id
+
+}  // namespace DDP
+
+namespace E131 {
+
+	constexpr int DEFAULT_PORT = 5568;
+
+	const uint8_t ACN_ID[12] = { 'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0x00, 0x00, 0x00 };
+
+	constexpr uint32_t VECTOR_ROOT_DATA = 0x00000004;
+	constexpr uint32_t VECTOR_ROOT_EXTENDED = 0x00000008;
+	constexpr uint32_t VECTOR_FRAME_DATA = 0x00000002;
+	constexpr uint32_t VECTOR_FRAME_SYNCHRONIZATION = 0x00000001;
+	constexpr uint8_t VECTOR_DMP_SET_PROPERTY = 0x02;
+	constexpr uint8_t DMP_TYPE = 0xa1;
+
+	// packet offsets
+	constexpr int ROOT_ACN_ID = 4;
+	constexpr int ROOT_VECTOR = 18;
+	constexpr int FRAME_VECTOR = 40;
+	constexpr int FRAME_SYNC_ADDRESS = 109;
+	constexpr int FRAME_SEQ = 111;
+	constexpr int FRAME_OPTIONS = 112;
+	constexpr int FRAME_UNIVERSE = 113;
+	constexpr int DMP_VECTOR = 117;
+	constexpr int DMP_TYPE_OFFSET = 118;
+	constexpr int DMP_COUNT = 123;
+	constexpr int DMP_START_CODE = 125;
+	constexpr int DMP_DATA = 126;
+
+	// synchronization packet offsets
+	constexpr int SYNC_ADDRESS = 45;
+	constexpr int SYNC_PACKET_LEN = 49;
+
+	constexpr uint8_t OPTION_PREVIEW = 0x80;
+	constexpr uint8_t OPTION_TERMINATED = 0x40;
+
+	// packets with a sequence number up to this distance behind the last one are out of order
+	constexpr int SEQUENCE_WINDOW = 20;
+
+	constexpr int MULTICAST_UNIVERSES_MAX = 64;
+
+	QHostAddress multicastGroup(int universe)
+	{
+		return QHostAddress((239U << 24) | (255U << 16) | static_cast<quint32>(universe & 0xffff));
+	}
+
+}  // namespace E131
+
+} //End of constants
+
+LedStreamServer::LedStreamServer(Hyperion* hyperion, const QJsonDocument& config)
+	: QObject()
+	, _hyperion(hyperion)
+	, _socket(new QUdpSocket(this))
+	, _log(nullptr)
+	, _protocol(Protocol::DDP)
+	, _port(0)
+	, _priority(0)
+	, _timeout(0)
+	, _universe(1)
+	, _channelsPerUniverse(510)
+	, _universeCount(0)
+	, _universesPending(0)
+	, _syncUniverse(0)
+	, _isRegistered(false)
+{
+	QString subComponent = _hyperion->property("instance").toString();
+	_log= Logger::getInstance("LEDSTREAM", subComponent);
+
+	Debug(_log, "Instance created");
+
+	// listen for component change
+	connect(_hyperion, &Hyperion::compStateChangeRequest, this, &LedStreamServer::compStateChangeRequest);
+	// listen for incoming data
+	connect(_socket, &QUdpSocket::readyRead, this, &LedStreamServer::readPendingDatagrams);
+
+	// init
+	handleSettingsUpdate(settings::LEDS, _hyperion->getSetting(settings::LEDS));
+	handleSettingsUpdate(settings::LEDSTREAMSERVER, config);
+}
+
+LedStreamServer::~LedStreamServer()
+{
+	stop();
+}
+
+void LedStreamServer::start()
+{
+	if ( active() )
+		return;
+
+	if (_socket->bind(QHostAddress::AnyIPv4, _port, QAbstractSocket::ShareAddress | QAbstractSocket::ReuseAddressHint))
+	{
+		Info(_log, "Started %s receiver on port: %d", _protocol == Protocol::DDP ? "DDP" : "E1.31", _port);
+		if (_protocol == Protocol::E131)
+		{
+			updateMulticastGroups(true);
+		}
+	}
+	else
+	{
+		Error(_log, "Failed to bind port %d: %s", _port, QSTRING_CSTR(_socket->errorString()));
+	}
+
+	_hyperion->setNewComponentState(COMP_LEDSTREAMSERVER, active());
+}
+
+void LedStreamServer::stop()
+{
+	if ( ! active() )
+		return;
+
+	updateMulticastGroups(false);
+	_socket->close();
+
+	if (_isRegistered)
+	{
+		_hyperion->clear(_priority);
+		_isRegistered = false;
+	}
+
+	Info(_log, "Stopped");
+	_hyperion->setNewComponentState(COMP_LEDSTREAMSERVER, active());
+}
+
+bool LedStreamServer::active() const
+{
+	return _socket->state() == QAbstractSocket::BoundState;
+}
+
+void LedStreamServer::compStateChangeRequest(hyperion::Components component, bool enable)
+{
+	if (component == COMP_LEDSTREAMSERVER)
+	{
+		if (active() != enable)
+		{
+			if (enable) start();
+			else        stop();
+		}
+	}
+}
+
+uint16_t LedStreamServer::getPort() const
+{
+	return _socket->localPort();
+}
+
+void LedStreamServer::readPendingDatagrams()
+{
+	QHostAddress sender;
+	while (_socket->hasPendingDatagrams())
+	{
+		const qint64 pendingSize = _socket->pendingDatagramSize();
+		if (pendingSize > static_cast<qint64>(_datagram.size()))
+		{
+			_datagram.resize(static_cast<size_t>(std::min<qint64>(pendingSize, MAX_DATAGRAM_SIZE)));
+		}
+
+		const qint64 size = _socket->readDatagram(_datagram.data(), static_cast<qint64>(_datagram.size()), &sender);
+		if (size <= 0 || _ledColors.empty())
+		{
+			continue;
+		}
+
+		const uint8_t* data = reinterpret_cast<const uint8_t*>(_datagram.data());
+		if (_protocol == Protocol::DDP)
+		{
+			processDdp(data, static_cast<int>(size), sender);
+		}
+		else
+		{
+			processE131(data, static_cast<int>(size), sender);
+		}
+	}
+}
+
+void LedStreamServer::processDdp(const uint8_t* data, int size, const QHostAddress& sender)
+{
+	if (size < DDP::HEADER_LEN)
+	{
+		return;
+	}
+
+	const uint8_t flags = data[0];
+	if ((flags & DDP::flags1::VER_MASK) != DDP::flags1::VER1 || (flags & (DDP::flags1::QUERY | DDP::flags1::REPLY)) != 0)
+	{
+		return;
+	}
+
+	const uint8_t id = data[3];
+	if (id != DDP::id::DISPLAY && id != DDP::id::ALLDEVICES)
+	{
+		return;
+	}
+
+	const int headerLen = (flags & DDP::flags1::TIME) ? DDP::HEADER_LEN_TIME : DDP::HEADER_LEN;
+	if (size < headerLen)
+	{
+		return;
+	}
+
+	const size_t bufferSize = _ledColors.size() * sizeof(ColorRgb);
+	const size_t offset = qFromBigEndian<quint32>(data + 4);
+	size_t length = std::min<size_t>(qFromBigEndian<quint16>(data + 8), static_cast<size_t>(size - headerLen));
+
+	if (offset < bufferSize)
+	{
+		length = std::min(length, bufferSize - offset);
+		memcpy(reinterpret_cast<uint8_t*>(_ledColors.data()) + offset, data + headerLen, length);
+	}
+
+	if (flags & DDP::flags1::PUSH)
+	{
+		pushFrame(sender);
+	}
+}
+
+void LedStreamServer::processE131(const uint8_t* data, int size, const QHostAddress& sender)
+{
+	if (size < E131::SYNC_PACKET_LEN || memcmp(data + E131::ROOT_ACN_ID, E131::ACN_ID, sizeof(E131::ACN_ID)) != 0)
+	{
+		return;
+	}
+
+	const uint32_t rootVector = qFromBigEndian<quint32>(data + E131::ROOT_VECTOR);
+	const uint32_t frameVector = qFromBigEndian<quint32>(data + E131::FRAME_VECTOR);
+
+	if (rootVector == E131::VECTOR_ROOT_EXTENDED)
+	{
+		// a synchronization packet releases the universes received so far
+		if (frameVector == E131::VECTOR_FRAME_SYNCHRONIZATION
+			&& _syncUniverse != 0
+			&& qFromBigEndian<quint16>(data + E131::SYNC_ADDRESS) == _syncUniverse
+			&& _universesPending < _universeCount)
+		{
+			pushFrame(sender);
+		}
+		return;
+	}
+
+	if (rootVector != E131::VECTOR_ROOT_DATA
+		|| frameVector != E131::VECTOR_FRAME_DATA
+		|| size <= E131::DMP_DATA
+		|| data[E131::DMP_VECTOR] != E131::VECTOR_DMP_SET_PROPERTY
+		|| data[E131::DMP_TYPE_OFFSET] != E131::DMP_TYPE
+		|| data[E131::DMP_START_CODE] != 0)
+	{
+		return;
+	}
+
+	const uint8_t options = data[E131::FRAME_OPTIONS];
+	if (options & E131::OPTION_PREVIEW)
+	{
+		return;
+	}
+
+	const int index = qFromBigEndian<quint16>(data + E131::FRAME_UNIVERSE) - _universe;
+	if (index < 0 || index >= _universeCount)
+	{
+		return;
+	}
+
+	if (options & E131::OPTION_TERMINATED)
+	{
+		if (_isRegistered)
+		{
+			Debug(_log, "Stream terminated by %s", QSTRING_CSTR(sender.toString()));
+			_hyperion->clear(_priority);
+			_isRegistered = false;
+		}
+		std::fill(_sequence.begin(), _sequence.end(), -1);
+		return;
+	}
+
+	// drop packets received out of order
+	const int sequence = data[E131::FRAME_SEQ];
+	if (_sequence[index] >= 0)
+	{
+		const int distance = static_cast<int8_t>(static_cast<uint8_t>(sequence - _sequence[index]));
+		if (distance <= 0 && distance > -E131::SEQUENCE_WINDOW)
+		{
+			return;
+		}
+	}
+	_sequence[index] = sequence;
+
+	// a universe received twice means the previous frame lacks universes, release what was received
+	if (_universeReceived[index])
+	{
+		pushFrame(sender);
+	}
+
+	const size_t bufferSize = _ledColors.size() * sizeof(ColorRgb);
+	const size_t offset = static_cast<size_t>(index) * static_cast<size_t>(_channelsPerUniverse);
+	const int count = qFromBigEndian<quint16>(data + E131::DMP_COUNT) - 1;
+	size_t length = std::min<size_t>(static_cast<size_t>(std::max(count, 0)), static_cast<size_t>(size - E131::DMP_DATA));
+	length = std::min(length, static_cast<size_t>(_channelsPerUniverse));
+	length = std::min(length, bufferSize - offset);
+
+	memcpy(reinterpret_cast<uint8_t*>(_ledColors.data()) + offset, data + E131::DMP_DATA, length);
+
+	_universeReceived[index] = true;
+	--_universesPending;
+	_syncUniverse = qFromBigEndian<quint16>(data + E131::FRAME_SYNC_ADDRESS);
+
+	if (_universesPending == 0 && _syncUniverse == 0)
+	{
+		pushFrame(sender);
+	}
+}
+
+void LedStreamServer::pushFrame(const QHostAddress& sender)
+{
+	if (!_isRegistered || sender != _registeredSender)
+	{
+		const QString origin = QString("%1@%2").arg(_protocol == Protocol::DDP ? "DDP" : "E1.31", sender.toString());
+		_hyperion->registerInput(_priority, hyperion::COMP_LEDSTREAMSERVER, origin);
+		_registeredSender = sender;
+		_isRegistered = true;
+	}
+
+	_hyperion->setInput(_priority, _ledColors, _timeout);
+
+	std::fill(_universeReceived.begin(), _universeReceived.end(), false);
+	_universesPending = _universeCount;
+}
+
+void LedStreamServer::updateLayout()
+{
+	const size_t channelCount = _ledColors.size() * sizeof(ColorRgb);
+	_universeCount = static_cast<int>((channelCount + _channelsPerUniverse - 1) / _channelsPerUniverse);
+	_universeReceived.assign(_universeCount, false);
+	_universesPending = _universeCount;
+	_sequence.assign(_universeCount, -1);
+	_syncUniverse = 0;
+}
+
+void LedStreamServer::updateMulticastGroups(bool join)
+{
+	for (const QHostAddress& group : _multicastGroups)
+	{
+		_socket->leaveMulticastGroup(group);
+	}
+	_multicastGroups.clear();
+
+	if (!join)
+	{
+		return;
+	}
+
+	const int universeCount = std::min(_universeCount, E131::MULTICAST_UNIVERSES_MAX);
+	for (int i = 0; i < universeCount; ++i)
+	{
+		const QHostAddress group = E131::multicastGroup(_universe + i);
+		if (_socket->joinMulticastGroup(group))
+		{
+			_multicastGroups.push_back(group);
+		}
+		else
+		{
+			Warning(_log, "Failed to join multicast group %s: %s", QSTRING_CSTR(group.toString()), QSTRING_CSTR(_socket->errorString()));
+		}
+	}
+}
+
+void LedStreamServer::handleSettingsUpdate(settings::type type, const QJsonDocument& config)
+{
+	if(type == settings::LEDSTREAMSERVER)
+	{
+		QJsonObject obj = config.object();
+		_protocol = (obj["protocol"].toString("ddp") == "e131") ? Protocol::E131 : Protocol::DDP;
+		int port = obj["port"].toInt(DDP::DEFAULT_PORT);
+		// the schema's default port is the one of DDP, a port left at it means the standard port of the protocol
+		if (_protocol == Protocol::E131 && port == DDP::DEFAULT_PORT)
+		{
+			port = E131::DEFAULT_PORT;
+		}
+		_port = static_cast<uint16_t>(port);
+		_priority = obj["priority"].toInt(140);
+		_timeout = obj["timeout"].toInt(2500);
+		_universe = obj["universe"].toInt(1);
+		_channelsPerUniverse = std::max(obj["channelsPerUniverse"].toInt(510), 1);
+		stop();
+		updateLayout();
+		if(obj["enable"].toBool())
+			start();
+	}
+	else if(type == settings::LEDS)
+	{
+		// LEDs not covered by the received data stay black
+		_ledColors.assign(config.array().size(), ColorRgb::BLACK);
+		updateLayout();
+		if (active() && _protocol == Protocol::E131)
+		{
+			updateMulticastGroups(true);
+		}
+	}
+}
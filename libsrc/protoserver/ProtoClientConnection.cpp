@@ -183,7 +183,7 @@ void ProtoClientConnection::handleImageCommand(const proto::ImageRequest &messag
 	}
 
 	// create ImageRgb
-	Image<ColorRgb> imageRGB(width, height);
+	Image<ColorRgb> imageRGB(width, height, ImageNoInit);
 	if (channelCount == 3)
 	{
 		memmove(imageRGB.memptr(), imageData.c_str(), imageData.size());
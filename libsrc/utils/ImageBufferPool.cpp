@@ -0,0 +1,292 @@
+#include <utils/ImageBufferPool.h>
+#include <utils/BitUtils.h>
+
+// STL includes
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <vector>
+
+// Qt includes
+#include <QJsonObject>
+
+namespace ImageBufferPool {
+
+namespace {
+
+// Size classes: everything up to MIN_CLASS_BYTES shares the first class, above every power of two range
+// is split into SUB_CLASSES linear classes. Larger buffers than MAX_POOLED_BYTES are not pooled.
+constexpr int MIN_CLASS_BITS = 8;
+constexpr size_t MIN_CLASS_BYTES = size_t(1) << MIN_CLASS_BITS;
+constexpr int SUB_CLASS_BITS = 3;
+constexpr size_t SUB_CLASSES = size_t(1) << SUB_CLASS_BITS;
+constexpr int MAX_POOLED_BITS = 26;
+constexpr size_t MAX_POOLED_BYTES = size_t(1) << MAX_POOLED_BITS;
+constexpr size_t CLASS_COUNT = 1 + static_cast<size_t>(MAX_POOLED_BITS - MIN_CLASS_BITS) * SUB_CLASSES;
+
+// Buffers kept per thread and size class, which covers the usual double buffering of a grabber
+constexpr size_t THREAD_CACHE_BUFFERS = 2;
+constexpr size_t THREAD_CACHE_MAX_BYTES = size_t(16) << 20;
+// Memory kept in the global free lists
+constexpr size_t GLOBAL_MAX_BYTES = size_t(48) << 20;
+
+struct Statistics
+{
+	std::atomic<uint64_t> reused { 0 };
+	std::atomic<uint64_t> systemAllocations { 0 };
+	std::atomic<uint64_t> systemFrees { 0 };
+	std::atomic<int64_t> inUseBytes { 0 };
+	std::atomic<int64_t> pooledBytes { 0 };
+};
+
+Statistics& statistics()
+{
+	static Statistics stats;
+	return stats;
+}
+
+// Size class and capacity of a buffer of the given size, the class is CLASS_COUNT for unpooled buffers
+inline size_t sizeClass(size_t bytes, size_t& capacity)
+{
+	if (bytes <= MIN_CLASS_BYTES)
+	{
+		capacity = MIN_CLASS_BYTES;
+		return 0;
+	}
+
+	if (bytes > MAX_POOLED_BYTES)
+	{
+		capacity = bytes;
+		return CLASS_COUNT;
+	}
+
+	const int exponent = BitUtils::highestBitIndex(static_cast<uint64_t>(bytes - 1));
+	const size_t base = size_t(1) << exponent;
+	const size_t step = base >> SUB_CLASS_BITS;
+	const size_t sub = (bytes - base + step - 1) / step;
+
+	capacity = base + sub * step;
+	return 1 + static_cast<size_t>(exponent - MIN_CLASS_BITS) * SUB_CLASSES + (sub - 1);
+}
+
+void* systemAllocate(size_t capacity)
+{
+	statistics().systemAllocations.fetch_add(1, std::memory_order_relaxed);
+	return ::operator new(capacity, std::align_val_t(ALIGNMENT));
+}
+
+void systemFree(void* buffer)
+{
+	statistics().systemFrees.fetch_add(1, std::memory_order_relaxed);
+	::operator delete(buffer, std::align_val_t(ALIGNMENT));
+}
+
+class GlobalPool
+{
+public:
+	void* take(size_t sizeClass)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		std::vector<void*>& list = _free[sizeClass];
+		if (list.empty())
+		{
+			return nullptr;
+		}
+
+		void* buffer = list.back();
+		list.pop_back();
+		return buffer;
+	}
+
+	bool put(size_t sizeClass, void* buffer, size_t capacity)
+	{
+		if (statistics().pooledBytes.load(std::memory_order_relaxed) + static_cast<int64_t>(capacity) > static_cast<int64_t>(GLOBAL_MAX_BYTES))
+		{
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		_free[sizeClass].push_back(buffer);
+		return true;
+	}
+
+private:
+	std::mutex _mutex;
+	std::array<std::vector<void*>, CLASS_COUNT> _free;
+};
+
+// Never destroyed, thread caches may be flushed to it during the shutdown
+GlobalPool& globalPool()
+{
+	static GlobalPool* pool = new GlobalPool();
+	return *pool;
+}
+
+// Images released after the thread cache was destroyed at the thread's exit bypass it
+thread_local bool threadCacheDestroyed = false;
+
+class ThreadCache
+{
+public:
+	~ThreadCache()
+	{
+		for (size_t sizeClass = 0; sizeClass < CLASS_COUNT; ++sizeClass)
+		{
+			Slots& slots = _slots[sizeClass];
+			while (slots.count > 0)
+			{
+				void* buffer = slots.buffers[--slots.count];
+				size_t capacity;
+				classCapacity(sizeClass, capacity);
+				_bytes -= capacity;
+				statistics().pooledBytes.fetch_sub(static_cast<int64_t>(capacity), std::memory_order_relaxed);
+				releaseGlobal(sizeClass, buffer, capacity);
+			}
+		}
+		threadCacheDestroyed = true;
+	}
+
+	void* take(size_t sizeClass, size_t capacity)
+	{
+		Slots& slots = _slots[sizeClass];
+		if (slots.count == 0)
+		{
+			return nullptr;
+		}
+
+		_bytes -= capacity;
+		return slots.buffers[--slots.count];
+	}
+
+	bool put(size_t sizeClass, void* buffer, size_t capacity)
+	{
+		Slots& slots = _slots[sizeClass];
+		if (slots.count == THREAD_CACHE_BUFFERS || _bytes + capacity > THREAD_CACHE_MAX_BYTES)
+		{
+			return false;
+		}
+
+		slots.buffers[slots.count++] = buffer;
+		_bytes += capacity;
+		return true;
+	}
+
+	static void releaseGlobal(size_t sizeClass, void* buffer, size_t capacity)
+	{
+		if (globalPool().put(sizeClass, buffer, capacity))
+		{
+			statistics().pooledBytes.fetch_add(static_cast<int64_t>(capacity), std::memory_order_relaxed);
+		}
+		else
+		{
+			systemFree(buffer);
+		}
+	}
+
+private:
+	static void classCapacity(size_t sizeClass, size_t& capacity)
+	{
+		if (sizeClass == 0)
+		{
+			capacity = MIN_CLASS_BYTES;
+			return;
+		}
+
+		const size_t index = sizeClass - 1;
+		const size_t base = MIN_CLASS_BYTES << (index / SUB_CLASSES);
+		capacity = base + (index % SUB_CLASSES + 1) * (base >> SUB_CLASS_BITS);
+	}
+
+	struct Slots
+	{
+		std::array<void*, THREAD_CACHE_BUFFERS> buffers {};
+		size_t count { 0 };
+	};
+
+	std::array<Slots, CLASS_COUNT> _slots;
+	size_t _bytes { 0 };
+};
+
+ThreadCache* threadCache()
+{
+	if (threadCacheDestroyed)
+	{
+		return nullptr;
+	}
+
+	thread_local ThreadCache cache;
+	return &cache;
+}
+
+} // namespace
+
+void* allocate(size_t bytes, size_t& capacity)
+{
+	Statistics& stats = statistics();
+	const size_t sizeClass = ImageBufferPool::sizeClass(bytes, capacity);
+	stats.inUseBytes.fetch_add(static_cast<int64_t>(capacity), std::memory_order_relaxed);
+
+	if (sizeClass == CLASS_COUNT)
+	{
+		return systemAllocate(capacity);
+	}
+
+	ThreadCache* cache = threadCache();
+	void* buffer = (cache != nullptr) ? cache->take(sizeClass, capacity) : nullptr;
+	if (buffer == nullptr)
+	{
+		buffer = globalPool().take(sizeClass);
+	}
+
+	if (buffer == nullptr)
+	{
+		return systemAllocate(capacity);
+	}
+
+	stats.reused.fetch_add(1, std::memory_order_relaxed);
+	stats.pooledBytes.fetch_sub(static_cast<int64_t>(capacity), std::memory_order_relaxed);
+	return buffer;
+}
+
+void release(void* buffer, size_t capacity)
+{
+	if (buffer == nullptr)
+	{
+		return;
+	}
+
+	statistics().inUseBytes.fetch_sub(static_cast<int64_t>(capacity), std::memory_order_relaxed);
+
+	size_t classCapacity;
+	const size_t sizeClass = ImageBufferPool::sizeClass(capacity, classCapacity);
+	if (sizeClass == CLASS_COUNT)
+	{
+		systemFree(buffer);
+		return;
+	}
+
+	ThreadCache* cache = threadCache();
+	if (cache != nullptr && cache->put(sizeClass, buffer, capacity))
+	{
+		statistics().pooledBytes.fetch_add(static_cast<int64_t>(capacity), std::memory_order_relaxed);
+		return;
+	}
+
+	ThreadCache::releaseGlobal(sizeClass, buffer, capacity);
+}
+
+QJsonObject getStatistics()
+{
+	const Statistics& stats = statistics();
+
+	QJsonObject result;
+	result["reused"] = static_cast<qint64>(stats.reused.load(std::memory_order_relaxed));
+	result["systemAllocations"] = static_cast<qint64>(stats.systemAllocations.load(std::memory_order_relaxed));
+	result["systemFrees"] = static_cast<qint64>(stats.systemFrees.load(std::memory_order_relaxed));
+	result["inUseBytes"] = static_cast<qint64>(stats.inUseBytes.load(std::memory_order_relaxed));
+	result["pooledBytes"] = static_cast<qint64>(stats.pooledBytes.load(std::memory_order_relaxed));
+	return result;
+}
+
+} // namespace ImageBufferPool
@@ -0,0 +1,341 @@
+#include <utils/ImageDecoder.h>
+
+// STL includes
+#include <array>
+#include <cstring>
+#include <limits>
+
+// Qt includes
+#include <QBuffer>
+#include <QImage>
+#include <QImageReader>
+#include <QSize>
+
+#ifdef HAVE_TURBO_JPEG
+#include <turbojpeg.h>
+#include <jconfig.h>
+#endif
+
+namespace ImageDecoder {
+
+namespace {
+
+// Reduce the size to the bound, keeping the aspect ratio
+QSize boundedSize(const QSize& size, int maxSize)
+{
+	if (maxSize <= 0 || (size.width() <= maxSize && size.height() <= maxSize))
+	{
+		return size;
+	}
+
+	return size.scaled(maxSize, maxSize, Qt::KeepAspectRatio).expandedTo(QSize(1, 1));
+}
+
+// Copy an RGB888 image into a new image
+void copyRgb888(const QImage& source, Image<ColorRgb>& image)
+{
+	Image<ColorRgb> target(source.width(), source.height(), ImageNoInit);
+	const size_t lineSize = static_cast<size_t>(source.width()) * sizeof(ColorRgb);
+	uint8_t* dest = reinterpret_cast<uint8_t*>(target.memptr());
+
+	if (static_cast<size_t>(source.bytesPerLine()) == lineSize)
+	{
+		memcpy(dest, source.constBits(), lineSize * static_cast<size_t>(source.height()));
+	}
+	else
+	{
+		for (int y = 0; y < source.height(); ++y)
+		{
+			memcpy(dest + lineSize * static_cast<size_t>(y), source.constScanLine(y), lineSize);
+		}
+	}
+
+	image = std::move(target);
+}
+
+#ifdef HAVE_TURBO_JPEG
+bool isJpeg(const QByteArray& data)
+{
+	return data.size() > 3
+		&& static_cast<uint8_t>(data[0]) == 0xFF
+		&& static_cast<uint8_t>(data[1]) == 0xD8
+		&& static_cast<uint8_t>(data[2]) == 0xFF;
+}
+
+// Decompressor instance of the calling thread, i.e. it is only initialised once per API thread
+class JpegDecompressor
+{
+public:
+	JpegDecompressor()
+		: _handle(tjInitDecompress())
+		, _scalingFactors(tjGetScalingFactors(&_scalingFactorsCount))
+	{
+	}
+
+	~JpegDecompressor()
+	{
+		if (_handle != nullptr)
+		{
+			tjDestroy(_handle);
+		}
+	}
+
+	JpegDecompressor(const JpegDecompressor&) = delete;
+	JpegDecompressor& operator=(const JpegDecompressor&) = delete;
+
+	bool decode(const QByteArray& data, int maxSize, Image<ColorRgb>& image, QString& error)
+	{
+		if (_handle == nullptr)
+		{
+			error = "Failed to initialise the JPEG decoder";
+			return false;
+		}
+
+		const auto* source = reinterpret_cast<const unsigned char*>(data.constData());
+		const auto sourceSize = static_cast<unsigned long>(data.size());
+
+		int width {0};
+		int height {0};
+		int subsamp {0};
+		int colorspace {0};
+		if (tjDecompressHeader3(_handle, source, sourceSize, &width, &height, &subsamp, &colorspace) < 0)
+		{
+			error = errorString();
+			return false;
+		}
+
+		// The largest reduction by the DCT scaling, which still provides at least the bounded size
+		const QSize bounded = boundedSize(QSize(width, height), maxSize);
+		int scaledWidth {width};
+		int scaledHeight {height};
+		for (int i = 0; i < _scalingFactorsCount && _scalingFactors != nullptr; ++i)
+		{
+			const tjscalingfactor& factor = _scalingFactors[i];
+			if (factor.num > factor.denom)
+			{
+				continue;
+			}
+
+			const int tempWidth = TJSCALED(width, factor);
+			const int tempHeight = TJSCALED(height, factor);
+			if (tempWidth >= bounded.width() && tempHeight >= bounded.height() && tempWidth < scaledWidth)
+			{
+				scaledWidth = tempWidth;
+				scaledHeight = tempHeight;
+			}
+		}
+
+		Image<ColorRgb> decoded(scaledWidth, scaledHeight, ImageNoInit);
+		if (tjDecompress2(_handle, source, sourceSize, reinterpret_cast<unsigned char*>(decoded.memptr()),
+						  scaledWidth, 0, scaledHeight, TJPF_RGB, TJFLAG_FASTDCT | TJFLAG_FASTUPSAMPLE) < 0 && isFatal())
+		{
+			error = errorString();
+			return false;
+		}
+
+		if (scaledWidth > bounded.width() || scaledHeight > bounded.height())
+		{
+			// The DCT scaling supports fixed factors only, reduce the rest in one pass
+			const QImage wrapped(reinterpret_cast<const uchar*>(decoded.memptr()), scaledWidth, scaledHeight,
+								 scaledWidth * static_cast<int>(sizeof(ColorRgb)), QImage::Format_RGB888);
+			copyRgb888(wrapped.scaled(bounded, Qt::IgnoreAspectRatio, Qt::SmoothTransformation), image);
+			return true;
+		}
+
+		image = std::move(decoded);
+		return true;
+	}
+
+private:
+	bool isFatal() const
+	{
+#if LIBJPEG_TURBO_VERSION_NUMBER > 2000000
+		return tjGetErrorCode(_handle) == TJERR_FATAL;
+#else
+		return true;
+#endif
+	}
+
+	QString errorString() const
+	{
+#if LIBJPEG_TURBO_VERSION_NUMBER > 2000000
+		return QString("Failed to decode JPEG image: %1").arg(tjGetErrorStr2(_handle));
+#else
+		return QString("Failed to decode JPEG image: %1").arg(tjGetErrorStr());
+#endif
+	}
+
+	tjhandle _handle;
+	int _scalingFactorsCount {0};
+	tjscalingfactor* _scalingFactors;
+};
+#endif
+
+// Decoding value of a base64 character, -1 for invalid characters
+constexpr std::array<int8_t, 128> base64Table()
+{
+	std::array<int8_t, 128> table {};
+	for (auto& value : table)
+	{
+		value = -1;
+	}
+	for (int i = 0; i < 26; ++i)
+	{
+		table[static_cast<size_t>('A' + i)] = static_cast<int8_t>(i);
+		table[static_cast<size_t>('a' + i)] = static_cast<int8_t>(26 + i);
+	}
+	for (int i = 0; i < 10; ++i)
+	{
+		table[static_cast<size_t>('0' + i)] = static_cast<int8_t>(52 + i);
+	}
+	table['+'] = 62;
+	table['/'] = 63;
+	// URL-safe alphabet
+	table['-'] = 62;
+	table['_'] = 63;
+	return table;
+}
+
+constexpr std::array<int8_t, 128> BASE64_TABLE = base64Table();
+
+// Length of the data decoded from base64, the padding and skipped characters do not count
+uint64_t decodedLength(const QString& base64)
+{
+	uint64_t characters = 0;
+	for (const QChar& character : base64)
+	{
+		const ushort code = character.unicode();
+		if (code == '=')
+		{
+			break;
+		}
+		if (code < BASE64_TABLE.size() && BASE64_TABLE[code] >= 0)
+		{
+			++characters;
+		}
+	}
+	return characters * 6 / 8;
+}
+
+} // namespace
+
+bool decode(const QByteArray& data, const QByteArray& format, int maxSize, Image<ColorRgb>& image, QString& error)
+{
+#ifdef HAVE_TURBO_JPEG
+	const QByteArray lowerFormat = format.toLower();
+	if ((lowerFormat.isEmpty() || lowerFormat == "jpg" || lowerFormat == "jpeg") && isJpeg(data))
+	{
+		thread_local JpegDecompressor decompressor;
+		return decompressor.decode(data, maxSize, image, error);
+	}
+#endif
+
+	QBuffer buffer;
+	buffer.setData(data);
+	buffer.open(QIODevice::ReadOnly);
+
+	QImageReader reader(&buffer, format);
+	const QSize size = reader.size();
+	if (size.isValid())
+	{
+		const QSize bounded = boundedSize(size, maxSize);
+		if (bounded != size)
+		{
+			reader.setScaledSize(bounded);
+		}
+	}
+
+	QImage decoded;
+	if (!reader.read(&decoded))
+	{
+		error = reader.errorString();
+		return false;
+	}
+
+	// formats without size information in the header
+	if (!size.isValid())
+	{
+		const QSize bounded = boundedSize(decoded.size(), maxSize);
+		if (bounded != decoded.size())
+		{
+			decoded = decoded.scaled(bounded, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+		}
+	}
+
+	// transparent pixels are black
+	if (decoded.hasAlphaChannel())
+	{
+		decoded = decoded.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+	}
+	if (decoded.format() != QImage::Format_RGB888)
+	{
+		decoded = decoded.convertToFormat(QImage::Format_RGB888);
+	}
+
+	copyRgb888(decoded, image);
+	return true;
+}
+
+bool decodeRawRgb(const QString& base64, int width, int height, Image<ColorRgb>& image, QString& error)
+{
+	if (width <= 0 || height <= 0)
+	{
+		error = "Size of image data does not match with the width and height";
+		return false;
+	}
+
+	// the decoded length is checked before allocating the image, the size is given by the client
+	const uint64_t expectedSize = static_cast<uint64_t>(width) * static_cast<uint64_t>(height) * 3;
+	if (expectedSize > std::numeric_limits<size_t>::max() || decodedLength(base64) != expectedSize)
+	{
+		error = "Size of image data does not match with the width and height";
+		return false;
+	}
+
+	Image<ColorRgb> target(width, height, ImageNoInit);
+	uint8_t* dest = reinterpret_cast<uint8_t*>(target.memptr());
+	const size_t size = static_cast<size_t>(target.size());
+
+	size_t written = 0;
+	uint32_t bits = 0;
+	int bitCount = 0;
+	for (const QChar& character : base64)
+	{
+		const ushort code = character.unicode();
+		if (code == '=')
+		{
+			break;
+		}
+
+		const int value = code < BASE64_TABLE.size() ? BASE64_TABLE[code] : -1;
+		if (value < 0)
+		{
+			// skip line breaks and other characters, like QByteArray::fromBase64()
+			continue;
+		}
+
+		bits = (bits << 6) | static_cast<uint32_t>(value);
+		bitCount += 6;
+		if (bitCount >= 8)
+		{
+			bitCount -= 8;
+			if (written == size)
+			{
+				error = "Size of image data does not match with the width and height";
+				return false;
+			}
+			dest[written++] = static_cast<uint8_t>(bits >> bitCount);
+		}
+	}
+
+	if (written != size)
+	{
+		error = "Size of image data does not match with the width and height";
+		return false;
+	}
+
+	image = std::move(target);
+	return true;
+}
+
+} // namespace ImageDecoder
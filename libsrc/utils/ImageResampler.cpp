@@ -1,6 +1,7 @@
 #include "utils/ImageResampler.h"
 #include <utils/ColorSys.h>
 #include <utils/Logger.h>
+#include <utils/Tracing.h>
 
 ImageResampler::ImageResampler()
 	: _horizontalDecimation(8)
@@ -24,6 +25,8 @@ void ImageResampler::setCropping(int cropLeft, int cropRight, int cropTop, int c
 
 void ImageResampler::processImage(const uint8_t * data, int width, int height, int lineLength, PixelFormat pixelFormat, Image<ColorRgb> &outputImage) const
 {
+	TRACE_SCOPE(tracing::Stage::RESAMPLE);
+
 	int cropLeft = _cropLeft;
 	int cropRight  = _cropRight;
 	int cropTop = _cropTop;
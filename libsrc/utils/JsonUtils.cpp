@@ -8,6 +8,8 @@
 #include <QRegularExpression>
 #include <QJsonObject>
 #include <QJsonParseError>
+#include <QHash>
+#include <QMutex>
 
 namespace JsonUtils {
 
@@ -84,18 +86,42 @@ namespace JsonUtils {
 
 	bool validate(const QString& file, const QJsonObject& json, const QString& schemaPath, Logger* log)
 	{
-		// get the schema data
-		QJsonObject schema;
-		if(!readFile(schemaPath, schema, log))
-			return false;
+		// schemas of the resources are compiled once, e.g. the JSON-RPC schemas validating every message
+		static QMutex cacheMutex;
+		static QHash<QString, QJsonSchemaChecker::CompiledSchema> compiledSchemas;
 
-		if(!validate(file, json, schema, log))
-			return false;
-		return true;
+		const bool isResource = schemaPath.startsWith(':');
+		QJsonSchemaChecker::CompiledSchema compiled;
+		if (isResource)
+		{
+			QMutexLocker lock(&cacheMutex);
+			compiled = compiledSchemas.value(schemaPath);
+		}
+
+		if (compiled == nullptr)
+		{
+			// get the schema data
+			QJsonObject schema;
+			if(!readFile(schemaPath, schema, log))
+				return false;
 
+			compiled = QJsonSchemaChecker::compile(schema);
+			if (isResource)
+			{
+				QMutexLocker lock(&cacheMutex);
+				compiledSchemas.insert(schemaPath, compiled);
+			}
+		}
+
+		return validate(file, json, compiled, log);
 	}
 
 	bool validate(const QString& file, const QJsonObject& json, const QJsonObject& schema, Logger* log)
+	{
+		return validate(file, json, QJsonSchemaChecker::compile(schema), log);
+	}
+
+	bool validate(const QString& file, const QJsonObject& json, const QJsonSchemaChecker::CompiledSchema& schema, Logger* log)
 	{
 		QJsonSchemaChecker schemaChecker;
 		schemaChecker.setSchema(schema);
@@ -1,6 +1,10 @@
 #include <utils/Logger.h>
 #include <utils/FileUtils.h>
+#include <utils/MpscRingBuffer.h>
 
+#include <atomic>
+#include <cstdarg>
+#include <cstring>
 #include <iostream>
 
 #ifndef _WIN32
@@ -13,7 +17,9 @@
 #include <QDateTime>
 #include <QFileInfo>
 #include <QMutexLocker>
+#include <QThread>
 #include <QThreadStorage>
+#include <QSemaphore>
 #include <QJsonObject>
 
 
@@ -42,8 +48,200 @@ const int MAX_LOG_MSG_BUFFERED = 500;
 const int MaxRepeatCountSize = 200;
 QThreadStorage<int> RepeatCount;
 QThreadStorage<Logger::T_LOG_MESSAGE> RepeatMessage;
+
+const size_t MAX_LOG_MSG_LENGTH = 1024;
+
+/// Number of records in the asynchronous log queue (power of two)
+const size_t ASYNC_LOG_QUEUE_SIZE = 512;
+
+/// Compact log record passed from the logging thread to the asynchronous log worker.
+/// File, function and line refer to the static call-site, the message is preformatted by the caller.
+struct LogRecord
+{
+	Logger*          logger;
+	Logger::LogLevel level;
+	const char*      sourceFile;
+	const char*      function;
+	unsigned int     line;
+	qint64           utime;
+	char             message[MAX_LOG_MSG_LENGTH];
+};
+
+std::atomic<bool> AsyncLogging { false };
+std::atomic<quint64> AsyncOverruns { 0 };
+
+/// Number of threads currently pushing to the asynchronous log queue
+std::atomic<int> AsyncProducers { 0 };
+
+///
+/// @brief Disable asynchronous logging and wait for threads, which are still pushing records
+///
+/// Afterwards no record is pushed anymore, i.e. the queue can be drained finally and loggers can be deleted.
+///
+/// @return False, if asynchronous logging was not enabled
+///
+bool disableAsyncLogging()
+{
+	if (!AsyncLogging.exchange(false))
+	{
+		return false;
+	}
+
+	while (AsyncProducers.load() != 0)
+	{
+		QThread::yieldCurrentThread();
+	}
+	return true;
+}
 } // namespace
 
+///
+/// @brief Background thread writing the records of the asynchronous log queue
+///
+class AsyncLogWorker : public QThread
+{
+public:
+	static AsyncLogWorker& getInstance()
+	{
+		// The worker is never destroyed while the application runs, as producers might still access the queue
+		static AsyncLogWorker worker;
+		return worker;
+	}
+
+	///
+	/// @brief Push a message to the queue, called by any thread
+	///
+	/// @return False, if the queue was full and the message was dropped
+	///
+	bool push(Logger* logger, Logger::LogLevel level, const char* sourceFile, const char* func, unsigned int line, const char* fmt, va_list args)
+	{
+		const qint64 utime = QDateTime::currentMSecsSinceEpoch();
+		const bool isPushed = _queue.tryPush([&](LogRecord& record)
+		{
+			record.logger     = logger;
+			record.level      = level;
+			record.sourceFile = sourceFile;
+			record.function   = func;
+			record.line       = line;
+			record.utime      = utime;
+			vsnprintf(record.message, MAX_LOG_MSG_LENGTH, fmt, args);
+		});
+
+		if (!isPushed)
+		{
+			AsyncOverruns.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		// Wake up the worker only, if it waits for new records
+		if (_isSleeping.exchange(false))
+		{
+			_wakeup.release();
+		}
+		return true;
+	}
+
+	void startWorker()
+	{
+		if (!isRunning())
+		{
+			_isStopRequested = false;
+			start(QThread::LowPriority);
+		}
+	}
+
+	///
+	/// @brief Stop the worker after all queued records were written
+	///
+	void stopWorker()
+	{
+		if (isRunning())
+		{
+			_isStopRequested = true;
+			_isSleeping = false;
+			_wakeup.release();
+			wait();
+		}
+
+		// Records pushed while the worker was stopping
+		drain();
+	}
+
+protected:
+	void run() override
+	{
+		while (true)
+		{
+			drain();
+
+			if (_isStopRequested)
+			{
+				break;
+			}
+
+			// Announce sleeping before the final check, so that producers do not miss to wake us up
+			_isSleeping = true;
+			if (_queue.isReadable() || _isStopRequested)
+			{
+				_isSleeping = false;
+				continue;
+			}
+			_wakeup.acquire();
+		}
+		drain();
+	}
+
+private:
+	AsyncLogWorker()
+		: _isStopRequested(false)
+		, _isSleeping(false)
+		, _repeatCount(0)
+		, _reportedOverruns(0)
+	{
+		setObjectName("AsyncLogWorker");
+	}
+
+	~AsyncLogWorker() override
+	{
+		disableAsyncLogging();
+		stopWorker();
+	}
+
+	void drain()
+	{
+		while (_queue.tryPop([this](LogRecord& record)
+		{
+			record.logger->dispatch(record.level, record.sourceFile, record.function, record.line, record.message, record.utime, _repeatCount, _repeatMessage);
+		}))
+		{
+		}
+
+		const quint64 overruns = AsyncOverruns.load(std::memory_order_relaxed);
+		if (overruns != _reportedOverruns)
+		{
+			char msg[MAX_LOG_MSG_LENGTH];
+			snprintf(msg, MAX_LOG_MSG_LENGTH, "Asynchronous log queue overrun, %llu message(s) dropped (%llu in total)",
+					 static_cast<unsigned long long>(overruns - _reportedOverruns), static_cast<unsigned long long>(overruns));
+			_reportedOverruns = overruns;
+
+			Logger* log = Logger::getInstance("LOGGER");
+			log->dispatch(Logger::WARNING, __FILE__, __FUNCTION__, __LINE__, msg, QDateTime::currentMSecsSinceEpoch(), _repeatCount, _repeatMessage);
+		}
+	}
+
+	MpscRingBuffer<LogRecord, ASYNC_LOG_QUEUE_SIZE> _queue;
+
+	std::atomic<bool> _isStopRequested;
+	std::atomic<bool> _isSleeping;
+	QSemaphore _wakeup;
+
+	/// Repeat detection of the worker's message stream
+	int _repeatCount;
+	Logger::T_LOG_MESSAGE _repeatMessage;
+
+	quint64 _reportedOverruns;
+};
+
 Logger* Logger::getInstance(const QString & name, const QString & subName, Logger::LogLevel minLevel)
 {
 	QMutexLocker lock(&MapLock);
@@ -61,6 +259,10 @@ Logger* Logger::getInstance(const QString & name, const QString & subName, Logge
 
 void Logger::deleteInstance(const QString & name, const QString & subName)
 {
+	// Queued records refer to their logger, write them before loggers are deleted
+	const bool isAsync = isAsynchronous();
+	stopAsynchronous();
+
 	QMutexLocker lock(&MapLock);
 
 	if (name.isEmpty())
@@ -75,6 +277,39 @@ void Logger::deleteInstance(const QString & name, const QString & subName)
 	{
 		delete LoggerMap.value(name + subName, nullptr);
 		LoggerMap.remove(name + subName);
+
+		setAsynchronous(isAsync);
+	}
+}
+
+void Logger::setAsynchronous(bool enable)
+{
+	if (enable)
+	{
+		AsyncLogWorker::getInstance().startWorker();
+		AsyncLogging = true;
+	}
+	else
+	{
+		stopAsynchronous();
+	}
+}
+
+bool Logger::isAsynchronous()
+{
+	return AsyncLogging;
+}
+
+quint64 Logger::getAsyncOverrunCount()
+{
+	return AsyncOverruns;
+}
+
+void Logger::stopAsynchronous()
+{
+	if (disableAsyncLogging())
+	{
+		AsyncLogWorker::getInstance().stopWorker();
 	}
 }
 
@@ -173,48 +408,69 @@ void Logger::Message(LogLevel level, const char* sourceFile, const char* func, u
 		return;
 	}
 
-	const size_t max_msg_length = 1024;
-	char msg[max_msg_length];
 	va_list args;
 	va_start (args, fmt);
-	vsnprintf (msg, max_msg_length, fmt, args);
+
+	if (AsyncLogging.load(std::memory_order_relaxed))
+	{
+		// Register as producer before checking again, so that stopping waits for the record to be pushed
+		AsyncProducers.fetch_add(1);
+		if (AsyncLogging.load())
+		{
+			// Only format the message, everything else is done by the worker thread
+			AsyncLogWorker::getInstance().push(this, level, sourceFile, func, line, fmt, args);
+			AsyncProducers.fetch_sub(1);
+			va_end (args);
+			return;
+		}
+		AsyncProducers.fetch_sub(1);
+	}
+
+	char msg[MAX_LOG_MSG_LENGTH];
+	vsnprintf (msg, MAX_LOG_MSG_LENGTH, fmt, args);
 	va_end (args);
 
+	dispatch(level, sourceFile, func, line, msg, QDateTime::currentMSecsSinceEpoch(), RepeatCount.localData(), RepeatMessage.localData());
+}
+
+void Logger::dispatch(LogLevel level, const char* sourceFile, const char* func, unsigned int line, const char* msg, qint64 utime,
+					  int& repeatCount, Logger::T_LOG_MESSAGE& repeatMessage)
+{
 	const auto repeatedSummary = [&]
 	{
-		Logger::T_LOG_MESSAGE repMsg = RepeatMessage.localData();
-		repMsg.message = "Previous line repeats " + QString::number(RepeatCount.localData()) + " times";
-		repMsg.utime   = QDateTime::currentMSecsSinceEpoch();
+		Logger::T_LOG_MESSAGE repMsg = repeatMessage;
+		repMsg.message = "Previous line repeats " + QString::number(repeatCount) + " times";
+		repMsg.utime   = utime;
 
 		write(repMsg);
 #ifndef _WIN32
 		if ( _syslogEnabled && repMsg.level >= Logger::WARNING )
 		{
-			syslog (LogLevelSysLog[repMsg.level], "Previous line repeats %d times", RepeatCount.localData());
+			syslog (LogLevelSysLog[repMsg.level], "Previous line repeats %d times", repeatCount);
 		}
 #endif
 
-		RepeatCount.setLocalData(0);
+		repeatCount = 0;
 	};
 
-	if (RepeatMessage.localData().loggerName == _name  &&
-		RepeatMessage.localData().loggerSubName == _subName  &&
-		RepeatMessage.localData().function == func &&
-		RepeatMessage.localData().message == msg   &&
-		RepeatMessage.localData().line == line)
+	if (repeatMessage.loggerName == _name  &&
+		repeatMessage.loggerSubName == _subName  &&
+		repeatMessage.function == func &&
+		repeatMessage.message == msg   &&
+		repeatMessage.line == line)
 	{
-		if (RepeatCount.localData() >= MaxRepeatCountSize)
+		if (repeatCount >= MaxRepeatCountSize)
 		{
 			repeatedSummary();
 		}
 		else
 		{
-			RepeatCount.setLocalData(RepeatCount.localData() + 1);
+			++repeatCount;
 		}
 	}
 	else
 	{
-		if (RepeatCount.localData())
+		if (repeatCount)
 		{
 			repeatedSummary();
 		}
@@ -226,7 +482,7 @@ void Logger::Message(LogLevel level, const char* sourceFile, const char* func, u
 		logMsg.function    = QString(func);
 		logMsg.line        = line;
 		logMsg.fileName    = FileUtils::getBaseName(sourceFile);
-		logMsg.utime       = QDateTime::currentMSecsSinceEpoch();
+		logMsg.utime       = utime;
 		logMsg.message     = QString(msg);
 		logMsg.level       = level;
 		logMsg.levelString = LogLevelStrings[level];
@@ -238,7 +494,7 @@ void Logger::Message(LogLevel level, const char* sourceFile, const char* func, u
 			syslog (LogLevelSysLog[level], "%s", msg);
 		}
 #endif
-		RepeatMessage.setLocalData(logMsg);
+		repeatMessage = logMsg;
 	}
 }
 
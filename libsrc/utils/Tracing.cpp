@@ -0,0 +1,416 @@
+#include <utils/Tracing.h>
+#include <utils/BitUtils.h>
+
+// STL includes
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <vector>
+
+// Qt includes
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QThread>
+
+namespace tracing {
+
+std::atomic<bool> RECORDING_ENABLED { true };
+
+namespace {
+
+const std::array<const char*, static_cast<size_t>(Stage::COUNT)> STAGE_NAMES = {
+	"grab",
+	"resample",
+	"borderDetection",
+	"mapping",
+	"adjustment",
+	"smoothing",
+	"deviceWrite"
+};
+
+constexpr size_t STAGE_COUNT = static_cast<size_t>(Stage::COUNT);
+
+// Log-linear histogram: values below SUB_BUCKETS are recorded exactly, above every power of two range is split into
+// SUB_BUCKETS linear buckets, i.e. the relative error is below 1/SUB_BUCKETS (~6%)
+constexpr int SUB_BUCKET_BITS = 4;
+constexpr uint64_t SUB_BUCKETS = 1ULL << SUB_BUCKET_BITS;
+// Largest exactly bucketed value is about 68s, longer durations end up in the last bucket
+constexpr int MAX_EXPONENT = 36;
+constexpr size_t BUCKET_COUNT = static_cast<size_t>(MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+// Number of recent spans kept per thread for the Chrome trace
+constexpr size_t SPAN_COUNT = 1024;
+
+inline size_t bucketIndex(uint64_t value)
+{
+	if (value < SUB_BUCKETS)
+	{
+		return static_cast<size_t>(value);
+	}
+
+	const int msb = BitUtils::highestBitIndex(value);
+	if (msb > MAX_EXPONENT)
+	{
+		return BUCKET_COUNT - 1;
+	}
+
+	const int shift = msb - SUB_BUCKET_BITS;
+	return static_cast<size_t>(shift + 1) * SUB_BUCKETS + static_cast<size_t>((value >> shift) & (SUB_BUCKETS - 1));
+}
+
+// Representative (mid) value of a bucket
+inline uint64_t bucketValue(size_t index)
+{
+	if (index < SUB_BUCKETS)
+	{
+		return index;
+	}
+
+	const size_t shift = index / SUB_BUCKETS - 1;
+	const uint64_t lower = (SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+	return lower + ((1ULL << shift) >> 1);
+}
+
+// Counters are only written by the owning thread, readers may see slightly outdated values.
+// Therefore plain load/store (no read-modify-write) is sufficient for updates.
+inline void increment(std::atomic<uint64_t>& counter, uint64_t value)
+{
+	counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+struct StageHistogram
+{
+	std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets {};
+	std::atomic<uint64_t> count { 0 };
+	std::atomic<uint64_t> sumNs { 0 };
+	std::atomic<uint64_t> maxNs { 0 };
+};
+
+struct Span
+{
+	std::atomic<int64_t> startNs { 0 };
+	// duration << 8 | stage
+	std::atomic<uint64_t> durationAndStage { 0 };
+};
+
+// Plain copy of histogram data as used by readers
+struct HistogramSnapshot
+{
+	std::array<uint64_t, BUCKET_COUNT> buckets {};
+	uint64_t count = 0;
+	uint64_t sumNs = 0;
+	uint64_t maxNs = 0;
+
+	void add(const StageHistogram& histogram)
+	{
+		for (size_t i = 0; i < BUCKET_COUNT; ++i)
+		{
+			buckets[i] += histogram.buckets[i].load(std::memory_order_relaxed);
+		}
+		count += histogram.count.load(std::memory_order_relaxed);
+		sumNs += histogram.sumNs.load(std::memory_order_relaxed);
+		maxNs = std::max(maxNs, histogram.maxNs.load(std::memory_order_relaxed));
+	}
+
+	void add(const HistogramSnapshot& other)
+	{
+		for (size_t i = 0; i < BUCKET_COUNT; ++i)
+		{
+			buckets[i] += other.buckets[i];
+		}
+		count += other.count;
+		sumNs += other.sumNs;
+		maxNs = std::max(maxNs, other.maxNs);
+	}
+
+	void subtract(const HistogramSnapshot& baseline)
+	{
+		for (size_t i = 0; i < BUCKET_COUNT; ++i)
+		{
+			buckets[i] -= std::min(buckets[i], baseline.buckets[i]);
+		}
+		count -= std::min(count, baseline.count);
+		sumNs -= std::min(sumNs, baseline.sumNs);
+	}
+
+	uint64_t percentile(double fraction) const
+	{
+		if (count == 0)
+		{
+			return 0;
+		}
+
+		const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(fraction * static_cast<double>(count) + 0.5));
+		uint64_t seen = 0;
+		for (size_t i = 0; i < BUCKET_COUNT; ++i)
+		{
+			seen += buckets[i];
+			if (seen >= rank)
+			{
+				return std::min(bucketValue(i), maxNs);
+			}
+		}
+		return maxNs;
+	}
+};
+
+struct ThreadState
+{
+	QString name;
+	qint64 id;
+	std::array<StageHistogram, STAGE_COUNT> stages;
+	std::array<Span, SPAN_COUNT> spans;
+	size_t spanPos = 0;
+
+	// Values at the last reset, only accessed by readers under the registry lock
+	std::array<HistogramSnapshot, STAGE_COUNT> baseline;
+};
+
+struct Registry
+{
+	std::mutex mutex;
+	std::vector<ThreadState*> threads;
+	// Metrics of threads already finished
+	std::array<HistogramSnapshot, STAGE_COUNT> retired;
+	int64_t resetTimeNs = nowNanos();
+	qint64 nextId = 1;
+};
+
+Registry& registry()
+{
+	static Registry instance;
+	return instance;
+}
+
+HistogramSnapshot snapshot(const ThreadState& state, size_t stage)
+{
+	HistogramSnapshot result;
+	result.add(state.stages[stage]);
+	if (state.baseline[stage].count > 0)
+	{
+		result.subtract(state.baseline[stage]);
+		// The exact max since the last reset is unknown, derive it from the histogram
+		result.maxNs = result.percentile(1.0);
+	}
+	return result;
+}
+
+class ThreadStateHolder
+{
+public:
+	~ThreadStateHolder()
+	{
+		if (_state == nullptr)
+		{
+			return;
+		}
+
+		Registry& reg = registry();
+		std::lock_guard<std::mutex> lock(reg.mutex);
+		for (size_t stage = 0; stage < STAGE_COUNT; ++stage)
+		{
+			reg.retired[stage].add(snapshot(*_state, stage));
+		}
+		reg.threads.erase(std::remove(reg.threads.begin(), reg.threads.end(), _state), reg.threads.end());
+		delete _state;
+	}
+
+	ThreadState* get()
+	{
+		if (_state == nullptr)
+		{
+			_state = new ThreadState();
+			QThread* thread = QThread::currentThread();
+			_state->name = (thread != nullptr) ? thread->objectName() : QString();
+
+			Registry& reg = registry();
+			std::lock_guard<std::mutex> lock(reg.mutex);
+			_state->id = reg.nextId++;
+			if (_state->name.isEmpty())
+			{
+				_state->name = QString("thread-%1").arg(_state->id);
+			}
+			reg.threads.push_back(_state);
+		}
+		return _state;
+	}
+
+private:
+	ThreadState* _state = nullptr;
+};
+
+thread_local ThreadStateHolder threadState;
+
+inline double toMicros(uint64_t nanos)
+{
+	return static_cast<double>(nanos) / 1000.0;
+}
+
+} // namespace
+
+const char* stageToString(Stage stage)
+{
+	const size_t index = static_cast<size_t>(stage);
+	return (index < STAGE_COUNT) ? STAGE_NAMES[index] : "unknown";
+}
+
+void setEnabled(bool enable)
+{
+	RECORDING_ENABLED.store(enable, std::memory_order_relaxed);
+}
+
+void record(Stage stage, int64_t startNs, int64_t endNs)
+{
+	const size_t index = static_cast<size_t>(stage);
+	if (index >= STAGE_COUNT)
+	{
+		return;
+	}
+
+	ThreadState* state = threadState.get();
+	const uint64_t durationNs = (endNs > startNs) ? static_cast<uint64_t>(endNs - startNs) : 0;
+
+	StageHistogram& histogram = state->stages[index];
+	increment(histogram.buckets[bucketIndex(durationNs)], 1);
+	increment(histogram.count, 1);
+	increment(histogram.sumNs, durationNs);
+	if (durationNs > histogram.maxNs.load(std::memory_order_relaxed))
+	{
+		histogram.maxNs.store(durationNs, std::memory_order_relaxed);
+	}
+
+	Span& span = state->spans[state->spanPos];
+	state->spanPos = (state->spanPos + 1) % SPAN_COUNT;
+	// Invalidate the span while it is updated, readers skip it
+	span.startNs.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	span.durationAndStage.store((durationNs << 8) | index, std::memory_order_relaxed);
+	span.startNs.store(startNs, std::memory_order_release);
+}
+
+QJsonObject getMetrics()
+{
+	std::array<HistogramSnapshot, STAGE_COUNT> totals;
+	QJsonArray threads;
+	int64_t resetTimeNs;
+	{
+		Registry& reg = registry();
+		std::lock_guard<std::mutex> lock(reg.mutex);
+		totals = reg.retired;
+		resetTimeNs = reg.resetTimeNs;
+		for (const ThreadState* state : reg.threads)
+		{
+			QJsonObject counts;
+			for (size_t stage = 0; stage < STAGE_COUNT; ++stage)
+			{
+				const HistogramSnapshot threadSnapshot = snapshot(*state, stage);
+				if (threadSnapshot.count > 0)
+				{
+					counts[STAGE_NAMES[stage]] = static_cast<qint64>(threadSnapshot.count);
+				}
+				totals[stage].add(threadSnapshot);
+			}
+
+			if (!counts.isEmpty())
+			{
+				threads.append(QJsonObject {
+					{ "name", state->name },
+					{ "id", state->id },
+					{ "counts", counts }
+				});
+			}
+		}
+	}
+
+	QJsonObject stages;
+	for (size_t stage = 0; stage < STAGE_COUNT; ++stage)
+	{
+		const HistogramSnapshot& total = totals[stage];
+		QJsonObject metrics;
+		metrics["count"] = static_cast<qint64>(total.count);
+		metrics["mean_us"] = (total.count > 0) ? toMicros(total.sumNs) / static_cast<double>(total.count) : 0.0;
+		metrics["p50_us"] = toMicros(total.percentile(0.5));
+		metrics["p90_us"] = toMicros(total.percentile(0.9));
+		metrics["p99_us"] = toMicros(total.percentile(0.99));
+		metrics["p999_us"] = toMicros(total.percentile(0.999));
+		metrics["max_us"] = toMicros(total.maxNs);
+		stages[STAGE_NAMES[stage]] = metrics;
+	}
+
+	return QJsonObject {
+		{ "enabled", isEnabled() },
+		{ "period_ms", static_cast<qint64>((nowNanos() - resetTimeNs) / 1000000) },
+		{ "stages", stages },
+		{ "threads", threads }
+	};
+}
+
+QJsonObject getChromeTrace()
+{
+	const qint64 pid = QCoreApplication::applicationPid();
+	QJsonArray events;
+
+	Registry& reg = registry();
+	std::lock_guard<std::mutex> lock(reg.mutex);
+	for (const ThreadState* state : reg.threads)
+	{
+		events.append(QJsonObject {
+			{ "name", "thread_name" },
+			{ "ph", "M" },
+			{ "pid", pid },
+			{ "tid", state->id },
+			{ "args", QJsonObject { { "name", state->name } } }
+		});
+
+		for (const Span& span : state->spans)
+		{
+			const int64_t startNs = span.startNs.load(std::memory_order_acquire);
+			if (startNs == 0)
+			{
+				continue;
+			}
+			const uint64_t durationAndStage = span.durationAndStage.load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (span.startNs.load(std::memory_order_relaxed) != startNs)
+			{
+				// Overwritten while reading
+				continue;
+			}
+
+			const size_t stage = durationAndStage & 0xFF;
+			events.append(QJsonObject {
+				{ "name", stageToString(static_cast<Stage>(stage)) },
+				{ "cat", "hyperion" },
+				{ "ph", "X" },
+				{ "pid", pid },
+				{ "tid", state->id },
+				{ "ts", toMicros(static_cast<uint64_t>(startNs)) },
+				{ "dur", toMicros(durationAndStage >> 8) }
+			});
+		}
+	}
+
+	return QJsonObject {
+		{ "traceEvents", events },
+		{ "displayTimeUnit", "ms" }
+	};
+}
+
+void reset()
+{
+	Registry& reg = registry();
+	std::lock_guard<std::mutex> lock(reg.mutex);
+	reg.retired = {};
+	reg.resetTimeNs = nowNanos();
+	for (ThreadState* state : reg.threads)
+	{
+		for (size_t stage = 0; stage < STAGE_COUNT; ++stage)
+		{
+			HistogramSnapshot current;
+			current.add(state->stages[stage]);
+			state->baseline[stage] = current;
+		}
+	}
+}
+
+} // namespace tracing
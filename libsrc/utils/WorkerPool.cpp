@@ -0,0 +1,124 @@
+#include <utils/WorkerPool.h>
+
+// STL includes
+#include <algorithm>
+
+WorkerPool& WorkerPool::getInstance()
+{
+	static WorkerPool instance;
+	return instance;
+}
+
+WorkerPool::~WorkerPool()
+{
+	stopThreads();
+}
+
+void WorkerPool::setThreadCount(int count)
+{
+	std::lock_guard<std::mutex> configLock(_configMutex);
+
+	count = std::max(count, 0);
+	if (count == static_cast<int>(_threads.size()))
+	{
+		return;
+	}
+
+	stopThreads();
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = false;
+	}
+
+	for (int i = 0; i < count; ++i)
+	{
+		_threads.emplace_back(&WorkerPool::work, this);
+	}
+	_threadCount.store(count, std::memory_order_relaxed);
+}
+
+void WorkerPool::run(size_t chunkCount, const std::function<void(size_t)>& task)
+{
+	if (chunkCount <= 1 || threadCount() == 0)
+	{
+		for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+		{
+			task(chunk);
+		}
+		return;
+	}
+
+	Job job;
+	job.task = &task;
+	job.chunkCount = chunkCount;
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_jobs.push_back(&job);
+	}
+	_jobAvailable.notify_all();
+
+	process(job);
+
+	// all chunks are claimed, wait for the workers still processing theirs
+	std::unique_lock<std::mutex> lock(_mutex);
+	_jobs.remove(&job);
+	_jobDone.wait(lock, [&job]() { return job.workers == 0; });
+}
+
+void WorkerPool::process(Job& job)
+{
+	for (size_t chunk = job.nextChunk.fetch_add(1, std::memory_order_relaxed); chunk < job.chunkCount; chunk = job.nextChunk.fetch_add(1, std::memory_order_relaxed))
+	{
+		(*job.task)(chunk);
+	}
+}
+
+void WorkerPool::work()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	while (true)
+	{
+		Job* job = nullptr;
+		_jobAvailable.wait(lock, [this, &job]() {
+			auto it = std::find_if(_jobs.begin(), _jobs.end(), [](const Job* candidate) {
+				return candidate->nextChunk.load(std::memory_order_relaxed) < candidate->chunkCount;
+			});
+			job = (it != _jobs.end()) ? *it : nullptr;
+			return _stop || job != nullptr;
+		});
+
+		if (_stop)
+		{
+			return;
+		}
+
+		++job->workers;
+		lock.unlock();
+
+		process(*job);
+
+		lock.lock();
+		if (--job->workers == 0)
+		{
+			_jobDone.notify_all();
+		}
+	}
+}
+
+void WorkerPool::stopThreads()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_jobAvailable.notify_all();
+
+	for (std::thread& thread : _threads)
+	{
+		thread.join();
+	}
+	_threads.clear();
+	_threadCount.store(0, std::memory_order_relaxed);
+}
@@ -3,11 +3,275 @@
 #include <iterator>
 #include <algorithm>
 #include <cmath>
+#include <vector>
 
 // Utils-Jsonschema includes
 #include <utils/jsonschema/QJsonSchemaChecker.h>
 #include <utils/jsonschema/QJsonUtils.h>
 
+// qt includes
+#include <QSet>
+
+struct QJsonSchemaChecker::Node
+{
+	enum class Keyword
+	{
+		Type,
+		Properties,
+		Dependencies,
+		AdditionalProperties,
+		Minimum,
+		Maximum,
+		MinLength,
+		MaxLength,
+		Items,
+		MinItems,
+		MaxItems,
+		UniqueItems,
+		Enum,
+		Unknown
+	};
+
+	enum class Type
+	{
+		Any,
+		String,
+		Number,
+		Integer,
+		Boolean,
+		Object,
+		Array,
+		Null
+	};
+
+	struct Property
+	{
+		QString name;
+		/// segment of the path in messages
+		QString pathSegment;
+		/// the schema of the property, used to create missing properties
+		QJsonValue schema;
+		CompiledSchema node;
+		bool required = false;
+		/// first entry of options.dependencies, the property is not created if the dependency differs
+		bool hasDependency = false;
+		QString dependencyName;
+		QJsonValue dependencyValue;
+	};
+
+	struct Condition
+	{
+		QString name;
+		bool isArray = false;
+		QJsonValue value;
+		QJsonArray values;
+	};
+
+	struct Dependency
+	{
+		QString name;
+		QString pathSegment;
+		std::vector<Condition> conditions;
+	};
+
+	/// the checked keywords in the order of the schema, unknown keywords are reported by name
+	std::vector<QPair<Keyword, QString>> keywords;
+
+	QJsonValue defaultValue = QJsonValue(QJsonValue::Null);
+
+	QString typeName;
+	Type type = Type::Any;
+
+	std::vector<Property> properties;
+	std::vector<Dependency> dependencies;
+
+	/// the properties handled by the properties attribute, they are ignored by additionalProperties
+	QSet<QString> propertyNames;
+	QJsonValue additionalProperties;
+	CompiledSchema additionalNode;
+
+	QJsonValue minimum;
+	QJsonValue maximum;
+	QJsonValue minLength;
+	QJsonValue maxLength;
+
+	CompiledSchema items;
+	bool allowEmptyArray = false;
+	QJsonValue minItems;
+	QJsonValue maxItems;
+	bool uniqueItems = false;
+
+	QJsonValue enumSchema;
+	/// string values of the enum and all other values
+	QSet<QString> enumStrings;
+	QJsonArray enumValues;
+};
+
+namespace {
+
+const QSet<QString> IGNORED_KEYWORDS {
+	"required", "id", "title", "description", "default", "format", "defaultProperties", "propertyOrder", "append", "step",
+	"access", "options", "script", "allowEmptyArray", "comment", "watch", "template"
+};
+
+using Node = QJsonSchemaChecker::Node;
+
+QJsonSchemaChecker::CompiledSchema compileNode(const QJsonObject& schema)
+{
+	auto node = std::make_shared<Node>();
+
+	QJsonObject::const_iterator defaultValue = schema.find("default");
+	if (defaultValue != schema.end())
+		node->defaultValue = *defaultValue;
+
+	for (QJsonObject::const_iterator i = schema.begin(); i != schema.end(); ++i)
+	{
+		const QString attribute = i.key();
+		const QJsonValue& attributeValue = *i;
+
+		if (attribute == "type")
+		{
+			node->typeName = attributeValue.toString();
+			if (node->typeName == "string" || node->typeName == "enum")
+				node->type = Node::Type::String;
+			else if (node->typeName == "number" || node->typeName == "double")
+				node->type = Node::Type::Number;
+			else if (node->typeName == "integer")
+				node->type = Node::Type::Integer;
+			else if (node->typeName == "boolean")
+				node->type = Node::Type::Boolean;
+			else if (node->typeName == "object")
+				node->type = Node::Type::Object;
+			else if (node->typeName == "array")
+				node->type = Node::Type::Array;
+			else if (node->typeName == "null")
+				node->type = Node::Type::Null;
+			node->keywords.push_back({Node::Keyword::Type, QString()});
+		}
+		else if (attribute == "properties")
+		{
+			const QJsonObject properties = attributeValue.toObject();
+			for (QJsonObject::const_iterator p = properties.begin(); p != properties.end(); ++p)
+			{
+				const QJsonObject propertySchema = p.value().toObject();
+
+				Node::Property property;
+				property.name = p.key();
+				property.pathSegment = "." + p.key();
+				property.schema = p.value();
+				property.node = compileNode(propertySchema);
+				property.required = propertySchema.value("required").toBool(false);
+
+				const QJsonObject depends = propertySchema.value("options").toObject().value("dependencies").toObject();
+				if (!depends.isEmpty())
+				{
+					property.hasDependency = true;
+					property.dependencyName = depends.begin().key();
+					property.dependencyValue = depends.begin().value();
+				}
+
+				node->properties.push_back(property);
+				node->propertyNames.insert(p.key());
+			}
+			node->keywords.push_back({Node::Keyword::Properties, QString()});
+		}
+		else if (attribute == "dependencies")
+		{
+			const QJsonObject dependencies = attributeValue.toObject();
+			for (QJsonObject::const_iterator d = dependencies.begin(); d != dependencies.end(); ++d)
+			{
+				if (!d.value().toObject().contains("properties"))
+					continue;
+
+				Node::Dependency dependency;
+				dependency.name = d.key();
+				dependency.pathSegment = "." + d.key();
+
+				const QJsonObject conditions = d.value().toObject()["properties"].toObject();
+				for (QJsonObject::const_iterator c = conditions.begin(); c != conditions.end(); ++c)
+				{
+					Node::Condition condition;
+					condition.name = c.key();
+					condition.value = c.value().toObject()["enum"];
+					condition.isArray = condition.value.isArray();
+					condition.values = condition.value.toArray();
+					dependency.conditions.push_back(condition);
+				}
+				node->dependencies.push_back(dependency);
+			}
+			node->keywords.push_back({Node::Keyword::Dependencies, QString()});
+		}
+		else if (attribute == "additionalProperties")
+		{
+			node->additionalProperties = attributeValue;
+			node->additionalNode = compileNode(attributeValue.toObject());
+			node->keywords.push_back({Node::Keyword::AdditionalProperties, QString()});
+		}
+		else if (attribute == "minimum")
+		{
+			node->minimum = attributeValue;
+			node->keywords.push_back({Node::Keyword::Minimum, QString()});
+		}
+		else if (attribute == "maximum")
+		{
+			node->maximum = attributeValue;
+			node->keywords.push_back({Node::Keyword::Maximum, QString()});
+		}
+		else if (attribute == "minLength")
+		{
+			node->minLength = attributeValue;
+			node->keywords.push_back({Node::Keyword::MinLength, QString()});
+		}
+		else if (attribute == "maxLength")
+		{
+			node->maxLength = attributeValue;
+			node->keywords.push_back({Node::Keyword::MaxLength, QString()});
+		}
+		else if (attribute == "items")
+		{
+			node->items = compileNode(attributeValue.toObject());
+			node->allowEmptyArray = attributeValue.toObject().contains("allowEmptyArray");
+			node->keywords.push_back({Node::Keyword::Items, QString()});
+		}
+		else if (attribute == "minItems")
+		{
+			node->minItems = attributeValue;
+			node->keywords.push_back({Node::Keyword::MinItems, QString()});
+		}
+		else if (attribute == "maxItems")
+		{
+			node->maxItems = attributeValue;
+			node->keywords.push_back({Node::Keyword::MaxItems, QString()});
+		}
+		else if (attribute == "uniqueItems")
+		{
+			node->uniqueItems = attributeValue.toBool();
+			node->keywords.push_back({Node::Keyword::UniqueItems, QString()});
+		}
+		else if (attribute == "enum")
+		{
+			node->enumSchema = attributeValue;
+			for (const QJsonValue& value : attributeValue.toArray())
+			{
+				if (value.isString())
+					node->enumStrings.insert(value.toString());
+				else
+					node->enumValues.append(value);
+			}
+			node->keywords.push_back({Node::Keyword::Enum, QString()});
+		}
+		else if (!IGNORED_KEYWORDS.contains(attribute))
+		{
+			// no check function defined for this attribute, reported while validating
+			node->keywords.push_back({Node::Keyword::Unknown, attribute});
+		}
+	}
+
+	return node;
+}
+
+} // namespace
+
 QJsonSchemaChecker::QJsonSchemaChecker() :
 	_ignoreRequired(false),
 	_error(false),
@@ -21,15 +285,26 @@ QJsonSchemaChecker::~QJsonSchemaChecker()
 	// empty
 }
 
+QJsonSchemaChecker::CompiledSchema QJsonSchemaChecker::compile(const QJsonObject& schema)
+{
+	return compileNode(schema);
+}
+
 bool QJsonSchemaChecker::setSchema(const QJsonObject& schema)
 {
-	_qSchema = schema;
+	_schema = compile(schema);
 
 	// TODO: check the schema
 
 	return true;
 }
 
+bool QJsonSchemaChecker::setSchema(const CompiledSchema& schema)
+{
+	_schema = schema;
+	return _schema != nullptr;
+}
+
 void QJsonSchemaChecker::setMessage(const QString& message)
 {
 	_messages.append(_currentPath.join("") + ": " + message);
@@ -51,7 +326,8 @@ QPair<bool, bool> QJsonSchemaChecker::validate(const QJsonObject& value, bool ig
 	_currentPath.append("[root]");
 
 	// validate
-	validate(value, _qSchema);
+	if (_schema != nullptr)
+		validate(value, *_schema);
 
 	return QPair<bool, bool>(!_error, !_schemaError);
 }
@@ -70,123 +346,111 @@ QJsonObject QJsonSchemaChecker::getAutoCorrectedConfig(const QJsonObject& value,
 		_correct = correct;
 		_currentPath.clear();
 		_currentPath.append("[root]");
-		validate(_autoCorrected, _qSchema);
+		if (_schema != nullptr)
+			validate(_autoCorrected, *_schema);
 	}
 
 	return _autoCorrected;
 }
 
-void QJsonSchemaChecker::validate(const QJsonValue& value, const QJsonObject& schema)
+void QJsonSchemaChecker::validate(const QJsonValue& value, const Node& schema)
 {
 	// check the current json value
-	for (QJsonObject::const_iterator i = schema.begin(); i != schema.end(); ++i)
+	for (const auto& keyword : schema.keywords)
 	{
-		QString attribute = i.key();
-		const QJsonValue& attributeValue = *i;
-
-		QJsonObject::const_iterator defaultValue = schema.find("default");
-
-		if (attribute == "type")
-			checkType(value, attributeValue, (defaultValue != schema.end() ? *defaultValue : QJsonValue(QJsonValue::Null)));
-		else if (attribute == "properties")
+		switch (keyword.first)
 		{
+		case Node::Keyword::Type:
+			checkType(value, schema);
+			break;
+		case Node::Keyword::Properties:
 			if (value.isObject())
-				checkProperties(value.toObject(), attributeValue.toObject());
+				checkProperties(value.toObject(), schema);
 			else
 			{
 				_schemaError = true;
 				setMessage("properties attribute is only valid for objects");
-				continue;
 			}
-		}
-		else if (attribute == "dependencies")
-		{
+			break;
+		case Node::Keyword::Dependencies:
 			if (value.isObject())
-				checkDependencies(value.toObject(), attributeValue.toObject());
+				checkDependencies(value.toObject(), schema);
 			else
 			{
 				_schemaError = true;
 				setMessage("dependencies attribute is only valid for objects");
-				continue;
 			}
-		}
-		else if (attribute == "additionalProperties")
-		{
+			break;
+		case Node::Keyword::AdditionalProperties:
 			if (value.isObject())
-			{
-				// ignore the properties which are handled by the properties attribute (if present)
-				QStringList ignoredProperties;
-				if (schema.contains("properties")) {
-					const QJsonObject& props = schema["properties"].toObject();
-					ignoredProperties = props.keys();
-				}
-
-				checkAdditionalProperties(value.toObject(), attributeValue, ignoredProperties);
-			}
+				checkAdditionalProperties(value.toObject(), schema);
 			else
 			{
 				_schemaError = true;
 				setMessage("additional properties attribute is only valid for objects");
-				continue;
 			}
-		}
-		else if (attribute == "minimum")
-			checkMinimum(value, attributeValue, (defaultValue != schema.end() ? *defaultValue : QJsonValue(QJsonValue::Null)));
-		else if (attribute == "maximum")
-			checkMaximum(value, attributeValue, (defaultValue != schema.end() ? *defaultValue : QJsonValue(QJsonValue::Null)));
-		else if (attribute == "minLength")
-			checkMinLength(value, attributeValue, (defaultValue != schema.end() ? *defaultValue : QJsonValue(QJsonValue::Null)));
-		else if (attribute == "maxLength")
-			checkMaxLength(value, attributeValue, (defaultValue != schema.end() ? *defaultValue : QJsonValue(QJsonValue::Null)));
-		else if (attribute == "items")
-		{
+			break;
+		case Node::Keyword::Minimum:
+			checkMinimum(value, schema);
+			break;
+		case Node::Keyword::Maximum:
+			checkMaximum(value, schema);
+			break;
+		case Node::Keyword::MinLength:
+			checkMinLength(value, schema);
+			break;
+		case Node::Keyword::MaxLength:
+			checkMaxLength(value, schema);
+			break;
+		case Node::Keyword::Items:
 			if (value.isArray())
-				checkItems(value, attributeValue.toObject());
+				checkItems(value, schema);
 			else
 			{
 				_error = true;
 				setMessage("items only valid for arrays");
-				continue;
 			}
-		}
-		else if (attribute == "minItems")
-			checkMinItems(value, attributeValue, (defaultValue != schema.end() ? *defaultValue : QJsonValue(QJsonValue::Null)));
-		else if (attribute == "maxItems")
-			checkMaxItems(value, attributeValue, (defaultValue != schema.end() ? *defaultValue : QJsonValue(QJsonValue::Null)));
-		else if (attribute == "uniqueItems")
-			checkUniqueItems(value, attributeValue);
-		else if (attribute == "enum")
-			checkEnum(value, attributeValue, (defaultValue != schema.end() ? *defaultValue : QJsonValue(QJsonValue::Null)));
-		else if (attribute == "required")
-			; // nothing to do. value is present so always oke
-		else if (attribute == "id")
-			; // references have already been collected
-		else if (attribute == "title" || attribute == "description" || attribute == "default" || attribute == "format"
-			|| attribute == "defaultProperties" || attribute == "propertyOrder" || attribute == "append" || attribute == "step"
-			|| attribute == "access" || attribute == "options" || attribute == "script" || attribute == "allowEmptyArray" || attribute == "comment"
-			|| attribute == "watch" || attribute == "template")
-			; // nothing to do.
-		else
-		{
+			break;
+		case Node::Keyword::MinItems:
+			checkMinItems(value, schema);
+			break;
+		case Node::Keyword::MaxItems:
+			checkMaxItems(value, schema);
+			break;
+		case Node::Keyword::UniqueItems:
+			checkUniqueItems(value, schema);
+			break;
+		case Node::Keyword::Enum:
+			checkEnum(value, schema);
+			break;
+		case Node::Keyword::Unknown:
 			// no check function defined for this attribute
 			_schemaError = true;
-			setMessage("No check function defined for attribute " + attribute);
-			continue;
+			setMessage("No check function defined for attribute " + keyword.second);
+			break;
 		}
 	}
 }
 
-void QJsonSchemaChecker::checkType(const QJsonValue& value, const QJsonValue& schema, const QJsonValue& defaultValue)
+void QJsonSchemaChecker::correctValue(const Node& schema, const QJsonValue& fallback)
 {
-	QString type = schema.toString();
+	(schema.defaultValue != QJsonValue::Null) ?
+		QJsonUtils::modify(_autoCorrected, _currentPath, schema.defaultValue) :
+		QJsonUtils::modify(_autoCorrected, _currentPath, fallback);
+}
 
+void QJsonSchemaChecker::checkType(const QJsonValue& value, const Node& schema)
+{
 	bool wrongType = false;
-	if (type == "string")
+	switch (schema.type)
+	{
+	case Node::Type::String:
 		wrongType = !value.isString();
-	else if (type == "number")
+		break;
+	case Node::Type::Number:
 		wrongType = !value.isDouble();
-	else if (type == "integer")
-	{
+		break;
+	case Node::Type::Integer:
 		if (value.isDouble()) //check if value type not boolean (true = 1 && false = 0)
 		{
 			double valueIntegratlPart;
@@ -198,60 +462,58 @@ void QJsonSchemaChecker::checkType(const QJsonValue& value, const QJsonValue& sc
 		}
 		else
 			wrongType = true;
-	}
-	else if (type == "double")
-		wrongType = !value.isDouble();
-	else if (type == "boolean")
+		break;
+	case Node::Type::Boolean:
 		wrongType = !value.isBool();
-	else if (type == "object")
+		break;
+	case Node::Type::Object:
 		wrongType = !value.isObject();
-	else if (type == "array")
+		break;
+	case Node::Type::Array:
 		wrongType = !value.isArray();
-	else if (type == "null")
+		break;
+	case Node::Type::Null:
 		wrongType = !value.isNull();
-	else if (type == "enum")
-		wrongType = !value.isString();
-	else if (type == "any")
+		break;
+	case Node::Type::Any:
 		wrongType = false;
+		break;
+	}
 
 	if (wrongType)
 	{
 		_error = true;
 
 		if (_correct == "modify")
-			QJsonUtils::modify(_autoCorrected, _currentPath, defaultValue);
+			QJsonUtils::modify(_autoCorrected, _currentPath, schema.defaultValue);
 
 
 		if (_correct == "")
-			setMessage(type + " expected");
+			setMessage(schema.typeName + " expected");
 	}
 }
 
-void QJsonSchemaChecker::checkProperties(const QJsonObject& value, const QJsonObject& schema)
+void QJsonSchemaChecker::checkProperties(const QJsonObject& value, const Node& schema)
 {
-	for (QJsonObject::const_iterator i = schema.begin(); i != schema.end(); ++i)
+	for (const Node::Property& property : schema.properties)
 	{
-		QString property = i.key();
-
-		const QJsonValue& propertyValue = *i;
-
-		_currentPath.append("." + property);
+		_currentPath.append(property.pathSegment);
 
-		if (value.contains(property))
+		QJsonObject::const_iterator member = value.constFind(property.name);
+		if (member != value.constEnd())
 		{
-			validate(value[property], propertyValue.toObject());
+			validate(*member, *property.node);
 		}
-		else if (!verifyDeps(property, value, schema))
+		else if (!(property.hasDependency && value.contains(property.dependencyName) && value[property.dependencyName] != property.dependencyValue))
 		{
-			bool isRequired = propertyValue.toObject().value("required").toBool(false);
-			if (isRequired && !_ignoreRequired)
+			if (property.required && !_ignoreRequired)
 			{
 				_error = true;
 
 				if (_correct == "create")
 				{
-					QJsonUtils::modify(_autoCorrected, _currentPath, QJsonUtils::create(propertyValue, _ignoreRequired), property);
-					setMessage("Create property: " + property + " with value: " + QJsonUtils::getDefaultValue(propertyValue));
+					QJsonUtils::modify(_autoCorrected, _currentPath, QJsonUtils::create(property.schema, _ignoreRequired), property.name);
+					setMessage("Create property: " + property.name + " with value: " + QJsonUtils::getDefaultValue(property.schema));
 				}
 
 				if (_correct == "")
@@ -261,7 +523,7 @@ void QJsonSchemaChecker::checkProperties(const QJsonObject& value, const QJsonOb
 			}
 			else if (_correct == "create" && _ignoreRequired)
 			{
-				QJsonUtils::modify(_autoCorrected, _currentPath, QJsonUtils::create(propertyValue, _ignoreRequired), property);
+				QJsonUtils::modify(_autoCorrected, _currentPath, QJsonUtils::create(property.schema, _ignoreRequired), property.name);
 			}
 		}
 
@@ -269,94 +531,62 @@ void QJsonSchemaChecker::checkProperties(const QJsonObject& value, const QJsonOb
 	}
 }
 
-bool QJsonSchemaChecker::verifyDeps(const QString& property, const QJsonObject& value, const QJsonObject& schema)
+void QJsonSchemaChecker::checkDependencies(const QJsonObject& value, const Node& schema)
 {
-	if (schema[property].toObject().contains("options") && (schema[property].toObject())["options"].toObject().contains("dependencies"))
+	for (const Node::Dependency& dependency : schema.dependencies)
 	{
-		const QJsonObject& depends = ((schema[property].toObject())["options"].toObject())["dependencies"].toObject();
+		_currentPath.append(dependency.pathSegment);
 
-		const QStringList dependsKeys = depends.keys();
-		if (!dependsKeys.isEmpty())
+		bool valid = false;
+		for (const Node::Condition& condition : dependency.conditions)
 		{
-			const QString firstName = dependsKeys.constFirst();
-			if (value.contains(firstName))
-			{
-				if (value[firstName] != depends[firstName])
-					return true;
-			}
-		}
-	}
-	return false;
-}
-
-void QJsonSchemaChecker::checkDependencies(const QJsonObject& value, const QJsonObject& schema)
-{
-	for (QJsonObject::const_iterator i = schema.begin(); i != schema.end(); ++i)
-	{
-		QString property = i.key();
-		const QJsonValue& propertyValue = *i;
-
-		if (propertyValue.toObject().contains("properties"))
-		{
-			_currentPath.append("." + property);
-
-			const QJsonObject& dependencies = propertyValue.toObject()["properties"].toObject();
-
-			bool valid = false;
-			for (QJsonObject::const_iterator d = dependencies.begin(); d != dependencies.end(); ++d)
+			if (condition.isArray)
 			{
-				QString dependency = d.key();
-				const QJsonValue& dependencyValue = *d;
-
-				if (dependencyValue.toObject()["enum"].isArray())
+				for (int a = 0; a < condition.values.size(); ++a)
 				{
-					QJsonArray jArray = dependencyValue.toObject()["enum"].toArray();
-					for (int a = 0; a < jArray.size(); ++a)
+					if (value[condition.name] == condition.values[a])
 					{
-						if (value[dependency] == jArray[a])
-						{
-							valid = true;
-							break;
-						}
-						else
-							valid = false;
+						valid = true;
+						break;
 					}
+					else
+						valid = false;
 				}
-				else
-					valid = (value[dependency] == dependencyValue.toObject()["enum"]);
 			}
+			else
+				valid = (value[condition.name] == condition.value);
+		}
 
-			if (value.contains(property) && !valid)
-			{
-				_error = true;
-
-				if (_correct == "remove")
-				{
-					QJsonUtils::modify(_autoCorrected, _currentPath);
-					setMessage("Removed property: " + property);
-				}
+		if (value.contains(dependency.name) && !valid)
+		{
+			_error = true;
 
-				if (_correct == "")
-					setMessage("Property not required");
+			if (_correct == "remove")
+			{
+				QJsonUtils::modify(_autoCorrected, _currentPath);
+				setMessage("Removed property: " + dependency.name);
 			}
 
-			_currentPath.removeLast();
+			if (_correct == "")
+				setMessage("Property not required");
 		}
+
+		_currentPath.removeLast();
 	}
 }
 
-void QJsonSchemaChecker::checkAdditionalProperties(const QJsonObject& value, const QJsonValue& schema, const QStringList& ignoredProperties)
+void QJsonSchemaChecker::checkAdditionalProperties(const QJsonObject& value, const Node& schema)
 {
 	for (QJsonObject::const_iterator i = value.begin(); i != value.end(); ++i)
 	{
-		QString property = i.key();
-		if (std::find(ignoredProperties.begin(), ignoredProperties.end(), property) == ignoredProperties.end())
+		const QString& property = i.key();
+		if (!schema.propertyNames.contains(property))
 		{
 			// property has no property definition. check against the definition for additional properties
 			_currentPath.append("." + property);
-			if (schema.isBool())
+			if (schema.additionalProperties.isBool())
 			{
-				if (schema.toBool() == false)
+				if (schema.additionalProperties.toBool() == false)
 				{
 					_error = true;
 
@@ -372,14 +602,14 @@ void QJsonSchemaChecker::checkAdditionalProperties(const QJsonObject& value, con
 			}
 			else
 			{
-				validate(value[property].toObject(), schema.toObject());
+				validate(i.value().toObject(), *schema.additionalNode);
 			}
 			_currentPath.removeLast();
 		}
 	}
 }
 
-void QJsonSchemaChecker::checkMinimum(const QJsonValue& value, const QJsonValue& schema, const QJsonValue& defaultValue)
+void QJsonSchemaChecker::checkMinimum(const QJsonValue& value, const Node& schema)
 {
 	if (!value.isDouble())
 	{
@@ -389,24 +619,22 @@ void QJsonSchemaChecker::checkMinimum(const QJsonValue& value, const QJsonValue&
 		return;
 	}
 
-	if (value.toDouble() < schema.toDouble())
+	if (value.toDouble() < schema.minimum.toDouble())
 	{
 		_error = true;
 
 		if (_correct == "modify")
 		{
-			(defaultValue != QJsonValue::Null) ?
-				QJsonUtils::modify(_autoCorrected, _currentPath, defaultValue) :
-				QJsonUtils::modify(_autoCorrected, _currentPath, schema);
-			setMessage("Correct too small value: " + QString::number(value.toDouble()) + " to: " + QString::number(defaultValue.toDouble()));
+			correctValue(schema, schema.minimum);
+			setMessage("Correct too small value: " + QString::number(value.toDouble()) + " to: " + QString::number(schema.defaultValue.toDouble()));
 		}
 
 		if (_correct == "")
-			setMessage("value is too small (minimum=" + QString::number(schema.toDouble()) + ")");
+			setMessage("value is too small (minimum=" + QString::number(schema.minimum.toDouble()) + ")");
 	}
 }
 
-void QJsonSchemaChecker::checkMaximum(const QJsonValue& value, const QJsonValue& schema, const QJsonValue& defaultValue)
+void QJsonSchemaChecker::checkMaximum(const QJsonValue& value, const Node& schema)
 {
 	if (!value.isDouble())
 	{
@@ -416,24 +644,22 @@ void QJsonSchemaChecker::checkMaximum(const QJsonValue& value, const QJsonValue&
 		return;
 	}
 
-	if (value.toDouble() > schema.toDouble())
+	if (value.toDouble() > schema.maximum.toDouble())
 	{
 		_error = true;
 
 		if (_correct == "modify")
 		{
-			(defaultValue != QJsonValue::Null) ?
-				QJsonUtils::modify(_autoCorrected, _currentPath, defaultValue) :
-				QJsonUtils::modify(_autoCorrected, _currentPath, schema);
-			setMessage("Correct too large value: " + QString::number(value.toDouble()) + " to: " + QString::number(defaultValue.toDouble()));
+			correctValue(schema, schema.maximum);
+			setMessage("Correct too large value: " + QString::number(value.toDouble()) + " to: " + QString::number(schema.defaultValue.toDouble()));
 		}
 
 		if (_correct == "")
-			setMessage("value is too large (maximum=" + QString::number(schema.toDouble()) + ")");
+			setMessage("value is too large (maximum=" + QString::number(schema.maximum.toDouble()) + ")");
 	}
 }
 
-void QJsonSchemaChecker::checkMinLength(const QJsonValue& value, const QJsonValue& schema, const QJsonValue& defaultValue)
+void QJsonSchemaChecker::checkMinLength(const QJsonValue& value, const Node& schema)
 {
 	if (!value.isString())
 	{
@@ -443,23 +669,21 @@ void QJsonSchemaChecker::checkMinLength(const QJsonValue& value, const QJsonValu
 		return;
 	}
 
-	if (value.toString().size() < schema.toInt())
+	if (value.toString().size() < schema.minLength.toInt())
 	{
 		_error = true;
 
 		if (_correct == "modify")
 		{
-			(defaultValue != QJsonValue::Null) ?
-				QJsonUtils::modify(_autoCorrected, _currentPath, defaultValue) :
-				QJsonUtils::modify(_autoCorrected, _currentPath, schema);
-			setMessage("Correct too short value: " + value.toString() + " to: " + defaultValue.toString());
+			correctValue(schema, schema.minLength);
+			setMessage("Correct too short value: " + value.toString() + " to: " + schema.defaultValue.toString());
 		}
 		if (_correct == "")
-			setMessage("value is too short (minLength=" + QString::number(schema.toInt()) + ")");
+			setMessage("value is too short (minLength=" + QString::number(schema.minLength.toInt()) + ")");
 	}
 }
 
-void QJsonSchemaChecker::checkMaxLength(const QJsonValue& value, const QJsonValue& schema, const QJsonValue& defaultValue)
+void QJsonSchemaChecker::checkMaxLength(const QJsonValue& value, const Node& schema)
 {
 	if (!value.isString())
 	{
@@ -469,23 +693,21 @@ void QJsonSchemaChecker::checkMaxLength(const QJsonValue& value, const QJsonValu
 		return;
 	}
 
-	if (value.toString().size() > schema.toInt())
+	if (value.toString().size() > schema.maxLength.toInt())
 	{
 		_error = true;
 
 		if (_correct == "modify")
 		{
-			(defaultValue != QJsonValue::Null) ?
-				QJsonUtils::modify(_autoCorrected, _currentPath, defaultValue) :
-				QJsonUtils::modify(_autoCorrected, _currentPath, schema);
-			setMessage("Correct too long value: " + value.toString() + " to: " + defaultValue.toString());
+			correctValue(schema, schema.maxLength);
+			setMessage("Correct too long value: " + value.toString() + " to: " + schema.defaultValue.toString());
 		}
 		if (_correct == "")
-			setMessage("value is too long (maxLength=" + QString::number(schema.toInt()) + ")");
+			setMessage("value is too long (maxLength=" + QString::number(schema.maxLength.toInt()) + ")");
 	}
 }
 
-void QJsonSchemaChecker::checkItems(const QJsonValue& value, const QJsonObject& schema)
+void QJsonSchemaChecker::checkItems(const QJsonValue& value, const Node& schema)
 {
 	if (!value.isArray())
 	{
@@ -495,10 +717,10 @@ void QJsonSchemaChecker::checkItems(const QJsonValue& value, const QJsonObject&
 		return;
 	}
 
-	QJsonArray jArray = value.toArray();
+	const QJsonArray jArray = value.toArray();
 
 	if (_correct == "remove")
-		if (jArray.isEmpty() && !schema.contains("allowEmptyArray"))
+		if (jArray.isEmpty() && !schema.allowEmptyArray)
 		{
 			QJsonUtils::modify(_autoCorrected, _currentPath);
 			setMessage("Remove empty array");
@@ -508,12 +730,12 @@ void QJsonSchemaChecker::checkItems(const QJsonValue& value, const QJsonObject&
 	{
 		// validate each item
 		_currentPath.append("[" + QString::number(i) + "]");
-		validate(jArray[i], schema);
+		validate(jArray[i], *schema.items);
 		_currentPath.removeLast();
 	}
 }
 
-void QJsonSchemaChecker::checkMinItems(const QJsonValue& value, const QJsonValue& schema, const QJsonValue& defaultValue)
+void QJsonSchemaChecker::checkMinItems(const QJsonValue& value, const Node& schema)
 {
 	if (!value.isArray())
 	{
@@ -523,25 +745,23 @@ void QJsonSchemaChecker::checkMinItems(const QJsonValue& value, const QJsonValue
 		return;
 	}
 
-	QJsonArray jArray = value.toArray();
-	if (jArray.size() < schema.toInt())
+	const QJsonArray jArray = value.toArray();
+	if (jArray.size() < schema.minItems.toInt())
 	{
 		_error = true;
 
 		if (_correct == "modify")
 		{
-			(defaultValue != QJsonValue::Null) ?
-				QJsonUtils::modify(_autoCorrected, _currentPath, defaultValue) :
-				QJsonUtils::modify(_autoCorrected, _currentPath, schema);
-			setMessage("Correct minItems: " + QString::number(jArray.size()) + " to: " + QString::number(defaultValue.toArray().size()));
+			correctValue(schema, schema.minItems);
+			setMessage("Correct minItems: " + QString::number(jArray.size()) + " to: " + QString::number(schema.defaultValue.toArray().size()));
 		}
 
 		if (_correct == "")
-			setMessage("array is too small (minimum=" + QString::number(schema.toInt()) + ")");
+			setMessage("array is too small (minimum=" + QString::number(schema.minItems.toInt()) + ")");
 	}
 }
 
-void QJsonSchemaChecker::checkMaxItems(const QJsonValue& value, const QJsonValue& schema, const QJsonValue& defaultValue)
+void QJsonSchemaChecker::checkMaxItems(const QJsonValue& value, const Node& schema)
 {
 	if (!value.isArray())
 	{
@@ -551,25 +771,23 @@ void QJsonSchemaChecker::checkMaxItems(const QJsonValue& value, const QJsonValue
 		return;
 	}
 
-	QJsonArray jArray = value.toArray();
-	if (jArray.size() > schema.toInt())
+	const QJsonArray jArray = value.toArray();
+	if (jArray.size() > schema.maxItems.toInt())
 	{
 		_error = true;
 
 		if (_correct == "modify")
 		{
-			(defaultValue != QJsonValue::Null) ?
-				QJsonUtils::modify(_autoCorrected, _currentPath, defaultValue) :
-				QJsonUtils::modify(_autoCorrected, _currentPath, schema);
-			setMessage("Correct maxItems: " + QString::number(jArray.size()) + " to: " + QString::number(defaultValue.toArray().size()));
+			correctValue(schema, schema.maxItems);
+			setMessage("Correct maxItems: " + QString::number(jArray.size()) + " to: " + QString::number(schema.defaultValue.toArray().size()));
 		}
 
 		if (_correct == "")
-			setMessage("array is too large (maximum=" + QString::number(schema.toInt()) + ")");
+			setMessage("array is too large (maximum=" + QString::number(schema.maxItems.toInt()) + ")");
 	}
 }
 
-void QJsonSchemaChecker::checkUniqueItems(const QJsonValue& value, const QJsonValue& schema)
+void QJsonSchemaChecker::checkUniqueItems(const QJsonValue& value, const Node& schema)
 {
 	if (!value.isArray())
 	{
@@ -579,13 +797,13 @@ void QJsonSchemaChecker::checkUniqueItems(const QJsonValue& value, const QJsonVa
 		return;
 	}
 
-	if (schema.toBool() == true)
+	if (schema.uniqueItems)
 	{
 		// make sure no two items are identical
 
 		bool removeDuplicates = false;
 
-		QJsonArray jArray = value.toArray();
+		const QJsonArray jArray = value.toArray();
 		for (int i = 0; i < jArray.size(); ++i)
 		{
 			for (int j = i + 1; j < jArray.size(); ++j)
@@ -615,18 +833,14 @@ void QJsonSchemaChecker::checkUniqueItems(const QJsonValue& value, const QJsonVa
 	}
 }
 
-void QJsonSchemaChecker::checkEnum(const QJsonValue& value, const QJsonValue& schema, const QJsonValue& defaultValue)
+void QJsonSchemaChecker::checkEnum(const QJsonValue& value, const Node& schema)
 {
-	if (schema.isArray())
+	if (schema.enumSchema.isArray())
 	{
-		QJsonArray jArray = schema.toArray();
-		for (int i = 0; i < jArray.size(); ++i)
+		if (value.isString() ? schema.enumStrings.contains(value.toString()) : schema.enumValues.contains(value))
 		{
-			if (jArray[i] == value)
-			{
-				// found enum value. done.
-				return;
-			}
+			// found enum value. done.
+			return;
 		}
 	}
 
@@ -635,15 +849,13 @@ void QJsonSchemaChecker::checkEnum(const QJsonValue& value, const QJsonValue& sc
 
 	if (_correct == "modify")
 	{
-		(defaultValue != QJsonValue::Null) ?
-			QJsonUtils::modify(_autoCorrected, _currentPath, defaultValue) :
-			QJsonUtils::modify(_autoCorrected, _currentPath, schema.toArray().first());
-		setMessage("Correct unknown enum value: " + value.toString() + " to: " + defaultValue.toString());
+		correctValue(schema, schema.enumSchema.toArray().first());
+		setMessage("Correct unknown enum value: " + value.toString() + " to: " + schema.defaultValue.toString());
 	}
 
 	if (_correct == "")
 	{
-		QJsonDocument doc(schema.toArray());
+		QJsonDocument doc(schema.enumSchema.toArray());
 		QString strJson(doc.toJson(QJsonDocument::Compact));
 		setMessage("Unknown enum value (allowed values are: " + strJson + ")");
 	}
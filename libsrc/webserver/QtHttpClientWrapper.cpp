@@ -14,6 +14,7 @@
 #include <QStringList>
 #include <QDateTime>
 #include <QHostAddress>
+#include <QTimer>
 
 const QByteArray & QtHttpClientWrapper::CRLF = QByteArrayLiteral ("\r\n");
 
@@ -27,8 +28,25 @@ QtHttpClientWrapper::QtHttpClientWrapper (QTcpSocket * sock, const bool& localCo
 	, m_localConnection(localConnection)
 	, m_websocketClient(nullptr)
 	, m_webJsonRpc     (nullptr)
+	, m_idleTimer      (new QTimer (this))
+	, m_requestCount   (0)
+	, m_keepAlive      (true)
 {
 	connect (m_sockClient, &QTcpSocket::readyRead, this, &QtHttpClientWrapper::onClientDataReceived);
+
+	// close persistent connections not used anymore
+	m_idleTimer->setSingleShot (true);
+	m_idleTimer->setInterval (KEEP_ALIVE_TIMEOUT_S * 1000);
+	connect (m_idleTimer, &QTimer::timeout, this, &QtHttpClientWrapper::onIdleTimeout);
+	m_idleTimer->start ();
+}
+
+void QtHttpClientWrapper::onIdleTimeout (void)
+{
+	if (m_websocketClient == Q_NULLPTR && m_currentRequest == Q_NULLPTR)
+	{
+		m_sockClient->close ();
+	}
 }
 
 QString QtHttpClientWrapper::getGuid (void)
@@ -50,6 +68,8 @@ void QtHttpClientWrapper::onClientDataReceived (void)
 {
 	if (m_sockClient != Q_NULLPTR)
 	{
+		m_idleTimer->start ();
+
 		while (m_sockClient->bytesAvailable ())
 		{
 			QByteArray line = m_sockClient->readLine ();
@@ -72,6 +92,7 @@ void QtHttpClientWrapper::onClientDataReceived (void)
 							m_currentRequest->setClientInfo(m_sockClient->localAddress(), m_sockClient->peerAddress());
 							m_currentRequest->setUrl (QUrl (url));
 							m_currentRequest->setCommand (command);
+							m_currentRequest->setVersion (version);
 							m_parsingStatus = AwaitingHeaders;
 						}
 						else
@@ -166,6 +187,7 @@ void QtHttpClientWrapper::onClientDataReceived (void)
 							// disabling packet bunching
 							m_sockClient->setSocketOption(QAbstractSocket::LowDelayOption, 1);
 							m_sockClient->setSocketOption(QAbstractSocket::KeepAliveOption, 1);
+							m_idleTimer->stop ();
 							m_websocketClient = new WebSocketClient(m_currentRequest, m_sockClient, m_localConnection, this);
 						}
 
@@ -221,6 +243,7 @@ void QtHttpClientWrapper::onClientDataReceived (void)
 				case ParsingError: // there was an error durin one of parsing steps
 				{
 					m_sockClient->readAll (); // clear remaining buffer to ignore content
+					m_keepAlive = false; // the stream cannot be resynchronised
 					QtHttpReply reply (m_serverHandle);
 					reply.setStatusCode (QtHttpReply::BadRequest);
 					reply.appendRawData (QByteArrayLiteral ("<h1>Bad Request (HTTP parsing error) !</h1>"));
@@ -258,11 +281,21 @@ void QtHttpClientWrapper::onReplySendHeadersRequested (void)
 			static const QByteArray & CHUNKED = QByteArrayLiteral ("chunked");
 			reply->addHeader (QtHttpHeader::TransferEncoding, CHUNKED);
 		}
-		else
+		else if (reply->getStatusCode () != QtHttpReply::NotModified)
 		{
 			reply->addHeader (QtHttpHeader::ContentLength, QByteArray::number (reply->getRawDataSize ()));
 		}
 
+		if (m_keepAlive)
+		{
+			reply->addHeader (QtHttpHeader::Connection, QByteArrayLiteral ("keep-alive"));
+			reply->addHeader (QtHttpHeader::KeepAlive, "timeout=" % QByteArray::number (KEEP_ALIVE_TIMEOUT_S) % ", max=" % QByteArray::number (KEEP_ALIVE_MAX_REQUESTS - m_requestCount));
+		}
+		else
+		{
+			reply->addHeader (QtHttpHeader::Connection, QByteArrayLiteral ("close"));
+		}
+
 		const QList<QByteArray> & headersList = reply->getHeadersList ();
 
 		foreach (const QByteArray & header, headersList)
@@ -276,8 +309,8 @@ void QtHttpClientWrapper::onReplySendHeadersRequested (void)
 
 		// empty line
 		data.append (CRLF);
+		// headers are flushed together with the content to avoid a separate segment
 		m_sockClient->write (data);
-		m_sockClient->flush ();
 	}
 }
 
@@ -313,6 +346,20 @@ QtHttpClientWrapper::ParsingStatus QtHttpClientWrapper::sendReplyToClient (QtHtt
 {
 	if (reply != Q_NULLPTR)
 	{
+		++m_requestCount;
+		if (m_currentRequest != Q_NULLPTR)
+		{
+			static const QByteArray & CLOSE = QByteArrayLiteral ("close");
+			static const QByteArray & KEEP_ALIVE = QByteArrayLiteral ("keep-alive");
+
+			// persistent connections are default for HTTP/1.1, older clients have to request them
+			const QByteArray connection = m_currentRequest->getHeader(QtHttpHeader::Connection).toLower();
+			const bool isPersistent = (m_currentRequest->getVersion() == QtHttpServer::HTTP_VERSION) ? connection != CLOSE : connection == KEEP_ALIVE;
+			m_keepAlive = m_keepAlive
+				&& isPersistent
+				&& m_requestCount < KEEP_ALIVE_MAX_REQUESTS;
+		}
+
 		if (!reply->useChunked ())
 		{
 			//reply->appendRawData (CRLF);
@@ -327,19 +374,18 @@ QtHttpClientWrapper::ParsingStatus QtHttpClientWrapper::sendReplyToClient (QtHtt
 			m_sockClient->flush ();
 		}
 
-		if (m_currentRequest != Q_NULLPTR)
+		if (!m_keepAlive)
 		{
-			static const QByteArray & CLOSE = QByteArrayLiteral ("close");
-
-			if (m_currentRequest->getHeader(QtHttpHeader::Connection) == CLOSE)
-			{
-				// must close connection after this request
-				m_sockClient->close ();
-			}
+			// must close connection after this request
+			m_sockClient->close ();
+		}
 
+		if (m_currentRequest != Q_NULLPTR)
+		{
 			m_currentRequest->deleteLater ();
 			m_currentRequest = Q_NULLPTR;
 		}
+		m_idleTimer->start ();
 	}
 
 	return AwaitingRequest;
@@ -347,6 +393,8 @@ QtHttpClientWrapper::ParsingStatus QtHttpClientWrapper::sendReplyToClient (QtHtt
 
 void QtHttpClientWrapper::closeConnection()
 {
+	m_keepAlive = false;
+
 	// probably filter for request to follow http spec
 	if(m_currentRequest != Q_NULLPTR)
 	{
@@ -5,6 +5,7 @@
 #include <QString>
 
 class QTcpSocket;
+class QTimer;
 
 class QtHttpRequest;
 class QtHttpReply;
@@ -22,6 +23,11 @@ public:
 	static const char COLON = ':';
 	static const QByteArray & CRLF;
 
+	/// Idle time after which a persistent connection is closed
+	static const int KEEP_ALIVE_TIMEOUT_S = 15;
+	/// Number of requests served via one persistent connection
+	static const int KEEP_ALIVE_MAX_REQUESTS = 200;
+
 	enum ParsingStatus {
 		ParsingError    = -1,
 		AwaitingRequest =  0,
@@ -48,6 +54,7 @@ protected:
 protected slots:
 	void onReplySendHeadersRequested (void);
 	void onReplySendDataRequested    (void);
+	void onIdleTimeout               (void);
 
 private:
 	QString           m_guid;
@@ -58,6 +65,9 @@ private:
 	const bool        m_localConnection;
 	WebSocketClient * m_websocketClient;
 	WebJsonRpc *      m_webJsonRpc;
+	QTimer *          m_idleTimer;
+	int               m_requestCount;
+	bool              m_keepAlive;
 };
 
 #endif // QTHTTPCLIENTWRAPPER_H
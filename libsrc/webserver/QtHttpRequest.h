@@ -30,6 +30,7 @@ public:
 	int                   getRawDataSize (void) const { return m_data.size ();        };
 	QUrl                  getUrl         (void) const { return m_url;                 };
 	QString               getCommand     (void) const { return m_command;             };
+	QString               getVersion     (void) const { return m_version;             };
 	QByteArray            getRawData     (void) const { return m_data;                };
 	QList<QByteArray>     getHeadersList (void) const { return m_headersHash.keys (); };
 	QtHttpClientWrapper * getClient      (void) const { return m_clientHandle;        };
@@ -44,6 +45,7 @@ public:
 public slots:
 	void setUrl        (const QUrl & url)            { m_url = url;          };
 	void setCommand    (const QString & command)     { m_command = command;  };
+	void setVersion    (const QString & version)     { m_version = version;  };
 	void appendRawData (const QByteArray & data)     { m_data.append (data); };
 	void setPostData   (const QtHttpPostData & data) { m_postData = data;    };
 
@@ -53,6 +55,7 @@ public slots:
 private:
 	QUrl                          m_url;
 	QString                       m_command;
+	QString                       m_version;
 	QByteArray                    m_data;
 	QtHttpServer *                m_serverHandle;
 	QtHttpClientWrapper *         m_clientHandle;
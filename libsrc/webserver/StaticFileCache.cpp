@@ -0,0 +1,257 @@
+#include "StaticFileCache.h"
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include <QLocale>
+#include <QMimeDatabase>
+
+#include <array>
+
+namespace {
+
+// Upper limit of memory used by cached files (incl. compressed variants)
+constexpr qint64 MAX_CACHE_BYTES = 16 * 1024 * 1024;
+
+// Files smaller than that are not worth compressing
+constexpr int MIN_COMPRESS_BYTES = 256;
+
+bool isCompressible(const QByteArray & mimeType, const QString & fileName)
+{
+	return mimeType.startsWith("text/")
+		|| mimeType == "application/javascript"
+		|| mimeType == "application/x-javascript"
+		|| mimeType == "application/json"
+		|| mimeType == "application/xml"
+		|| mimeType == "image/svg+xml"
+		|| mimeType == "image/x-icon"
+		|| mimeType == "font/ttf"
+		|| mimeType == "application/x-font-ttf"
+		|| mimeType == "application/vnd.ms-fontobject"
+		|| fileName.endsWith(".map");
+}
+
+quint32 crc32(const QByteArray & data)
+{
+	static const std::array<quint32, 256> table = [] {
+		std::array<quint32, 256> result {};
+		for (quint32 i = 0; i < 256; ++i)
+		{
+			quint32 crc = i;
+			for (int bit = 0; bit < 8; ++bit)
+			{
+				crc = (crc & 1) ? (0xEDB88320U ^ (crc >> 1)) : (crc >> 1);
+			}
+			result[i] = crc;
+		}
+		return result;
+	}();
+
+	quint32 crc = 0xFFFFFFFFU;
+	for (const char byte : data)
+	{
+		crc = table[(crc ^ static_cast<quint8>(byte)) & 0xFF] ^ (crc >> 8);
+	}
+	return crc ^ 0xFFFFFFFFU;
+}
+
+void appendLittleEndian(QByteArray & data, quint32 value)
+{
+	for (int i = 0; i < 4; ++i)
+	{
+		data.append(static_cast<char>((value >> (8 * i)) & 0xFF));
+	}
+}
+
+} // namespace
+
+StaticFileCache::StaticFileCache(QMimeDatabase * mimeDb)
+	: _mimeDb(mimeDb)
+	, _totalBytes(0)
+	, _useCounter(0)
+{
+}
+
+void StaticFileCache::clear()
+{
+	_assets.clear();
+	_totalBytes = 0;
+}
+
+const StaticFileCache::Asset * StaticFileCache::get(const QString & fileName, bool & readable)
+{
+	readable = true;
+
+	// Files of the resource tree are immutable, files on disk are revalidated
+	const bool isResource = fileName.startsWith(':');
+
+	auto it = _assets.find(fileName);
+	if (it != _assets.end())
+	{
+		if (isResource)
+		{
+			it->lastUse = ++_useCounter;
+			return &(*it);
+		}
+
+		QFileInfo info(fileName);
+		if (info.exists() && info.lastModified() == it->modified && info.size() == it->fileSize)
+		{
+			it->lastUse = ++_useCounter;
+			return &(*it);
+		}
+
+		_totalBytes -= it->data.size() + it->gzipData.size();
+		_assets.erase(it);
+	}
+
+	QFile file(fileName);
+	if (!file.exists())
+	{
+		return nullptr;
+	}
+
+	if (!file.open(QFile::ReadOnly))
+	{
+		readable = false;
+		return nullptr;
+	}
+
+	Asset asset;
+	asset.data = file.readAll();
+	file.close();
+
+	QFileInfo info(fileName);
+	asset.fileSize = info.size();
+	asset.modified = info.lastModified();
+	if (asset.modified.isValid())
+	{
+		asset.lastModified = toHttpDate(asset.modified);
+	}
+
+	const QString mimeName = _mimeDb->mimeTypeForFile(fileName).name();
+	// Workaround https://bugreports.qt.io/browse/QTBUG-97392
+	asset.mimeType = (mimeName == QStringLiteral("application/x-extension-html")) ? QByteArrayLiteral("text/html") : mimeName.toLocal8Bit();
+
+	const QByteArray hash = QCryptographicHash::hash(asset.data, QCryptographicHash::Md5).toHex();
+	asset.etag = '"' + hash + '"';
+	asset.gzipEtag = '"' + hash + "-gzip\"";
+	asset.compressible = asset.data.size() >= MIN_COMPRESS_BYTES && isCompressible(asset.mimeType, fileName);
+	asset.lastUse = ++_useCounter;
+
+	if (asset.data.size() > MAX_CACHE_BYTES)
+	{
+		// would evict all other files and still exceed the limit, provide it directly
+		asset.compressible = false;
+		_uncached = asset;
+		return &_uncached;
+	}
+
+	evict(asset.data.size());
+	_totalBytes += asset.data.size();
+	return &(*_assets.insert(fileName, asset));
+}
+
+const StaticFileCache::Asset * StaticFileCache::getCompressed(const QString & fileName)
+{
+	auto it = _assets.find(fileName);
+	if (it == _assets.end() || !it->compressible)
+	{
+		return nullptr;
+	}
+
+	if (!it->gzipDone)
+	{
+		it->gzipDone = true;
+		QByteArray compressed = gzip(it->data);
+		if (compressed.size() < it->data.size() && it->data.size() + compressed.size() <= MAX_CACHE_BYTES)
+		{
+			// the asset itself is in use by the caller and not evicted
+			evict(compressed.size(), fileName);
+			it = _assets.find(fileName);
+			it->gzipData = compressed;
+			_totalBytes += compressed.size();
+		}
+		else
+		{
+			it->compressible = false;
+			return nullptr;
+		}
+	}
+
+	return &(*it);
+}
+
+QByteArray StaticFileCache::gzip(const QByteArray & data)
+{
+	// qCompress provides a zlib stream (RFC 1950) prefixed by the uncompressed size,
+	// the raw deflate data is wrapped into a gzip header and trailer
+	const QByteArray zlibData = qCompress(data);
+	if (zlibData.size() < 10)
+	{
+		return QByteArray();
+	}
+
+	static const char header[] = { '\x1f', '\x8b', '\x08', '\x00', '\x00', '\x00', '\x00', '\x00', '\x00', '\x03' };
+
+	QByteArray result;
+	result.reserve(zlibData.size() + 12);
+	result.append(header, sizeof(header));
+	// skip size prefix and zlib header, drop the Adler-32 checksum
+	result.append(zlibData.constData() + 6, zlibData.size() - 10);
+	appendLittleEndian(result, crc32(data));
+	appendLittleEndian(result, static_cast<quint32>(data.size()));
+	return result;
+}
+
+QByteArray StaticFileCache::toHttpDate(const QDateTime & time)
+{
+	return QLocale::c().toString(time.toUTC(), QStringLiteral("ddd, dd MMM yyyy hh:mm:ss 'GMT'")).toLatin1();
+}
+
+QDateTime StaticFileCache::fromHttpDate(const QByteArray & date)
+{
+	static const QString IMF_FIXDATE = QStringLiteral("ddd, dd MMM yyyy hh:mm:ss 'GMT'");
+	static const QString RFC_850 = QStringLiteral("dddd, dd-MMM-yy hh:mm:ss 'GMT'");
+	static const QString ASCTIME = QStringLiteral("ddd MMM d hh:mm:ss yyyy");
+
+	const QString value = QString::fromLatin1(date).simplified();
+	for (const QString & format : { IMF_FIXDATE, RFC_850, ASCTIME })
+	{
+		QDateTime time = QLocale::c().toDateTime(value, format);
+		if (time.isValid())
+		{
+			// two digit years are parsed as 19xx
+			if (format == RFC_850 && time.date().year() < 1970)
+			{
+				time = time.addYears(100);
+			}
+			time.setTimeSpec(Qt::UTC);
+			return time;
+		}
+	}
+	return QDateTime();
+}
+
+void StaticFileCache::evict(qint64 requiredBytes, const QString & keepFileName)
+{
+	while (!_assets.isEmpty() && _totalBytes + requiredBytes > MAX_CACHE_BYTES)
+	{
+		auto oldest = _assets.end();
+		for (auto it = _assets.begin(); it != _assets.end(); ++it)
+		{
+			if (it.key() != keepFileName && (oldest == _assets.end() || it->lastUse < oldest->lastUse))
+			{
+				oldest = it;
+			}
+		}
+
+		if (oldest == _assets.end())
+		{
+			break;
+		}
+
+		_totalBytes -= oldest->data.size() + oldest->gzipData.size();
+		_assets.erase(oldest);
+	}
+}
@@ -0,0 +1,91 @@
+#ifndef STATICFILECACHE_H
+#define STATICFILECACHE_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QHash>
+#include <QString>
+
+class QMimeDatabase;
+
+///
+/// @brief In-memory cache of static files served by the webserver
+///
+/// Files are read once and kept together with their mime type, a strong ETag and the last modification time.
+/// Compressible content (html, css, js, json, ...) is additionally kept gzip encoded, the compressed variant is
+/// created on first use. Files below a document root on disk are revalidated against their modification time
+/// and size, files of the resource tree never change.
+///
+class StaticFileCache
+{
+public:
+	struct Asset
+	{
+		QByteArray data;
+		QByteArray gzipData;
+		QByteArray mimeType;
+		QByteArray etag;
+		QByteArray gzipEtag;
+		QByteArray lastModified;
+		QDateTime modified;
+		qint64 fileSize = 0;
+		bool compressible = false;
+		bool gzipDone = false;
+		quint64 lastUse = 0;
+	};
+
+	explicit StaticFileCache(QMimeDatabase * mimeDb);
+
+	///
+	/// @brief Drop all cached files, e.g. if the document root changed
+	///
+	void clear();
+
+	///
+	/// @brief Get a file, load it into the cache if required
+	///
+	/// @param fileName  The full name of the file
+	/// @param[out] readable  False, if the file exists but cannot be read
+	/// @return The cached file or nullptr, if it cannot be provided. The pointer is valid until the next call.
+	///         Files exceeding the cache size are provided without caching them.
+	///
+	const Asset * get(const QString & fileName, bool & readable);
+
+	///
+	/// @brief Get the gzip encoded content of a file, compressed on first use
+	///
+	/// @param fileName  The full name of the (cached) file
+	/// @return The cached file incl. gzip data or nullptr, if the content is not compressible
+	///
+	const Asset * getCompressed(const QString & fileName);
+
+	///
+	/// @brief Create a gzip (RFC 1952) stream of the given data
+	///
+	static QByteArray gzip(const QByteArray & data);
+
+	///
+	/// @brief Format a time as HTTP date (RFC 7231 IMF-fixdate)
+	///
+	static QByteArray toHttpDate(const QDateTime & time);
+
+	///
+	/// @brief Parse an HTTP date (RFC 7231 IMF-fixdate, obsolete RFC 850 and asctime formats)
+	///
+	/// @return The time (UTC) or an invalid time, if the date cannot be parsed
+	///
+	static QDateTime fromHttpDate(const QByteArray & date);
+
+private:
+	void evict(qint64 requiredBytes, const QString & keepFileName = QString());
+
+	QMimeDatabase *         _mimeDb;
+	QHash<QString, Asset>   _assets;
+	qint64                  _totalBytes;
+	quint64                 _useCounter;
+
+	/// Last file provided without caching it, as it exceeds the cache size
+	Asset                   _uncached;
+};
+
+#endif // STATICFILECACHE_H
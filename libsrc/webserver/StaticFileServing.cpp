@@ -11,18 +11,19 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QResource>
+#include <QRegularExpression>
 
 #include <exception>
 
 StaticFileServing::StaticFileServing (QObject * parent)
 	:  QObject   (parent)
 	, _baseUrl ()
+	, _mimeDb(new QMimeDatabase)
 	, _cgi(this)
 	, _log(Logger::getInstance("WEBSERVER"))
+	, _cache(_mimeDb)
 {
 	Q_INIT_RESOURCE(WebConfig);
-
-	_mimeDb = new QMimeDatabase;
 }
 
 StaticFileServing::~StaticFileServing ()
@@ -34,6 +35,7 @@ void StaticFileServing::setBaseUrl(const QString& url)
 {
 	_baseUrl = url;
 	_cgi.setBaseUrl(url);
+	_cache.clear();
 }
 
 void StaticFileServing::setSSDPDescription(const QString& desc)
@@ -47,38 +49,134 @@ void StaticFileServing::setSSDPDescription(const QString& desc)
 	}
 }
 
+void StaticFileServing::appendCachedFile (QtHttpReply * reply, const QString& fileName)
+{
+	bool readable;
+	const StaticFileCache::Asset * asset = _cache.get(fileName, readable);
+	if (asset != nullptr)
+	{
+		reply->appendRawData (asset->data);
+	}
+}
+
 void StaticFileServing::printErrorToReply (QtHttpReply * reply, QtHttpReply::StatusCode code, const QString& errorMessage)
 {
 	reply->setStatusCode(code);
 	reply->addHeader ("Content-Type", QByteArrayLiteral ("text/html"));
-	QFile errorPageHeader(_baseUrl %  "/errorpages/header.html" );
-	QFile errorPageFooter(_baseUrl %  "/errorpages/footer.html" );
-	QFile errorPage      (_baseUrl %  "/errorpages/" % QString::number((int)code) % ".html" );
+	reply->addHeader (QtHttpHeader::CacheControl, QByteArrayLiteral ("no-store"));
 
-	if (errorPageHeader.open (QFile::ReadOnly))
-	{
-		QByteArray data = errorPageHeader.readAll();
-		reply->appendRawData (data);
-		errorPageHeader.close ();
-	}
+	appendCachedFile (reply, _baseUrl % "/errorpages/header.html");
 
-	if (errorPage.open (QFile::ReadOnly))
+	bool readable;
+	const StaticFileCache::Asset * errorPage = _cache.get(_baseUrl % "/errorpages/" % QString::number((int)code) % ".html", readable);
+	if (errorPage != nullptr)
 	{
-		QByteArray data = errorPage.readAll();
+		QByteArray data = errorPage->data;
 		data = data.replace("{MESSAGE}", QString(errorMessage.toLocal8Bit()).toHtmlEscaped().toLocal8Bit() );
 		reply->appendRawData (data);
-		errorPage.close ();
 	}
 	else
 	{
 		reply->appendRawData (QString(QString::number(code) + " - " +errorMessage.toLocal8Bit()).toHtmlEscaped().toLocal8Bit());
 	}
 
-	if (errorPageFooter.open (QFile::ReadOnly))
+	appendCachedFile (reply, _baseUrl % "/errorpages/footer.html");
+}
+
+void StaticFileServing::sendFile (QtHttpRequest * request, QtHttpReply * reply, const QString& fileName, const StaticFileCache::Asset * asset)
+{
+	// Libraries carry their version in the file name, bundles a content hash; other files can be requested
+	// versioned via a version or hash query (e.g. "?v=2.0.16"). Only such URLs change with the content and are immutable.
+	static const QRegularExpression versionedName(QStringLiteral("[-.]\\d+\\.\\d+(\\.\\d+)?[-.]"));
+	static const QRegularExpression hashedName(QStringLiteral("[-.][0-9a-fA-F]{8,}\\."));
+	static const QRegularExpression versionQuery(QStringLiteral("^(v|ver|version|hash)=[0-9A-Za-z._-]+$"));
+	const QString name = QFileInfo(fileName).fileName();
+	const bool isVersioned = versionQuery.match(request->getUrl().query()).hasMatch()
+		|| versionedName.match(name).hasMatch()
+		|| hashedName.match(name).hasMatch();
+
+	// Serve the gzip encoded variant, if accepted by the client
+	bool useGzip = false;
+	if (asset->compressible)
 	{
-		QByteArray data = errorPageFooter.readAll ();
-		reply->appendRawData (data);
-		errorPageFooter.close ();
+		const QList<QByteArray> encodings = request->getHeader(QtHttpHeader::AcceptEncoding).split(',');
+		for (const QByteArray & encoding : encodings)
+		{
+			const QList<QByteArray> parameters = encoding.split(';');
+			if (parameters.at(0).trimmed().toLower() == "gzip")
+			{
+				useGzip = (parameters.size() < 2 || parameters.at(1).trimmed() != "q=0");
+				break;
+			}
+		}
+
+		if (useGzip)
+		{
+			const StaticFileCache::Asset * compressed = _cache.getCompressed(fileName);
+			if (compressed != nullptr)
+			{
+				asset = compressed;
+			}
+			else
+			{
+				useGzip = false;
+			}
+		}
+		reply->addHeader (QtHttpHeader::Vary, QtHttpHeader::AcceptEncoding);
+	}
+
+	const QByteArray & etag = useGzip ? asset->gzipEtag : asset->etag;
+
+	reply->addHeader ("Content-Type", asset->mimeType);
+	reply->addHeader (QtHttpHeader::AccessControlAllow, "*" );
+	reply->addHeader (QtHttpHeader::ETag, etag);
+	if (!asset->lastModified.isEmpty())
+	{
+		reply->addHeader (QtHttpHeader::LastModified, asset->lastModified);
+	}
+	reply->addHeader (QtHttpHeader::CacheControl, isVersioned ? QByteArrayLiteral ("public, max-age=31536000, immutable") : QByteArrayLiteral ("no-cache"));
+
+	// Validate the client's copy, If-None-Match takes precedence over If-Modified-Since
+	bool notModified = false;
+	const QByteArray ifNoneMatch = request->getHeader(QtHttpHeader::IfNoneMatch);
+	if (!ifNoneMatch.isEmpty())
+	{
+		const QList<QByteArray> tags = ifNoneMatch.split(',');
+		for (const QByteArray & tag : tags)
+		{
+			QByteArray value = tag.trimmed();
+			if (value.startsWith("W/"))
+			{
+				value = value.mid(2);
+			}
+			if (value == "*" || value == etag)
+			{
+				notModified = true;
+				break;
+			}
+		}
+	}
+	else if (asset->modified.isValid())
+	{
+		// HTTP dates have a resolution of seconds
+		const QDateTime since = StaticFileCache::fromHttpDate(request->getHeader(QtHttpHeader::IfModifiedSince));
+		notModified = since.isValid() && asset->modified.toMSecsSinceEpoch() / 1000 <= since.toMSecsSinceEpoch() / 1000;
+	}
+
+	if (notModified)
+	{
+		reply->setStatusCode (QtHttpReply::NotModified);
+		return;
+	}
+
+	if (useGzip)
+	{
+		reply->addHeader (QtHttpHeader::ContentEncoding, QByteArrayLiteral ("gzip"));
+		reply->appendRawData (asset->gzipData);
+	}
+	else
+	{
+		reply->appendRawData (asset->data);
 	}
 }
 
@@ -130,30 +228,16 @@ void StaticFileServing::onRequestNeedsReply (QtHttpRequest * request, QtHttpRepl
 		}
 
 		// get static files
-		QFile file(_baseUrl % "/" % path);
-		if (file.exists())
+		const QString fileName = _baseUrl % "/" % path;
+		bool readable;
+		const StaticFileCache::Asset * asset = _cache.get(fileName, readable);
+		if (asset != nullptr)
 		{
-			QMimeType mime = _mimeDb->mimeTypeForFile (file.fileName ());
-			if (file.open (QFile::ReadOnly)) {
-				QByteArray data = file.readAll ();
-
-				// Workaround https://bugreports.qt.io/browse/QTBUG-97392
-				if (mime.name() == QStringLiteral("application/x-extension-html"))
-				{
-					reply->addHeader ("Content-Type", "text/html");
-				}
-				else
-				{
-					reply->addHeader ("Content-Type", mime.name().toLocal8Bit());
-				}
-				reply->addHeader(QtHttpHeader::AccessControlAllow, "*" );
-				reply->appendRawData (data);
-				file.close ();
-			}
-			else
-			{
-				printErrorToReply (reply, QtHttpReply::Forbidden ,"Requested file: " % path);
-			}
+			sendFile (request, reply, fileName, asset);
+		}
+		else if (!readable)
+		{
+			printErrorToReply (reply, QtHttpReply::Forbidden ,"Requested file: " % path);
 		}
 		else
 		{
@@ -6,6 +6,7 @@
 #include "QtHttpRequest.h"
 #include "QtHttpReply.h"
 #include "CgiHandler.h"
+#include "StaticFileCache.h"
 
 #include <utils/Logger.h>
 
@@ -36,8 +37,11 @@ private:
 	CgiHandler      _cgi;
 	Logger        * _log;
 	QByteArray      _ssdpDescription;
+	StaticFileCache _cache;
 
 	void printErrorToReply (QtHttpReply * reply, QtHttpReply::StatusCode code, const QString& errorMessage);
+	void appendCachedFile (QtHttpReply * reply, const QString& fileName);
+	void sendFile (QtHttpRequest * request, QtHttpReply * reply, const QString& fileName, const StaticFileCache::Asset * asset);
 
 };
 
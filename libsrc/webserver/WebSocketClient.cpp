@@ -25,6 +25,7 @@ WebSocketClient::WebSocketClient(QtHttpRequest* request, QTcpSocket* sock, bool
 	// Json processor
 	_jsonAPI.reset(new JsonAPI(client, _log, localConnection, this));
 	connect(_jsonAPI.get(), &JsonAPI::callbackMessage, this, &WebSocketClient::sendMessage);
+	connect(_jsonAPI.get(), &JsonAPI::callbackData, this, &WebSocketClient::sendData);
 	connect(_jsonAPI.get(), &JsonAPI::forceClose, this,[this]() { this->sendClose(CLOSECODE::NORMAL); });
 
 	connect(this, &WebSocketClient::handleMessage, _jsonAPI.get(), &JsonAPI::handleMessage);
@@ -264,8 +265,11 @@ void WebSocketClient::handleBinaryMessage(QByteArray &data)
 qint64 WebSocketClient::sendMessage(QJsonObject obj)
 {
 	QJsonDocument writer(obj);
-	QByteArray data = writer.toJson(QJsonDocument::Compact) + "\n";
+	return sendData(writer.toJson(QJsonDocument::Compact) + "\n");
+}
 
+qint64 WebSocketClient::sendData(const QByteArray& data)
+{
 	if (!_socket || (_socket->state() != QAbstractSocket::ConnectedState)) return 0;
 
 	qint64 payloadWritten = 0;
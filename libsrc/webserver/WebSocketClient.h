@@ -76,6 +76,7 @@ private:
 private slots:
 	void handleWebSocketFrame();
 	qint64 sendMessage(QJsonObject obj);
+	qint64 sendData(const QByteArray& data);
 
 signals:
 	void handleMessage(const QString &message, const QString &httpAuthHeader);
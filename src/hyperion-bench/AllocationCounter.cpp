@@ -0,0 +1,105 @@
+#include "AllocationCounter.h"
+
+// STL includes
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<uint64_t> allocationCount { 0 };
+
+void* allocate(std::size_t size)
+{
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	void* ptr = std::malloc(size == 0 ? 1 : size);
+	if (ptr == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment)
+{
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	const std::size_t align = static_cast<std::size_t>(alignment);
+	void* ptr = nullptr;
+	if (posix_memalign(&ptr, align < sizeof(void*) ? sizeof(void*) : align, size == 0 ? 1 : size) != 0)
+	{
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+} // namespace
+
+namespace AllocationCounter {
+
+uint64_t allocations()
+{
+	return allocationCount.load(std::memory_order_relaxed);
+}
+
+} // namespace AllocationCounter
+
+// Replacements of the global allocation functions, the array and nothrow versions forward to these by default
+void* operator new(std::size_t size)
+{
+	return allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+	return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	return allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+	return allocateAligned(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept
+{
+	std::free(ptr);
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+// STL includes
+#include <cstdint>
+
+///
+/// @brief Counts the heap allocations of the process
+///
+/// The global operator new is replaced for the benchmark binary, i.e. the allocations of all linked libraries
+/// and threads are counted, including the buffers requested by the image buffer pool from the system.
+///
+namespace AllocationCounter {
+
+/// @return The number of allocations since the start of the process
+uint64_t allocations();
+
+} // namespace AllocationCounter
@@ -0,0 +1,154 @@
+#include "FrameRecording.h"
+
+// STL includes
+#include <cstring>
+
+// Qt includes
+#include <QtEndian>
+
+namespace FrameRecording {
+
+namespace {
+
+const char MAGIC[] = "HYPFRAME";
+constexpr int MAGIC_SIZE = 8;
+
+} // namespace
+
+Writer::~Writer()
+{
+	close();
+}
+
+bool Writer::open(const QString& fileName, int width, int height, uint32_t frameIntervalUs)
+{
+	close();
+
+	_width = width;
+	_height = height;
+	_frameIntervalUs = frameIntervalUs;
+	_frameCount = 0;
+
+	_file.setFileName(fileName);
+	if (width <= 0 || height <= 0 || !_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		return false;
+	}
+
+	return writeHeader();
+}
+
+bool Writer::append(const Image<ColorRgb>& image)
+{
+	if (!_file.isOpen() || image.width() != _width || image.height() != _height)
+	{
+		return false;
+	}
+
+	if (_file.write(reinterpret_cast<const char*>(image.memptr()), image.size()) != image.size())
+	{
+		return false;
+	}
+
+	++_frameCount;
+	return true;
+}
+
+bool Writer::close()
+{
+	if (!_file.isOpen())
+	{
+		return true;
+	}
+
+	const bool success = _file.seek(0) && writeHeader();
+	_file.close();
+	return success;
+}
+
+bool Writer::writeHeader()
+{
+	uchar header[HEADER_SIZE] = {};
+	memcpy(header, MAGIC, MAGIC_SIZE);
+	qToLittleEndian<quint32>(FORMAT_VERSION, header + 8);
+	qToLittleEndian<quint32>(static_cast<quint32>(_width), header + 12);
+	qToLittleEndian<quint32>(static_cast<quint32>(_height), header + 16);
+	qToLittleEndian<quint32>(_frameCount, header + 20);
+	qToLittleEndian<quint32>(_frameIntervalUs, header + 24);
+
+	return _file.write(reinterpret_cast<const char*>(header), HEADER_SIZE) == HEADER_SIZE;
+}
+
+Reader::~Reader()
+{
+	close();
+}
+
+bool Reader::open(const QString& fileName)
+{
+	close();
+
+	_file.setFileName(fileName);
+	if (!_file.open(QIODevice::ReadOnly))
+	{
+		_error = _file.errorString();
+		return false;
+	}
+
+	if (_file.size() < HEADER_SIZE)
+	{
+		_error = "File too small for a recording";
+		close();
+		return false;
+	}
+
+	_data = _file.map(0, _file.size());
+	if (_data == nullptr)
+	{
+		_error = _file.errorString();
+		close();
+		return false;
+	}
+
+	if (memcmp(_data, MAGIC, MAGIC_SIZE) != 0)
+	{
+		_error = "No frame recording";
+		close();
+		return false;
+	}
+
+	const quint32 version = qFromLittleEndian<quint32>(_data + 8);
+	if (version != FORMAT_VERSION)
+	{
+		_error = QString("Unsupported recording version %1").arg(version);
+		close();
+		return false;
+	}
+
+	_width = static_cast<int>(qFromLittleEndian<quint32>(_data + 12));
+	_height = static_cast<int>(qFromLittleEndian<quint32>(_data + 16));
+	_frameCount = static_cast<int>(qFromLittleEndian<quint32>(_data + 20));
+	_frameIntervalUs = qFromLittleEndian<quint32>(_data + 24);
+
+	if (_width <= 0 || _height <= 0 || _frameCount <= 0 || HEADER_SIZE + static_cast<qint64>(_frameCount * frameSize()) > _file.size())
+	{
+		_error = "Recording is empty or truncated";
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+void Reader::close()
+{
+	if (_data != nullptr)
+	{
+		_file.unmap(const_cast<uchar*>(_data));
+		_data = nullptr;
+	}
+	_file.close();
+	_width = _height = _frameCount = 0;
+}
+
+} // namespace FrameRecording
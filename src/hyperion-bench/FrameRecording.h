@@ -0,0 +1,125 @@
+#pragma once
+
+// STL includes
+#include <cstdint>
+
+// Qt includes
+#include <QFile>
+#include <QString>
+
+// Utils includes
+#include <utils/Image.h>
+#include <utils/ColorRgb.h>
+
+///
+/// @brief Recording of RGB frames used to replay a reproducible input into the processing pipeline
+///
+/// The file consists of a fixed header followed by the raw frames, every frame stored as width * height packed
+/// ColorRgb pixels. All frames share the size of the recording, i.e. the frames can be accessed in place by
+/// memory-mapping the file. Header fields are stored little-endian.
+///
+///     offset  size  field
+///          0     8  magic "HYPFRAME"
+///          8     4  format version
+///         12     4  width in pixels
+///         16     4  height in pixels
+///         20     4  number of frames
+///         24     4  capture interval in microseconds, zero if unknown
+///         28     4  reserved
+///
+namespace FrameRecording {
+
+constexpr int HEADER_SIZE = 32;
+constexpr uint32_t FORMAT_VERSION = 1;
+
+///
+/// @brief Appends frames to a new recording file
+///
+class Writer
+{
+public:
+	Writer() = default;
+	~Writer();
+
+	///
+	/// @brief Create the recording file, an existing file is overwritten
+	///
+	/// @param fileName          The file to write
+	/// @param width             The width of all frames
+	/// @param height            The height of all frames
+	/// @param frameIntervalUs   The capture interval of the frames in microseconds, zero if unknown
+	/// @return True on success
+	///
+	bool open(const QString& fileName, int width, int height, uint32_t frameIntervalUs = 0);
+
+	///
+	/// @brief Append a frame, which must have the size of the recording
+	///
+	bool append(const Image<ColorRgb>& image);
+
+	///
+	/// @brief Finalise the header and close the file
+	///
+	bool close();
+
+	int frameCount() const { return static_cast<int>(_frameCount); }
+
+	QString errorString() const { return _file.errorString(); }
+
+private:
+	bool writeHeader();
+
+	QFile _file;
+	int _width = 0;
+	int _height = 0;
+	uint32_t _frameIntervalUs = 0;
+	uint32_t _frameCount = 0;
+};
+
+///
+/// @brief Provides the frames of a recording file memory-mapped
+///
+class Reader
+{
+public:
+	Reader() = default;
+	~Reader();
+
+	///
+	/// @brief Open and map the recording file
+	///
+	/// @param fileName  The file to read
+	/// @return True on success, else the reason is provided by errorString()
+	///
+	bool open(const QString& fileName);
+
+	void close();
+
+	int width() const { return _width; }
+	int height() const { return _height; }
+	int frameCount() const { return _frameCount; }
+	uint32_t frameIntervalUs() const { return _frameIntervalUs; }
+
+	/// @return The size of a frame in bytes
+	size_t frameSize() const { return static_cast<size_t>(_width) * static_cast<size_t>(_height) * sizeof(ColorRgb); }
+
+	///
+	/// @brief Get the pixels of a frame in place
+	///
+	/// @param index  The frame index, must be less than frameCount()
+	///
+	const uint8_t* frame(int index) const { return _data + HEADER_SIZE + static_cast<size_t>(index) * frameSize(); }
+
+	QString errorString() const { return _error; }
+
+private:
+	QFile _file;
+	const uint8_t* _data = nullptr;
+	int _width = 0;
+	int _height = 0;
+	int _frameCount = 0;
+	uint32_t _frameIntervalUs = 0;
+	QString _error;
+};
+
+} // namespace FrameRecording
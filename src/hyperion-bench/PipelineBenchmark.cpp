@@ -0,0 +1,397 @@
+#include "PipelineBenchmark.h"
+#include "AllocationCounter.h"
+
+// STL includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+// Qt includes
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMetaObject>
+
+// Hyperion includes
+#include <hyperion/Hyperion.h>
+#include <hyperion/ImageProcessor.h>
+#include <hyperion/MultiColorAdjustment.h>
+#include <hyperion/LinearColorSmoothing.h>
+#include <utils/hyperion.h>
+#include <utils/Tracing.h>
+#include <db/InstanceTable.h>
+
+// LedDevice includes
+#include <leddevice/LedDevice.h>
+#include <leddevice/dev_other/LedDeviceFile.h>
+
+namespace {
+
+const int INSTANCE = 0;
+
+// Depth of the generated LED areas relative to the screen size
+const double LED_AREA_DEPTH = 0.08;
+
+///
+/// @brief LED device discarding the colors, i.e. only the common device handling is measured
+///
+class NullLedDevice : public LedDevice
+{
+public:
+	explicit NullLedDevice(const QJsonObject& deviceConfig)
+		: LedDevice(deviceConfig)
+	{
+	}
+
+protected:
+	int write(const std::vector<ColorRgb>& /*ledValues*/) override
+	{
+		return 0;
+	}
+};
+
+///
+/// @brief Create a classic layout with the given number of LEDs around a 16:9 screen
+///
+QJsonArray createLedLayout(int ledCount)
+{
+	const int horizontal = std::max(1, static_cast<int>(std::lround(ledCount * 16.0 / 50.0)));
+	const int vertical = std::max(0, (ledCount - 2 * horizontal) / 2);
+	const int bottom = ledCount - horizontal - 2 * vertical;
+
+	QJsonArray layout;
+	auto addLed = [&layout](double hmin, double hmax, double vmin, double vmax) {
+		QJsonObject led;
+		led["hmin"] = hmin;
+		led["hmax"] = hmax;
+		led["vmin"] = vmin;
+		led["vmax"] = vmax;
+		layout.append(led);
+	};
+
+	// clockwise, starting at the top left corner
+	for (int i = 0; i < horizontal; ++i)
+	{
+		addLed(double(i) / horizontal, double(i + 1) / horizontal, 0.0, LED_AREA_DEPTH);
+	}
+	for (int i = 0; i < vertical; ++i)
+	{
+		addLed(1.0 - LED_AREA_DEPTH, 1.0, double(i) / vertical, double(i + 1) / vertical);
+	}
+	for (int i = bottom - 1; i >= 0; --i)
+	{
+		addLed(double(i) / bottom, double(i + 1) / bottom, 1.0 - LED_AREA_DEPTH, 1.0);
+	}
+	for (int i = vertical - 1; i >= 0; --i)
+	{
+		addLed(0.0, LED_AREA_DEPTH, double(i) / vertical, double(i + 1) / vertical);
+	}
+
+	return layout;
+}
+
+/// Nearest-rank percentile of sorted values
+int64_t percentile(const std::vector<int64_t>& sortedValues, double fraction)
+{
+	if (sortedValues.empty())
+	{
+		return 0;
+	}
+
+	const size_t rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sortedValues.size())));
+	return sortedValues[std::min(std::max(rank, size_t(1)), sortedValues.size()) - 1];
+}
+
+double toMicros(int64_t nanos)
+{
+	return static_cast<double>(nanos) / 1000.0;
+}
+
+} // namespace
+
+PipelineBenchmark::PipelineBenchmark(const Options& options)
+	: _options(options)
+	, _log(Logger::getInstance("BENCH"))
+	, _imageProcessor(nullptr)
+	, _smoothing(nullptr)
+	, _smoothingEnabled(false)
+	, _smoothedAvailable(false)
+{
+}
+
+PipelineBenchmark::~PipelineBenchmark()
+{
+	if (_device != nullptr)
+	{
+		_device->stop();
+	}
+
+	// owned by the instance, but refers to it on destruction
+	delete _smoothing;
+}
+
+const char* PipelineBenchmark::stageToString(Stage stage)
+{
+	switch (stage)
+	{
+	case INPUT:            return "input";
+	case IMAGE_TO_LEDS:    return "imageToLeds";
+	case COLOR_ADJUSTMENT: return "colorAdjustment";
+	case SMOOTHING:        return "smoothing";
+	case DEVICE:           return "device";
+	default:               return "unknown";
+	}
+}
+
+bool PipelineBenchmark::init(QString& error)
+{
+	// The settings of an existing installation are only read, else a temporary database with the defaults is created
+	const bool readonlyMode = !_options.userDataPath.isEmpty();
+	QString rootPath = _options.userDataPath;
+	if (!readonlyMode)
+	{
+		if (!_tempDir.isValid())
+		{
+			error = "Failed to create a temporary directory";
+			return false;
+		}
+		rootPath = _tempDir.path();
+	}
+
+	try
+	{
+		InstanceTable instanceTable(rootPath, nullptr, readonlyMode);
+		_hyperion.reset(new Hyperion(INSTANCE, readonlyMode));
+	}
+	catch (const std::exception& e)
+	{
+		error = QString("Failed to create the Hyperion instance: %1").arg(e.what());
+		return false;
+	}
+
+	// LED layout
+	LedString ledString = LedString::createLedString(_hyperion->getSetting(settings::LEDS).array(), hyperion::createColorOrder(_hyperion->getSetting(settings::DEVICE).object()));
+	if (_options.ledCount > 0)
+	{
+		ledString = LedString::createLedString(createLedLayout(_options.ledCount), ColorOrder::ORDER_RGB);
+	}
+	const int ledCount = static_cast<int>(ledString.leds().size());
+
+	// image to LEDs
+	_imageProcessor = _hyperion->getImageProcessor();
+	_imageProcessor->setLedString(ledString);
+	if (!_options.mappingType.isEmpty())
+	{
+		_imageProcessor->setLedMappingType(ImageProcessor::mappingTypeToInt(_options.mappingType));
+	}
+
+	// color adjustment
+	_adjustment.reset(hyperion::createLedColorsAdjustment(ledCount, _hyperion->getSetting(settings::COLOR).object()));
+
+	// smoothing, the updates are triggered per frame instead of by the timer or output thread
+	QJsonObject smoothingConfig = _hyperion->getSetting(settings::SMOOTHING).object();
+	smoothingConfig["outputThread"] = false;
+	if (_options.disableSmoothing)
+	{
+		smoothingConfig["enable"] = false;
+	}
+	_smoothingEnabled = smoothingConfig["enable"].toBool(false);
+	_smoothing = new LinearColorSmoothing(QJsonDocument(smoothingConfig), _hyperion.get());
+
+	QObject::connect(_hyperion.get(), &Hyperion::ledDeviceData, _hyperion.get(), [this](const std::vector<ColorRgb>& ledValues) {
+		_smoothedColors = ledValues;
+		_smoothedAvailable = true;
+	}, Qt::DirectConnection);
+
+	// device, written on every frame
+	QJsonObject deviceConfig;
+	deviceConfig["currentLedCount"] = ledCount;
+	deviceConfig["colorOrder"] = "rgb";
+	deviceConfig["latchTime"] = 0;
+	deviceConfig["rewriteTime"] = 0;
+	deviceConfig["autoStart"] = true;
+	if (_options.deviceOutput.isEmpty())
+	{
+		deviceConfig["type"] = "null";
+		_device.reset(new NullLedDevice(deviceConfig));
+	}
+	else
+	{
+		deviceConfig["type"] = "file";
+		deviceConfig["output"] = _options.deviceOutput;
+		_device.reset(LedDeviceFile::construct(deviceConfig));
+	}
+	_device->setActiveDeviceType(deviceConfig["type"].toString());
+	_device->start();
+	if (!_device->isReady())
+	{
+		error = "Failed to open the LED device";
+		return false;
+	}
+
+	_ledColors.resize(static_cast<size_t>(ledCount));
+	_smoothedColors.reserve(static_cast<size_t>(ledCount));
+
+	Info(_log, "Pipeline created with %d LEDs, smoothing %s, %s device", ledCount, _smoothingEnabled ? "enabled" : "disabled", QSTRING_CSTR(deviceConfig["type"].toString()));
+	return true;
+}
+
+template <typename Function>
+void PipelineBenchmark::measureStage(Stage stage, bool measure, Function&& function)
+{
+	const uint64_t allocations = AllocationCounter::allocations();
+	const int64_t start = tracing::nowNanos();
+
+	function();
+
+	if (measure)
+	{
+		const int64_t end = tracing::nowNanos();
+		StageStatistics& statistics = _statistics[stage];
+		statistics.durationsNs.push_back(end - start);
+		statistics.allocations += AllocationCounter::allocations() - allocations;
+	}
+}
+
+void PipelineBenchmark::processFrame(const FrameRecording::Reader& recording, int index, bool measure)
+{
+	measureStage(INPUT, measure, [&]() {
+		Image<ColorRgb> image(recording.width(), recording.height(), ImageNoInit);
+		memcpy(image.memptr(), recording.frame(index % recording.frameCount()), recording.frameSize());
+		_image = std::move(image);
+	});
+
+	measureStage(IMAGE_TO_LEDS, measure, [&]() {
+		_imageProcessor->process(_image, _ledColors);
+	});
+
+	measureStage(COLOR_ADJUSTMENT, measure, [&]() {
+		_adjustment->applyAdjustment(_ledColors);
+	});
+
+	if (_smoothingEnabled)
+	{
+		_smoothedAvailable = false;
+		measureStage(SMOOTHING, measure, [&]() {
+			_smoothing->updateLedValues(_ledColors);
+			QMetaObject::invokeMethod(_smoothing, "updateLeds", Qt::DirectConnection);
+		});
+	}
+	else
+	{
+		_smoothedColors = _ledColors;
+		_smoothedAvailable = true;
+	}
+
+	// an output delay of the smoothing holds back the first frames
+	if (_smoothedAvailable)
+	{
+		measureStage(DEVICE, measure, [&]() {
+			_device->updateLeds(_smoothedColors);
+		});
+	}
+}
+
+QJsonObject PipelineBenchmark::run(const FrameRecording::Reader& recording)
+{
+	for (StageStatistics& statistics : _statistics)
+	{
+		statistics.durationsNs.clear();
+		statistics.durationsNs.reserve(static_cast<size_t>(_options.frames));
+		statistics.allocations = 0;
+	}
+
+	for (int i = 0; i < _options.warmupFrames; ++i)
+	{
+		processFrame(recording, i, false);
+	}
+
+	const auto interval = std::chrono::nanoseconds(_options.fps > 0 ? static_cast<int64_t>(1e9 / _options.fps) : 0);
+	int lateFrames = 0;
+
+	std::vector<int64_t> frameDurations;
+	frameDurations.reserve(static_cast<size_t>(_options.frames));
+	uint64_t frameAllocations = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+	auto nextFrame = start;
+	for (int i = 0; i < _options.frames; ++i)
+	{
+		if (interval.count() > 0)
+		{
+			const auto now = std::chrono::steady_clock::now();
+			if (i > 0 && now > nextFrame)
+			{
+				// the previous frame overran its interval, do not try to catch up
+				++lateFrames;
+				nextFrame = now;
+			}
+			std::this_thread::sleep_until(nextFrame);
+			nextFrame += interval;
+		}
+
+		const uint64_t allocations = AllocationCounter::allocations();
+		const int64_t frameStart = tracing::nowNanos();
+
+		processFrame(recording, _options.warmupFrames + i, true);
+
+		frameDurations.push_back(tracing::nowNanos() - frameStart);
+		frameAllocations += AllocationCounter::allocations() - allocations;
+	}
+	const double elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	QJsonObject stages;
+	for (int stage = 0; stage < STAGE_COUNT; ++stage)
+	{
+		if (!_statistics[stage].durationsNs.empty())
+		{
+			stages[stageToString(static_cast<Stage>(stage))] = statisticsReport(_statistics[stage]);
+		}
+	}
+
+	StageStatistics pipeline;
+	pipeline.durationsNs = std::move(frameDurations);
+	pipeline.allocations = frameAllocations;
+
+	QJsonObject report;
+	report["width"] = recording.width();
+	report["height"] = recording.height();
+	report["leds"] = static_cast<int>(_ledColors.size());
+	report["mappingType"] = ImageProcessor::mappingTypeToStr(_imageProcessor->ledMappingType());
+	report["smoothing"] = _smoothingEnabled;
+	report["device"] = _options.deviceOutput.isEmpty() ? "null" : "file";
+	report["frames"] = _options.frames;
+	report["warmupFrames"] = _options.warmupFrames;
+	report["targetFps"] = _options.fps;
+	report["achievedFps"] = elapsedSeconds > 0 ? _options.frames / elapsedSeconds : 0.0;
+	report["lateFrames"] = lateFrames;
+	report["stages"] = stages;
+	report["pipeline"] = statisticsReport(pipeline);
+	return report;
+}
+
+QJsonObject PipelineBenchmark::statisticsReport(const StageStatistics& statistics)
+{
+	std::vector<int64_t> durations = statistics.durationsNs;
+	std::sort(durations.begin(), durations.end());
+
+	int64_t sum = 0;
+	for (int64_t duration : durations)
+	{
+		sum += duration;
+	}
+
+	const double count = static_cast<double>(durations.size());
+
+	QJsonObject report;
+	report["frames"] = static_cast<qint64>(durations.size());
+	// rate the stage could sustain on its own
+	report["throughputFps"] = sum > 0 ? count * 1e9 / static_cast<double>(sum) : 0.0;
+	report["meanUs"] = count > 0 ? toMicros(sum) / count : 0.0;
+	report["p50Us"] = toMicros(percentile(durations, 0.50));
+	report["p99Us"] = toMicros(percentile(durations, 0.99));
+	report["maxUs"] = toMicros(durations.empty() ? 0 : durations.back());
+	report["allocationsPerFrame"] = count > 0 ? static_cast<double>(statistics.allocations) / count : 0.0;
+	return report;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+// STL includes
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Qt includes
+#include <QJsonObject>
+#include <QString>
+#include <QTemporaryDir>
+
+// Utils includes
+#include <utils/Image.h>
+#include <utils/ColorRgb.h>
+#include <utils/Logger.h>
+
+#include "FrameRecording.h"
+
+class Hyperion;
+class ImageProcessor;
+class MultiColorAdjustment;
+class LinearColorSmoothing;
+class LedDevice;
+
+///
+/// @brief Replays frames through the processing stages of a Hyperion instance and measures every stage
+///
+/// The stages are called directly one after another in the calling thread, i.e. the measurements are not affected by
+/// the event loop or other components of a running instance:
+///
+///     input            copy of the frame into a new image, as done by the grabbers
+///     imageToLeds      ImageProcessor, incl. black border detection and LED mapping
+///     colorAdjustment  MultiColorAdjustment
+///     smoothing        LinearColorSmoothing, one update per frame
+///     device           LED device, LedDeviceFile or a null device discarding the colors
+///
+class PipelineBenchmark
+{
+public:
+	struct Options
+	{
+		/// Hyperion user data directory to take the instance's configuration from, a temporary default configuration if empty
+		QString userDataPath;
+		/// Generate a layout with the given number of LEDs around the screen, zero to use the configured layout
+		int ledCount = 0;
+		/// Image to LED mapping type, the configured type if empty
+		QString mappingType;
+		/// Disable smoothing, else the configured smoothing is applied
+		bool disableSmoothing = false;
+		/// Output file of LedDeviceFile, the colors are discarded if empty
+		QString deviceOutput;
+		/// Replay rate, zero to replay as fast as possible
+		double fps = 0;
+		/// Number of frames to measure, the recording is looped if required
+		int frames = 1000;
+		/// Number of frames processed before the measurement starts
+		int warmupFrames = 50;
+	};
+
+	explicit PipelineBenchmark(const Options& options);
+	~PipelineBenchmark();
+
+	///
+	/// @brief Create the instance and the pipeline stages
+	///
+	/// @param[out] error  The reason of a failure
+	/// @return True on success
+	///
+	bool init(QString& error);
+
+	///
+	/// @brief Replay the frames of the recording and measure the stages
+	///
+	/// @return Report with throughput, latency percentiles and allocations per frame of every stage
+	///
+	QJsonObject run(const FrameRecording::Reader& recording);
+
+private:
+	enum Stage
+	{
+		INPUT = 0,
+		IMAGE_TO_LEDS,
+		COLOR_ADJUSTMENT,
+		SMOOTHING,
+		DEVICE,
+		STAGE_COUNT
+	};
+
+	struct StageStatistics
+	{
+		std::vector<int64_t> durationsNs;
+		uint64_t allocations = 0;
+	};
+
+	static const char* stageToString(Stage stage);
+
+	void processFrame(const FrameRecording::Reader& recording, int index, bool measure);
+
+	template <typename Function>
+	void measureStage(Stage stage, bool measure, Function&& function);
+
+	static QJsonObject statisticsReport(const StageStatistics& statistics);
+
+	Options _options;
+	Logger* _log;
+
+	QTemporaryDir _tempDir;
+	std::unique_ptr<Hyperion> _hyperion;
+	ImageProcessor* _imageProcessor;
+	std::unique_ptr<MultiColorAdjustment> _adjustment;
+	LinearColorSmoothing* _smoothing;
+	std::unique_ptr<LedDevice> _device;
+	bool _smoothingEnabled;
+
+	Image<ColorRgb> _image;
+	std::vector<ColorRgb> _ledColors;
+	std::vector<ColorRgb> _smoothedColors;
+	bool _smoothedAvailable;
+
+	std::array<StageStatistics, STAGE_COUNT> _statistics;
+};
@@ -0,0 +1,244 @@
+// stl includes
+#include <clocale>
+#include <cstring>
+#include <iostream>
+
+// Qt includes
+#include <QCoreApplication>
+#include <QFile>
+#include <QImage>
+#include <QJsonDocument>
+#include <QLocale>
+#include <QTemporaryFile>
+
+#include <utils/Logger.h>
+#include <utils/WorkerPool.h>
+#include <utils/DefaultSignalHandler.h>
+
+#include "HyperionConfig.h"
+#include <commandline/Parser.h>
+
+#include "FrameRecording.h"
+#include "PipelineBenchmark.h"
+
+using namespace commandline;
+
+namespace {
+
+// Number of LEDs of the generated layout, if the default configuration is used
+const int DEFAULT_LED_COUNT = 200;
+
+///
+/// @brief Write moving gradients as reproducible frames to the recording
+///
+bool writeSyntheticFrames(FrameRecording::Writer& writer, int width, int height, int frameCount)
+{
+	Image<ColorRgb> image(width, height, ImageNoInit);
+	for (int frame = 0; frame < frameCount; ++frame)
+	{
+		for (int y = 0; y < height; ++y)
+		{
+			for (int x = 0; x < width; ++x)
+			{
+				ColorRgb& pixel = image(x, y);
+				pixel.red = static_cast<uint8_t>(x * 255 / width + frame * 4);
+				pixel.green = static_cast<uint8_t>(y * 255 / height + frame * 2);
+				pixel.blue = static_cast<uint8_t>((x + y) / 8 + frame * 8);
+			}
+		}
+
+		if (!writer.append(image))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+///
+/// @brief Write image files, e.g. frames exported from a capture or video, to the recording
+///
+bool writeImageFiles(FrameRecording::Writer& writer, int width, int height, const QStringList& fileNames, Logger* log)
+{
+	Image<ColorRgb> image(width, height, ImageNoInit);
+	for (const QString& fileName : fileNames)
+	{
+		QImage source(fileName);
+		if (source.isNull())
+		{
+			Error(log, "Failed to load image '%s'", QSTRING_CSTR(fileName));
+			return false;
+		}
+
+		source = source.scaled(width, height, Qt::IgnoreAspectRatio, Qt::SmoothTransformation).convertToFormat(QImage::Format_RGB888);
+		for (int y = 0; y < height; ++y)
+		{
+			memcpy(&image(0, y), source.constScanLine(y), static_cast<size_t>(width) * sizeof(ColorRgb));
+		}
+
+		if (!writer.append(image))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+	Logger* log = Logger::getInstance("BENCH");
+	Logger::setLogLevel(Logger::WARNING);
+
+	// stdout is reserved for the report
+	std::cerr
+		<< "hyperion-bench:" << std::endl
+		<< "\tVersion   : " << HYPERION_VERSION << " (" << HYPERION_BUILD_ID << ")" << std::endl
+		<< "\tbuild time: " << __DATE__ << " " << __TIME__ << std::endl;
+
+	DefaultSignalHandler::install();
+
+	QCoreApplication app(argc, argv);
+
+	// force the locale
+	setlocale(LC_ALL, "C");
+	QLocale::setDefault(QLocale::c());
+
+	try
+	{
+		// create the option parser and initialize all parameters
+		Parser parser("Benchmark of the Hyperion processing pipeline. Replays a frame recording or synthetic frames through the image to LED mapping, color adjustment, smoothing and LED device and reports throughput, latency and allocations per stage as JSON.\nImage files given as arguments are written to a recording with --record, e.g. screenshots or frames exported from a video.");
+
+		Option          & argRecord          = parser.add<Option>       ('r', "record",          "Write the image files given as arguments, or synthetic frames if none are given, to the recording file and exit");
+		Option          & argInput           = parser.add<Option>       ('i', "input",           "Replay the recording file, synthetic frames are replayed if not given");
+		IntOption       & argWidth           = parser.add<IntOption>    (0x0, "width",           "Width of recorded and synthetic frames [default: %1]", "1280", 1);
+		IntOption       & argHeight          = parser.add<IntOption>    (0x0, "height",          "Height of recorded and synthetic frames [default: %1]", "720", 1);
+		IntOption       & argSyntheticFrames = parser.add<IntOption>    (0x0, "synthetic-frames", "Number of different synthetic frames [default: %1]", "100", 1);
+		DoubleOption    & argFps             = parser.add<DoubleOption> ('f', "fps",             "Replay rate in frames per second, 0 replays as fast as possible [default: %1]", "0");
+		IntOption       & argFrames          = parser.add<IntOption>    ('n', "frames",          "Number of frames to measure, the input is looped if required [default: %1]", "1000", 1);
+		IntOption       & argWarmup          = parser.add<IntOption>    (0x0, "warmup",          "Number of frames processed before measuring [default: %1]", "50", 0);
+		Option          & argUserData        = parser.add<Option>       ('u', "userdata",        "Take the configuration of the first instance from the given Hyperion user data directory (read only), else the default configuration is used");
+		IntOption       & argLeds            = parser.add<IntOption>    ('l', "leds",            QString("Generate a layout with the given number of LEDs around the screen [default: %1 with the default configuration, else the configured layout]").arg(DEFAULT_LED_COUNT), "", 1);
+		Option          & argMapping         = parser.add<Option>       ('m', "mapping",         "Image to LED mapping type: multicolor_mean, unicolor_mean, multicolor_mean_squared, dominant_color, dominant_color_advanced [default: configured type]");
+		BooleanOption   & argNoSmoothing     = parser.add<BooleanOption>(0x0, "no-smoothing",    "Disable the smoothing stage");
+		Option          & argDeviceOutput    = parser.add<Option>       ('d', "device-output",   "Write the LED colors to the given file by the file LED device, else the colors are discarded by a null device");
+		IntOption       & argWorkerThreads   = parser.add<IntOption>    ('t', "worker-threads",  "Number of worker threads processing the LED areas in parallel [default: %1]", "0", 0, 16);
+		Option          & argReport          = parser.add<Option>       ('o', "report",          "Write the JSON report to the given file instead of stdout");
+		BooleanOption   & argDebug           = parser.add<BooleanOption>(0x0, "debug",           "Enable debug logging");
+		BooleanOption   & argHelp            = parser.add<BooleanOption>('h', "help",            "Show this help message and exit");
+
+		// parse all options
+		parser.process(app);
+
+		// check if debug logging is required
+		if (parser.isSet(argDebug))
+		{
+			Logger::setLogLevel(Logger::DEBUG);
+		}
+
+		// check if we need to display the usage. exit if we do.
+		if (parser.isSet(argHelp))
+		{
+			parser.showHelp(0);
+		}
+
+		const int width = argWidth.getInt(parser);
+		const int height = argHeight.getInt(parser);
+
+		if (parser.isSet(argRecord))
+		{
+			FrameRecording::Writer writer;
+			if (!writer.open(argRecord.value(parser), width, height))
+			{
+				Error(log, "Failed to create recording '%s': %s", QSTRING_CSTR(argRecord.value(parser)), QSTRING_CSTR(writer.errorString()));
+				return 1;
+			}
+
+			const QStringList fileNames = parser.positionalArguments();
+			const bool success = fileNames.isEmpty()
+					? writeSyntheticFrames(writer, width, height, argSyntheticFrames.getInt(parser))
+					: writeImageFiles(writer, width, height, fileNames, log);
+			if (!success || !writer.close())
+			{
+				Error(log, "Failed to write recording '%s'", QSTRING_CSTR(argRecord.value(parser)));
+				return 1;
+			}
+
+			std::cerr << "Recorded " << writer.frameCount() << " frames of " << width << "x" << height << std::endl;
+			return 0;
+		}
+
+		// replay, synthetic frames are replayed from a temporary recording
+		QTemporaryFile syntheticFile;
+		QString inputFile = argInput.value(parser);
+		if (!parser.isSet(argInput))
+		{
+			FrameRecording::Writer writer;
+			if (!syntheticFile.open() || !writer.open(syntheticFile.fileName(), width, height)
+				|| !writeSyntheticFrames(writer, width, height, argSyntheticFrames.getInt(parser)) || !writer.close())
+			{
+				Error(log, "Failed to create the synthetic frames");
+				return 1;
+			}
+			inputFile = syntheticFile.fileName();
+		}
+
+		FrameRecording::Reader recording;
+		if (!recording.open(inputFile))
+		{
+			Error(log, "Failed to open recording '%s': %s", QSTRING_CSTR(inputFile), QSTRING_CSTR(recording.errorString()));
+			return 1;
+		}
+
+		WorkerPool::getInstance().setThreadCount(argWorkerThreads.getInt(parser));
+
+		PipelineBenchmark::Options options;
+		options.userDataPath = argUserData.value(parser);
+		options.ledCount = parser.isSet(argLeds) ? argLeds.getInt(parser) : (options.userDataPath.isEmpty() ? DEFAULT_LED_COUNT : 0);
+		options.mappingType = argMapping.value(parser);
+		options.disableSmoothing = parser.isSet(argNoSmoothing);
+		options.deviceOutput = argDeviceOutput.value(parser);
+		options.fps = argFps.getDouble(parser);
+		options.frames = argFrames.getInt(parser);
+		options.warmupFrames = argWarmup.getInt(parser);
+
+		PipelineBenchmark benchmark(options);
+		QString error;
+		if (!benchmark.init(error))
+		{
+			Error(log, "%s", QSTRING_CSTR(error));
+			return 1;
+		}
+
+		QJsonObject report = benchmark.run(recording);
+		report["version"] = HYPERION_VERSION;
+		report["input"] = parser.isSet(argInput) ? inputFile : QString("synthetic");
+		report["workerThreads"] = WorkerPool::getInstance().threadCount();
+
+		const QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+		if (parser.isSet(argReport))
+		{
+			QFile file(argReport.value(parser));
+			if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(json) != json.size())
+			{
+				Error(log, "Failed to write report '%s'", QSTRING_CSTR(argReport.value(parser)));
+				return 1;
+			}
+		}
+		else
+		{
+			std::cout << json.constData() << std::flush;
+		}
+
+		WorkerPool::getInstance().setThreadCount(0);
+	}
+	catch (const std::runtime_error & e)
+	{
+		// An error occurred. Display error and quit
+		Error(log, "%s", e.what());
+		return 1;
+	}
+
+	return 0;
+}
@@ -43,8 +43,11 @@ bool X11Wrapper::displayInit()
 
 void X11Wrapper::capture()
 {
-	_grabber.grabFrame(_screenshot, !_inited);
-	emit sig_screenshot(_screenshot);
+	// an unchanged screen is not sent again
+	if (_grabber.grabFrame(_screenshot, !_inited) != Grabber::FRAME_UNCHANGED)
+	{
+		emit sig_screenshot(_screenshot);
+	}
 	_inited = true;
 }
 
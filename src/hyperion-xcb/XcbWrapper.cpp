@@ -44,8 +44,11 @@ bool XcbWrapper::displayInit()
 
 void XcbWrapper::capture()
 {
-	_grabber.grabFrame(_screenshot, !_inited);
-	emit sig_screenshot(_screenshot);
+	// an unchanged screen is not sent again
+	if (_grabber.grabFrame(_screenshot, !_inited) != Grabber::FRAME_UNCHANGED)
+	{
+		emit sig_screenshot(_screenshot);
+	}
 	_inited = true;
 }
 
@@ -56,6 +56,9 @@ Q_IMPORT_PLUGIN(QGifPlugin)
 // NetOrigin checks
 #include <utils/NetOrigin.h>
 
+// Worker pool shared by the instances
+#include <utils/WorkerPool.h>
+
 #if defined(ENABLE_EFFECTENGINE)
 // Init Python
 #include <python/PythonInit.h>
@@ -97,6 +100,9 @@ HyperionDaemon::HyperionDaemon(const QString& rootPath, QObject* parent, bool lo
 		handleSettingsUpdate(settings::LOGGER, getSetting(settings::LOGGER));
 	}
 
+	// size the worker pool before the instances start processing
+	handleSettingsUpdate(settings::GENERAL, getSetting(settings::GENERAL));
+
 #ifdef ENABLE_MDNS
 	//Create MdnsBrowser singleton in main tread to ensure thread affinity during destruction
 	MdnsBrowser::getInstance();
@@ -410,6 +416,13 @@ void HyperionDaemon::handleSettingsUpdate(settings::type settingsType, const QJs
 		{
 			Logger::setLogLevel(Logger::DEBUG);
 		}
+
+		Logger::setAsynchronous(logConfig["asynchronous"].toBool(false));
+	}
+
+	if (settingsType == settings::GENERAL)
+	{
+		WorkerPool::getInstance().setThreadCount(config.object()["workerThreads"].toInt(0));
 	}
 
 	if (settingsType == settings::SYSTEMCAPTURE)
@@ -0,0 +1,71 @@
+// STL includes
+#include <iostream>
+#include <vector>
+
+// Qt includes
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QTimer>
+
+// Hyperion includes
+#include <hyperion/PriorityMuxer.h>
+#include <utils/ColorRgb.h>
+
+namespace {
+
+/// The muxer updates on changes via its (zero) timer, let the event loop process it
+void processUpdates()
+{
+	QEventLoop loop;
+	QTimer::singleShot(50, &loop, &QEventLoop::quit);
+	loop.exec();
+}
+
+bool expectPriority(const PriorityMuxer& muxer, int expected, const char* step)
+{
+	if (muxer.getCurrentPriority() != expected)
+	{
+		std::cout << step << ": current priority " << muxer.getCurrentPriority() << ", expected " << expected << std::endl;
+		return false;
+	}
+	return true;
+}
+
+} // End of anonymous namespace
+
+int main(int argc, char** argv)
+{
+	QCoreApplication app(argc, argv);
+
+	QObject instance;
+	instance.setProperty("instance", 0);
+	PriorityMuxer muxer(1, &instance);
+
+	const std::vector<ColorRgb> colors(1, ColorRgb::WHITE);
+	muxer.registerInput(50, hyperion::COMP_COLOR, "Test", "first");
+	muxer.registerInput(60, hyperion::COMP_COLOR, "Test", "second");
+	muxer.setInput(50, colors);
+	muxer.setInput(60, colors);
+	processUpdates();
+
+	int errors = 0;
+	errors += expectPriority(muxer, 50, "auto selection") ? 0 : 1;
+
+	// disables auto selection
+	muxer.setPriority(60);
+	processUpdates();
+	errors += expectPriority(muxer, 60, "first manual selection") ? 0 : 1;
+
+	// auto selection is disabled already, switching manually has to be applied as well
+	muxer.setPriority(50);
+	processUpdates();
+	errors += expectPriority(muxer, 50, "second manual selection") ? 0 : 1;
+
+	muxer.setPriority(60);
+	processUpdates();
+	errors += expectPriority(muxer, 60, "third manual selection") ? 0 : 1;
+
+	std::cout << "Finished with " << errors << " error(s)" << std::endl;
+
+	return errors == 0 ? 0 : 1;
+}
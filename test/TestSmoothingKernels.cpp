@@ -0,0 +1,113 @@
+// STL includes
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Hyperion includes
+#include <hyperion/SmoothingKernels.h>
+
+namespace {
+
+/// Reference rounding as used by the original per LED implementation
+long clampRounded(float x)
+{
+	return std::min(255L, std::max(0L, std::lroundf(x)));
+}
+
+} // End of anonymous namespace
+
+int main()
+{
+	const smoothing::Kernels& scalar = smoothing::scalarKernels();
+	const smoothing::Kernels& simd = smoothing::kernels();
+
+	std::cout << "Comparing smoothing kernels [" << simd.name << "] with [" << scalar.name << "]" << std::endl;
+
+	std::mt19937 rng(42);
+	std::uniform_int_distribution<int> byteDist(0, 255);
+	std::uniform_real_distribution<float> floatDist(-20.0F, 280.0F);
+
+	int errors = 0;
+
+	// Include sizes not being a multiple of any vector width to cover the scalar tail handling
+	for (size_t count : {0, 1, 3, 7, 15, 16, 17, 33, 300, 3001})
+	{
+		std::vector<uint8_t> source(count);
+		std::vector<uint8_t> target(count);
+		std::vector<uint8_t> current(count);
+		std::vector<float> values(count);
+		std::vector<float> residuals(count);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			source[i] = static_cast<uint8_t>(byteDist(rng));
+			target[i] = static_cast<uint8_t>(byteDist(rng));
+			current[i] = static_cast<uint8_t>(byteDist(rng));
+			values[i] = floatDist(rng);
+			residuals[i] = floatDist(rng) / 300.0F;
+		}
+
+		// accumulate
+		std::vector<float> accScalar = values;
+		std::vector<float> accSimd = values;
+		scalar.accumulate(source.data(), accScalar.data(), count, 0.37F);
+		simd.accumulate(source.data(), accSimd.data(), count, 0.37F);
+		if (accScalar != accSimd)
+		{
+			std::cout << "accumulate mismatch, count " << count << std::endl;
+			++errors;
+		}
+
+		// quantize
+		std::vector<uint8_t> outScalar(count);
+		std::vector<uint8_t> outSimd(count);
+		scalar.quantize(values.data(), outScalar.data(), count);
+		simd.quantize(values.data(), outSimd.data(), count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (outSimd[i] != outScalar[i] || outScalar[i] != clampRounded(values[i]))
+			{
+				std::cout << "quantize mismatch, count " << count << " idx " << i << " value " << values[i] << std::endl;
+				++errors;
+			}
+		}
+
+		// quantize with dithering
+		std::vector<float> resScalar = residuals;
+		std::vector<float> resSimd = residuals;
+		scalar.quantizeDithered(values.data(), resScalar.data(), outScalar.data(), count);
+		simd.quantizeDithered(values.data(), resSimd.data(), outSimd.data(), count);
+		if (outScalar != outSimd || resScalar != resSimd)
+		{
+			std::cout << "quantizeDithered mismatch, count " << count << std::endl;
+			++errors;
+		}
+
+		// linear step
+		for (float k : {0.0F, 0.1F, 0.5F, 0.999F, 1.0F})
+		{
+			std::vector<uint8_t> stepScalar = current;
+			std::vector<uint8_t> stepSimd = current;
+			scalar.linearStep(target.data(), stepScalar.data(), count, k);
+			simd.linearStep(target.data(), stepSimd.data(), count, k);
+			for (size_t i = 0; i < count; ++i)
+			{
+				const int diff = target[i] - current[i];
+				uint8_t expected = current[i];
+				expected += (diff < 0 ? -1 : 1) * std::ceil(k * std::abs(diff));
+				if (stepSimd[i] != stepScalar[i] || stepScalar[i] != expected)
+				{
+					std::cout << "linearStep mismatch, count " << count << " k " << k << " idx " << i << std::endl;
+					++errors;
+				}
+			}
+		}
+	}
+
+	std::cout << "Finished with " << errors << " error(s)" << std::endl;
+
+	return errors == 0 ? 0 : 1;
+}